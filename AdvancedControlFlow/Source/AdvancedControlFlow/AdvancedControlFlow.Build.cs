@@ -22,9 +22,15 @@ public class AdvancedControlFlow : ModuleRules
 		});
 
 		PrivateDependencyModuleNames.AddRange(new string[]{
+			"AdvancedControlFlowRuntime",
+			"AnimGraph",
+			"AnimGraphRuntime",
 			"BlueprintGraph",
+			"DeveloperSettings",
 			"EditorStyle",
+			"GameplayTags",
 			"GraphEditor",
+			"Json",
 			"KismetCompiler",
 			"Slate",
 			"SlateCore",
@@ -32,6 +38,9 @@ public class AdvancedControlFlow : ModuleRules
 			"UnrealEd",
 		});
 
+		// Seen by the modules depending on this module, which compile the differential tests of the exported C++ code.
+		PublicDefinitions.Add("ACF_DIFFERENTIAL_TEST");
+
 		// @remove-start FULL_VERSION=true
 		PublicDefinitions.Add("ACF_FREE_VERSION");
 		// @remove-end
@@ -0,0 +1,1618 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "ACFBenchmarkCommandlet.h"
+
+#include "ACFBatchLibrary.h"
+#include "ACFConditionLibrary.h"
+#include "ACFRandomLibrary.h"
+#include "ACFRangeLibrary.h"
+#include "ACFSwitchLibrary.h"
+#include "Dom/JsonObject.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "K2Node_CallArrayFunction.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_ConditionalSequence.h"
+#include "K2Node_ExecutionSequence.h"
+#include "K2Node_FunctionEntry.h"
+#include "K2Node_IfThenElse.h"
+#include "K2Node_MultiBranch.h"
+#include "K2Node_MultiConditionalSelect.h"
+#include "K2Node_MultiConditionalSelectBatch.h"
+#include "K2Node_MultiSwitch.h"
+#include "K2Node_RangeSelect.h"
+#include "K2Node_SwitchInteger.h"
+#include "K2Node_SwitchString.h"
+#include "K2Node_VariableGet.h"
+#include "K2Node_VariableSet.h"
+#include "Kismet/KismetArrayLibrary.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Script.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogACFBenchmark, Log, All);
+
+// Number of the condition sets evaluated per iteration.
+static const int32 NumConditionSets = 1024;
+
+// Number of the cases of Multi-Conditional Select (Batch).
+static const int32 NumBatchCases = 4;
+
+// Counts the allocations made on the thread while counting, including the blocks which are freed before the counting ends.
+// The allocations of the other threads go to the inner allocator without being counted.
+class FACFCountingMalloc final : public FMalloc
+{
+	FMalloc* InnerMalloc;
+	static thread_local bool bCounting;
+
+public:
+	// Written only by the counting thread.
+	int64 NumAllocations = 0;
+	int64 AllocatedBytes = 0;
+
+	explicit FACFCountingMalloc(FMalloc* InInnerMalloc) : InnerMalloc(InInnerMalloc)
+	{
+	}
+
+	void BeginCounting()
+	{
+		NumAllocations = 0;
+		AllocatedBytes = 0;
+		bCounting = true;
+	}
+	void EndCounting()
+	{
+		bCounting = false;
+	}
+
+	virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+	{
+		if (bCounting)
+		{
+			++NumAllocations;
+			AllocatedBytes += Count;
+		}
+		return InnerMalloc->Malloc(Count, Alignment);
+	}
+	virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+	{
+		if (bCounting && (Count != 0))
+		{
+			++NumAllocations;
+			AllocatedBytes += Count;
+		}
+		return InnerMalloc->Realloc(Original, Count, Alignment);
+	}
+	virtual void Free(void* Original) override
+	{
+		InnerMalloc->Free(Original);
+	}
+	virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+	{
+		return InnerMalloc->GetAllocationSize(Original, SizeOut);
+	}
+	virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+	{
+		return InnerMalloc->QuantizeSize(Count, Alignment);
+	}
+	virtual void Trim(bool bTrimThreadCaches) override
+	{
+		InnerMalloc->Trim(bTrimThreadCaches);
+	}
+	virtual void SetupTLSCachesOnCurrentThread() override
+	{
+		InnerMalloc->SetupTLSCachesOnCurrentThread();
+	}
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+	{
+		InnerMalloc->ClearAndDisableTLSCachesOnCurrentThread();
+	}
+	virtual void UpdateStats() override
+	{
+		InnerMalloc->UpdateStats();
+	}
+	virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override
+	{
+		InnerMalloc->GetAllocatorStats(OutStats);
+	}
+	virtual void DumpAllocatorStats(FOutputDevice& Ar) override
+	{
+		InnerMalloc->DumpAllocatorStats(Ar);
+	}
+	virtual bool ValidateHeap() override
+	{
+		return InnerMalloc->ValidateHeap();
+	}
+	virtual bool IsInternallyThreadSafe() const override
+	{
+		return InnerMalloc->IsInternallyThreadSafe();
+	}
+	virtual const TCHAR* GetDescriptiveName() override
+	{
+		return TEXT("ACFCountingMalloc");
+	}
+};
+
+thread_local bool FACFCountingMalloc::bCounting = false;
+
+// Installed once when the commandlet starts, and never removed nor deleted, so that every block is freed through the allocator
+// which allocated it. The other threads see the old or the new GMalloc, and both forward to the same inner allocator.
+static FACFCountingMalloc* CountingMalloc = nullptr;
+
+static void InstallCountingMalloc()
+{
+	if (CountingMalloc == nullptr)
+	{
+		CountingMalloc = new FACFCountingMalloc(GMalloc);
+		GMalloc = CountingMalloc;
+	}
+}
+
+// Number of the Blueprint function calls per iteration.
+static const int32 NumBlueprintEvaluations = 64;
+
+static const FName BenchmarkFunctionName(TEXT("Evaluate"));
+static const FName SinkVariableName(TEXT("Sink"));
+static const FName ResultsVariableName(TEXT("Results"));
+static const FName LoopIndexVariableName(TEXT("LoopIndex"));
+
+static const FName SelectionParamName(TEXT("Selection"));
+static const FName RangeValueParamName(TEXT("Value"));
+
+typedef void (*FBuildBenchmarkGraph)(UEdGraph* Graph, UEdGraphPin* EntryExecPin, const TArray<UEdGraphPin*>& ConditionPins);
+
+// Parameter of the Evaluate function.
+struct FBenchmarkParam
+{
+	FName Name;
+	FEdGraphPinType PinType;
+};
+
+static FEdGraphPinType MakeBenchmarkPinType(FName PinCategory, EPinContainerType ContainerType = EPinContainerType::None)
+{
+	FEdGraphPinType PinType;
+	PinType.PinCategory = PinCategory;
+	PinType.ContainerType = ContainerType;
+
+	return PinType;
+}
+
+static FName GetConditionParamName(int32 Case)
+{
+	return *FString::Printf(TEXT("Condition%d"), Case);
+}
+
+static FName GetOptionParamName(int32 Case)
+{
+	return *FString::Printf(TEXT("Option%d"), Case);
+}
+
+// Boolean condition of each case.
+static TArray<FBenchmarkParam> MakeConditionParams(int32 NumCases)
+{
+	TArray<FBenchmarkParam> Params;
+	for (int32 Case = 0; Case < NumCases; ++Case)
+	{
+		Params.Add({GetConditionParamName(Case), MakeBenchmarkPinType(UEdGraphSchema_K2::PC_Boolean)});
+	}
+
+	return Params;
+}
+
+static UK2Node_VariableGet* SpawnGetMember(UEdGraph* Graph, FName VariableName)
+{
+	FGraphNodeCreator<UK2Node_VariableGet> Creator(*Graph);
+	UK2Node_VariableGet* Get = Creator.CreateNode(false);
+	Get->VariableReference.SetSelfMember(VariableName);
+	Creator.Finalize();
+
+	return Get;
+}
+
+static UK2Node_VariableSet* SpawnSetMember(UEdGraph* Graph, FName VariableName)
+{
+	FGraphNodeCreator<UK2Node_VariableSet> Creator(*Graph);
+	UK2Node_VariableSet* Set = Creator.CreateNode(false);
+	Set->VariableReference.SetSelfMember(VariableName);
+	Creator.Finalize();
+
+	return Set;
+}
+
+// Returns the Set node of the Sink variable, which is the observable effect of the graph.
+static UK2Node_VariableSet* SpawnSetSink(UEdGraph* Graph, int32 Value)
+{
+	UK2Node_VariableSet* SetSink = SpawnSetMember(Graph, SinkVariableName);
+	GetDefault<UEdGraphSchema_K2>()->TrySetDefaultValue(*SetSink->FindPinChecked(SinkVariableName), LexToString(Value));
+
+	return SetSink;
+}
+
+static UK2Node_CallFunction* SpawnCallFunction(UEdGraph* Graph, UClass* Class, FName FunctionName)
+{
+	FGraphNodeCreator<UK2Node_CallFunction> Creator(*Graph);
+	UK2Node_CallFunction* Call = Creator.CreateNode(false);
+	Call->SetFromFunction(Class->FindFunctionByName(FunctionName));
+	Creator.Finalize();
+
+	return Call;
+}
+
+// Connecting the array fixes the element type of the other pins.
+static UK2Node_CallArrayFunction* SpawnCallArrayFunction(UEdGraph* Graph, FName FunctionName, UEdGraphPin* ArrayPin)
+{
+	FGraphNodeCreator<UK2Node_CallArrayFunction> Creator(*Graph);
+	UK2Node_CallArrayFunction* Call = Creator.CreateNode(false);
+	Call->SetFromFunction(UKismetArrayLibrary::StaticClass()->FindFunctionByName(FunctionName));
+	Creator.Finalize();
+
+	GetDefault<UEdGraphSchema_K2>()->TryCreateConnection(ArrayPin, Call->FindPinChecked(TEXT("TargetArray")));
+
+	return Call;
+}
+
+static void BuildMultiBranchGraph(UEdGraph* Graph, UEdGraphPin* EntryExecPin, const TArray<UEdGraphPin*>& ConditionPins)
+{
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+
+	FGraphNodeCreator<UK2Node_MultiBranch> Creator(*Graph);
+	UK2Node_MultiBranch* MultiBranch = Creator.CreateNode(false);
+	Creator.Finalize();
+	while (MultiBranch->GetCasePinCount() < ConditionPins.Num())
+	{
+		MultiBranch->AddCasePinLast();
+	}
+
+	Schema->TryCreateConnection(EntryExecPin, MultiBranch->GetExecPin());
+	const TArray<UEdGraphPin*> CondPins = MultiBranch->GetCaseConditionPins();
+	for (int32 Case = 0; Case < ConditionPins.Num(); ++Case)
+	{
+		Schema->TryCreateConnection(ConditionPins[Case], CondPins[Case]);
+		Schema->TryCreateConnection(
+			MultiBranch->GetCaseValuePinFromCaseKeyPin(CondPins[Case]), SpawnSetSink(Graph, Case)->GetExecPin());
+	}
+}
+
+static void BuildNestedBranchGraph(UEdGraph* Graph, UEdGraphPin* EntryExecPin, const TArray<UEdGraphPin*>& ConditionPins)
+{
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+
+	// The Else pin of each Branch node goes to the Branch node of the next case.
+	UEdGraphPin* ExecPin = EntryExecPin;
+	for (int32 Case = 0; Case < ConditionPins.Num(); ++Case)
+	{
+		FGraphNodeCreator<UK2Node_IfThenElse> Creator(*Graph);
+		UK2Node_IfThenElse* Branch = Creator.CreateNode(false);
+		Creator.Finalize();
+
+		Schema->TryCreateConnection(ExecPin, Branch->GetExecPin());
+		Schema->TryCreateConnection(ConditionPins[Case], Branch->GetConditionPin());
+		Schema->TryCreateConnection(Branch->GetThenPin(), SpawnSetSink(Graph, Case)->GetExecPin());
+		ExecPin = Branch->GetElsePin();
+	}
+}
+
+static void BuildConditionalSequenceGraph(UEdGraph* Graph, UEdGraphPin* EntryExecPin, const TArray<UEdGraphPin*>& ConditionPins)
+{
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+
+	FGraphNodeCreator<UK2Node_ConditionalSequence> Creator(*Graph);
+	UK2Node_ConditionalSequence* ConditionalSequence = Creator.CreateNode(false);
+	Creator.Finalize();
+	while (ConditionalSequence->GetCasePinCount() < ConditionPins.Num())
+	{
+		ConditionalSequence->AddCasePinLast();
+	}
+
+	Schema->TryCreateConnection(EntryExecPin, ConditionalSequence->GetExecPin());
+	const TArray<UEdGraphPin*> CondPins = ConditionalSequence->GetCaseConditionPins();
+	for (int32 Case = 0; Case < ConditionPins.Num(); ++Case)
+	{
+		Schema->TryCreateConnection(ConditionPins[Case], CondPins[Case]);
+		Schema->TryCreateConnection(
+			ConditionalSequence->GetCaseValuePinFromCaseKeyPin(CondPins[Case]), SpawnSetSink(Graph, Case)->GetExecPin());
+	}
+}
+
+static void BuildSequenceBranchGraph(UEdGraph* Graph, UEdGraphPin* EntryExecPin, const TArray<UEdGraphPin*>& ConditionPins)
+{
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+
+	FGraphNodeCreator<UK2Node_ExecutionSequence> SequenceCreator(*Graph);
+	UK2Node_ExecutionSequence* Sequence = SequenceCreator.CreateNode(false);
+	SequenceCreator.Finalize();
+	while (Sequence->GetThenPinGivenIndex(ConditionPins.Num() - 1) == nullptr)
+	{
+		Sequence->AddInputPin();
+	}
+
+	Schema->TryCreateConnection(EntryExecPin, Sequence->GetExecPin());
+	for (int32 Case = 0; Case < ConditionPins.Num(); ++Case)
+	{
+		FGraphNodeCreator<UK2Node_IfThenElse> BranchCreator(*Graph);
+		UK2Node_IfThenElse* Branch = BranchCreator.CreateNode(false);
+		BranchCreator.Finalize();
+
+		Schema->TryCreateConnection(Sequence->GetThenPinGivenIndex(Case), Branch->GetExecPin());
+		Schema->TryCreateConnection(ConditionPins[Case], Branch->GetConditionPin());
+		Schema->TryCreateConnection(Branch->GetThenPin(), SpawnSetSink(Graph, Case)->GetExecPin());
+	}
+}
+
+static void BuildMultiConditionalSelectGraph(UEdGraph* Graph, UEdGraphPin* EntryExecPin, const TArray<UEdGraphPin*>& ConditionPins)
+{
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+
+	FGraphNodeCreator<UK2Node_MultiConditionalSelect> Creator(*Graph);
+	UK2Node_MultiConditionalSelect* MultiConditionalSelect = Creator.CreateNode(false);
+	Creator.Finalize();
+	while (MultiConditionalSelect->GetCasePinCount() < ConditionPins.Num())
+	{
+		MultiConditionalSelect->AddCasePinLast();
+	}
+
+	// Connecting the return value fixes the option pins to Integer.
+	UK2Node_VariableSet* SetSink = SpawnSetSink(Graph, INDEX_NONE);
+	Schema->TryCreateConnection(EntryExecPin, SetSink->GetExecPin());
+	Schema->TryCreateConnection(MultiConditionalSelect->GetReturnValuePin(), SetSink->FindPinChecked(SinkVariableName));
+
+	Schema->TrySetDefaultValue(*MultiConditionalSelect->GetDefaultOptionPin(), LexToString(INDEX_NONE));
+	const TArray<UEdGraphPin*> CondPins = MultiConditionalSelect->GetCaseConditionPins();
+	for (int32 Case = 0; Case < ConditionPins.Num(); ++Case)
+	{
+		Schema->TryCreateConnection(ConditionPins[Case], CondPins[Case]);
+		Schema->TrySetDefaultValue(*MultiConditionalSelect->GetCaseKeyPinFromCaseValuePin(CondPins[Case]), LexToString(Case));
+	}
+}
+
+static void BuildNestedSelectGraph(UEdGraph* Graph, UEdGraphPin* EntryExecPin, const TArray<UEdGraphPin*>& ConditionPins)
+{
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+	UFunction* SelectInt =
+		UKismetMathLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, SelectInt));
+
+	UK2Node_VariableSet* SetSink = SpawnSetSink(Graph, INDEX_NONE);
+	Schema->TryCreateConnection(EntryExecPin, SetSink->GetExecPin());
+
+	// The Select node of each case takes the Select node of the next case as the value when the condition is false.
+	UEdGraphPin* ValuePin = SetSink->FindPinChecked(SinkVariableName);
+	for (int32 Case = 0; Case < ConditionPins.Num(); ++Case)
+	{
+		FGraphNodeCreator<UK2Node_CallFunction> Creator(*Graph);
+		UK2Node_CallFunction* Select = Creator.CreateNode(false);
+		Select->SetFromFunction(SelectInt);
+		Creator.Finalize();
+
+		Schema->TryCreateConnection(Select->GetReturnValuePin(), ValuePin);
+		Schema->TryCreateConnection(ConditionPins[Case], Select->FindPinChecked(TEXT("bPickA")));
+		Schema->TrySetDefaultValue(*Select->FindPinChecked(TEXT("A")), LexToString(Case));
+		ValuePin = Select->FindPinChecked(TEXT("B"));
+	}
+	Schema->TrySetDefaultValue(*ValuePin, LexToString(INDEX_NONE));
+}
+
+static void BuildMultiSwitchGraph(
+	UEdGraph* Graph, UEdGraphPin* EntryExecPin, UEdGraphPin* SelectionPin, const TArray<FString>& Keys)
+{
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+
+	FGraphNodeCreator<UK2Node_MultiSwitch> Creator(*Graph);
+	UK2Node_MultiSwitch* MultiSwitch = Creator.CreateNode(false);
+	Creator.Finalize();
+
+	// Connecting the selection fixes the key pins to its type.
+	Schema->TryCreateConnection(EntryExecPin, MultiSwitch->GetExecPin());
+	Schema->TryCreateConnection(SelectionPin, MultiSwitch->GetSelectionPin());
+	while (MultiSwitch->GetCasePinCount() < Keys.Num())
+	{
+		MultiSwitch->AddCasePinLast();
+	}
+
+	// The last hit pin is the default, which is left unconnected as the other graphs do nothing on the miss.
+	const TArray<UEdGraphPin*> ExecPins = MultiSwitch->GetCaseHitPins();
+	for (int32 Case = 0; Case < Keys.Num(); ++Case)
+	{
+		Schema->TrySetDefaultValue(*MultiSwitch->GetCaseKeyPinFromCaseValuePin(ExecPins[Case]), Keys[Case]);
+		Schema->TryCreateConnection(ExecPins[Case], SpawnSetSink(Graph, Case)->GetExecPin());
+	}
+}
+
+static void BuildEqualityMultiBranchGraph(
+	UEdGraph* Graph, UEdGraphPin* EntryExecPin, UEdGraphPin* SelectionPin, const TArray<FString>& Keys)
+{
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+	UFunction* EqualInt =
+		UKismetMathLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, EqualEqual_IntInt));
+
+	// The condition of each case is the equality of the selection and the key.
+	TArray<UEdGraphPin*> ConditionPins;
+	for (const FString& Key : Keys)
+	{
+		FGraphNodeCreator<UK2Node_CallFunction> Creator(*Graph);
+		UK2Node_CallFunction* Equal = Creator.CreateNode(false);
+		Equal->SetFromFunction(EqualInt);
+		Creator.Finalize();
+
+		Schema->TryCreateConnection(SelectionPin, Equal->FindPinChecked(TEXT("A")));
+		Schema->TrySetDefaultValue(*Equal->FindPinChecked(TEXT("B")), Key);
+		ConditionPins.Add(Equal->GetReturnValuePin());
+	}
+
+	BuildMultiBranchGraph(Graph, EntryExecPin, ConditionPins);
+}
+
+// The parameters are the Boolean array of the conditions of each case followed by the integer array of the options of each case.
+// The selected options are set to the Results variable.
+static void BuildBatchSelectGraph(UEdGraph* Graph, UEdGraphPin* EntryExecPin, const TArray<UEdGraphPin*>& ParamPins)
+{
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+	const int32 NumCases = ParamPins.Num() / 2;
+	FBlueprintEditorUtils::AddMemberVariable(FBlueprintEditorUtils::FindBlueprintForGraphChecked(Graph), ResultsVariableName,
+		MakeBenchmarkPinType(UEdGraphSchema_K2::PC_Int, EPinContainerType::Array));
+
+	FGraphNodeCreator<UK2Node_MultiConditionalSelectBatch> Creator(*Graph);
+	UK2Node_MultiConditionalSelectBatch* Batch = Creator.CreateNode(false);
+	Creator.Finalize();
+	while (Batch->GetCasePinCount() < NumCases)
+	{
+		Batch->AddCasePinLast();
+	}
+
+	// Connecting the option array fixes the element type.
+	const TArray<UEdGraphPin*> CondPins = Batch->GetCaseConditionPins();
+	for (int32 Case = 0; Case < NumCases; ++Case)
+	{
+		Schema->TryCreateConnection(ParamPins[NumCases + Case], Batch->GetCaseKeyPinFromCaseValuePin(CondPins[Case]));
+		Schema->TryCreateConnection(ParamPins[Case], CondPins[Case]);
+	}
+	Schema->TrySetDefaultValue(*Batch->GetDefaultOptionPin(), LexToString(INDEX_NONE));
+
+	UK2Node_VariableSet* SetResults = SpawnSetMember(Graph, ResultsVariableName);
+	Schema->TryCreateConnection(EntryExecPin, SetResults->GetExecPin());
+	Schema->TryCreateConnection(Batch->GetReturnValuePin(), SetResults->FindPinChecked(ResultsVariableName));
+}
+
+// Same as the expansion of For Loop over the elements, whose body sets the option selected by Multi-Conditional Select to the
+// element of the Results variable. The loop index is a member variable instead of the local variable of the macro.
+static void BuildLoopSelectGraph(UEdGraph* Graph, UEdGraphPin* EntryExecPin, const TArray<UEdGraphPin*>& ParamPins)
+{
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+	const int32 NumCases = ParamPins.Num() / 2;
+	UBlueprint* Blueprint = FBlueprintEditorUtils::FindBlueprintForGraphChecked(Graph);
+	FBlueprintEditorUtils::AddMemberVariable(
+		Blueprint, ResultsVariableName, MakeBenchmarkPinType(UEdGraphSchema_K2::PC_Int, EPinContainerType::Array));
+	FBlueprintEditorUtils::AddMemberVariable(Blueprint, LoopIndexVariableName, MakeBenchmarkPinType(UEdGraphSchema_K2::PC_Int));
+
+	UEdGraphPin* ResultsPin = SpawnGetMember(Graph, ResultsVariableName)->FindPinChecked(ResultsVariableName);
+	UEdGraphPin* IndexPin = SpawnGetMember(Graph, LoopIndexVariableName)->FindPinChecked(LoopIndexVariableName);
+
+	// Resize the results to the number of the elements, and reset the index.
+	UEdGraphPin* LengthPin =
+		SpawnCallArrayFunction(Graph, GET_FUNCTION_NAME_CHECKED(UKismetArrayLibrary, Array_Length), ParamPins[0])
+			->GetReturnValuePin();
+	UK2Node_CallArrayFunction* Resize =
+		SpawnCallArrayFunction(Graph, GET_FUNCTION_NAME_CHECKED(UKismetArrayLibrary, Array_Resize), ResultsPin);
+	Schema->TryCreateConnection(LengthPin, Resize->FindPinChecked(TEXT("Size")));
+	Schema->TryCreateConnection(EntryExecPin, Resize->GetExecPin());
+
+	UK2Node_VariableSet* ResetIndex = SpawnSetMember(Graph, LoopIndexVariableName);
+	Schema->TrySetDefaultValue(*ResetIndex->FindPinChecked(LoopIndexVariableName), TEXT("0"));
+	Schema->TryCreateConnection(Resize->GetThenPin(), ResetIndex->GetExecPin());
+
+	// Branch on Index < Length.
+	UK2Node_CallFunction* Less =
+		SpawnCallFunction(Graph, UKismetMathLibrary::StaticClass(), GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, Less_IntInt));
+	Schema->TryCreateConnection(IndexPin, Less->FindPinChecked(TEXT("A")));
+	Schema->TryCreateConnection(LengthPin, Less->FindPinChecked(TEXT("B")));
+
+	FGraphNodeCreator<UK2Node_IfThenElse> BranchCreator(*Graph);
+	UK2Node_IfThenElse* Branch = BranchCreator.CreateNode(false);
+	BranchCreator.Finalize();
+	Schema->TryCreateConnection(ResetIndex->GetThenPin(), Branch->GetExecPin());
+	Schema->TryCreateConnection(Less->GetReturnValuePin(), Branch->GetConditionPin());
+
+	// Body: Set Array Elem of Results to the option selected from the elements of the index.
+	UK2Node_CallArrayFunction* SetElement =
+		SpawnCallArrayFunction(Graph, GET_FUNCTION_NAME_CHECKED(UKismetArrayLibrary, Array_Set), ResultsPin);
+	Schema->TryCreateConnection(IndexPin, SetElement->FindPinChecked(TEXT("Index")));
+	Schema->TryCreateConnection(Branch->GetThenPin(), SetElement->GetExecPin());
+
+	FGraphNodeCreator<UK2Node_MultiConditionalSelect> SelectCreator(*Graph);
+	UK2Node_MultiConditionalSelect* MultiConditionalSelect = SelectCreator.CreateNode(false);
+	SelectCreator.Finalize();
+	while (MultiConditionalSelect->GetCasePinCount() < NumCases)
+	{
+		MultiConditionalSelect->AddCasePinLast();
+	}
+
+	// Connecting the return value fixes the option pins to Integer.
+	Schema->TryCreateConnection(MultiConditionalSelect->GetReturnValuePin(), SetElement->FindPinChecked(TEXT("Item")));
+	Schema->TrySetDefaultValue(*MultiConditionalSelect->GetDefaultOptionPin(), LexToString(INDEX_NONE));
+	const TArray<UEdGraphPin*> CondPins = MultiConditionalSelect->GetCaseConditionPins();
+	for (int32 Case = 0; Case < NumCases; ++Case)
+	{
+		UK2Node_CallArrayFunction* GetCondition =
+			SpawnCallArrayFunction(Graph, GET_FUNCTION_NAME_CHECKED(UKismetArrayLibrary, Array_Get), ParamPins[Case]);
+		Schema->TryCreateConnection(IndexPin, GetCondition->FindPinChecked(TEXT("Index")));
+		Schema->TryCreateConnection(GetCondition->FindPinChecked(TEXT("Item")), CondPins[Case]);
+
+		UK2Node_CallArrayFunction* GetOption = SpawnCallArrayFunction(
+			Graph, GET_FUNCTION_NAME_CHECKED(UKismetArrayLibrary, Array_Get), ParamPins[NumCases + Case]);
+		Schema->TryCreateConnection(IndexPin, GetOption->FindPinChecked(TEXT("Index")));
+		Schema->TryCreateConnection(
+			GetOption->FindPinChecked(TEXT("Item")), MultiConditionalSelect->GetCaseKeyPinFromCaseValuePin(CondPins[Case]));
+	}
+
+	// Increment the index, and go back to the branch.
+	UK2Node_CallFunction* Increment =
+		SpawnCallFunction(Graph, UKismetMathLibrary::StaticClass(), GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, Add_IntInt));
+	Schema->TryCreateConnection(IndexPin, Increment->FindPinChecked(TEXT("A")));
+	Schema->TrySetDefaultValue(*Increment->FindPinChecked(TEXT("B")), TEXT("1"));
+
+	UK2Node_VariableSet* SetIndex = SpawnSetMember(Graph, LoopIndexVariableName);
+	Schema->TryCreateConnection(Increment->GetReturnValuePin(), SetIndex->FindPinChecked(LoopIndexVariableName));
+	Schema->TryCreateConnection(SetElement->GetThenPin(), SetIndex->GetExecPin());
+	Schema->TryCreateConnection(SetIndex->GetThenPin(), Branch->GetExecPin());
+}
+
+// Switch on String compares the selection with each key case-insensitively in turn.
+static void BuildSwitchOnStringGraph(
+	UEdGraph* Graph, UEdGraphPin* EntryExecPin, UEdGraphPin* SelectionPin, const TArray<FString>& Keys)
+{
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+
+	// The case pins are created from the names when the node is finalized.
+	FGraphNodeCreator<UK2Node_SwitchString> Creator(*Graph);
+	UK2Node_SwitchString* Switch = Creator.CreateNode(false);
+	for (const FString& Key : Keys)
+	{
+		Switch->PinNames.Add(*Key);
+	}
+	Creator.Finalize();
+
+	Schema->TryCreateConnection(EntryExecPin, Switch->GetExecPin());
+	Schema->TryCreateConnection(SelectionPin, Switch->GetSelectionPin());
+	for (int32 Case = 0; Case < Keys.Num(); ++Case)
+	{
+		Schema->TryCreateConnection(Switch->FindPinChecked(Switch->PinNames[Case]), SpawnSetSink(Graph, Case)->GetExecPin());
+	}
+}
+
+static void BuildRangeSelectGraph(UEdGraph* Graph, UEdGraphPin* EntryExecPin, UEdGraphPin* ValuePin, const TArray<FString>& Bounds)
+{
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+
+	FGraphNodeCreator<UK2Node_RangeSelect> Creator(*Graph);
+	UK2Node_RangeSelect* RangeSelect = Creator.CreateNode(false);
+	Creator.Finalize();
+
+	// Connecting the value fixes the bound pins to its type, and connecting the return value fixes the option pins to Integer.
+	Schema->TryCreateConnection(ValuePin, RangeSelect->GetValuePin());
+	while (RangeSelect->GetCasePinCount() < Bounds.Num())
+	{
+		RangeSelect->AddCasePinLast();
+	}
+	UK2Node_VariableSet* SetSink = SpawnSetSink(Graph, INDEX_NONE);
+	Schema->TryCreateConnection(EntryExecPin, SetSink->GetExecPin());
+	Schema->TryCreateConnection(RangeSelect->GetReturnValuePin(), SetSink->FindPinChecked(SinkVariableName));
+
+	Schema->TrySetDefaultValue(*RangeSelect->GetDefaultOptionPin(), LexToString(INDEX_NONE));
+	const TArray<UEdGraphPin*> OptionPins = RangeSelect->GetCaseHitPins();
+	for (int32 Case = 0; Case < Bounds.Num(); ++Case)
+	{
+		Schema->TrySetDefaultValue(*OptionPins[Case], LexToString(Case));
+		Schema->TrySetDefaultValue(*RangeSelect->GetCaseValuePinFromCaseKeyPin(OptionPins[Case]), Bounds[Case]);
+	}
+}
+
+static void BuildLessMultiConditionalSelectGraph(
+	UEdGraph* Graph, UEdGraphPin* EntryExecPin, UEdGraphPin* ValuePin, const TArray<FString>& Bounds)
+{
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+
+	// The condition of each case is "Value < Bound".
+	TArray<UEdGraphPin*> ConditionPins;
+	for (const FString& Bound : Bounds)
+	{
+		UK2Node_CallFunction* Less = SpawnCallFunction(
+			Graph, UKismetMathLibrary::StaticClass(), GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, Less_IntInt));
+		Schema->TryCreateConnection(ValuePin, Less->FindPinChecked(TEXT("A")));
+		Schema->TrySetDefaultValue(*Less->FindPinChecked(TEXT("B")), Bound);
+		ConditionPins.Add(Less->GetReturnValuePin());
+	}
+
+	BuildMultiConditionalSelectGraph(Graph, EntryExecPin, ConditionPins);
+}
+
+// The cases of Switch on Int are the consecutive integers from 0.
+static void BuildSwitchOnIntGraph(UEdGraph* Graph, UEdGraphPin* EntryExecPin, UEdGraphPin* SelectionPin, int32 NumCases)
+{
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+
+	FGraphNodeCreator<UK2Node_SwitchInteger> Creator(*Graph);
+	UK2Node_SwitchInteger* Switch = Creator.CreateNode(false);
+	Creator.Finalize();
+	for (int32 Case = 0; Case < NumCases; ++Case)
+	{
+		Switch->AddPinToSwitchNode();
+	}
+
+	Schema->TryCreateConnection(EntryExecPin, Switch->GetExecPin());
+	Schema->TryCreateConnection(SelectionPin, Switch->GetSelectionPin());
+	for (int32 Case = 0; Case < NumCases; ++Case)
+	{
+		Schema->TryCreateConnection(Switch->FindPinChecked(*FString::FromInt(Case)), SpawnSetSink(Graph, Case)->GetExecPin());
+	}
+}
+
+// Creates the Blueprint whose Evaluate function takes the parameters, and compiles it.
+// BuildGraph takes the pins of the parameters in the order of Params.
+static UBlueprint* CreateBenchmarkBlueprint(const TCHAR* GraphName, int32 NumCases, const TArray<FBenchmarkParam>& Params,
+	TFunctionRef<void(UEdGraph*, UEdGraphPin*, const TArray<UEdGraphPin*>&)> BuildGraph)
+{
+	const FName BlueprintName = MakeUniqueObjectName(
+		GetTransientPackage(), UBlueprint::StaticClass(), *FString::Printf(TEXT("BP_ACFBenchmark_%s_%d"), GraphName, NumCases));
+	UBlueprint* Blueprint = FKismetEditorUtilities::CreateBlueprint(UObject::StaticClass(), GetTransientPackage(), BlueprintName,
+		BPTYPE_Normal, UBlueprint::StaticClass(), UBlueprintGeneratedClass::StaticClass());
+
+	FBlueprintEditorUtils::AddMemberVariable(Blueprint, SinkVariableName, MakeBenchmarkPinType(UEdGraphSchema_K2::PC_Int));
+
+	UEdGraph* Graph = FBlueprintEditorUtils::CreateNewGraph(
+		Blueprint, BenchmarkFunctionName, UEdGraph::StaticClass(), UEdGraphSchema_K2::StaticClass());
+	FBlueprintEditorUtils::AddFunctionGraph<UClass>(Blueprint, Graph, true, nullptr);
+
+	TArray<UK2Node_FunctionEntry*> EntryNodes;
+	Graph->GetNodesOfClass(EntryNodes);
+	check(EntryNodes.Num() == 1);
+
+	TArray<UEdGraphPin*> ParamPins;
+	for (const FBenchmarkParam& Param : Params)
+	{
+		ParamPins.Add(EntryNodes[0]->CreateUserDefinedPin(Param.Name, Param.PinType, EGPD_Output, false));
+	}
+	BuildGraph(Graph, EntryNodes[0]->FindPinChecked(UEdGraphSchema_K2::PN_Then), ParamPins);
+
+	FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::SkipGarbageCollection);
+	if (Blueprint->Status == BS_Error)
+	{
+		UE_LOG(LogACFBenchmark, Error, TEXT("Failed to compile %s"), *BlueprintName.ToString());
+		return nullptr;
+	}
+
+	return Blueprint;
+}
+
+struct FBlueprintMeasurement
+{
+	double Ns = 0.0;
+	// Allocations made by the call on the game thread, including the temporaries freed within the call.
+	double Allocations = 0.0;
+	double AllocatedBytes = 0.0;
+};
+
+// Fills the parameters of the Evaluate function for the call of the index.
+typedef TFunctionRef<void(const UFunction* Function, uint8* Params, int32 Call)> FFillBenchmarkParams;
+
+// Calls the Evaluate function NumCalls times with the parameters of each call, and returns the time and the allocations per
+// call.
+static FBlueprintMeasurement MeasureBenchmarkBlueprint(
+	UBlueprint* Blueprint, int32 NumCalls, FFillBenchmarkParams FillParams, int32 NumIterations)
+{
+	UObject* Object = NewObject<UObject>(GetTransientPackage(), Blueprint->GeneratedClass);
+	UFunction* Function = Blueprint->GeneratedClass->FindFunctionByName(BenchmarkFunctionName);
+
+	// The parameters of all calls are filled in advance, so that the timing includes only the calls.
+	const int32 Alignment = Function->GetMinAlignment();
+	const int32 Stride = Align(FMath::Max<int32>(Function->ParmsSize, 1), Alignment);
+	uint8* Params = static_cast<uint8*>(FMemory::Malloc(static_cast<SIZE_T>(Stride) * NumCalls, Alignment));
+	FMemory::Memzero(Params, static_cast<SIZE_T>(Stride) * NumCalls);
+	for (int32 Call = 0; Call < NumCalls; ++Call)
+	{
+		for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+		{
+			It->InitializeValue_InContainer(Params + Stride * Call);
+		}
+		FillParams(Function, Params + Stride * Call, Call);
+	}
+
+	// Warm up, so that the first call does not count the lazy initialization.
+	Object->ProcessEvent(Function, Params);
+
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		for (int32 Call = 0; Call < NumCalls; ++Call)
+		{
+			Object->ProcessEvent(Function, Params + Stride * Call);
+		}
+	}
+	const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+	FBlueprintMeasurement Measurement;
+	Measurement.Ns = Seconds * 1e9 / (static_cast<double>(NumIterations) * NumCalls);
+
+	CountingMalloc->BeginCounting();
+	for (int32 Call = 0; Call < NumCalls; ++Call)
+	{
+		Object->ProcessEvent(Function, Params + Stride * Call);
+	}
+	CountingMalloc->EndCounting();
+	Measurement.Allocations = static_cast<double>(CountingMalloc->NumAllocations) / NumCalls;
+	Measurement.AllocatedBytes = static_cast<double>(CountingMalloc->AllocatedBytes) / NumCalls;
+
+	for (int32 Call = 0; Call < NumCalls; ++Call)
+	{
+		for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+		{
+			It->DestroyValue_InContainer(Params + Stride * Call);
+		}
+	}
+	FMemory::Free(Params);
+
+	return Measurement;
+}
+
+// Calls the Evaluate function with only the condition of the winner case true.
+static FBlueprintMeasurement MeasureBenchmarkBlueprint(UBlueprint* Blueprint, int32 NumCases, int32 Winner, int32 NumIterations)
+{
+	return MeasureBenchmarkBlueprint(
+		Blueprint, NumBlueprintEvaluations,
+		[NumCases, Winner](const UFunction* Function, uint8* Params, int32 Call)
+		{
+			for (int32 Case = 0; Case < NumCases; ++Case)
+			{
+				FBoolProperty* ConditionProperty = FindFProperty<FBoolProperty>(Function, GetConditionParamName(Case));
+				ConditionProperty->SetPropertyValue_InContainer(Params, Case == Winner);
+			}
+		},
+		NumIterations);
+}
+
+// Builds the Blueprint and returns the time per call of the parameters of each call, or a negative time if the Blueprint is not
+// compiled.
+static double MeasureBenchmarkGraph(const TCHAR* GraphName, int32 NumCases, const TArray<FBenchmarkParam>& Params,
+	TFunctionRef<void(UEdGraph*, UEdGraphPin*, const TArray<UEdGraphPin*>&)> BuildGraph, int32 NumCalls,
+	FFillBenchmarkParams FillParams, int32 NumIterations)
+{
+	UBlueprint* Blueprint = CreateBenchmarkBlueprint(GraphName, NumCases, Params, BuildGraph);
+	if (Blueprint == nullptr)
+	{
+		return -1.0;
+	}
+
+	return MeasureBenchmarkBlueprint(Blueprint, NumCalls, FillParams, NumIterations).Ns;
+}
+
+// The Blueprint which is not compiled has been reported, and has no field.
+static void SetBlueprintNsField(const TSharedRef<FJsonObject>& ResultObject, const TCHAR* FieldName, double Ns)
+{
+	if (Ns >= 0.0)
+	{
+		ResultObject->SetNumberField(FieldName, Ns);
+	}
+}
+
+UACFBenchmarkCommandlet::UACFBenchmarkCommandlet(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UACFBenchmarkCommandlet::Main(const FString& Params)
+{
+	int32 NumIterations = 1000;
+	FParse::Value(*Params, TEXT("Iterations="), NumIterations);
+	NumIterations = FMath::Max(NumIterations, 1);
+
+	InstallCountingMalloc();
+
+	// The commandlet does not tick the engine, which resets the runaway loop counter of the Blueprint VM, and the loop Blueprint
+	// of BatchSelect runs over 1M elements in a call.
+	TGuardValue<int32> MaxLoopIterationsGuard(GMaximumScriptLoopIterations, MAX_int32);
+
+	TSharedRef<FJsonObject> RootObject = MakeShared<FJsonObject>();
+	RootObject->SetNumberField(TEXT("Iterations"), NumIterations);
+	RootObject->SetObjectField(TEXT("FirstTrue"), RunFirstTrueBenchmark(NumIterations));
+	RootObject->SetObjectField(TEXT("BatchSelect"), RunBatchSelectBenchmark(NumIterations));
+	RootObject->SetObjectField(TEXT("Partition"), RunPartitionBenchmark(NumIterations));
+	RootObject->SetObjectField(TEXT("WeightedRandom"), RunWeightedRandomBenchmark(NumIterations));
+	RootObject->SetObjectField(TEXT("Switch"), RunSwitchBenchmark(NumIterations));
+	RootObject->SetObjectField(TEXT("RangeSelect"), RunRangeSelectBenchmark(NumIterations));
+	RootObject->SetObjectField(TEXT("HashSwitch"), RunHashSwitchBenchmark(NumIterations));
+	RootObject->SetObjectField(TEXT("Blueprint"), RunBlueprintBenchmark(NumIterations));
+
+	FString JsonString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonString);
+	if (!FJsonSerializer::Serialize(RootObject, Writer))
+	{
+		return 1;
+	}
+
+	const FString FilePath = FPaths::ProjectSavedDir() / TEXT("AdvancedControlFlow") / TEXT("Benchmark.json");
+	if (!FFileHelper::SaveStringToFile(JsonString, *FilePath))
+	{
+		UE_LOG(LogACFBenchmark, Error, TEXT("Failed to write %s"), *FilePath);
+		return 1;
+	}
+	UE_LOG(LogACFBenchmark, Display, TEXT("Wrote %s"), *FilePath);
+
+	return 0;
+}
+
+TSharedRef<FJsonObject> UACFBenchmarkCommandlet::RunFirstTrueBenchmark(int32 NumIterations) const
+{
+	// Compare Make Array + Find (Array) with the bit mask kernel for 2-256 cases.
+	// The winner is uniformly distributed over the cases and the default case.
+	TSharedRef<FJsonObject> SuiteObject = MakeShared<FJsonObject>();
+	TArray<TSharedPtr<FJsonValue>> Results;
+	FRandomStream Random(0x0acf);
+	volatile int32 Sink = 0;
+
+	for (int32 NumCases = 2; NumCases <= 256; NumCases *= 2)
+	{
+		TArray<bool> Conditions;
+		Conditions.SetNumZeroed(NumCases * NumConditionSets);
+		for (int32 Set = 0; Set < NumConditionSets; ++Set)
+		{
+			const int32 Winner = Random.RandRange(0, NumCases);
+			for (int32 Case = Winner; Case < NumCases; ++Case)
+			{
+				Conditions[Set * NumCases + Case] = (Case == Winner) || Random.GetFraction() < 0.5f;
+			}
+		}
+
+		// Make Array copies the conditions into a new array every evaluation.
+		TArray<bool> Array;
+		const double ArrayStartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			for (int32 Set = 0; Set < NumConditionSets; ++Set)
+			{
+				Array.Reset(NumCases);
+				Array.Append(&Conditions[Set * NumCases], NumCases);
+				Sink = Sink + Array.Find(true);
+			}
+		}
+		const double ArraySeconds = FPlatformTime::Seconds() - ArrayStartTime;
+
+		const double KernelStartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			for (int32 Set = 0; Set < NumConditionSets; ++Set)
+			{
+				Sink = Sink + ACFConditions::FindFirstTrue(&Conditions[Set * NumCases], NumCases);
+			}
+		}
+		const double KernelSeconds = FPlatformTime::Seconds() - KernelStartTime;
+
+		const double NumEvaluations = static_cast<double>(NumIterations) * NumConditionSets;
+		TSharedRef<FJsonObject> ResultObject = MakeShared<FJsonObject>();
+		ResultObject->SetNumberField(TEXT("NumCases"), NumCases);
+		ResultObject->SetNumberField(TEXT("ArrayFindNs"), ArraySeconds * 1e9 / NumEvaluations);
+		ResultObject->SetNumberField(TEXT("KernelNs"), KernelSeconds * 1e9 / NumEvaluations);
+		Results.Add(MakeShared<FJsonValueObject>(ResultObject));
+
+		UE_LOG(LogACFBenchmark, Display, TEXT("FirstTrue: %3d cases, Find (Array) %.2f ns, Kernel %.2f ns"), NumCases,
+			ArraySeconds * 1e9 / NumEvaluations, KernelSeconds * 1e9 / NumEvaluations);
+	}
+
+	SuiteObject->SetArrayField(TEXT("Results"), Results);
+
+	return SuiteObject;
+}
+
+TSharedRef<FJsonObject> UACFBenchmarkCommandlet::RunBatchSelectBenchmark(int32 NumIterations) const
+{
+	// Compare the loop of Multi-Conditional Select over the elements with the batch kernel for 1K-1M elements.
+	// The number of iterations is scaled so that each size processes the same number of the elements.
+	// The Blueprints of the loop and of Multi-Conditional Select (Batch) also process the same arrays on the Blueprint VM.
+	TSharedRef<FJsonObject> SuiteObject = MakeShared<FJsonObject>();
+	TArray<TSharedPtr<FJsonValue>> Results;
+	FRandomStream Random(0x0acf);
+
+	const UFunction* AddFunction =
+		UKismetMathLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, Add_IntInt));
+	const FProperty* ElementProperty = (AddFunction != nullptr) ? AddFunction->FindPropertyByName(TEXT("A")) : nullptr;
+	if (ElementProperty == nullptr)
+	{
+		UE_LOG(LogACFBenchmark, Error, TEXT("BatchSelect: Failed to find the element property"));
+		return SuiteObject;
+	}
+
+	TArray<FBenchmarkParam> Params;
+	for (int32 Case = 0; Case < NumBatchCases; ++Case)
+	{
+		Params.Add({GetConditionParamName(Case), MakeBenchmarkPinType(UEdGraphSchema_K2::PC_Boolean, EPinContainerType::Array)});
+	}
+	for (int32 Case = 0; Case < NumBatchCases; ++Case)
+	{
+		Params.Add({GetOptionParamName(Case), MakeBenchmarkPinType(UEdGraphSchema_K2::PC_Int, EPinContainerType::Array)});
+	}
+	UBlueprint* LoopBlueprint = CreateBenchmarkBlueprint(TEXT("LoopSelect"), NumBatchCases, Params, &BuildLoopSelectGraph);
+	UBlueprint* BatchBlueprint = CreateBenchmarkBlueprint(TEXT("BatchSelect"), NumBatchCases, Params, &BuildBatchSelectGraph);
+
+	for (int32 NumElements = 1024; NumElements <= 1024 * 1024; NumElements *= 4)
+	{
+		const int32 NumBatchIterations = FMath::Max(static_cast<int32>(static_cast<int64>(NumIterations) * 1024 / NumElements), 1);
+
+		TArray<TArray<bool>> Conditions;
+		TArray<TArray<int32>> Options;
+		Conditions.SetNum(NumBatchCases);
+		Options.SetNum(NumBatchCases);
+		for (int32 Case = 0; Case < NumBatchCases; ++Case)
+		{
+			Conditions[Case].SetNumUninitialized(NumElements);
+			Options[Case].SetNumUninitialized(NumElements);
+			for (int32 Index = 0; Index < NumElements; ++Index)
+			{
+				Conditions[Case][Index] = Random.GetFraction() < 0.25f;
+				Options[Case][Index] = Random.RandHelper(MAX_int32);
+			}
+		}
+		const int32 DefaultValue = -1;
+		TArray<int32> Result;
+		Result.SetNumZeroed(NumElements);
+
+		// The loop builds the array of the conditions with Make Array for each element, as the graph would do.
+		TArray<bool> Array;
+		const double LoopStartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumBatchIterations; ++Iteration)
+		{
+			for (int32 Index = 0; Index < NumElements; ++Index)
+			{
+				Array.Reset(NumBatchCases);
+				for (int32 Case = 0; Case < NumBatchCases; ++Case)
+				{
+					Array.Add(Conditions[Case][Index]);
+				}
+				const int32 CaseIndex = Array.Find(true);
+				Result[Index] = (CaseIndex == INDEX_NONE) ? DefaultValue : Options[CaseIndex][Index];
+			}
+		}
+		const double LoopSeconds = FPlatformTime::Seconds() - LoopStartTime;
+
+		TArray<const bool*, TInlineAllocator<NumBatchCases>> ConditionData;
+		TArray<ACFBatch::FOption, TInlineAllocator<NumBatchCases>> OptionData;
+		for (int32 Case = 0; Case < NumBatchCases; ++Case)
+		{
+			ConditionData.Add(Conditions[Case].GetData());
+			OptionData.Add({reinterpret_cast<const uint8*>(Options[Case].GetData()), sizeof(int32)});
+		}
+		const ACFBatch::FOption Default = {reinterpret_cast<const uint8*>(&DefaultValue), 0};
+
+		const double BatchStartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumBatchIterations; ++Iteration)
+		{
+			ACFBatch::MultiConditionalSelect(
+				ElementProperty, ConditionData, OptionData, Default, NumElements, reinterpret_cast<uint8*>(Result.GetData()));
+		}
+		const double BatchSeconds = FPlatformTime::Seconds() - BatchStartTime;
+
+		// A call processes all elements.
+		auto FillArrays = [&Conditions, &Options](const UFunction* Function, uint8* CallParams, int32 Call)
+		{
+			for (int32 Case = 0; Case < NumBatchCases; ++Case)
+			{
+				FArrayProperty* ConditionsProperty = FindFProperty<FArrayProperty>(Function, GetConditionParamName(Case));
+				*ConditionsProperty->ContainerPtrToValuePtr<TArray<bool>>(CallParams) = Conditions[Case];
+				FArrayProperty* OptionsProperty = FindFProperty<FArrayProperty>(Function, GetOptionParamName(Case));
+				*OptionsProperty->ContainerPtrToValuePtr<TArray<int32>>(CallParams) = Options[Case];
+			}
+		};
+		const double LoopBlueprintNs =
+			(LoopBlueprint != nullptr)
+				? MeasureBenchmarkBlueprint(LoopBlueprint, 1, FillArrays, NumBatchIterations).Ns / NumElements
+				: -1.0;
+		const double BatchBlueprintNs =
+			(BatchBlueprint != nullptr)
+				? MeasureBenchmarkBlueprint(BatchBlueprint, 1, FillArrays, NumBatchIterations).Ns / NumElements
+				: -1.0;
+
+		const double NumEvaluations = static_cast<double>(NumBatchIterations) * NumElements;
+		TSharedRef<FJsonObject> ResultObject = MakeShared<FJsonObject>();
+		ResultObject->SetNumberField(TEXT("NumElements"), NumElements);
+		ResultObject->SetNumberField(TEXT("LoopNs"), LoopSeconds * 1e9 / NumEvaluations);
+		ResultObject->SetNumberField(TEXT("BatchNs"), BatchSeconds * 1e9 / NumEvaluations);
+		SetBlueprintNsField(ResultObject, TEXT("LoopBlueprintNs"), LoopBlueprintNs);
+		SetBlueprintNsField(ResultObject, TEXT("BatchBlueprintNs"), BatchBlueprintNs);
+		Results.Add(MakeShared<FJsonValueObject>(ResultObject));
+
+		UE_LOG(LogACFBenchmark, Display,
+			TEXT("BatchSelect: %7d elements, Loop %.2f ns, Batch %.2f ns, Blueprint Loop %.2f ns, Batch %.2f ns"), NumElements,
+			LoopSeconds * 1e9 / NumEvaluations, BatchSeconds * 1e9 / NumEvaluations, LoopBlueprintNs, BatchBlueprintNs);
+	}
+
+	SuiteObject->SetNumberField(TEXT("NumCases"), NumBatchCases);
+	SuiteObject->SetNumberField(TEXT("ParallelThreshold"), ACFBatch::GetParallelThreshold());
+	SuiteObject->SetArrayField(TEXT("Results"), Results);
+
+	return SuiteObject;
+}
+
+TSharedRef<FJsonObject> UACFBenchmarkCommandlet::RunPartitionBenchmark(int32 NumIterations) const
+{
+	// Compare the loop of Multi-Branch + Add (Array) over the elements with the partition kernel for 1K-1M elements.
+	TSharedRef<FJsonObject> SuiteObject = MakeShared<FJsonObject>();
+	TArray<TSharedPtr<FJsonValue>> Results;
+	FRandomStream Random(0x0acf);
+
+	const UFunction* LengthFunction =
+		UKismetArrayLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UKismetArrayLibrary, Array_Length));
+	const FArrayProperty* ArrayProperty =
+		(LengthFunction != nullptr) ? CastField<FArrayProperty>(LengthFunction->FindPropertyByName(TEXT("TargetArray"))) : nullptr;
+	if (ArrayProperty == nullptr)
+	{
+		UE_LOG(LogACFBenchmark, Error, TEXT("Partition: Failed to find the array property"));
+		return SuiteObject;
+	}
+
+	for (int32 NumElements = 1024; NumElements <= 1024 * 1024; NumElements *= 4)
+	{
+		const int32 NumPartitionIterations =
+			FMath::Max(static_cast<int32>(static_cast<int64>(NumIterations) * 1024 / NumElements), 1);
+
+		TArray<int32> Elements;
+		Elements.SetNumUninitialized(NumElements);
+		TArray<TArray<bool>> Conditions;
+		Conditions.SetNum(NumBatchCases);
+		for (int32 Index = 0; Index < NumElements; ++Index)
+		{
+			Elements[Index] = Random.RandHelper(MAX_int32);
+		}
+		for (int32 Case = 0; Case < NumBatchCases; ++Case)
+		{
+			Conditions[Case].SetNumUninitialized(NumElements);
+			for (int32 Index = 0; Index < NumElements; ++Index)
+			{
+				Conditions[Case][Index] = Random.GetFraction() < 0.25f;
+			}
+		}
+		TArray<TArray<int32>> Buckets;
+		Buckets.SetNum(NumBatchCases + 1);
+
+		// The loop clears the buckets and adds the elements one by one, as the graph would do.
+		TArray<bool> Array;
+		const double LoopStartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumPartitionIterations; ++Iteration)
+		{
+			for (TArray<int32>& Bucket : Buckets)
+			{
+				Bucket.Reset();
+			}
+			for (int32 Index = 0; Index < NumElements; ++Index)
+			{
+				Array.Reset(NumBatchCases);
+				for (int32 Case = 0; Case < NumBatchCases; ++Case)
+				{
+					Array.Add(Conditions[Case][Index]);
+				}
+				const int32 CaseIndex = Array.Find(true);
+				Buckets[(CaseIndex == INDEX_NONE) ? NumBatchCases : CaseIndex].Add(Elements[Index]);
+			}
+		}
+		const double LoopSeconds = FPlatformTime::Seconds() - LoopStartTime;
+
+		TArray<const bool*, TInlineAllocator<NumBatchCases>> ConditionData;
+		for (int32 Case = 0; Case < NumBatchCases; ++Case)
+		{
+			ConditionData.Add(Conditions[Case].GetData());
+		}
+		TArray<FScriptArrayHelper, TInlineAllocator<NumBatchCases + 1>> BucketHelpers;
+		for (TArray<int32>& Bucket : Buckets)
+		{
+			BucketHelpers.Emplace(ArrayProperty, &Bucket);
+		}
+
+		const double PartitionStartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumPartitionIterations; ++Iteration)
+		{
+			ACFBatch::Partition(ArrayProperty->Inner, ConditionData, reinterpret_cast<const uint8*>(Elements.GetData()),
+				NumElements, BucketHelpers);
+		}
+		const double PartitionSeconds = FPlatformTime::Seconds() - PartitionStartTime;
+
+		const double NumEvaluations = static_cast<double>(NumPartitionIterations) * NumElements;
+		TSharedRef<FJsonObject> ResultObject = MakeShared<FJsonObject>();
+		ResultObject->SetNumberField(TEXT("NumElements"), NumElements);
+		ResultObject->SetNumberField(TEXT("LoopNs"), LoopSeconds * 1e9 / NumEvaluations);
+		ResultObject->SetNumberField(TEXT("PartitionNs"), PartitionSeconds * 1e9 / NumEvaluations);
+		Results.Add(MakeShared<FJsonValueObject>(ResultObject));
+
+		UE_LOG(LogACFBenchmark, Display, TEXT("Partition: %7d elements, Loop %.2f ns, Partition %.2f ns"), NumElements,
+			LoopSeconds * 1e9 / NumEvaluations, PartitionSeconds * 1e9 / NumEvaluations);
+	}
+
+	SuiteObject->SetNumberField(TEXT("NumCases"), NumBatchCases);
+	SuiteObject->SetNumberField(TEXT("ParallelThreshold"), ACFBatch::GetParallelThreshold());
+	SuiteObject->SetArrayField(TEXT("Results"), Results);
+
+	return SuiteObject;
+}
+
+TSharedRef<FJsonObject> UACFBenchmarkCommandlet::RunWeightedRandomBenchmark(int32 NumIterations) const
+{
+	// Compare the scan of the cumulative weights with the alias table for 2-256 cases.
+	// The scan recomputes the cumulative weights for every sample, as the chain of Random Float and compares does.
+	TSharedRef<FJsonObject> SuiteObject = MakeShared<FJsonObject>();
+	TArray<TSharedPtr<FJsonValue>> Results;
+	FRandomStream Random(0x0acf);
+	volatile int32 Sink = 0;
+
+	for (int32 NumCases = 2; NumCases <= 256; NumCases *= 2)
+	{
+		TArray<float> Weights;
+		for (int32 Case = 0; Case < NumCases; ++Case)
+		{
+			Weights.Add(Random.FRandRange(0.0f, 10.0f));
+		}
+
+		FRandomStream ScanStream(0x0acf);
+		const double ScanStartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			for (int32 Sample = 0; Sample < NumConditionSets; ++Sample)
+			{
+				float Sum = 0.0f;
+				for (float Weight : Weights)
+				{
+					Sum += Weight;
+				}
+				const float Threshold = ScanStream.GetFraction() * Sum;
+				int32 CaseIndex = NumCases - 1;
+				float Cumulative = 0.0f;
+				for (int32 Case = 0; Case < NumCases; ++Case)
+				{
+					Cumulative += Weights[Case];
+					if (Threshold < Cumulative)
+					{
+						CaseIndex = Case;
+						break;
+					}
+				}
+				Sink = Sink + CaseIndex;
+			}
+		}
+		const double ScanSeconds = FPlatformTime::Seconds() - ScanStartTime;
+
+		ACFRandom::FAliasTable Table;
+		Table.Build(Weights);
+		FRandomStream AliasStream(0x0acf);
+		const double AliasStartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			for (int32 Sample = 0; Sample < NumConditionSets; ++Sample)
+			{
+				Sink = Sink + Table.Sample(&AliasStream);
+			}
+		}
+		const double AliasSeconds = FPlatformTime::Seconds() - AliasStartTime;
+
+		const double NumSamples = static_cast<double>(NumIterations) * NumConditionSets;
+		TSharedRef<FJsonObject> ResultObject = MakeShared<FJsonObject>();
+		ResultObject->SetNumberField(TEXT("NumCases"), NumCases);
+		ResultObject->SetNumberField(TEXT("ScanNs"), ScanSeconds * 1e9 / NumSamples);
+		ResultObject->SetNumberField(TEXT("AliasNs"), AliasSeconds * 1e9 / NumSamples);
+		Results.Add(MakeShared<FJsonValueObject>(ResultObject));
+
+		UE_LOG(LogACFBenchmark, Display, TEXT("WeightedRandom: %3d cases, Scan %.2f ns, Alias %.2f ns"), NumCases,
+			ScanSeconds * 1e9 / NumSamples, AliasSeconds * 1e9 / NumSamples);
+	}
+
+	SuiteObject->SetArrayField(TEXT("Results"), Results);
+
+	return SuiteObject;
+}
+
+TSharedRef<FJsonObject> UACFBenchmarkCommandlet::RunSwitchBenchmark(int32 NumIterations) const
+{
+	// Compare the compare chain of Multi-Branch and Switch on Int with the search tree of Multi-Switch for 8-512 cases.
+	// The compares are executed natively first, and the number of the compares shows the cost on the Blueprint VM, where each
+	// compare is a function call. Then the Blueprints of Multi-Switch, Multi-Branch with the equality conditions and Switch on
+	// Int are built and called with the first selections. Switch on Int is built only for the dense keys, since its cases are
+	// the consecutive integers.
+	// The selection hits one of the keys or misses all of them uniformly.
+	TSharedRef<FJsonObject> SuiteObject = MakeShared<FJsonObject>();
+	TArray<TSharedPtr<FJsonValue>> Results;
+	FRandomStream Random(0x0acf);
+	volatile int32 Sink = 0;
+
+	for (int32 NumCases = 8; NumCases <= 512; NumCases *= 2)
+	{
+		for (const bool bDense : {true, false})
+		{
+			// Sparse keys are spread over the range 8 times as wide as the number of the cases.
+			TArray<int32> Keys;
+			for (int32 Case = 0; Case < NumCases; ++Case)
+			{
+				Keys.Add(bDense ? Case : Case * 8 + Random.RandRange(0, 7));
+			}
+			TArray<int32> Selections;
+			for (int32 Set = 0; Set < NumConditionSets; ++Set)
+			{
+				const int32 Case = Random.RandRange(0, NumCases);
+				Selections.Add((Case < NumCases) ? Keys[Case] : -1);
+			}
+
+			int64 ChainCompares = 0;
+			const double ChainStartTime = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+			{
+				for (int32 Selection : Selections)
+				{
+					int32 CaseIndex = NumCases;
+					for (int32 Case = 0; Case < NumCases; ++Case)
+					{
+						++ChainCompares;
+						if (Selection == Keys[Case])
+						{
+							CaseIndex = Case;
+							break;
+						}
+					}
+					Sink = Sink + CaseIndex;
+				}
+			}
+			const double ChainSeconds = FPlatformTime::Seconds() - ChainStartTime;
+
+			// Same as the tree compiled by FKCHandler_MultiSwitch.
+			int64 TreeCompares = 0;
+			const double TreeStartTime = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+			{
+				for (int32 Selection : Selections)
+				{
+					int32 Begin = 0;
+					int32 End = NumCases;
+					int64 Lo = MIN_int32;
+					int64 Hi = MAX_int32;
+					while (End - Begin > 1)
+					{
+						const int32 Mid = (Begin + End) / 2;
+						++TreeCompares;
+						if (Selection < Keys[Mid])
+						{
+							End = Mid;
+							Hi = Keys[Mid] - 1;
+						}
+						else
+						{
+							Begin = Mid;
+							Lo = Keys[Mid];
+						}
+					}
+					int32 CaseIndex = Begin;
+					if (Lo != Hi)
+					{
+						++TreeCompares;
+						CaseIndex = (Selection == Keys[Begin]) ? Begin : NumCases;
+					}
+					Sink = Sink + CaseIndex;
+				}
+			}
+			const double TreeSeconds = FPlatformTime::Seconds() - TreeStartTime;
+
+			TArray<FString> KeyStrings;
+			for (int32 Key : Keys)
+			{
+				KeyStrings.Add(FString::FromInt(Key));
+			}
+			const TArray<FBenchmarkParam> Params = {{SelectionParamName, MakeBenchmarkPinType(UEdGraphSchema_K2::PC_Int)}};
+			auto FillSelection = [&Selections](const UFunction* Function, uint8* CallParams, int32 Call)
+			{
+				FIntProperty* SelectionProperty = FindFProperty<FIntProperty>(Function, SelectionParamName);
+				SelectionProperty->SetPropertyValue_InContainer(CallParams, Selections[Call]);
+			};
+
+			const double MultiSwitchBlueprintNs = MeasureBenchmarkGraph(TEXT("MultiSwitch"), NumCases, Params,
+				[&KeyStrings](UEdGraph* Graph, UEdGraphPin* EntryExecPin, const TArray<UEdGraphPin*>& ParamPins)
+				{ BuildMultiSwitchGraph(Graph, EntryExecPin, ParamPins[0], KeyStrings); },
+				NumBlueprintEvaluations, FillSelection, NumIterations);
+			const double MultiBranchBlueprintNs = MeasureBenchmarkGraph(TEXT("EqualityMultiBranch"), NumCases, Params,
+				[&KeyStrings](UEdGraph* Graph, UEdGraphPin* EntryExecPin, const TArray<UEdGraphPin*>& ParamPins)
+				{ BuildEqualityMultiBranchGraph(Graph, EntryExecPin, ParamPins[0], KeyStrings); },
+				NumBlueprintEvaluations, FillSelection, NumIterations);
+			double SwitchOnIntBlueprintNs = -1.0;
+			if (bDense)
+			{
+				SwitchOnIntBlueprintNs = MeasureBenchmarkGraph(TEXT("SwitchOnInt"), NumCases, Params,
+					[NumCases](UEdGraph* Graph, UEdGraphPin* EntryExecPin, const TArray<UEdGraphPin*>& ParamPins)
+					{ BuildSwitchOnIntGraph(Graph, EntryExecPin, ParamPins[0], NumCases); },
+					NumBlueprintEvaluations, FillSelection, NumIterations);
+			}
+
+			const double NumEvaluations = static_cast<double>(NumIterations) * NumConditionSets;
+			TSharedRef<FJsonObject> ResultObject = MakeShared<FJsonObject>();
+			ResultObject->SetNumberField(TEXT("NumCases"), NumCases);
+			ResultObject->SetBoolField(TEXT("Dense"), bDense);
+			ResultObject->SetNumberField(TEXT("ChainNs"), ChainSeconds * 1e9 / NumEvaluations);
+			ResultObject->SetNumberField(TEXT("ChainCompares"), ChainCompares / NumEvaluations);
+			ResultObject->SetNumberField(TEXT("TreeNs"), TreeSeconds * 1e9 / NumEvaluations);
+			ResultObject->SetNumberField(TEXT("TreeCompares"), TreeCompares / NumEvaluations);
+			SetBlueprintNsField(ResultObject, TEXT("MultiSwitchBlueprintNs"), MultiSwitchBlueprintNs);
+			SetBlueprintNsField(ResultObject, TEXT("MultiBranchBlueprintNs"), MultiBranchBlueprintNs);
+			SetBlueprintNsField(ResultObject, TEXT("SwitchOnIntBlueprintNs"), SwitchOnIntBlueprintNs);
+			Results.Add(MakeShared<FJsonValueObject>(ResultObject));
+
+			UE_LOG(LogACFBenchmark, Display,
+				TEXT("Switch: %3d %s cases, Chain %.2f ns (%.1f compares), Tree %.2f ns (%.1f compares), Blueprint Multi-Switch "
+					 "%.2f ns, Multi-Branch %.2f ns, Switch on Int %.2f ns"),
+				NumCases, bDense ? TEXT("dense") : TEXT("sparse"), ChainSeconds * 1e9 / NumEvaluations,
+				ChainCompares / NumEvaluations, TreeSeconds * 1e9 / NumEvaluations, TreeCompares / NumEvaluations,
+				MultiSwitchBlueprintNs, MultiBranchBlueprintNs, SwitchOnIntBlueprintNs);
+		}
+	}
+
+	SuiteObject->SetArrayField(TEXT("Results"), Results);
+
+	return SuiteObject;
+}
+
+TSharedRef<FJsonObject> UACFBenchmarkCommandlet::RunRangeSelectBenchmark(int32 NumIterations) const
+{
+	// Compare Multi-Conditional Select with the conditions of "Value < Bound" with the binary search of Range Select
+	// for 2-256 bounds. Multi-Conditional Select evaluates all conditions into the array before finding the first true one.
+	// The Blueprints of both are also called with the integer part of the first values, since the bounds are integers.
+	TSharedRef<FJsonObject> SuiteObject = MakeShared<FJsonObject>();
+	TArray<TSharedPtr<FJsonValue>> Results;
+	FRandomStream Random(0x0acf);
+	volatile int32 Sink = 0;
+
+	for (int32 NumCases = 2; NumCases <= 256; NumCases *= 2)
+	{
+		TArray<double> Bounds;
+		for (int32 Case = 0; Case < NumCases; ++Case)
+		{
+			Bounds.Add((Case + 1) * 10.0);
+		}
+		TArray<double> Values;
+		for (int32 Set = 0; Set < NumConditionSets; ++Set)
+		{
+			Values.Add(Random.FRandRange(0.0f, (NumCases + 1) * 10.0f));
+		}
+
+		const double ConditionsStartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			for (double Value : Values)
+			{
+				TArray<bool> Conditions;
+				for (double Bound : Bounds)
+				{
+					Conditions.Add(Value < Bound);
+				}
+				Sink = Sink + ACFConditions::FindFirstTrue(Conditions.GetData(), Conditions.Num());
+			}
+		}
+		const double ConditionsSeconds = FPlatformTime::Seconds() - ConditionsStartTime;
+
+		const double SearchStartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			for (double Value : Values)
+			{
+				Sink = Sink + ACFRange::FindRange(Bounds, Value);
+			}
+		}
+		const double SearchSeconds = FPlatformTime::Seconds() - SearchStartTime;
+
+		TArray<FString> BoundStrings;
+		for (double Bound : Bounds)
+		{
+			BoundStrings.Add(FString::FromInt(FMath::FloorToInt(Bound)));
+		}
+		const TArray<FBenchmarkParam> Params = {{RangeValueParamName, MakeBenchmarkPinType(UEdGraphSchema_K2::PC_Int)}};
+		auto FillValue = [&Values](const UFunction* Function, uint8* CallParams, int32 Call)
+		{
+			FIntProperty* ValueProperty = FindFProperty<FIntProperty>(Function, RangeValueParamName);
+			ValueProperty->SetPropertyValue_InContainer(CallParams, FMath::FloorToInt(Values[Call]));
+		};
+
+		const double ConditionsBlueprintNs = MeasureBenchmarkGraph(TEXT("LessMultiConditionalSelect"), NumCases, Params,
+			[&BoundStrings](UEdGraph* Graph, UEdGraphPin* EntryExecPin, const TArray<UEdGraphPin*>& ParamPins)
+			{ BuildLessMultiConditionalSelectGraph(Graph, EntryExecPin, ParamPins[0], BoundStrings); },
+			NumBlueprintEvaluations, FillValue, NumIterations);
+		const double SearchBlueprintNs = MeasureBenchmarkGraph(TEXT("RangeSelect"), NumCases, Params,
+			[&BoundStrings](UEdGraph* Graph, UEdGraphPin* EntryExecPin, const TArray<UEdGraphPin*>& ParamPins)
+			{ BuildRangeSelectGraph(Graph, EntryExecPin, ParamPins[0], BoundStrings); },
+			NumBlueprintEvaluations, FillValue, NumIterations);
+
+		const double NumEvaluations = static_cast<double>(NumIterations) * NumConditionSets;
+		TSharedRef<FJsonObject> ResultObject = MakeShared<FJsonObject>();
+		ResultObject->SetNumberField(TEXT("NumCases"), NumCases);
+		ResultObject->SetNumberField(TEXT("ConditionsNs"), ConditionsSeconds * 1e9 / NumEvaluations);
+		ResultObject->SetNumberField(TEXT("SearchNs"), SearchSeconds * 1e9 / NumEvaluations);
+		SetBlueprintNsField(ResultObject, TEXT("ConditionsBlueprintNs"), ConditionsBlueprintNs);
+		SetBlueprintNsField(ResultObject, TEXT("SearchBlueprintNs"), SearchBlueprintNs);
+		Results.Add(MakeShared<FJsonValueObject>(ResultObject));
+
+		UE_LOG(LogACFBenchmark, Display,
+			TEXT("RangeSelect: %3d cases, Conditions %.2f ns, Search %.2f ns, Blueprint Conditions %.2f ns, Search %.2f ns"),
+			NumCases, ConditionsSeconds * 1e9 / NumEvaluations, SearchSeconds * 1e9 / NumEvaluations, ConditionsBlueprintNs,
+			SearchBlueprintNs);
+	}
+
+	SuiteObject->SetArrayField(TEXT("Results"), Results);
+
+	return SuiteObject;
+}
+
+TSharedRef<FJsonObject> UACFBenchmarkCommandlet::RunHashSwitchBenchmark(int32 NumIterations) const
+{
+	// Compare the chain of the case-insensitive string comparisons with the perfect hash table of Multi-Switch for 8-512 keys.
+	// A quarter of the selections matches no key, which takes the whole chain.
+	// The Blueprints of Switch on String and of Multi-Switch are also called with the first selections.
+	TSharedRef<FJsonObject> SuiteObject = MakeShared<FJsonObject>();
+	TArray<TSharedPtr<FJsonValue>> Results;
+	FRandomStream Random(0x0acf);
+	volatile int32 Sink = 0;
+
+	for (int32 NumCases = 8; NumCases <= 512; NumCases *= 2)
+	{
+		TArray<FString> Keys;
+		for (int32 Case = 0; Case < NumCases; ++Case)
+		{
+			Keys.Add(FString::Printf(TEXT("State_%d"), Case * 7));
+		}
+		TArray<FString> Selections;
+		for (int32 Set = 0; Set < NumConditionSets; ++Set)
+		{
+			const int32 Case = Random.RandRange(0, NumCases + NumCases / 3);
+			Selections.Add(FString::Printf(TEXT("State_%d"), (Case < NumCases) ? Case * 7 : Case * 7 + 1));
+		}
+
+		ACFSwitch::FKeyTable Table;
+		Table.Build(ACFSwitch::EKeyType::String, Keys);
+
+		const double ChainStartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			for (const FString& Selection : Selections)
+			{
+				int32 Found = INDEX_NONE;
+				for (int32 Case = 0; Case < Keys.Num(); ++Case)
+				{
+					if (Selection.Equals(Keys[Case], ESearchCase::IgnoreCase))
+					{
+						Found = Case;
+						break;
+					}
+				}
+				Sink = Sink + Found;
+			}
+		}
+		const double ChainSeconds = FPlatformTime::Seconds() - ChainStartTime;
+
+		const double HashStartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			for (const FString& Selection : Selections)
+			{
+				Sink = Sink + Table.FindString(Selection);
+			}
+		}
+		const double HashSeconds = FPlatformTime::Seconds() - HashStartTime;
+
+		const TArray<FBenchmarkParam> Params = {{SelectionParamName, MakeBenchmarkPinType(UEdGraphSchema_K2::PC_String)}};
+		auto FillSelection = [&Selections](const UFunction* Function, uint8* CallParams, int32 Call)
+		{
+			FStrProperty* SelectionProperty = FindFProperty<FStrProperty>(Function, SelectionParamName);
+			SelectionProperty->SetPropertyValue_InContainer(CallParams, Selections[Call]);
+		};
+
+		const double ChainBlueprintNs = MeasureBenchmarkGraph(TEXT("SwitchOnString"), NumCases, Params,
+			[&Keys](UEdGraph* Graph, UEdGraphPin* EntryExecPin, const TArray<UEdGraphPin*>& ParamPins)
+			{ BuildSwitchOnStringGraph(Graph, EntryExecPin, ParamPins[0], Keys); },
+			NumBlueprintEvaluations, FillSelection, NumIterations);
+		const double HashBlueprintNs = MeasureBenchmarkGraph(TEXT("StringMultiSwitch"), NumCases, Params,
+			[&Keys](UEdGraph* Graph, UEdGraphPin* EntryExecPin, const TArray<UEdGraphPin*>& ParamPins)
+			{ BuildMultiSwitchGraph(Graph, EntryExecPin, ParamPins[0], Keys); },
+			NumBlueprintEvaluations, FillSelection, NumIterations);
+
+		const double NumEvaluations = static_cast<double>(NumIterations) * NumConditionSets;
+		TSharedRef<FJsonObject> ResultObject = MakeShared<FJsonObject>();
+		ResultObject->SetNumberField(TEXT("NumCases"), NumCases);
+		ResultObject->SetNumberField(TEXT("ChainNs"), ChainSeconds * 1e9 / NumEvaluations);
+		ResultObject->SetNumberField(TEXT("HashNs"), HashSeconds * 1e9 / NumEvaluations);
+		SetBlueprintNsField(ResultObject, TEXT("ChainBlueprintNs"), ChainBlueprintNs);
+		SetBlueprintNsField(ResultObject, TEXT("HashBlueprintNs"), HashBlueprintNs);
+		Results.Add(MakeShared<FJsonValueObject>(ResultObject));
+
+		UE_LOG(LogACFBenchmark, Display,
+			TEXT("HashSwitch: %3d cases, Chain %.2f ns, Hash %.2f ns, Blueprint Chain %.2f ns, Hash %.2f ns"), NumCases,
+			ChainSeconds * 1e9 / NumEvaluations, HashSeconds * 1e9 / NumEvaluations, ChainBlueprintNs, HashBlueprintNs);
+	}
+
+	SuiteObject->SetArrayField(TEXT("Results"), Results);
+
+	return SuiteObject;
+}
+
+TSharedRef<FJsonObject> UACFBenchmarkCommandlet::RunBlueprintBenchmark(int32 NumIterations) const
+{
+	// Compare the Blueprints of the nodes with the Blueprints of the vanilla graphs which they replace for 2-256 cases.
+	// The Blueprints are built and compiled here, and the winner is the first, the middle, the last or no case.
+	struct FGraphPair
+	{
+		const TCHAR* Name;
+		FBuildBenchmarkGraph BuildNodeGraph;
+		FBuildBenchmarkGraph BuildVanillaGraph;
+	};
+	const FGraphPair GraphPairs[] = {
+		{TEXT("MultiBranch"), &BuildMultiBranchGraph, &BuildNestedBranchGraph},
+		{TEXT("ConditionalSequence"), &BuildConditionalSequenceGraph, &BuildSequenceBranchGraph},
+		{TEXT("MultiConditionalSelect"), &BuildMultiConditionalSelectGraph, &BuildNestedSelectGraph},
+	};
+
+	TSharedRef<FJsonObject> SuiteObject = MakeShared<FJsonObject>();
+	TArray<TSharedPtr<FJsonValue>> Results;
+
+	for (const FGraphPair& GraphPair : GraphPairs)
+	{
+		for (int32 NumCases = 2; NumCases <= 256; NumCases *= 2)
+		{
+			const TArray<FBenchmarkParam> Params = MakeConditionParams(NumCases);
+			UBlueprint* NodeBlueprint = CreateBenchmarkBlueprint(GraphPair.Name, NumCases, Params, GraphPair.BuildNodeGraph);
+			const FString VanillaName = FString::Printf(TEXT("%sVanilla"), GraphPair.Name);
+			UBlueprint* VanillaBlueprint = CreateBenchmarkBlueprint(*VanillaName, NumCases, Params, GraphPair.BuildVanillaGraph);
+			if (NodeBlueprint == nullptr || VanillaBlueprint == nullptr)
+			{
+				continue;
+			}
+
+			const int32 NodeBytecode = NodeBlueprint->GeneratedClass->FindFunctionByName(BenchmarkFunctionName)->Script.Num();
+			const int32 VanillaBytecode = VanillaBlueprint->GeneratedClass->FindFunctionByName(BenchmarkFunctionName)->Script.Num();
+
+			const TPair<const TCHAR*, int32> Winners[] = {
+				{TEXT("First"), 0},
+				{TEXT("Middle"), NumCases / 2},
+				{TEXT("Last"), NumCases - 1},
+				{TEXT("None"), INDEX_NONE},
+			};
+			for (const TPair<const TCHAR*, int32>& Winner : Winners)
+			{
+				const FBlueprintMeasurement Node = MeasureBenchmarkBlueprint(NodeBlueprint, NumCases, Winner.Value, NumIterations);
+				const FBlueprintMeasurement Vanilla =
+					MeasureBenchmarkBlueprint(VanillaBlueprint, NumCases, Winner.Value, NumIterations);
+
+				TSharedRef<FJsonObject> ResultObject = MakeShared<FJsonObject>();
+				ResultObject->SetStringField(TEXT("Node"), GraphPair.Name);
+				ResultObject->SetNumberField(TEXT("NumCases"), NumCases);
+				ResultObject->SetStringField(TEXT("Winner"), Winner.Key);
+				ResultObject->SetNumberField(TEXT("NodeNs"), Node.Ns);
+				ResultObject->SetNumberField(TEXT("VanillaNs"), Vanilla.Ns);
+				ResultObject->SetNumberField(TEXT("NodeBytecode"), NodeBytecode);
+				ResultObject->SetNumberField(TEXT("VanillaBytecode"), VanillaBytecode);
+				ResultObject->SetNumberField(TEXT("NodeAllocations"), Node.Allocations);
+				ResultObject->SetNumberField(TEXT("VanillaAllocations"), Vanilla.Allocations);
+				ResultObject->SetNumberField(TEXT("NodeAllocatedBytes"), Node.AllocatedBytes);
+				ResultObject->SetNumberField(TEXT("VanillaAllocatedBytes"), Vanilla.AllocatedBytes);
+				Results.Add(MakeShared<FJsonValueObject>(ResultObject));
+
+				UE_LOG(LogACFBenchmark, Display,
+					TEXT("Blueprint: %s, %3d cases, %-6s winner, Node %.2f ns %d bytes %.2f allocs %.1f allocated bytes, "
+						 "Vanilla %.2f ns %d bytes %.2f allocs %.1f allocated bytes"),
+					GraphPair.Name, NumCases, Winner.Key, Node.Ns, NodeBytecode, Node.Allocations, Node.AllocatedBytes,
+					Vanilla.Ns, VanillaBytecode, Vanilla.Allocations, Vanilla.AllocatedBytes);
+			}
+		}
+	}
+
+	SuiteObject->SetArrayField(TEXT("Results"), Results);
+
+	return SuiteObject;
+}
@@ -0,0 +1,175 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "ACFCaseProfile.h"
+
+#include "ACFCaseHitCounters.h"
+#include "Dom/JsonObject.h"
+#include "EdGraph/EdGraphNode.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "KismetCompiler.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+static FAutoConsoleCommand ResetCaseProfileCommand(TEXT("ACF.ResetCaseProfile"),
+	TEXT("Discard the per-case hit counts recorded for Advanced Control Flow nodes."),
+	FConsoleCommandDelegate::CreateLambda([]() { FACFCaseProfile::Get().Reset(); }));
+
+FACFCaseProfile& FACFCaseProfile::Get()
+{
+	static FACFCaseProfile Instance;
+	return Instance;
+}
+
+FString FACFCaseProfile::MakeNodeKey(FKismetCompilerContext& CompilerContext, const UEdGraphNode* Node)
+{
+	// Intermediate nodes are duplicated from the source graph, so resolve the original node to get a stable GUID.
+	const UEdGraphNode* SourceNode = Cast<UEdGraphNode>(CompilerContext.MessageLog.FindSourceObject(Node));
+	if (SourceNode == nullptr)
+	{
+		SourceNode = Node;
+	}
+
+	return FString::Printf(TEXT("%s:%s"), *CompilerContext.Blueprint->GetPathName(), *SourceNode->NodeGuid.ToString());
+}
+
+FString FACFCaseProfile::MakeNodeKey(const UEdGraphNode* SourceNode)
+{
+	const UBlueprint* Blueprint = FBlueprintEditorUtils::FindBlueprintForNode(SourceNode);
+	if (Blueprint == nullptr)
+	{
+		return FString();
+	}
+
+	return FString::Printf(TEXT("%s:%s"), *Blueprint->GetPathName(), *SourceNode->NodeGuid.ToString());
+}
+
+uint64 FACFCaseProfile::RegisterCounter(const FString& NodeKey, int32 NumCases)
+{
+	uint64 CounterKey = FACFCaseHitCounters::MakeCounterKey(NodeKey);
+	Counters.Add(CounterKey, {NodeKey, NumCases});
+
+	// The hits recorded before the cases were added or removed are counted under the different case indices.
+	const TArray<uint64>* Hits = CaseHits.Find(NodeKey);
+	if ((Hits != nullptr) && (Hits->Num() != NumCases))
+	{
+		CaseHits.Remove(NodeKey);
+		bDirty = true;
+	}
+
+	return CounterKey;
+}
+
+void FACFCaseProfile::CollectCaseHits()
+{
+	for (auto& Entry : Counters)
+	{
+		TArray<uint64> CounterHits;
+		if (!FACFCaseHitCounters::Get().GetCaseHits(Entry.Key, CounterHits))
+		{
+			continue;
+		}
+
+		// The counter also counts the default case. The counter of the different number of the cases has not counted since
+		// the node was recompiled.
+		const int32 NumCases = Entry.Value.NumCases;
+		if (CounterHits.Num() != NumCases + 1)
+		{
+			continue;
+		}
+
+		TArray<uint64>& Hits = CaseHits.FindOrAdd(Entry.Value.NodeKey);
+		if (Hits.Num() != NumCases)
+		{
+			Hits.Reset();
+			Hits.SetNumZeroed(NumCases);
+		}
+		for (int32 Index = 0; Index < NumCases; ++Index)
+		{
+			Hits[Index] += CounterHits[Index];
+		}
+		bDirty = true;
+	}
+}
+
+const TArray<uint64>* FACFCaseProfile::FindCaseHits(const FString& NodeKey, int32 NumCases) const
+{
+	const TArray<uint64>* Hits = CaseHits.Find(NodeKey);
+
+	return ((Hits != nullptr) && (Hits->Num() == NumCases)) ? Hits : nullptr;
+}
+
+void FACFCaseProfile::Reset()
+{
+	CaseHits.Empty();
+	bDirty = true;
+	Save();
+}
+
+FString FACFCaseProfile::GetProfileFilePath() const
+{
+	return FPaths::ProjectSavedDir() / TEXT("AdvancedControlFlow") / TEXT("CaseProfile.json");
+}
+
+void FACFCaseProfile::Load()
+{
+	FString JsonString;
+	if (!FFileHelper::LoadFileToString(JsonString, *GetProfileFilePath()))
+	{
+		return;
+	}
+
+	TSharedPtr<FJsonObject> RootObject;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+	if (!FJsonSerializer::Deserialize(Reader, RootObject) || !RootObject.IsValid())
+	{
+		return;
+	}
+
+	CaseHits.Empty();
+	for (auto& Entry : RootObject->Values)
+	{
+		TArray<uint64>& Hits = CaseHits.Add(Entry.Key);
+		for (auto& Value : Entry.Value->AsArray())
+		{
+			Hits.Add(static_cast<uint64>(Value->AsNumber()));
+		}
+	}
+	bDirty = false;
+}
+
+void FACFCaseProfile::Save()
+{
+	if (!bDirty)
+	{
+		return;
+	}
+
+	TSharedRef<FJsonObject> RootObject = MakeShared<FJsonObject>();
+	for (auto& Entry : CaseHits)
+	{
+		TArray<TSharedPtr<FJsonValue>> Values;
+		for (uint64 Hit : Entry.Value)
+		{
+			Values.Add(MakeShared<FJsonValueNumber>(static_cast<double>(Hit)));
+		}
+		RootObject->SetArrayField(Entry.Key, Values);
+	}
+
+	FString JsonString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonString);
+	if (FJsonSerializer::Serialize(RootObject, Writer))
+	{
+		FFileHelper::SaveStringToFile(JsonString, *GetProfileFilePath());
+		bDirty = false;
+	}
+}
@@ -0,0 +1,354 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "ACFDifferentialTest.h"
+
+#include "EdGraphSchema_K2.h"
+#include "EdGraphUtilities.h"
+#include "Engine/Blueprint.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_CasePairedPinsNode.h"
+#include "K2Node_FunctionEntry.h"
+#include "K2Node_FunctionResult.h"
+#include "K2Node_MultiBranch.h"
+#include "K2Node_MultiConditionalSelect.h"
+#include "K2Node_VariableGet.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/EngineVersionComparison.h"
+
+static const FName OracleFunctionName(TEXT("ACFOracle"));
+static const FName OracleReturnValueName(TEXT("ReturnValue"));
+
+// Cases executed by the last call of the oracle function, which is called on the game thread.
+static TArray<int32> RecordedCaseHits;
+
+void UACFDifferentialTestLibrary::RecordCaseHit(int32 CaseIndex)
+{
+	RecordedCaseHits.Add(CaseIndex);
+}
+
+static void RandomizePropertyValue(const FProperty* Property, void* Data, FRandomStream& Random)
+{
+	if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+	{
+		BoolProperty->SetPropertyValue(Data, Random.RandRange(0, 1) == 1);
+	}
+	else if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+	{
+		if (NumericProperty->IsFloatingPoint())
+		{
+			NumericProperty->SetFloatingPointPropertyValue(Data, Random.FRandRange(-100.0f, 100.0f));
+		}
+		else if (!NumericProperty->IsEnum())
+		{
+			NumericProperty->SetIntPropertyValue(Data, static_cast<int64>(Random.RandRange(-100, 100)));
+		}
+	}
+}
+
+static FString CaseHitsToString(const TArray<bool>& CaseHits)
+{
+	FString Result;
+	for (bool bHit : CaseHits)
+	{
+		Result += bHit ? TEXT("1") : TEXT("0");
+	}
+
+	return Result;
+}
+
+static FString PropertyValueToString(const FProperty* Property, const void* Data)
+{
+	FString Result;
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+	Property->ExportTextItem(Result, Data, nullptr, nullptr, PPF_None);
+#else
+	Property->ExportTextItem_Direct(Result, Data, nullptr, nullptr, PPF_None);
+#endif
+
+	return Result;
+}
+
+static bool IsPropertyValueEqual(const FProperty* Property, const void* A, const void* B)
+{
+	// The native code may compute the floating point option in the different precision from the Blueprint VM.
+	const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property);
+	if ((NumericProperty != nullptr) && NumericProperty->IsFloatingPoint())
+	{
+		const double ValueA = NumericProperty->GetFloatingPointPropertyValue(A);
+		const double ValueB = NumericProperty->GetFloatingPointPropertyValue(B);
+		return FMath::IsNearlyEqual(ValueA, ValueB, static_cast<double>(KINDA_SMALL_NUMBER));
+	}
+
+	return Property->Identical(A, B);
+}
+
+// Collects the node and the pure nodes which provide the inputs of the node.
+static void CollectInputNodes(UEdGraphNode* Node, TSet<UObject*>& OutNodes)
+{
+	bool bAlreadyCollected = false;
+	OutNodes.Add(Node, &bAlreadyCollected);
+	if (bAlreadyCollected)
+	{
+		return;
+	}
+
+	for (UEdGraphPin* Pin : Node->Pins)
+	{
+		if ((Pin->Direction == EGPD_Input) && (Pin->PinType.PinCategory != UEdGraphSchema_K2::PC_Exec))
+		{
+			for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
+			{
+				CollectInputNodes(LinkedPin->GetOwningNode(), OutNodes);
+			}
+		}
+	}
+}
+
+// Creates the Blueprint deriving from the Blueprint of the node, whose function runs the copy of the node.
+// The function records the executed cases of Multi-Branch and Conditional Sequence, and returns the option selected by
+// Multi-Conditional Select.
+static UBlueprint* CreateOracleBlueprint(
+	FAutomationTestBase& Test, const UK2Node_CasePairedPinsNode* Node, TArray<FName>& OutReadVariables)
+{
+	UBlueprint* SourceBlueprint = Node->GetBlueprint();
+	if ((SourceBlueprint->GeneratedClass == nullptr) || (SourceBlueprint->Status == BS_Error))
+	{
+		Test.AddError(FString::Printf(TEXT("%s is not compiled"), *SourceBlueprint->GetPathName()));
+		return nullptr;
+	}
+
+	const FName BlueprintName = MakeUniqueObjectName(GetTransientPackage(), SourceBlueprint->GetClass(), TEXT("BP_ACFOracle"));
+	UBlueprint* Blueprint = FKismetEditorUtilities::CreateBlueprint(SourceBlueprint->GeneratedClass, GetTransientPackage(),
+		BlueprintName, BPTYPE_Normal, SourceBlueprint->GetClass(), SourceBlueprint->GeneratedClass->GetClass());
+	UEdGraph* Graph = FBlueprintEditorUtils::CreateNewGraph(
+		Blueprint, OracleFunctionName, UEdGraph::StaticClass(), UEdGraphSchema_K2::StaticClass());
+	FBlueprintEditorUtils::AddFunctionGraph<UClass>(Blueprint, Graph, true, nullptr);
+
+	// The links from the copied nodes to the nodes which are not copied are dropped.
+	TSet<UObject*> SourceNodes;
+	CollectInputNodes(const_cast<UK2Node_CasePairedPinsNode*>(Node), SourceNodes);
+	FString ExportedText;
+	FEdGraphUtilities::ExportNodesToText(SourceNodes, ExportedText);
+	TSet<UEdGraphNode*> ImportedNodes;
+	FEdGraphUtilities::ImportNodesFromText(Graph, ExportedText, ImportedNodes);
+
+	UK2Node_CasePairedPinsNode* CopiedNode = nullptr;
+	for (UEdGraphNode* ImportedNode : ImportedNodes)
+	{
+		if (ImportedNode->NodeGuid == Node->NodeGuid)
+		{
+			CopiedNode = Cast<UK2Node_CasePairedPinsNode>(ImportedNode);
+		}
+
+		const UK2Node_VariableGet* VariableGet = Cast<UK2Node_VariableGet>(ImportedNode);
+		const UEdGraphPin* SelfPin = (VariableGet != nullptr) ? VariableGet->FindPin(UEdGraphSchema_K2::PN_Self) : nullptr;
+		if ((VariableGet != nullptr) && VariableGet->VariableReference.IsSelfContext() &&
+			((SelfPin == nullptr) || (SelfPin->LinkedTo.Num() == 0)))
+		{
+			OutReadVariables.AddUnique(VariableGet->GetVarName());
+		}
+	}
+	if (CopiedNode == nullptr)
+	{
+		Test.AddError(TEXT("Failed to copy the node into the oracle Blueprint"));
+		return nullptr;
+	}
+
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+	TArray<UK2Node_FunctionEntry*> EntryNodes;
+	Graph->GetNodesOfClass(EntryNodes);
+	check(EntryNodes.Num() == 1);
+	UEdGraphPin* EntryThenPin = EntryNodes[0]->FindPinChecked(UEdGraphSchema_K2::PN_Then);
+
+	if (UK2Node_MultiConditionalSelect* MultiConditionalSelect = Cast<UK2Node_MultiConditionalSelect>(CopiedNode))
+	{
+		FGraphNodeCreator<UK2Node_FunctionResult> Creator(*Graph);
+		UK2Node_FunctionResult* Result = Creator.CreateNode(false);
+		Creator.Finalize();
+
+		UEdGraphPin* ReturnValuePin = MultiConditionalSelect->GetReturnValuePin();
+		UEdGraphPin* ResultPin = Result->CreateUserDefinedPin(OracleReturnValueName, ReturnValuePin->PinType, EGPD_Input, false);
+		Schema->TryCreateConnection(EntryThenPin, Result->GetExecPin());
+		Schema->TryCreateConnection(ReturnValuePin, ResultPin);
+	}
+	else
+	{
+		Schema->TryCreateConnection(EntryThenPin, CopiedNode->GetExecPin());
+
+		// Multi-Branch never takes the case whose execution pin is not connected, so connect only the connected cases.
+		const TArray<CasePinPair> SourcePairs = Node->GetCasePinPairs();
+		const TArray<CasePinPair> CopiedPairs = CopiedNode->GetCasePinPairs();
+		for (int32 Index = 0; Index < CopiedPairs.Num(); ++Index)
+		{
+			if (Node->IsA<UK2Node_MultiBranch>() && (SourcePairs[Index].Value->LinkedTo.Num() == 0))
+			{
+				continue;
+			}
+
+			FGraphNodeCreator<UK2Node_CallFunction> Creator(*Graph);
+			UK2Node_CallFunction* RecordCaseHit = Creator.CreateNode(false);
+			RecordCaseHit->SetFromFunction(UACFDifferentialTestLibrary::StaticClass()->FindFunctionByName(
+				GET_FUNCTION_NAME_CHECKED(UACFDifferentialTestLibrary, RecordCaseHit)));
+			Creator.Finalize();
+
+			Schema->TrySetDefaultValue(*RecordCaseHit->FindPinChecked(TEXT("CaseIndex")), FString::FromInt(Index));
+			Schema->TryCreateConnection(CopiedPairs[Index].Value, RecordCaseHit->GetExecPin());
+		}
+	}
+
+	FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::SkipGarbageCollection);
+	if (Blueprint->Status == BS_Error)
+	{
+		Test.AddError(FString::Printf(TEXT("Failed to compile the oracle Blueprint of %s"), *SourceBlueprint->GetPathName()));
+		return nullptr;
+	}
+
+	return Blueprint;
+}
+
+// Calls the oracle function while randomizing the variables read by the node, and checks the result after each call.
+static bool RunOracle(FAutomationTestBase& Test, const FString& BlueprintPath, const FGuid& NodeGuid, int32 Iterations,
+	TFunctionRef<bool(UObject* Self, const UFunction* Function, const uint8* Params, int32 Iteration)> CheckResult)
+{
+	const UK2Node_CasePairedPinsNode* Node = FACFDifferentialTest::FindNode(BlueprintPath, NodeGuid);
+	if (Node == nullptr)
+	{
+		Test.AddError(FString::Printf(TEXT("Node %s is not found in %s"), *NodeGuid.ToString(), *BlueprintPath));
+		return false;
+	}
+
+	TArray<FName> ReadVariables;
+	UBlueprint* Blueprint = CreateOracleBlueprint(Test, Node, ReadVariables);
+	if (Blueprint == nullptr)
+	{
+		return false;
+	}
+
+	// The oracle class is transient, so the variables are randomized on its class default object.
+	UObject* Self = Blueprint->GeneratedClass->GetDefaultObject();
+	UFunction* Function = Blueprint->GeneratedClass->FindFunctionByName(OracleFunctionName);
+	TArray<const FProperty*> ReadProperties;
+	for (const FName& VariableName : ReadVariables)
+	{
+		if (const FProperty* Property = Blueprint->GeneratedClass->FindPropertyByName(VariableName))
+		{
+			ReadProperties.Add(Property);
+		}
+	}
+
+	uint8* Params =
+		reinterpret_cast<uint8*>(FMemory::Malloc(FMath::Max<int32>(Function->ParmsSize, 1), Function->GetMinAlignment()));
+	FMemory::Memzero(Params, Function->ParmsSize);
+	for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+	{
+		It->InitializeValue_InContainer(Params);
+	}
+
+	FRandomStream Random(GetTypeHash(NodeGuid));
+	bool bSucceeded = true;
+	for (int32 Iteration = 0; (Iteration < Iterations) && bSucceeded; ++Iteration)
+	{
+		for (const FProperty* Property : ReadProperties)
+		{
+			RandomizePropertyValue(Property, Property->ContainerPtrToValuePtr<void>(Self), Random);
+		}
+
+		RecordedCaseHits.Reset();
+		Self->ProcessEvent(Function, Params);
+		bSucceeded = CheckResult(Self, Function, Params, Iteration);
+	}
+
+	for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+	{
+		It->DestroyValue_InContainer(Params);
+	}
+	FMemory::Free(Params);
+
+	return bSucceeded;
+}
+
+UK2Node_CasePairedPinsNode* FACFDifferentialTest::FindNode(const FString& BlueprintPath, const FGuid& NodeGuid)
+{
+	UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
+	if (Blueprint == nullptr)
+	{
+		return nullptr;
+	}
+
+	TArray<UK2Node_CasePairedPinsNode*> Nodes;
+	FBlueprintEditorUtils::GetAllNodesOfClass(Blueprint, Nodes);
+	for (UK2Node_CasePairedPinsNode* Node : Nodes)
+	{
+		if (Node->NodeGuid == NodeGuid)
+		{
+			return Node;
+		}
+	}
+
+	return nullptr;
+}
+
+bool FACFDifferentialTest::RunCaseHitsTest(FAutomationTestBase& Test, const FString& BlueprintPath, const FGuid& NodeGuid,
+	TFunction<TArray<bool>(UObject* Self)> NativeCaseHits, int32 Iterations)
+{
+	return RunOracle(Test, BlueprintPath, NodeGuid, Iterations,
+		[&](UObject* Self, const UFunction* Function, const uint8* Params, int32 Iteration)
+		{
+			const TArray<bool> Actual = NativeCaseHits(Self);
+			TArray<bool> Expected;
+			Expected.Init(false, Actual.Num());
+			for (int32 CaseIndex : RecordedCaseHits)
+			{
+				if (CaseIndex >= Expected.Num())
+				{
+					Expected.SetNumZeroed(CaseIndex + 1);
+				}
+				Expected[CaseIndex] = true;
+			}
+
+			if (Expected != Actual)
+			{
+				Test.AddError(FString::Printf(TEXT("Case hits differ at iteration %d (Blueprint: %s, Native: %s)"), Iteration,
+					*CaseHitsToString(Expected), *CaseHitsToString(Actual)));
+				return false;
+			}
+			return true;
+		});
+}
+
+bool FACFDifferentialTest::RunSelectTest(FAutomationTestBase& Test, const FString& BlueprintPath, const FGuid& NodeGuid,
+	TFunction<void(UObject* Self, void* OutValue)> NativeSelect, int32 Iterations)
+{
+	return RunOracle(Test, BlueprintPath, NodeGuid, Iterations,
+		[&](UObject* Self, const UFunction* Function, const uint8* Params, int32 Iteration)
+		{
+			const FProperty* ReturnProperty = Function->FindPropertyByName(OracleReturnValueName);
+			const void* Expected = ReturnProperty->ContainerPtrToValuePtr<void>(Params);
+
+			void* Actual = FMemory::Malloc(ReturnProperty->GetSize(), ReturnProperty->GetMinAlignment());
+			ReturnProperty->InitializeValue(Actual);
+			NativeSelect(Self, Actual);
+
+			const bool bEqual = IsPropertyValueEqual(ReturnProperty, Expected, Actual);
+			if (!bEqual)
+			{
+				Test.AddError(FString::Printf(TEXT("Selected options differ at iteration %d (Blueprint: %s, Native: %s)"),
+					Iteration, *PropertyValueToString(ReturnProperty, Expected), *PropertyValueToString(ReturnProperty, Actual)));
+			}
+
+			ReturnProperty->DestroyValue(Actual);
+			FMemory::Free(Actual);
+
+			return bEqual;
+		});
+}
@@ -0,0 +1,616 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "ACFExpression.h"
+
+#include "EdGraphSchema_K2.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_IfThenElse.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "KismetCompiler.h"
+#include "Misc/EngineVersionComparison.h"
+
+#define LOCTEXT_NAMESPACE "AdvancedControlFlow"
+
+namespace ACFExpression
+{
+static const FString InputPinNamePrefix(TEXT("Input_"));
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+static const TCHAR* FloatFunctionSuffix = TEXT("_FloatFloat");
+static const TCHAR* IntToFloatFunctionName = TEXT("Conv_IntToFloat");
+#else
+static const TCHAR* FloatFunctionSuffix = TEXT("_DoubleDouble");
+static const TCHAR* IntToFloatFunctionName = TEXT("Conv_IntToDouble");
+#endif
+
+struct FBinaryOperator
+{
+	const TCHAR* Token;
+	FACFExpression::EKind Kind;
+};
+
+// Binary operators from the lowest precedence.
+static const TArray<TArray<FBinaryOperator>> BinaryOperators = {
+	{{TEXT("||"), FACFExpression::EKind::Or}},
+	{{TEXT("&&"), FACFExpression::EKind::And}},
+	{{TEXT("=="), FACFExpression::EKind::Equal}, {TEXT("!="), FACFExpression::EKind::NotEqual}},
+	{{TEXT("<"), FACFExpression::EKind::Less}, {TEXT("<="), FACFExpression::EKind::LessEqual},
+		{TEXT(">"), FACFExpression::EKind::Greater}, {TEXT(">="), FACFExpression::EKind::GreaterEqual}},
+	{{TEXT("+"), FACFExpression::EKind::Add}, {TEXT("-"), FACFExpression::EKind::Subtract}},
+	{{TEXT("*"), FACFExpression::EKind::Multiply}, {TEXT("/"), FACFExpression::EKind::Divide},
+		{TEXT("%"), FACFExpression::EKind::Modulo}},
+};
+
+static bool IsBooleanLiteral(const FString& Text)
+{
+	return Text.Equals(TEXT("true"), ESearchCase::IgnoreCase) || Text.Equals(TEXT("false"), ESearchCase::IgnoreCase);
+}
+
+static bool IsIdentifierStart(TCHAR Char)
+{
+	return FChar::IsAlpha(Char) || (Char == TEXT('_'));
+}
+
+static bool IsIdentifierChar(TCHAR Char)
+{
+	return FChar::IsAlnum(Char) || (Char == TEXT('_'));
+}
+
+static bool Tokenize(const FString& Text, TArray<FString>& OutTokens, FText& OutError)
+{
+	static const TCHAR* TwoCharTokens[] = {TEXT("&&"), TEXT("||"), TEXT("=="), TEXT("!="), TEXT("<="), TEXT(">=")};
+	static const FString OneCharTokens(TEXT("!<>+-*/%()"));
+
+	int32 Position = 0;
+	while (Position < Text.Len())
+	{
+		const TCHAR Char = Text[Position];
+		if (FChar::IsWhitespace(Char))
+		{
+			++Position;
+			continue;
+		}
+
+		int32 End = Position;
+		if (IsIdentifierStart(Char))
+		{
+			while ((End < Text.Len()) && IsIdentifierChar(Text[End]))
+			{
+				++End;
+			}
+		}
+		else if (FChar::IsDigit(Char))
+		{
+			while ((End < Text.Len()) && FChar::IsDigit(Text[End]))
+			{
+				++End;
+			}
+			if ((End + 1 < Text.Len()) && (Text[End] == TEXT('.')) && FChar::IsDigit(Text[End + 1]))
+			{
+				for (++End; (End < Text.Len()) && FChar::IsDigit(Text[End]); ++End)
+				{
+				}
+			}
+		}
+		else
+		{
+			for (const TCHAR* Token : TwoCharTokens)
+			{
+				if (Text.Mid(Position, 2) == Token)
+				{
+					End = Position + 2;
+					break;
+				}
+			}
+			int32 CharIndex = INDEX_NONE;
+			if ((End == Position) && OneCharTokens.FindChar(Char, CharIndex))
+			{
+				End = Position + 1;
+			}
+			if (End == Position)
+			{
+				OutError = FText::Format(LOCTEXT("ExpressionUnexpectedChar_Error", "Unexpected character '{0}' at {1}"),
+					FText::FromString(FString::Chr(Char)), FText::AsNumber(Position));
+				return false;
+			}
+		}
+
+		OutTokens.Add(Text.Mid(Position, End - Position));
+		Position = End;
+	}
+
+	return true;
+}
+
+// Recursive descent parser for the tokens.
+class FParser
+{
+	const TArray<FString>& Tokens;
+	int32 Position = 0;
+
+	static TSharedPtr<FACFExpression> MakeExpression(FACFExpression::EKind Kind, const FString& Text)
+	{
+		TSharedPtr<FACFExpression> Expression = MakeShared<FACFExpression>();
+		Expression->Kind = Kind;
+		Expression->Text = Text;
+		return Expression;
+	}
+
+	bool Match(const TCHAR* Token)
+	{
+		if ((Position < Tokens.Num()) && (Tokens[Position] == Token))
+		{
+			++Position;
+			return true;
+		}
+		return false;
+	}
+
+	TSharedPtr<FACFExpression> ParseBinary(int32 Level)
+	{
+		if (Level == BinaryOperators.Num())
+		{
+			return ParseUnary();
+		}
+
+		TSharedPtr<FACFExpression> LHS = ParseBinary(Level + 1);
+		while (LHS.IsValid())
+		{
+			const FBinaryOperator* Operator = BinaryOperators[Level].FindByPredicate(
+				[this](const FBinaryOperator& Op) { return (Position < Tokens.Num()) && (Tokens[Position] == Op.Token); });
+			if (Operator == nullptr)
+			{
+				break;
+			}
+			++Position;
+
+			TSharedPtr<FACFExpression> RHS = ParseBinary(Level + 1);
+			if (!RHS.IsValid())
+			{
+				return nullptr;
+			}
+			TSharedPtr<FACFExpression> Binary = MakeExpression(Operator->Kind, Operator->Token);
+			Binary->Operands = {LHS, RHS};
+			LHS = Binary;
+		}
+
+		return LHS;
+	}
+
+	TSharedPtr<FACFExpression> ParseUnary()
+	{
+		for (const auto& Operator : {TPair<const TCHAR*, FACFExpression::EKind>(TEXT("!"), FACFExpression::EKind::Not),
+				 TPair<const TCHAR*, FACFExpression::EKind>(TEXT("-"), FACFExpression::EKind::Negate)})
+		{
+			if (Match(Operator.Key))
+			{
+				TSharedPtr<FACFExpression> Operand = ParseUnary();
+				if (!Operand.IsValid())
+				{
+					return nullptr;
+				}
+				TSharedPtr<FACFExpression> Unary = MakeExpression(Operator.Value, Operator.Key);
+				Unary->Operands = {Operand};
+				return Unary;
+			}
+		}
+
+		return ParsePrimary();
+	}
+
+	TSharedPtr<FACFExpression> ParsePrimary()
+	{
+		if (Position >= Tokens.Num())
+		{
+			Error = LOCTEXT("ExpressionUnexpectedEnd_Error", "Unexpected end of the expression");
+			return nullptr;
+		}
+
+		const FString& Token = Tokens[Position];
+		if (Match(TEXT("(")))
+		{
+			TSharedPtr<FACFExpression> Inner = ParseBinary(0);
+			if (Inner.IsValid() && !Match(TEXT(")")))
+			{
+				Error = LOCTEXT("ExpressionNoClosingParen_Error", "')' is expected");
+				return nullptr;
+			}
+			return Inner;
+		}
+		if (FChar::IsDigit(Token[0]) || IsBooleanLiteral(Token))
+		{
+			++Position;
+			return MakeExpression(FACFExpression::EKind::Literal, Token.ToLower());
+		}
+		if (IsIdentifierStart(Token[0]))
+		{
+			++Position;
+			return MakeExpression(FACFExpression::EKind::Input, Token);
+		}
+
+		Error = FText::Format(LOCTEXT("ExpressionUnexpectedToken_Error", "Unexpected '{0}'"), FText::FromString(Token));
+		return nullptr;
+	}
+
+public:
+	FText Error;
+
+	FParser(const TArray<FString>& InTokens) : Tokens(InTokens)
+	{
+	}
+
+	TSharedPtr<FACFExpression> Parse()
+	{
+		TSharedPtr<FACFExpression> Expression = ParseBinary(0);
+		if (Expression.IsValid() && (Position < Tokens.Num()))
+		{
+			Error = FText::Format(
+				LOCTEXT("ExpressionUnexpectedToken_Error", "Unexpected '{0}'"), FText::FromString(Tokens[Position]));
+			return nullptr;
+		}
+		return Expression;
+	}
+};
+}  // namespace ACFExpression
+
+TSharedPtr<const FACFExpression> FACFExpression::Parse(const FString& Text, FText& OutError)
+{
+	// The map hashes the text, so that the expressions repeated over the cases and the graphs are parsed once per editor session.
+	static TMap<FString, TSharedPtr<const FACFExpression>> ParsedExpressions;
+
+	const FString TrimmedText = Text.TrimStartAndEnd();
+	if (const TSharedPtr<const FACFExpression>* Parsed = ParsedExpressions.Find(TrimmedText))
+	{
+		return *Parsed;
+	}
+
+	if (TrimmedText.IsEmpty())
+	{
+		OutError = LOCTEXT("ExpressionEmpty_Error", "The expression is empty");
+		return nullptr;
+	}
+
+	TArray<FString> Tokens;
+	if (!ACFExpression::Tokenize(TrimmedText, Tokens, OutError))
+	{
+		return nullptr;
+	}
+
+	ACFExpression::FParser Parser(Tokens);
+	TSharedPtr<const FACFExpression> Expression = Parser.Parse();
+	if (!Expression.IsValid())
+	{
+		OutError = Parser.Error;
+		return nullptr;
+	}
+	ParsedExpressions.Add(TrimmedText, Expression);
+
+	return Expression;
+}
+
+FACFExpressionCompiler::FACFExpressionCompiler(FKismetCompilerContext& InCompilerContext, UEdGraph* InSourceGraph, UK2Node* InNode,
+	const TArray<FACFExpressionInput>& InInputs)
+	: CompilerContext(InCompilerContext), SourceGraph(InSourceGraph), Node(InNode), Inputs(InInputs)
+{
+}
+
+bool FACFExpressionCompiler::CheckType(const FACFExpression& Expression, EType& OutType, FText& OutError) const
+{
+	using EKind = FACFExpression::EKind;
+
+	if (Expression.Kind == EKind::Literal)
+	{
+		OutType = ACFExpression::IsBooleanLiteral(Expression.Text)
+					  ? EType::Boolean
+					  : (Expression.Text.Contains(TEXT(".")) ? EType::Float : EType::Integer);
+		return true;
+	}
+	if (Expression.Kind == EKind::Input)
+	{
+		const FACFExpressionInput* Input =
+			Inputs.FindByPredicate([&Expression](const FACFExpressionInput& In) { return In.Name == FName(*Expression.Text); });
+		if ((Input == nullptr) || (FindInputPin(Node, Input->Name) == nullptr))
+		{
+			OutError = FText::Format(
+				LOCTEXT("ExpressionUnknownInput_Error", "'{0}' is not an expression input"), FText::FromString(Expression.Text));
+			return false;
+		}
+		OutType = static_cast<EType>(Input->Type);
+		return true;
+	}
+
+	TArray<EType> OperandTypes;
+	for (auto& Operand : Expression.Operands)
+	{
+		if (!CheckType(*Operand, OperandTypes.AddDefaulted_GetRef(), OutError))
+		{
+			return false;
+		}
+	}
+	const bool bBoolean = !OperandTypes.ContainsByPredicate([](EType Type) { return Type != EType::Boolean; });
+	const bool bNumeric = !OperandTypes.Contains(EType::Boolean);
+
+	bool bValid = false;
+	switch (Expression.Kind)
+	{
+		case EKind::Not:
+		case EKind::And:
+		case EKind::Or:
+			bValid = bBoolean;
+			OutType = EType::Boolean;
+			break;
+		case EKind::Equal:
+		case EKind::NotEqual:
+			bValid = bBoolean || bNumeric;
+			OutType = EType::Boolean;
+			break;
+		case EKind::Less:
+		case EKind::LessEqual:
+		case EKind::Greater:
+		case EKind::GreaterEqual:
+			bValid = bNumeric;
+			OutType = EType::Boolean;
+			break;
+		default:
+			bValid = bNumeric;
+			OutType = OperandTypes.Contains(EType::Float) ? EType::Float : EType::Integer;
+			break;
+	}
+	if (!bValid)
+	{
+		OutError = FText::Format(
+			LOCTEXT("ExpressionOperandType_Error", "Operands of '{0}' have invalid types"), FText::FromString(Expression.Text));
+	}
+
+	return bValid;
+}
+
+FACFExpressionCompiler::FValue FACFExpressionCompiler::ExpandValue(const FACFExpression& Expression)
+{
+	using EKind = FACFExpression::EKind;
+
+	FValue Value;
+	FText Error;
+	CheckType(Expression, Value.Type, Error);
+
+	if (Expression.Kind == EKind::Literal)
+	{
+		Value.Literal = Expression.Text;
+		return Value;
+	}
+	if (Expression.Kind == EKind::Input)
+	{
+		Value.InputPin = FindInputPin(Node, FName(*Expression.Text));
+		return Value;
+	}
+
+	TArray<FValue> Operands;
+	for (auto& Operand : Expression.Operands)
+	{
+		Operands.Add(ExpandValue(*Operand));
+	}
+
+	switch (Expression.Kind)
+	{
+		case EKind::Not:
+			return ExpandFunctionCall(TEXT("Not_PreBool"), Operands, EType::Boolean);
+		case EKind::And:
+			return ExpandFunctionCall(TEXT("BooleanAND"), Operands, EType::Boolean);
+		case EKind::Or:
+			return ExpandFunctionCall(TEXT("BooleanOR"), Operands, EType::Boolean);
+		case EKind::Negate:
+		{
+			FValue Zero;
+			Zero.Type = Value.Type;
+			Zero.Literal = TEXT("0");
+			Operands.Insert(Zero, 0);
+			break;
+		}
+		default:
+			break;
+	}
+
+	static const TMap<EKind, const TCHAR*> FunctionNames = {{EKind::Equal, TEXT("EqualEqual")}, {EKind::NotEqual, TEXT("NotEqual")},
+		{EKind::Less, TEXT("Less")}, {EKind::LessEqual, TEXT("LessEqual")}, {EKind::Greater, TEXT("Greater")},
+		{EKind::GreaterEqual, TEXT("GreaterEqual")}, {EKind::Add, TEXT("Add")}, {EKind::Subtract, TEXT("Subtract")},
+		{EKind::Negate, TEXT("Subtract")}, {EKind::Multiply, TEXT("Multiply")}, {EKind::Divide, TEXT("Divide")},
+		{EKind::Modulo, TEXT("Percent")}};
+	const FString FunctionName = FunctionNames.FindChecked(Expression.Kind);
+
+	if (Operands[0].Type == EType::Boolean)
+	{
+		return ExpandFunctionCall(FunctionName + TEXT("_BoolBool"), Operands, EType::Boolean);
+	}
+	if ((Operands[0].Type == EType::Integer) && (Operands[1].Type == EType::Integer))
+	{
+		return ExpandFunctionCall(FunctionName + TEXT("_IntInt"), Operands, Value.Type);
+	}
+
+	for (auto& Operand : Operands)
+	{
+		Operand = ConvertToFloat(Operand);
+	}
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+	// Modulo of the floating point numbers is not renamed on UE 5.
+	if (Expression.Kind == EKind::Modulo)
+	{
+		return ExpandFunctionCall(TEXT("Percent_FloatFloat"), Operands, Value.Type);
+	}
+#endif
+	return ExpandFunctionCall(FunctionName + ACFExpression::FloatFunctionSuffix, Operands, Value.Type);
+}
+
+FACFExpressionCompiler::FValue FACFExpressionCompiler::ExpandFunctionCall(
+	const FString& FunctionName, const TArray<FValue>& Arguments, EType ReturnType)
+{
+	UK2Node_CallFunction* CallFunction = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(Node, SourceGraph);
+	UFunction* Function = UKismetMathLibrary::StaticClass()->FindFunctionByName(*FunctionName);
+	check(Function != nullptr);
+	CallFunction->SetFromFunction(Function);
+	CallFunction->AllocateDefaultPins();
+
+	int32 ArgumentIndex = 0;
+	for (auto& Pin : CallFunction->Pins)
+	{
+		if ((Pin->Direction == EGPD_Input) && (Pin->PinName != UEdGraphSchema_K2::PN_Self) && (ArgumentIndex < Arguments.Num()))
+		{
+			LinkValue(Arguments[ArgumentIndex++], Pin);
+		}
+	}
+
+	FValue Value;
+	Value.Type = ReturnType;
+	Value.OutputPin = CallFunction->GetReturnValuePin();
+	return Value;
+}
+
+FACFExpressionCompiler::FValue FACFExpressionCompiler::ConvertToFloat(const FValue& Value)
+{
+	if (Value.Type == EType::Float)
+	{
+		return Value;
+	}
+	if (!Value.Literal.IsEmpty())
+	{
+		FValue Converted = Value;
+		Converted.Type = EType::Float;
+		return Converted;
+	}
+
+	return ExpandFunctionCall(ACFExpression::IntToFloatFunctionName, {Value}, EType::Float);
+}
+
+void FACFExpressionCompiler::LinkValue(const FValue& Value, UEdGraphPin* TargetPin)
+{
+	if (Value.OutputPin != nullptr)
+	{
+		Value.OutputPin->MakeLinkTo(TargetPin);
+	}
+	else if (Value.InputPin != nullptr)
+	{
+		CompilerContext.CopyPinLinksToIntermediate(*Value.InputPin, *TargetPin);
+	}
+	else
+	{
+		CompilerContext.GetSchema()->TrySetDefaultValue(*TargetPin, Value.Literal);
+	}
+}
+
+TSharedPtr<const FACFExpression> FACFExpressionCompiler::ParseCondition(const UEdGraphPin* ExpressionPin)
+{
+	FText Error;
+	TSharedPtr<const FACFExpression> Expression = FACFExpression::Parse(ExpressionPin->DefaultValue, Error);
+
+	EType Type = EType::Boolean;
+	if (Expression.IsValid() && CheckType(*Expression, Type, Error) && (Type != EType::Boolean))
+	{
+		Error = LOCTEXT("ExpressionNotBoolean_Error", "The expression must be Boolean");
+	}
+	if (!Error.IsEmpty())
+	{
+		CompilerContext.MessageLog.Error(
+			*FText::Format(LOCTEXT("Expression_Error", "{0} in the expression of @@"), Error).ToString(), ExpressionPin);
+		return nullptr;
+	}
+
+	return Expression;
+}
+
+void FACFExpressionCompiler::ExpandCondition(const FACFExpression& Expression, UEdGraphPin* BoolPin)
+{
+	LinkValue(ExpandValue(Expression), BoolPin);
+}
+
+UEdGraphPin* FACFExpressionCompiler::ExpandBranch(
+	const FACFExpression& Expression, TArray<UEdGraphPin*>& OutTrueExecPins, TArray<UEdGraphPin*>& OutFalseExecPins)
+{
+	using EKind = FACFExpression::EKind;
+
+	if (Expression.Kind == EKind::Not)
+	{
+		return ExpandBranch(*Expression.Operands[0], OutFalseExecPins, OutTrueExecPins);
+	}
+	if ((Expression.Kind == EKind::And) || (Expression.Kind == EKind::Or))
+	{
+		// The right operand is entered only when the left operand does not decide the result.
+		TArray<UEdGraphPin*> LHSTrueExecPins;
+		TArray<UEdGraphPin*> LHSFalseExecPins;
+		UEdGraphPin* EntryPin = ExpandBranch(*Expression.Operands[0], LHSTrueExecPins, LHSFalseExecPins);
+		UEdGraphPin* RHSEntryPin = ExpandBranch(*Expression.Operands[1], OutTrueExecPins, OutFalseExecPins);
+
+		const bool bAnd = (Expression.Kind == EKind::And);
+		for (auto& Pin : bAnd ? LHSTrueExecPins : LHSFalseExecPins)
+		{
+			Pin->MakeLinkTo(RHSEntryPin);
+		}
+		(bAnd ? OutFalseExecPins : OutTrueExecPins).Append(bAnd ? LHSFalseExecPins : LHSTrueExecPins);
+
+		return EntryPin;
+	}
+
+	UK2Node_IfThenElse* Branch = CompilerContext.SpawnIntermediateNode<UK2Node_IfThenElse>(Node, SourceGraph);
+	Branch->AllocateDefaultPins();
+	ExpandCondition(Expression, Branch->GetConditionPin());
+	OutTrueExecPins.Add(Branch->GetThenPin());
+	OutFalseExecPins.Add(Branch->GetElsePin());
+
+	return Branch->GetExecPin();
+}
+
+void FACFExpressionCompiler::CreateInputPins(UK2Node* Node, const TArray<FACFExpressionInput>& Inputs)
+{
+	for (auto& Input : Inputs)
+	{
+		if (Input.Name.IsNone() || (FindInputPin(Node, Input.Name) != nullptr))
+		{
+			continue;
+		}
+
+		UEdGraphPin* InputPin = Node->CreatePin(
+			EGPD_Input, GetInputPinType(Input.Type), *(ACFExpression::InputPinNamePrefix + Input.Name.ToString()));
+		InputPin->PinFriendlyName = FText::FromName(Input.Name);
+	}
+}
+
+UEdGraphPin* FACFExpressionCompiler::FindInputPin(const UK2Node* Node, FName Name)
+{
+	return Node->FindPin(ACFExpression::InputPinNamePrefix + Name.ToString(), EGPD_Input);
+}
+
+bool FACFExpressionCompiler::IsInputPin(const UEdGraphPin* Pin)
+{
+	return (Pin->Direction == EGPD_Input) && Pin->PinName.ToString().StartsWith(ACFExpression::InputPinNamePrefix);
+}
+
+FEdGraphPinType FACFExpressionCompiler::GetInputPinType(EACFExpressionInputType Type)
+{
+	FEdGraphPinType PinType;
+	switch (Type)
+	{
+		case EACFExpressionInputType::Boolean:
+			PinType.PinCategory = UEdGraphSchema_K2::PC_Boolean;
+			break;
+		case EACFExpressionInputType::Integer:
+			PinType.PinCategory = UEdGraphSchema_K2::PC_Int;
+			break;
+		case EACFExpressionInputType::Float:
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+			PinType.PinCategory = UEdGraphSchema_K2::PC_Float;
+#else
+			PinType.PinCategory = UEdGraphSchema_K2::PC_Real;
+			PinType.PinSubCategory = UEdGraphSchema_K2::PC_Double;
+#endif
+			break;
+	}
+
+	return PinType;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,960 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "ACFNativeCodeGenerator.h"
+
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_CasePairedPinsNode.h"
+#include "K2Node_ConditionalSequence.h"
+#include "K2Node_Knot.h"
+#include "K2Node_MultiBranch.h"
+#include "K2Node_MultiConditionalSelect.h"
+#include "K2Node_Self.h"
+#include "K2Node_VariableGet.h"
+#include "Misc/App.h"
+#include "Misc/EngineVersionComparison.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+// Helpers emitted into the private namespace of each generated source file.
+// Blueprint variables and the functions which can't be called directly are accessed through the reflection.
+static const TCHAR* GeneratedHelperCode = TEXT(R"(
+template <typename T>
+T GetVariable(UObject* Object, const TCHAR* Name)
+{
+	check(Object != nullptr);
+	const FProperty* Property = FindFProperty<FProperty>(Object->GetClass(), Name);
+	check(Property != nullptr);
+	return *Property->ContainerPtrToValuePtr<T>(Object);
+}
+
+template <>
+bool GetVariable<bool>(UObject* Object, const TCHAR* Name)
+{
+	check(Object != nullptr);
+	const FBoolProperty* Property = FindFProperty<FBoolProperty>(Object->GetClass(), Name);
+	check(Property != nullptr);
+	return Property->GetPropertyValue_InContainer(Object);
+}
+
+template <>
+UObject* GetVariable<UObject*>(UObject* Object, const TCHAR* Name)
+{
+	check(Object != nullptr);
+	const FObjectPropertyBase* Property = FindFProperty<FObjectPropertyBase>(Object->GetClass(), Name);
+	check(Property != nullptr);
+	return Property->GetObjectPropertyValue_InContainer(Object);
+}
+
+UObject* GetClassDefaultObject(const TCHAR* ClassPath)
+{
+	UClass* Class = LoadObject<UClass>(nullptr, ClassPath);
+	check(Class != nullptr);
+	return Class->GetDefaultObject();
+}
+
+class FProcessEventCall
+{
+	UObject* Target;
+	UFunction* Function;
+	uint8* Params;
+
+	const FProperty* FindParam(const TCHAR* Name) const
+	{
+		const FProperty* Property = FindFProperty<FProperty>(Function, Name);
+		check(Property != nullptr);
+		return Property;
+	}
+
+	void GetResult(const TCHAR* Name, bool& OutResult) const
+	{
+		OutResult = CastFieldChecked<FBoolProperty>(FindParam(Name))->GetPropertyValue_InContainer(Params);
+	}
+	void GetResult(const TCHAR* Name, UObject*& OutResult) const
+	{
+		OutResult = CastFieldChecked<FObjectPropertyBase>(FindParam(Name))->GetObjectPropertyValue_InContainer(Params);
+	}
+	template <typename T>
+	void GetResult(const TCHAR* Name, T& OutResult) const
+	{
+		OutResult = *FindParam(Name)->ContainerPtrToValuePtr<T>(Params);
+	}
+
+public:
+	FProcessEventCall(UObject* InTarget, const TCHAR* FunctionName) : Target(InTarget)
+	{
+		check(Target != nullptr);
+		Function = Target->FindFunctionChecked(FunctionName);
+		Params = static_cast<uint8*>(FMemory::Malloc(FMath::Max<int32>(Function->ParmsSize, 1), Function->GetMinAlignment()));
+		FMemory::Memzero(Params, Function->ParmsSize);
+		for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+		{
+			It->InitializeValue_InContainer(Params);
+		}
+	}
+	FProcessEventCall(const FProcessEventCall&) = delete;
+	FProcessEventCall& operator=(const FProcessEventCall&) = delete;
+	~FProcessEventCall()
+	{
+		for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+		{
+			It->DestroyValue_InContainer(Params);
+		}
+		FMemory::Free(Params);
+	}
+
+	FProcessEventCall& Set(const TCHAR* Name, bool Value)
+	{
+		CastFieldChecked<FBoolProperty>(FindParam(Name))->SetPropertyValue_InContainer(Params, Value);
+		return *this;
+	}
+	FProcessEventCall& Set(const TCHAR* Name, UObject* Value)
+	{
+		CastFieldChecked<FObjectPropertyBase>(FindParam(Name))->SetObjectPropertyValue_InContainer(Params, Value);
+		return *this;
+	}
+	template <typename T>
+	FProcessEventCall& Set(const TCHAR* Name, const T& Value)
+	{
+		const FProperty* Property = FindParam(Name);
+		check(Property->GetSize() == sizeof(T));
+		Property->CopySingleValue(Property->ContainerPtrToValuePtr<void>(Params), &Value);
+		return *this;
+	}
+
+	template <typename T>
+	T Call(const TCHAR* ResultName)
+	{
+		Target->ProcessEvent(Function, Params);
+		T Result;
+		GetResult(ResultName, Result);
+		return Result;
+	}
+};
+)");
+
+static FString SanitizeIdentifier(const FString& Name)
+{
+	FString Result;
+	for (TCHAR Char : Name)
+	{
+		Result.AppendChar(FChar::IsAlnum(Char) ? Char : TEXT('_'));
+	}
+
+	return Result;
+}
+
+static FString MakeFloatLiteral(double Value, bool bSinglePrecision)
+{
+	FString Literal = FString::Printf(bSinglePrecision ? TEXT("%.9g") : TEXT("%.17g"), Value);
+	if (!Literal.Contains(TEXT(".")) && !Literal.Contains(TEXT("e")))
+	{
+		Literal += TEXT(".0");
+	}
+
+	return bSinglePrecision ? Literal + TEXT("f") : Literal;
+}
+
+static FString MakeStringLiteral(const FString& Value)
+{
+	return FString::Printf(TEXT("TEXT(\"%s\")"), *Value.ReplaceCharWithEscapedChar());
+}
+
+static FString IndentLines(const FString& Code, int32 Depth)
+{
+	FString Indent = FString::ChrN(Depth, TEXT('\t'));
+	TArray<FString> Lines;
+	Code.ParseIntoArrayLines(Lines, false);
+
+	FString Result;
+	for (const FString& Line : Lines)
+	{
+		Result += Line.IsEmpty() ? TEXT("\n") : Indent + Line + TEXT("\n");
+	}
+
+	return Result;
+}
+
+FACFNativeCodeGenerator::FACFNativeCodeGenerator(const UK2Node_CasePairedPinsNode* InNode) : Node(InNode)
+{
+	UBlueprint* Blueprint = Node->GetBlueprint();
+	BaseName = FString::Printf(
+		TEXT("ACF_%s_%s"), *SanitizeIdentifier(Blueprint->GetName()), *Node->NodeGuid.ToString(EGuidFormats::Digits).Left(8));
+	ApiMacro = FString(FApp::GetProjectName()).ToUpper() + TEXT("_API");
+}
+
+bool FACFNativeCodeGenerator::IsSupportedNode(const UK2Node_CasePairedPinsNode* Node)
+{
+	// The conditions written as the expressions are not translated, and the throttle and reactive states live in the Blueprint.
+	if (const UK2Node_MultiBranch* MultiBranch = Cast<UK2Node_MultiBranch>(Node))
+	{
+		return !MultiBranch->bUseExpressions && (MultiBranch->ThrottleMode == EACFThrottleMode::Disabled);
+	}
+	if (const UK2Node_MultiConditionalSelect* MultiConditionalSelect = Cast<UK2Node_MultiConditionalSelect>(Node))
+	{
+		return !MultiConditionalSelect->bUseExpressions && !MultiConditionalSelect->bReactive;
+	}
+	return Node->IsA<UK2Node_ConditionalSequence>();
+}
+
+FString FACFNativeCodeGenerator::GetObjectType(const UClass* Class)
+{
+	// Blueprint classes don't exist in C++, so refer to the nearest native class.
+	while ((Class != nullptr) && !Class->HasAnyClassFlags(CLASS_Native))
+	{
+		Class = Class->GetSuperClass();
+	}
+	if ((Class == nullptr) || (Class == UObject::StaticClass()))
+	{
+		return TEXT("UObject*");
+	}
+
+	const FString& IncludePath = Class->GetMetaData(TEXT("IncludePath"));
+	if (!IncludePath.IsEmpty())
+	{
+		Includes.Add(IncludePath);
+	}
+
+	return FString::Printf(TEXT("%s%s*"), Class->GetPrefixCPP(), *Class->GetName());
+}
+
+bool FACFNativeCodeGenerator::GetCppType(const FEdGraphPinType& PinType, FString& OutType)
+{
+	if (PinType.IsContainer())
+	{
+		return false;
+	}
+
+	const FName& Category = PinType.PinCategory;
+	if (Category == UEdGraphSchema_K2::PC_Boolean)
+	{
+		OutType = TEXT("bool");
+	}
+	else if (Category == UEdGraphSchema_K2::PC_Int)
+	{
+		OutType = TEXT("int32");
+	}
+	else if (Category == UEdGraphSchema_K2::PC_Int64)
+	{
+		OutType = TEXT("int64");
+	}
+	else if (Category == UEdGraphSchema_K2::PC_Byte)
+	{
+		OutType = TEXT("uint8");
+	}
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	else if (Category == UEdGraphSchema_K2::PC_Float)
+	{
+		OutType = TEXT("float");
+	}
+#else
+	else if (Category == UEdGraphSchema_K2::PC_Real)
+	{
+		OutType = (PinType.PinSubCategory == UEdGraphSchema_K2::PC_Float) ? TEXT("float") : TEXT("double");
+	}
+#endif
+	else if (Category == UEdGraphSchema_K2::PC_Name)
+	{
+		OutType = TEXT("FName");
+	}
+	else if (Category == UEdGraphSchema_K2::PC_String)
+	{
+		OutType = TEXT("FString");
+	}
+	else if (Category == UEdGraphSchema_K2::PC_Object)
+	{
+		OutType = GetObjectType(Cast<UClass>(PinType.PinSubCategoryObject.Get()));
+	}
+	else
+	{
+		return false;
+	}
+
+	return true;
+}
+
+bool FACFNativeCodeGenerator::GetCppType(const FProperty* Property, FString& OutType)
+{
+	if (Property->IsA<FBoolProperty>())
+	{
+		OutType = TEXT("bool");
+	}
+	else if (Property->IsA<FIntProperty>())
+	{
+		OutType = TEXT("int32");
+	}
+	else if (Property->IsA<FInt64Property>())
+	{
+		OutType = TEXT("int64");
+	}
+	else if (const FByteProperty* ByteProperty = CastField<FByteProperty>(Property))
+	{
+		if (ByteProperty->Enum != nullptr)
+		{
+			return false;
+		}
+		OutType = TEXT("uint8");
+	}
+	else if (Property->IsA<FFloatProperty>())
+	{
+		OutType = TEXT("float");
+	}
+	else if (Property->IsA<FDoubleProperty>())
+	{
+		OutType = TEXT("double");
+	}
+	else if (Property->IsA<FNameProperty>())
+	{
+		OutType = TEXT("FName");
+	}
+	else if (Property->IsA<FStrProperty>())
+	{
+		OutType = TEXT("FString");
+	}
+	else if (const FObjectProperty* ObjectProperty = CastField<FObjectProperty>(Property))
+	{
+		OutType = GetObjectType(ObjectProperty->PropertyClass);
+	}
+	else
+	{
+		return false;
+	}
+
+	return true;
+}
+
+bool FACFNativeCodeGenerator::GetProcessEventParamType(const FProperty* Property, FString& OutType)
+{
+	// Enumerations and objects are passed through their underlying representation.
+	if (Property->IsA<FObjectPropertyBase>())
+	{
+		OutType = TEXT("UObject*");
+		return true;
+	}
+	if (Property->IsA<FByteProperty>())
+	{
+		OutType = TEXT("uint8");
+		return true;
+	}
+	if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+	{
+		if (!EnumProperty->GetUnderlyingProperty()->IsA<FByteProperty>())
+		{
+			return false;
+		}
+		OutType = TEXT("uint8");
+		return true;
+	}
+
+	return GetCppType(Property, OutType);
+}
+
+FString FACFNativeCodeGenerator::ConvertExpression(const FExpression& Expression, const FString& Type) const
+{
+	if (Expression.Type == Type)
+	{
+		return Expression.Code;
+	}
+	if (Type.EndsWith(TEXT("*")))
+	{
+		if (Type == TEXT("UObject*"))
+		{
+			return FString::Printf(TEXT("static_cast<UObject*>(%s)"), *Expression.Code);
+		}
+		return FString::Printf(TEXT("Cast<%s>(%s)"), *Type.LeftChop(1), *Expression.Code);
+	}
+
+	return FString::Printf(TEXT("static_cast<%s>(%s)"), *Type, *Expression.Code);
+}
+
+bool FACFNativeCodeGenerator::TranslateLiteral(const UEdGraphPin* Pin, const FString& Type, FExpression& OutExpression)
+{
+	const FString DefaultValue = Pin->GetDefaultAsString();
+	OutExpression.Type = Type;
+
+	if (Type == TEXT("bool"))
+	{
+		OutExpression.Code = DefaultValue.ToBool() ? TEXT("true") : TEXT("false");
+	}
+	else if ((Type == TEXT("int32")) || (Type == TEXT("int64")) || (Type == TEXT("uint8")))
+	{
+		int64 Value = FCString::Atoi64(*DefaultValue);
+		if (const UEnum* Enum = Cast<UEnum>(Pin->PinType.PinSubCategoryObject.Get()))
+		{
+			Value = FMath::Max<int64>(Enum->GetValueByNameString(DefaultValue), 0);
+		}
+		OutExpression.Code = (Type == TEXT("int64")) ? FString::Printf(TEXT("%lldLL"), Value) : FString::Printf(TEXT("%lld"), Value);
+		if (Type == TEXT("uint8"))
+		{
+			OutExpression.Code = FString::Printf(TEXT("static_cast<uint8>(%s)"), *OutExpression.Code);
+		}
+	}
+	else if ((Type == TEXT("float")) || (Type == TEXT("double")))
+	{
+		OutExpression.Code = MakeFloatLiteral(FCString::Atod(*DefaultValue), Type == TEXT("float"));
+	}
+	else if (Type == TEXT("FName"))
+	{
+		OutExpression.Code = FString::Printf(TEXT("FName(%s)"), *MakeStringLiteral(DefaultValue));
+	}
+	else if (Type == TEXT("FString"))
+	{
+		OutExpression.Code = FString::Printf(TEXT("FString(%s)"), *MakeStringLiteral(DefaultValue));
+	}
+	else if (Type.EndsWith(TEXT("*")))
+	{
+		// Hidden object pins are the self or world context pins.
+		FExpression ObjectExpression;
+		ObjectExpression.Type = TEXT("UObject*");
+		if (Pin->DefaultObject != nullptr)
+		{
+			ObjectExpression.Code =
+				FString::Printf(TEXT("LoadObject<UObject>(nullptr, %s)"), *MakeStringLiteral(Pin->DefaultObject->GetPathName()));
+		}
+		else if (Pin->bHidden || (Pin->PinName == UEdGraphSchema_K2::PN_Self))
+		{
+			ObjectExpression.Code = TEXT("Self");
+		}
+		else
+		{
+			ObjectExpression.Code = TEXT("nullptr");
+			ObjectExpression.Type = Type;
+		}
+		OutExpression.Code = ConvertExpression(ObjectExpression, Type);
+	}
+	else
+	{
+		ErrorMessage = FString::Printf(TEXT("Unsupported default value on pin '%s'"), *Pin->PinName.ToString());
+		return false;
+	}
+
+	return true;
+}
+
+bool FACFNativeCodeGenerator::TranslateInputPin(const UEdGraphPin* InputPin, const FString& Type, FExpression& OutExpression)
+{
+	if (InputPin->LinkedTo.Num() == 0)
+	{
+		return TranslateLiteral(InputPin, Type, OutExpression);
+	}
+
+	FExpression Expression;
+	if (!TranslateOutputPin(InputPin->LinkedTo[0], Expression))
+	{
+		return false;
+	}
+	OutExpression.Code = ConvertExpression(Expression, Type);
+	OutExpression.Type = Type;
+
+	return true;
+}
+
+bool FACFNativeCodeGenerator::TranslateTargetPin(const UEdGraphPin* TargetPin, FExpression& OutExpression)
+{
+	if ((TargetPin == nullptr) || (TargetPin->LinkedTo.Num() == 0))
+	{
+		OutExpression.Code = TEXT("Self");
+		OutExpression.Type = TEXT("UObject*");
+		return true;
+	}
+
+	return TranslateInputPin(TargetPin, TEXT("UObject*"), OutExpression);
+}
+
+bool FACFNativeCodeGenerator::TranslateOutputPin(const UEdGraphPin* OutputPin, FExpression& OutExpression)
+{
+	UEdGraphNode* SourceNode = OutputPin->GetOwningNode();
+
+	if (UK2Node_Knot* Knot = Cast<UK2Node_Knot>(SourceNode))
+	{
+		UEdGraphPin* KnotInputPin = Knot->GetInputPin();
+		if (KnotInputPin->LinkedTo.Num() == 0)
+		{
+			ErrorMessage = TEXT("Reroute node is not connected");
+			return false;
+		}
+		return TranslateOutputPin(KnotInputPin->LinkedTo[0], OutExpression);
+	}
+
+	if (SourceNode->IsA<UK2Node_Self>())
+	{
+		OutExpression.Code = TEXT("Self");
+		OutExpression.Type = TEXT("UObject*");
+		return true;
+	}
+
+	if (UK2Node_VariableGet* VariableGet = Cast<UK2Node_VariableGet>(SourceNode))
+	{
+		if (VariableGet->VariableReference.IsLocalScope())
+		{
+			ErrorMessage = FString::Printf(TEXT("Local variable '%s' is not supported"), *VariableGet->GetVarNameString());
+			return false;
+		}
+
+		FExpression Target;
+		if (!TranslateTargetPin(VariableGet->FindPin(UEdGraphSchema_K2::PN_Self), Target))
+		{
+			return false;
+		}
+
+		FString Type;
+		if (!GetCppType(OutputPin->PinType, Type))
+		{
+			ErrorMessage = FString::Printf(TEXT("Type of variable '%s' is not supported"), *VariableGet->GetVarNameString());
+			return false;
+		}
+		if (Type.EndsWith(TEXT("*")))
+		{
+			Type = TEXT("UObject*");
+		}
+
+		OutExpression.Code = FString::Printf(TEXT("%s_Private::GetVariable<%s>(%s, %s)"), *BaseName, *Type, *Target.Code,
+			*MakeStringLiteral(VariableGet->GetVarName().ToString()));
+		OutExpression.Type = Type;
+		return true;
+	}
+
+	if (UK2Node_CallFunction* CallFunction = Cast<UK2Node_CallFunction>(SourceNode))
+	{
+		if (!CallFunction->IsNodePure())
+		{
+			ErrorMessage = FString::Printf(
+				TEXT("Impure function '%s' is not supported"), *CallFunction->GetNodeTitle(ENodeTitleType::ListView).ToString());
+			return false;
+		}
+		return TranslateFunctionCall(CallFunction, OutputPin, OutExpression);
+	}
+
+	ErrorMessage = FString::Printf(TEXT("Unsupported node '%s'"), *SourceNode->GetNodeTitle(ENodeTitleType::ListView).ToString());
+
+	return false;
+}
+
+bool FACFNativeCodeGenerator::CanCallDirectly(const UFunction* Function)
+{
+	const UClass* OwnerClass = Function->GetOuterUClass();
+	if (!Function->HasAllFunctionFlags(FUNC_Static | FUNC_Native) || Function->HasMetaData(TEXT("CustomThunk")) ||
+		!OwnerClass->HasAnyClassFlags(CLASS_Native) || OwnerClass->GetMetaData(TEXT("IncludePath")).IsEmpty())
+	{
+		return false;
+	}
+
+	for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+	{
+		if (It->HasAnyPropertyFlags(CPF_OutParm) && !It->HasAnyPropertyFlags(CPF_ReturnParm) &&
+			!It->HasAllPropertyFlags(CPF_ReferenceParm | CPF_ConstParm))
+		{
+			return false;
+		}
+
+		FString Type;
+		if (!GetCppType(*It, Type))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FACFNativeCodeGenerator::TranslateFunctionCall(
+	const UK2Node_CallFunction* CallFunction, const UEdGraphPin* OutputPin, FExpression& OutExpression)
+{
+	UFunction* Function = CallFunction->GetTargetFunction();
+	if (Function == nullptr)
+	{
+		ErrorMessage = FString::Printf(
+			TEXT("Failed to resolve function of '%s'"), *CallFunction->GetNodeTitle(ENodeTitleType::ListView).ToString());
+		return false;
+	}
+
+	const FProperty* ResultProperty = Function->FindPropertyByName(OutputPin->PinName);
+	const bool bDirectCall = CanCallDirectly(Function) && (ResultProperty != nullptr) && ResultProperty->HasAnyPropertyFlags(CPF_ReturnParm);
+
+	TArray<FProperty*> InputParams;
+	for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+	{
+		if (!It->HasAnyPropertyFlags(CPF_OutParm) || It->HasAnyPropertyFlags(CPF_ReferenceParm))
+		{
+			InputParams.Add(*It);
+		}
+	}
+
+	// Additional pins of the commutative associative operators (e.g. AND with 3 or more inputs) are folded.
+	TArray<UEdGraphPin*> AdditionalInputPins;
+	for (UEdGraphPin* Pin : CallFunction->Pins)
+	{
+		if ((Pin->Direction == EGPD_Input) && (Pin->PinType.PinCategory != UEdGraphSchema_K2::PC_Exec) &&
+			(Pin->PinName != UEdGraphSchema_K2::PN_Self) && (Function->FindPropertyByName(Pin->PinName) == nullptr))
+		{
+			AdditionalInputPins.Add(Pin);
+		}
+	}
+
+	FString ResultType;
+	if ((ResultProperty == nullptr) || ((AdditionalInputPins.Num() > 0) && (InputParams.Num() < 2)) ||
+		!(bDirectCall ? GetCppType(ResultProperty, ResultType) : GetProcessEventParamType(ResultProperty, ResultType)))
+	{
+		ErrorMessage = FString::Printf(
+			TEXT("Unsupported function call '%s'"), *CallFunction->GetNodeTitle(ENodeTitleType::ListView).ToString());
+		return false;
+	}
+
+	TArray<FExpression> Arguments;
+	for (FProperty* Param : InputParams)
+	{
+		FString ParamType;
+		if (!(bDirectCall ? GetCppType(Param, ParamType) : GetProcessEventParamType(Param, ParamType)))
+		{
+			ErrorMessage = FString::Printf(TEXT("Type of parameter '%s' of '%s' is not supported"), *Param->GetName(),
+				*CallFunction->GetNodeTitle(ENodeTitleType::ListView).ToString());
+			return false;
+		}
+
+		FExpression Argument;
+		UEdGraphPin* ParamPin = CallFunction->FindPin(Param->GetFName(), EGPD_Input);
+		if (ParamPin != nullptr)
+		{
+			if (!TranslateInputPin(ParamPin, ParamType, Argument))
+			{
+				return false;
+			}
+		}
+		else if (ParamType.EndsWith(TEXT("*")))
+		{
+			// World context pin is removed from the node when the owner has the world.
+			Argument.Code = ConvertExpression({TEXT("Self"), TEXT("UObject*")}, ParamType);
+			Argument.Type = ParamType;
+		}
+		else
+		{
+			ErrorMessage = FString::Printf(TEXT("Pin of parameter '%s' is not found"), *Param->GetName());
+			return false;
+		}
+		Arguments.Add(Argument);
+	}
+
+	auto MakeDirectCall = [&](const TArray<FExpression>& Args) -> FString {
+		TArray<FString> ArgCodes;
+		for (const FExpression& Arg : Args)
+		{
+			ArgCodes.Add(Arg.Code);
+		}
+		const UClass* OwnerClass = Function->GetOuterUClass();
+		return FString::Printf(TEXT("%s%s::%s(%s)"), OwnerClass->GetPrefixCPP(), *OwnerClass->GetName(), *Function->GetName(),
+			*FString::Join(ArgCodes, TEXT(", ")));
+	};
+
+	FString Target;
+	if (bDirectCall)
+	{
+		Includes.Add(Function->GetOuterUClass()->GetMetaData(TEXT("IncludePath")));
+	}
+	else if (Function->HasAnyFunctionFlags(FUNC_Static))
+	{
+		Target = FString::Printf(TEXT("%s_Private::GetClassDefaultObject(%s)"), *BaseName,
+			*MakeStringLiteral(Function->GetOuterUClass()->GetPathName()));
+	}
+	else
+	{
+		FExpression TargetExpression;
+		if (!TranslateTargetPin(CallFunction->FindPin(UEdGraphSchema_K2::PN_Self), TargetExpression))
+		{
+			return false;
+		}
+		Target = TargetExpression.Code;
+	}
+
+	auto MakeProcessEventCall = [&](const TArray<FExpression>& Args) -> FString {
+		FString Code = FString::Printf(
+			TEXT("%s_Private::FProcessEventCall(%s, %s)"), *BaseName, *Target, *MakeStringLiteral(Function->GetName()));
+		for (int32 Index = 0; Index < Args.Num(); ++Index)
+		{
+			Code += FString::Printf(TEXT(".Set(%s, %s)"), *MakeStringLiteral(InputParams[Index]->GetName()), *Args[Index].Code);
+		}
+		return Code + FString::Printf(TEXT(".Call<%s>(%s)"), *ResultType, *MakeStringLiteral(ResultProperty->GetName()));
+	};
+
+	OutExpression.Code = bDirectCall ? MakeDirectCall(Arguments) : MakeProcessEventCall(Arguments);
+	OutExpression.Type = ResultType;
+
+	for (UEdGraphPin* AdditionalInputPin : AdditionalInputPins)
+	{
+		FString SecondParamType = Arguments[1].Type;
+		if (!TranslateInputPin(AdditionalInputPin, SecondParamType, Arguments[1]))
+		{
+			return false;
+		}
+		Arguments[0].Code = ConvertExpression(OutExpression, Arguments[0].Type);
+		OutExpression.Code = bDirectCall ? MakeDirectCall(Arguments) : MakeProcessEventCall(Arguments);
+	}
+
+	return true;
+}
+
+bool FACFNativeCodeGenerator::GenerateMultiBranch(
+	FString& OutTypes, FString& OutDeclarations, FString& OutDefinitions, FString& OutNativeTest)
+{
+	const UK2Node_MultiBranch* MultiBranch = CastChecked<UK2Node_MultiBranch>(Node);
+	TArray<UEdGraphPin*> CondPins = MultiBranch->GetCaseConditionPins();
+	const FString ClassName = TEXT("U") + BaseName;
+	const FString EnumName = TEXT("E") + BaseName + TEXT("Exec");
+
+	OutTypes += TEXT("UENUM(BlueprintType)\n");
+	OutTypes += FString::Printf(TEXT("enum class %s : uint8\n{\n"), *EnumName);
+	for (int32 Index = 0; Index < CondPins.Num(); ++Index)
+	{
+		OutTypes += FString::Printf(TEXT("\tCase%d,\n"), Index);
+	}
+	OutTypes += TEXT("\tDefault\n};\n\n");
+
+	OutDeclarations += TEXT("\tUFUNCTION(BlueprintCallable, Category = \"AdvancedControlFlow|Generated\",\n");
+	OutDeclarations += TEXT("\t\tmeta = (DefaultToSelf = \"Self\", ExpandEnumAsExecs = \"Branches\"))\n");
+	OutDeclarations += FString::Printf(TEXT("\tstatic void Evaluate(UObject* Self, %s& Branches);\n\n"), *EnumName);
+	OutDeclarations += TEXT("\t// Index of the case to be executed, or INDEX_NONE for the default.\n");
+	OutDeclarations += TEXT("\tUFUNCTION(BlueprintPure, Category = \"AdvancedControlFlow|Generated\", meta = (DefaultToSelf = \"Self\"))\n");
+	OutDeclarations += TEXT("\tstatic int32 EvaluateCaseIndex(UObject* Self);\n");
+
+	OutDefinitions += FString::Printf(TEXT("int32 %s::EvaluateCaseIndex(UObject* Self)\n{\n"), *ClassName);
+	for (int32 Index = 0; Index < CondPins.Num(); ++Index)
+	{
+		// The case whose execution pin is not connected is never taken.
+		if (MultiBranch->GetCaseValuePinFromCaseKeyPin(CondPins[Index])->LinkedTo.Num() == 0)
+		{
+			continue;
+		}
+
+		FExpression Condition;
+		if (!TranslateInputPin(CondPins[Index], TEXT("bool"), Condition))
+		{
+			return false;
+		}
+		OutDefinitions += FString::Printf(TEXT("\tif (%s)\n\t{\n\t\treturn %d;\n\t}\n"), *Condition.Code, Index);
+	}
+	OutDefinitions += TEXT("\n\treturn INDEX_NONE;\n}\n\n");
+
+	OutDefinitions += FString::Printf(TEXT("void %s::Evaluate(UObject* Self, %s& Branches)\n{\n"), *ClassName, *EnumName);
+	OutDefinitions += TEXT("\tconst int32 CaseIndex = EvaluateCaseIndex(Self);\n");
+	OutDefinitions +=
+		FString::Printf(TEXT("\tBranches = (CaseIndex == INDEX_NONE) ? %s::Default : static_cast<%s>(CaseIndex);\n}\n"), *EnumName,
+			*EnumName);
+
+	OutNativeTest += FString::Printf(TEXT("TArray<bool> CaseHits;\nCaseHits.Init(false, %d);\n"), CondPins.Num());
+	OutNativeTest += FString::Printf(TEXT("const int32 CaseIndex = %s::EvaluateCaseIndex(Self);\n"), *ClassName);
+	OutNativeTest += TEXT("if (CaseIndex != INDEX_NONE)\n{\n\tCaseHits[CaseIndex] = true;\n}\nreturn CaseHits;\n");
+
+	return true;
+}
+
+bool FACFNativeCodeGenerator::GenerateConditionalSequence(
+	FString& OutTypes, FString& OutDeclarations, FString& OutDefinitions, FString& OutNativeTest)
+{
+	TArray<UEdGraphPin*> CondPins = Node->GetCaseConditionPins();
+	const FString ClassName = TEXT("U") + BaseName;
+
+	TArray<FString> Params;
+	TArray<FString> Args;
+	for (int32 Index = 0; Index < CondPins.Num(); ++Index)
+	{
+		Params.Add(FString::Printf(TEXT("bool& bCase%d"), Index));
+		Args.Add(FString::Printf(TEXT("bCase%d"), Index));
+	}
+	const FString ParamList = Params.Num() > 0 ? TEXT(", ") + FString::Join(Params, TEXT(", ")) : FString();
+
+	OutDeclarations += TEXT("\t// Conditions of the cases. All cases whose condition is true are executed in order.\n");
+	OutDeclarations += TEXT("\tUFUNCTION(BlueprintPure, Category = \"AdvancedControlFlow|Generated\", meta = (DefaultToSelf = \"Self\"))\n");
+	OutDeclarations += FString::Printf(TEXT("\tstatic void Evaluate(UObject* Self%s);\n"), *ParamList);
+
+	OutDefinitions += FString::Printf(TEXT("void %s::Evaluate(UObject* Self%s)\n{\n"), *ClassName, *ParamList);
+	for (int32 Index = 0; Index < CondPins.Num(); ++Index)
+	{
+		FExpression Condition;
+		if (!TranslateInputPin(CondPins[Index], TEXT("bool"), Condition))
+		{
+			return false;
+		}
+		OutDefinitions += FString::Printf(TEXT("\tbCase%d = %s;\n"), Index, *Condition.Code);
+	}
+	OutDefinitions += TEXT("}\n");
+
+	for (const FString& Arg : Args)
+	{
+		OutNativeTest += FString::Printf(TEXT("bool %s = false;\n"), *Arg);
+	}
+	OutNativeTest += FString::Printf(TEXT("%s::Evaluate(Self%s%s);\n"), *ClassName, Args.Num() > 0 ? TEXT(", ") : TEXT(""),
+		*FString::Join(Args, TEXT(", ")));
+	OutNativeTest += FString::Printf(TEXT("return TArray<bool>({%s});\n"), *FString::Join(Args, TEXT(", ")));
+
+	return true;
+}
+
+bool FACFNativeCodeGenerator::GenerateMultiConditionalSelect(
+	FString& OutTypes, FString& OutDeclarations, FString& OutDefinitions, FString& OutNativeTest)
+{
+	const UK2Node_MultiConditionalSelect* MultiConditionalSelect = CastChecked<UK2Node_MultiConditionalSelect>(Node);
+	TArray<UEdGraphPin*> CondPins = MultiConditionalSelect->GetCaseConditionPins();
+	const FString ClassName = TEXT("U") + BaseName;
+
+	FString ReturnType;
+	if (!GetCppType(MultiConditionalSelect->GetReturnValuePin()->PinType, ReturnType))
+	{
+		ErrorMessage = TEXT("Type of the options is not supported");
+		return false;
+	}
+	if (ReturnType.EndsWith(TEXT("*")) && (ReturnType != TEXT("UObject*")))
+	{
+		OutTypes += FString::Printf(TEXT("class %s;\n\n"), *ReturnType.LeftChop(1));
+	}
+
+	OutDeclarations += TEXT("\tUFUNCTION(BlueprintPure, Category = \"AdvancedControlFlow|Generated\", meta = (DefaultToSelf = \"Self\"))\n");
+	OutDeclarations += FString::Printf(TEXT("\tstatic %s Evaluate(UObject* Self);\n\n"), *ReturnType);
+	OutDeclarations += TEXT("\t// Index of the selected option, or INDEX_NONE for the default.\n");
+	OutDeclarations += TEXT("\tUFUNCTION(BlueprintPure, Category = \"AdvancedControlFlow|Generated\", meta = (DefaultToSelf = \"Self\"))\n");
+	OutDeclarations += TEXT("\tstatic int32 EvaluateCaseIndex(UObject* Self);\n");
+
+	OutDefinitions += FString::Printf(TEXT("int32 %s::EvaluateCaseIndex(UObject* Self)\n{\n"), *ClassName);
+	for (int32 Index = 0; Index < CondPins.Num(); ++Index)
+	{
+		FExpression Condition;
+		if (!TranslateInputPin(CondPins[Index], TEXT("bool"), Condition))
+		{
+			return false;
+		}
+		OutDefinitions += FString::Printf(TEXT("\tif (%s)\n\t{\n\t\treturn %d;\n\t}\n"), *Condition.Code, Index);
+	}
+	OutDefinitions += TEXT("\n\treturn INDEX_NONE;\n}\n\n");
+
+	OutDefinitions += FString::Printf(TEXT("%s %s::Evaluate(UObject* Self)\n{\n"), *ReturnType, *ClassName);
+	OutDefinitions += TEXT("\tswitch (EvaluateCaseIndex(Self))\n\t{\n");
+	for (int32 Index = 0; Index < CondPins.Num(); ++Index)
+	{
+		FExpression Option;
+		if (!TranslateInputPin(MultiConditionalSelect->GetCaseKeyPinFromCaseValuePin(CondPins[Index]), ReturnType, Option))
+		{
+			return false;
+		}
+		OutDefinitions += FString::Printf(TEXT("\t\tcase %d:\n\t\t\treturn %s;\n"), Index, *Option.Code);
+	}
+	OutDefinitions += TEXT("\t\tdefault:\n\t\t\tbreak;\n\t}\n\n");
+
+	FExpression DefaultOption;
+	if (!TranslateInputPin(MultiConditionalSelect->GetDefaultOptionPin(), ReturnType, DefaultOption))
+	{
+		return false;
+	}
+	OutDefinitions += FString::Printf(TEXT("\treturn %s;\n}\n"), *DefaultOption.Code);
+
+	OutNativeTest += FString::Printf(TEXT("*static_cast<%s*>(OutValue) = %s::Evaluate(Self);\n"), *ReturnType, *ClassName);
+
+	return true;
+}
+
+bool FACFNativeCodeGenerator::Generate(FString& OutHeader, FString& OutSource)
+{
+	Includes.Empty();
+	ErrorMessage.Empty();
+
+	FString Types;
+	FString Declarations;
+	FString Definitions;
+	FString NativeTest;
+	bool bSucceeded = false;
+	if (Node->IsA<UK2Node_MultiBranch>())
+	{
+		bSucceeded = GenerateMultiBranch(Types, Declarations, Definitions, NativeTest);
+	}
+	else if (Node->IsA<UK2Node_ConditionalSequence>())
+	{
+		bSucceeded = GenerateConditionalSequence(Types, Declarations, Definitions, NativeTest);
+	}
+	else if (Node->IsA<UK2Node_MultiConditionalSelect>())
+	{
+		bSucceeded = GenerateMultiConditionalSelect(Types, Declarations, Definitions, NativeTest);
+	}
+	else
+	{
+		ErrorMessage = TEXT("Node is not supported");
+	}
+	if (!bSucceeded)
+	{
+		return false;
+	}
+
+	const FString BlueprintPath = Node->GetBlueprint()->GetPathName();
+	const FString Banner = FString::Printf(
+		TEXT("// Generated by Advanced Control Flow from '%s' in %s.\n// Regenerate the code instead of editing it by hand.\n\n"),
+		*Node->GetNodeTitle(ENodeTitleType::ListView).ToString(), *BlueprintPath);
+
+	OutHeader = Banner;
+	OutHeader += TEXT("#pragma once\n\n");
+	OutHeader += TEXT("#include \"CoreMinimal.h\"\n#include \"Kismet/BlueprintFunctionLibrary.h\"\n\n");
+	OutHeader += FString::Printf(TEXT("#include \"%s.generated.h\"\n\n"), *BaseName);
+	OutHeader += Types;
+	OutHeader += TEXT("UCLASS()\n");
+	OutHeader += FString::Printf(TEXT("class %s U%s : public UBlueprintFunctionLibrary\n{\n"), *ApiMacro, *BaseName);
+	OutHeader += TEXT("\tGENERATED_BODY()\n\npublic:\n");
+	OutHeader += Declarations;
+	OutHeader += TEXT("};\n");
+
+	TArray<FString> SortedIncludes = Includes.Array();
+	SortedIncludes.Sort();
+
+	OutSource = Banner;
+	OutSource += FString::Printf(TEXT("#include \"%s.h\"\n\n"), *BaseName);
+	for (const FString& Include : SortedIncludes)
+	{
+		OutSource += FString::Printf(TEXT("#include \"%s\"\n"), *Include);
+	}
+	OutSource += SortedIncludes.Num() > 0 ? TEXT("\n") : TEXT("");
+	OutSource += FString::Printf(TEXT("namespace %s_Private\n{%s}  // namespace %s_Private\n\n"), *BaseName, GeneratedHelperCode, *BaseName);
+	OutSource += Definitions;
+
+	const FGuid& Guid = Node->NodeGuid;
+	// The test is compiled only when the project module depends on AdvancedControlFlow, which defines ACF_DIFFERENTIAL_TEST.
+	OutSource += TEXT("\n#if WITH_DEV_AUTOMATION_TESTS && defined(ACF_DIFFERENTIAL_TEST)\n\n");
+	OutSource += TEXT("#include \"ACFDifferentialTest.h\"\n#include \"Misc/AutomationTest.h\"\n\n");
+	OutSource += FString::Printf(TEXT("IMPLEMENT_SIMPLE_AUTOMATION_TEST(F%sDifferentialTest, \"AdvancedControlFlow.Generated.%s\",\n"),
+		*BaseName, *BaseName);
+	OutSource += TEXT("\tEAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)\n\n");
+	OutSource += FString::Printf(TEXT("bool F%sDifferentialTest::RunTest(const FString& Parameters)\n{\n"), *BaseName);
+	const bool bSelect = Node->IsA<UK2Node_MultiConditionalSelect>();
+	OutSource += FString::Printf(TEXT("\treturn FACFDifferentialTest::%s(*this, %s, FGuid(0x%08X, 0x%08X, 0x%08X, 0x%08X),\n"),
+		bSelect ? TEXT("RunSelectTest") : TEXT("RunCaseHitsTest"), *MakeStringLiteral(BlueprintPath), Guid.A, Guid.B, Guid.C,
+		Guid.D);
+	OutSource += bSelect ? TEXT("\t\t[](UObject* Self, void* OutValue)\n\t\t{\n") : TEXT("\t\t[](UObject* Self)\n\t\t{\n");
+	OutSource += IndentLines(NativeTest, 3);
+	OutSource += TEXT("\t\t});\n}\n\n#endif\n");
+
+	return true;
+}
+
+bool FACFNativeCodeGenerator::Export(FString& OutHeaderFilePath)
+{
+	FString Header;
+	FString Source;
+	if (!Generate(Header, Source))
+	{
+		return false;
+	}
+
+	const FString OutputDir = FPaths::GameSourceDir() / FApp::GetProjectName() / TEXT("ACFGenerated");
+	OutHeaderFilePath = OutputDir / BaseName + TEXT(".h");
+	const FString SourceFilePath = OutputDir / BaseName + TEXT(".cpp");
+
+	if (!FFileHelper::SaveStringToFile(Header, *OutHeaderFilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM) ||
+		!FFileHelper::SaveStringToFile(Source, *SourceFilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		ErrorMessage = FString::Printf(TEXT("Failed to write %s"), *OutputDir);
+		return false;
+	}
+
+	return true;
+}
@@ -9,10 +9,16 @@
 
 #include "AdvancedControlFlowModule.h"
 
+#include "ACFCaseHitCounters.h"
+#include "ACFCaseProfile.h"
+#include "AdvancedControlFlowSettings.h"
 #include "EdGraphUtilities.h"
+#include "Editor.h"
+#include "K2Node_CasePairedPinsNode.h"
 #include "K2Node_ConditionalSequence.h"
 #include "K2Node_MultiBranch.h"
 #include "K2Node_MultiConditionalSelect.h"
+#include "SGraphNodeCasePairedPinsNode.h"
 #include "SGraphNodeConditionalSequence.h"
 #include "SGraphNodeMultiBranch.h"
 #include "SGraphNodeMultiConditionalSelect.h"
@@ -35,6 +41,10 @@ class FGraphPanelNodeFactory_AdvancedControlFlow : public FGraphPanelNodeFactory
 		{
 			return SNew(SGraphNodeMultiConditionalSelect, MultiConditionalSelect);
 		}
+		else if (UK2Node_CasePairedPinsNode* CasePairedPinsNode = Cast<UK2Node_CasePairedPinsNode>(Node))
+		{
+			return SNew(SGraphNodeCasePairedPinsNode, CasePairedPinsNode);
+		}
 
 		return nullptr;
 	}
@@ -44,10 +54,27 @@ void FAdvancedControlFlowModule::StartupModule()
 {
 	GraphPanelNodeFactory_AdvancedControlFlow = MakeShareable(new FGraphPanelNodeFactory_AdvancedControlFlow());
 	FEdGraphUtilities::RegisterVisualNodeFactory(GraphPanelNodeFactory_AdvancedControlFlow);
+
+	FACFCaseProfile::Get().Load();
+	BeginPIEHandle = FEditorDelegates::BeginPIE.AddLambda([](bool bIsSimulating) { FACFCaseHitCounters::Get().Reset(); });
+	EndPIEHandle = FEditorDelegates::EndPIE.AddLambda(
+		[](bool bIsSimulating)
+		{
+			// The counters are kept until the next PIE session to show them on the nodes.
+			if (GetDefault<UAdvancedControlFlowSettings>()->bRecordCaseProfile)
+			{
+				FACFCaseProfile::Get().CollectCaseHits();
+			}
+			FACFCaseProfile::Get().Save();
+		});
 }
 
 void FAdvancedControlFlowModule::ShutdownModule()
 {
+	FEditorDelegates::BeginPIE.Remove(BeginPIEHandle);
+	FEditorDelegates::EndPIE.Remove(EndPIEHandle);
+	FACFCaseProfile::Get().Save();
+
 	if (GraphPanelNodeFactory_AdvancedControlFlow.IsValid())
 	{
 		FEdGraphUtilities::UnregisterVisualNodeFactory(GraphPanelNodeFactory_AdvancedControlFlow);
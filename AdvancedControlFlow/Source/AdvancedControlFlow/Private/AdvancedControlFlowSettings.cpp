@@ -0,0 +1,22 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowSettings.h"
+
+UAdvancedControlFlowSettings::UAdvancedControlFlowSettings(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	bRecordCaseProfile = false;
+	bCountCaseHits = false;
+	bEmitTraceEvents = false;
+}
+
+FName UAdvancedControlFlowSettings::GetCategoryName() const
+{
+	return TEXT("Plugins");
+}
@@ -0,0 +1,210 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "AnimGraphNode_BlendListByFirstTrue.h"
+
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "ScopedTransaction.h"
+#include "ToolMenu.h"
+
+#define LOCTEXT_NAMESPACE "AdvancedControlFlow"
+
+static const FString ConditionsPinPrefix(TEXT("Conditions_"));
+static const FString BlendPosePinPrefix(TEXT("BlendPose_"));
+static const FString BlendTimePinPrefix(TEXT("BlendTime_"));
+
+// Array pins of the anim node are named by the property name and the array index.
+static bool ParseArrayPinName(const FString& PinName, const FString& Prefix, int32& OutArrayIndex)
+{
+	if (!PinName.StartsWith(Prefix))
+	{
+		return false;
+	}
+	const FString Index = PinName.RightChop(Prefix.Len());
+	if (!Index.IsNumeric())
+	{
+		return false;
+	}
+	OutArrayIndex = FCString::Atoi(*Index);
+	return true;
+}
+
+UAnimGraphNode_BlendListByFirstTrue::UAnimGraphNode_BlendListByFirstTrue(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	RemovedCaseIndex = INDEX_NONE;
+
+	// Default pose and 2 cases.
+	Node.AddPose();
+	Node.AddCase();
+	Node.AddCase();
+}
+
+FText UAnimGraphNode_BlendListByFirstTrue::GetTooltipText() const
+{
+	return LOCTEXT("BlendListByFirstTrue_Tooltip",
+		"Blend Poses by First True Condition\nBlends to the pose whose condition is true first, or to the default pose");
+}
+
+FText UAnimGraphNode_BlendListByFirstTrue::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("BlendListByFirstTrue", "Blend Poses by First True Condition");
+}
+
+FString UAnimGraphNode_BlendListByFirstTrue::GetNodeCategory() const
+{
+	return TEXT("Animation|Blends");
+}
+
+void UAnimGraphNode_BlendListByFirstTrue::GetNodeContextMenuActions(
+	class UToolMenu* Menu, class UGraphNodeContextMenuContext* Context) const
+{
+	Super::GetNodeContextMenuActions(Menu, Context);
+
+	if (!Context->bIsDebugging)
+	{
+		FToolMenuSection& Section = Menu->AddSection(
+			"AnimGraphNodeBlendListByFirstTrue", LOCTEXT("BlendListByFirstTrue", "Blend Poses by First True Condition"));
+
+#ifdef ACF_FREE_VERSION
+		if (Node.Conditions.Num() < 3)
+		{
+#endif
+			Section.AddMenuEntry("AddCasePin", LOCTEXT("AddCasePin", "Add case pin"),
+				LOCTEXT("AddCasePinTooltip", "Add case pin at the last of this node"), FSlateIcon(),
+				FUIAction(FExecuteAction::CreateUObject(
+					const_cast<UAnimGraphNode_BlendListByFirstTrue*>(this), &UAnimGraphNode_BlendListByFirstTrue::AddCasePin)));
+#ifdef ACF_FREE_VERSION
+		}
+#endif
+
+		if ((Context->Pin != nullptr) && (GetCaseIndexFromPin(Context->Pin) != INDEX_NONE))
+		{
+			Section.AddMenuEntry("RemoveThisCasePin", LOCTEXT("RemoveThisCasePin", "Remove this case pin"),
+				LOCTEXT("RemoveThisCasePinTooltip", "Remove this case pin on this node"), FSlateIcon(),
+				FUIAction(FExecuteAction::CreateUObject(const_cast<UAnimGraphNode_BlendListByFirstTrue*>(this),
+					&UAnimGraphNode_BlendListByFirstTrue::RemoveCasePin, const_cast<UEdGraphPin*>(Context->Pin))));
+		}
+	}
+}
+
+void UAnimGraphNode_BlendListByFirstTrue::ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins)
+{
+	// The old pins are matched with the new pins by the name, so shift the array index of the pins after the removed case.
+	if (RemovedCaseIndex != INDEX_NONE)
+	{
+		for (UEdGraphPin* OldPin : OldPins)
+		{
+			const FString PinName = OldPin->PinName.ToString();
+			int32 ArrayIndex = INDEX_NONE;
+			const FString* Prefix = nullptr;
+			int32 CaseIndex = INDEX_NONE;
+			if (ParseArrayPinName(PinName, ConditionsPinPrefix, ArrayIndex))
+			{
+				Prefix = &ConditionsPinPrefix;
+				CaseIndex = ArrayIndex;
+			}
+			else if (ParseArrayPinName(PinName, BlendPosePinPrefix, ArrayIndex))
+			{
+				Prefix = &BlendPosePinPrefix;
+				CaseIndex = ArrayIndex - 1;
+			}
+			else if (ParseArrayPinName(PinName, BlendTimePinPrefix, ArrayIndex))
+			{
+				Prefix = &BlendTimePinPrefix;
+				CaseIndex = ArrayIndex - 1;
+			}
+
+			if (CaseIndex == RemovedCaseIndex)
+			{
+				OldPin->PinName = *(*Prefix + TEXT("Removed"));
+				OldPin->bSavePinIfOrphaned = false;
+			}
+			else if (CaseIndex > RemovedCaseIndex)
+			{
+				OldPin->PinName = *(*Prefix + FString::FromInt(ArrayIndex - 1));
+			}
+		}
+		RemovedCaseIndex = INDEX_NONE;
+	}
+
+	Super::ReallocatePinsDuringReconstruction(OldPins);
+}
+
+void UAnimGraphNode_BlendListByFirstTrue::CustomizePinData(UEdGraphPin* Pin, FName SourcePropertyName, int32 ArrayIndex) const
+{
+	Super::CustomizePinData(Pin, SourcePropertyName, ArrayIndex);
+
+	if (ArrayIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (SourcePropertyName == GET_MEMBER_NAME_CHECKED(FAnimNode_BlendListByFirstTrue, Conditions))
+	{
+		Pin->PinFriendlyName = FText::Format(LOCTEXT("ConditionPin", "Condition {0}"), FText::AsNumber(ArrayIndex));
+	}
+	else if (SourcePropertyName == TEXT("BlendPose"))
+	{
+		Pin->PinFriendlyName = (ArrayIndex == 0) ? LOCTEXT("DefaultPosePin", "Default Pose")
+												 : FText::Format(LOCTEXT("PosePin", "Pose {0}"), FText::AsNumber(ArrayIndex - 1));
+	}
+	else if (SourcePropertyName == TEXT("BlendTime"))
+	{
+		Pin->PinFriendlyName = (ArrayIndex == 0)
+								   ? LOCTEXT("DefaultBlendTimePin", "Default Blend Time")
+								   : FText::Format(LOCTEXT("BlendTimePin", "Blend Time {0}"), FText::AsNumber(ArrayIndex - 1));
+	}
+}
+
+void UAnimGraphNode_BlendListByFirstTrue::AddCasePin()
+{
+	FScopedTransaction Transaction(LOCTEXT("AddCasePinTransaction", "Add case pin"));
+	Modify();
+
+	Node.AddCase();
+	ReconstructNode();
+	FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(GetBlueprint());
+}
+
+void UAnimGraphNode_BlendListByFirstTrue::RemoveCasePin(UEdGraphPin* Pin)
+{
+	const int32 CaseIndex = GetCaseIndexFromPin(Pin);
+	if (!Node.Conditions.IsValidIndex(CaseIndex))
+	{
+		return;
+	}
+
+	FScopedTransaction Transaction(LOCTEXT("RemoveCasePinTransaction", "Remove case pin"));
+	Modify();
+
+	Node.RemoveCase(CaseIndex);
+	RemovedCaseIndex = CaseIndex;
+	ReconstructNode();
+	FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(GetBlueprint());
+}
+
+int32 UAnimGraphNode_BlendListByFirstTrue::GetCaseIndexFromPin(const UEdGraphPin* Pin)
+{
+	const FString PinName = Pin->PinName.ToString();
+	int32 ArrayIndex = INDEX_NONE;
+	if (ParseArrayPinName(PinName, ConditionsPinPrefix, ArrayIndex))
+	{
+		return ArrayIndex;
+	}
+	if (ParseArrayPinName(PinName, BlendPosePinPrefix, ArrayIndex) || ParseArrayPinName(PinName, BlendTimePinPrefix, ArrayIndex))
+	{
+		return ArrayIndex - 1;
+	}
+	return INDEX_NONE;
+}
+
+#undef LOCTEXT_NAMESPACE
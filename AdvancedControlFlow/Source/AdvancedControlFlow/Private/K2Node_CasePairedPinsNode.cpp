@@ -11,15 +11,125 @@
 
 #include "K2Node_CasePairedPinsNode.h"
 
+#include "ACFCaseHitCounters.h"
+#include "ACFCaseProfile.h"
+#include "ACFConditionLibrary.h"
+#include "ACFNativeCodeGenerator.h"
+#include "ACFRandomLibrary.h"
+#include "ACFTrace.h"
+#include "AdvancedControlFlowSettings.h"
+#include "Framework/Notifications/NotificationManager.h"
 #include "Internationalization/Regex.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_FunctionEntry.h"
+#include "K2Node_Knot.h"
+#include "K2Node_MakeArray.h"
+#include "K2Node_VariableGet.h"
+#include "Kismet/KismetArrayLibrary.h"
 #include "Kismet2/BlueprintEditorUtils.h"
+#include "KismetCompiler.h"
 #include "ToolMenu.h"
+#include "Widgets/Notifications/SNotificationList.h"
 
 #define LOCTEXT_NAMESPACE "AdvancedControlFlow"
 
 const FName DefaultExecPinName(TEXT("DefaultExec"));
 const FName DefaultExecPinFriendlyName(TEXT("Default"));
 
+// Relative cost of the pure nodes used by the static cost model.
+static const int32 CallFunctionNodeCost = 4;
+static const int32 OtherPureNodeCost = 1;
+
+static int32 EstimatePureSubgraphCost(const UEdGraphPin* InputPin, TSet<const UEdGraphNode*>& VisitedNodes)
+{
+	int32 Cost = 0;
+
+	for (const UEdGraphPin* LinkedPin : InputPin->LinkedTo)
+	{
+		const UK2Node* Node = Cast<UK2Node>(LinkedPin->GetOwningNode());
+		if ((Node == nullptr) || !Node->IsNodePure() || VisitedNodes.Contains(Node))
+		{
+			continue;
+		}
+		VisitedNodes.Add(Node);
+
+		if (Node->IsA<UK2Node_CallFunction>())
+		{
+			Cost += CallFunctionNodeCost;
+		}
+		else if (!Node->IsA<UK2Node_VariableGet>() && !Node->IsA<UK2Node_Knot>())
+		{
+			Cost += OtherPureNodeCost;
+		}
+
+		for (const UEdGraphPin* Pin : Node->Pins)
+		{
+			if (Pin->Direction == EGPD_Input)
+			{
+				Cost += EstimatePureSubgraphCost(Pin, VisitedNodes);
+			}
+		}
+	}
+
+	return Cost;
+}
+
+// Same rule as the thread-safe animation graph. The function or its class is marked, and the function is not opted out.
+static bool IsThreadSafeFunction(const UFunction* Function)
+{
+	if (Function->HasMetaData(TEXT("NotBlueprintThreadSafe")))
+	{
+		return false;
+	}
+	return Function->HasMetaData(TEXT("BlueprintThreadSafe")) ||
+		   Function->GetOwnerClass()->HasMetaData(TEXT("BlueprintThreadSafe"));
+}
+
+// Types whose literal is set from the default value of the pin by ACFParallelLibrary.
+static bool IsParallelLiteralProperty(const FProperty* Property)
+{
+	return Property->IsA<FBoolProperty>() || Property->IsA<FNumericProperty>() || Property->IsA<FEnumProperty>() ||
+		   Property->IsA<FNameProperty>() || Property->IsA<FStrProperty>();
+}
+
+// The upper case is escaped as ACFSwitch::EncodeKeys does, since the conditions are compared as the case-insensitive FName.
+static FString EscapeParallelLiteral(const FString& Literal)
+{
+	FString Escaped;
+	for (TCHAR Char : Literal)
+	{
+		const TCHAR Lower = FChar::ToLower(Char);
+		if ((Char == TEXT('%')) || (Char == TEXT('|')) || (Char == TEXT(',')) || (Char == TEXT('=')) || (Char == TEXT(';')))
+		{
+			Escaped += FString::Printf(TEXT("%%%02X"), Char);
+		}
+		else if ((Char == TEXT('^')) || (Char != Lower))
+		{
+			Escaped.AppendChar(TEXT('^'));
+			Escaped.AppendChar(Lower);
+		}
+		else
+		{
+			Escaped.AppendChar(Char);
+		}
+	}
+	return Escaped;
+}
+
+// Returns the member variable of self read by the pin, or nullptr.
+static const UK2Node_VariableGet* FindMemberVariableGet(const UEdGraphPin* Pin)
+{
+	const UK2Node_VariableGet* VariableGet =
+		(Pin->LinkedTo.Num() == 1) ? Cast<UK2Node_VariableGet>(Pin->LinkedTo[0]->GetOwningNode()) : nullptr;
+	if ((VariableGet == nullptr) || !VariableGet->VariableReference.IsSelfContext() ||
+		VariableGet->VariableReference.IsLocalScope())
+	{
+		return nullptr;
+	}
+	const UEdGraphPin* SelfPin = VariableGet->FindPin(UEdGraphSchema_K2::PN_Self);
+	return ((SelfPin == nullptr) || (SelfPin->LinkedTo.Num() == 0)) ? VariableGet : nullptr;
+}
+
 UK2Node_CasePairedPinsNode::UK2Node_CasePairedPinsNode(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 }
@@ -67,7 +177,37 @@ void UK2Node_CasePairedPinsNode::GetNodeContextMenuActions(class UToolMenu* Menu
 				FUIAction(FExecuteAction::CreateUObject(
 					const_cast<UK2Node_CasePairedPinsNode*>(this), &UK2Node_CasePairedPinsNode::RemoveLastCasePin)));
 		}
+
+		if (FACFNativeCodeGenerator::IsSupportedNode(this))
+		{
+			Section.AddMenuEntry("ExportAsNativeCode", LOCTEXT("ExportAsNativeCode", "Export as C++"),
+				LOCTEXT("ExportAsNativeCodeTooltip",
+					"Generate a Blueprint function library in C++ which evaluates this node and its pure condition graph"),
+				FSlateIcon(),
+				FUIAction(FExecuteAction::CreateUObject(
+					const_cast<UK2Node_CasePairedPinsNode*>(this), &UK2Node_CasePairedPinsNode::ExportAsNativeCode)));
+		}
+	}
+}
+
+void UK2Node_CasePairedPinsNode::ExportAsNativeCode()
+{
+	FACFNativeCodeGenerator Generator(this);
+	FString HeaderFilePath;
+
+	FNotificationInfo Info(FText::GetEmpty());
+	if (Generator.Export(HeaderFilePath))
+	{
+		Info.Text = FText::Format(LOCTEXT("ExportAsNativeCodeSucceeded", "Exported {0}. Regenerate the project files to build it."),
+			FText::FromString(HeaderFilePath));
 	}
+	else
+	{
+		Info.Text = FText::Format(
+			LOCTEXT("ExportAsNativeCodeFailed", "Failed to export as C++: {0}"), FText::FromString(Generator.GetErrorMessage()));
+	}
+	Info.ExpireDuration = 8.0f;
+	FSlateNotificationManager::Get().AddNotification(Info);
 }
 
 void UK2Node_CasePairedPinsNode::ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins)
@@ -128,6 +268,7 @@ void UK2Node_CasePairedPinsNode::AddCasePinAfter(UEdGraphPin* Pin)
 			CaseKeyPin->PinFriendlyName =
 				FText::AsCultureInvariant(GetCasePinFriendlyName(CaseKeyPinFriendlyNamePrefix.ToString(), Index + 1));
 		}
+		RestoreCaseCompanionPins();
 
 		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(GetBlueprint());
 	}
@@ -172,6 +313,7 @@ void UK2Node_CasePairedPinsNode::AddCasePinBefore(UEdGraphPin* Pin)
 			CaseKeyPin->PinFriendlyName =
 				FText::AsCultureInvariant(GetCasePinFriendlyName(CaseKeyPinFriendlyNamePrefix.ToString(), Index + 1));
 		}
+		RestoreCaseCompanionPins();
 
 		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(GetBlueprint());
 	}
@@ -344,6 +486,7 @@ void UK2Node_CasePairedPinsNode::RemoveCasePinAt(int32 CaseIndex)
 			++Index;
 		}
 	}
+	RestoreCaseCompanionPins();
 
 	FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(GetBlueprint());
 }
@@ -446,6 +589,126 @@ UEdGraphPin* UK2Node_CasePairedPinsNode::GetCaseValuePinFromCaseKeyPin(const UEd
 	return FindPin(CaseValuePinNamePrefix.ToString() + Suffix);
 }
 
+int32 UK2Node_CasePairedPinsNode::EstimateCaseConditionCost(const UEdGraphPin* CondPin) const
+{
+	TSet<const UEdGraphNode*> VisitedNodes;
+
+	return EstimatePureSubgraphCost(CondPin, VisitedNodes);
+}
+
+TArray<int32> UK2Node_CasePairedPinsNode::GetCaseEvaluationOrder(
+	const TArray<UEdGraphPin*>& CondPins, const TArray<uint64>* CaseHits) const
+{
+	// Minimize the expected cost of the mutually exclusive tests by sorting them in ascending order of cost / probability.
+	// The static cost is only used when no profile is recorded.
+	TArray<double> Ranks;
+	Ranks.SetNum(CondPins.Num());
+
+	uint64 TotalHits = 0;
+	if (CaseHits != nullptr)
+	{
+		for (uint64 Hits : *CaseHits)
+		{
+			TotalHits += Hits;
+		}
+	}
+
+	for (int32 Index = 0; Index < CondPins.Num(); ++Index)
+	{
+		double Cost = FMath::Max(EstimateCaseConditionCost(CondPins[Index]), 1);
+		if (TotalHits > 0)
+		{
+			uint64 Hits = CaseHits->IsValidIndex(Index) ? (*CaseHits)[Index] : 0;
+			double Probability = static_cast<double>(Hits + 1) / static_cast<double>(TotalHits + CondPins.Num());
+			Ranks[Index] = Cost / Probability;
+		}
+		else
+		{
+			Ranks[Index] = Cost;
+		}
+	}
+
+	TArray<int32> Order;
+	for (int32 Index = 0; Index < CondPins.Num(); ++Index)
+	{
+		Order.Add(Index);
+	}
+	Order.StableSort([&Ranks](int32 A, int32 B) { return Ranks[A] < Ranks[B]; });
+
+	return Order;
+}
+
+FString UK2Node_CasePairedPinsNode::MakeParallelConditions(const TArray<UEdGraphPin*>& CondPins, const UEdGraph* SourceGraph) const
+{
+	// The results are returned as the bits of int64.
+	if ((CondPins.Num() == 0) || (CondPins.Num() > 64) || IsThreadSafeGraph(SourceGraph))
+	{
+		return FString();
+	}
+
+	TArray<FString> Calls;
+	for (const UEdGraphPin* CondPin : CondPins)
+	{
+		const UK2Node_CallFunction* CallFunction =
+			(CondPin->LinkedTo.Num() == 1) ? Cast<UK2Node_CallFunction>(CondPin->LinkedTo[0]->GetOwningNode()) : nullptr;
+		const UFunction* Function = (CallFunction != nullptr) ? CallFunction->GetTargetFunction() : nullptr;
+		if ((Function == nullptr) || !CallFunction->IsNodePure() || (CondPin->LinkedTo[0] != CallFunction->GetReturnValuePin()) ||
+			!Function->HasAllFunctionFlags(FUNC_Static | FUNC_Native) || !IsThreadSafeFunction(Function) ||
+			(CastField<FBoolProperty>(Function->GetReturnProperty()) == nullptr))
+		{
+			return FString();
+		}
+
+		TArray<FString> Tokens;
+		Tokens.Add(Function->GetPathName());
+		const FString WorldContext = Function->GetMetaData(TEXT("WorldContext"));
+		for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+		{
+			const FProperty* Param = *It;
+			if (Param->HasAnyPropertyFlags(CPF_ReturnParm))
+			{
+				continue;
+			}
+
+			// The output parameters and the world context cannot be passed from the worker threads.
+			const UEdGraphPin* ArgPin = CallFunction->FindPin(Param->GetFName(), EGPD_Input);
+			if ((ArgPin == nullptr) || (Param->GetName() == WorldContext) ||
+				(Param->HasAnyPropertyFlags(CPF_OutParm) && !Param->HasAnyPropertyFlags(CPF_ConstParm)))
+			{
+				return FString();
+			}
+
+			if (ArgPin->LinkedTo.Num() == 0)
+			{
+				if (!IsParallelLiteralProperty(Param))
+				{
+					return FString();
+				}
+				Tokens.Add(Param->GetName() + TEXT("=") + EscapeParallelLiteral(ArgPin->GetDefaultAsString()));
+				continue;
+			}
+
+			const UK2Node_VariableGet* VariableGet = FindMemberVariableGet(ArgPin);
+			const FProperty* Variable = (VariableGet != nullptr) ? VariableGet->GetPropertyForVariable() : nullptr;
+			const FNumericProperty* NumericParam = CastField<FNumericProperty>(Param);
+			const FNumericProperty* NumericVariable = CastField<FNumericProperty>(Variable);
+			const bool bFloatingPoint = (NumericParam != nullptr) && (NumericVariable != nullptr) &&
+										NumericParam->IsFloatingPoint() && NumericVariable->IsFloatingPoint();
+			if ((Variable == nullptr) || !(Param->SameType(Variable) || bFloatingPoint))
+			{
+				return FString();
+			}
+			Tokens.Add(Param->GetName() + TEXT("=@") + VariableGet->GetVarName().ToString());
+		}
+
+		Calls.Add(FString::Join(Tokens, TEXT(",")));
+	}
+
+	// The conditions are passed as the name, which is parsed once at runtime.
+	const FString Conditions = NodeGuid.ToString(EGuidFormats::Digits) + TEXT(";") + FString::Join(Calls, TEXT("|"));
+	return (Conditions.Len() < NAME_SIZE) ? Conditions : FString();
+}
+
 void UK2Node_CasePairedPinsNode::AddCasePinLast()
 {
 	Modify();
@@ -453,6 +716,288 @@ void UK2Node_CasePairedPinsNode::AddCasePinLast()
 	int32 N = GetCasePinCount();
 
 	AddCasePinPair(N);
+	RestoreCaseCompanionPins();
+}
+
+bool UK2Node_CasePairedPinsNode::ShouldCountCaseHits(bool bRecordCaseProfile) const
+{
+	// Cooked Blueprints are never instrumented.
+	if (IsRunningCommandlet())
+	{
+		return false;
+	}
+
+	const UAdvancedControlFlowSettings* Settings = GetDefault<UAdvancedControlFlowSettings>();
+
+	return Settings->bCountCaseHits || (bRecordCaseProfile && Settings->bRecordCaseProfile);
+}
+
+void UK2Node_CasePairedPinsNode::ExpandCaseHitCounters(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	TArray<UEdGraphPin*> HitPins = GetCaseHitPins();
+	const uint64 CounterKey =
+		FACFCaseProfile::Get().RegisterCounter(FACFCaseProfile::MakeNodeKey(CompilerContext, this), HitPins.Num() - 1);
+
+	// Insert the counter between the execution pin and the connected nodes.
+	for (int32 Index = 0; Index < HitPins.Num(); ++Index)
+	{
+		UEdGraphPin* HitPin = HitPins[Index];
+		if ((HitPin == nullptr) || (HitPin->LinkedTo.Num() == 0))
+		{
+			continue;
+		}
+
+		UK2Node_CallFunction* CountCaseHit =
+			SpawnCaseHitCounter(CompilerContext, SourceGraph, CounterKey, HitPins.Num(), Index);
+		CompilerContext.MovePinLinksToIntermediate(*HitPin, *CountCaseHit->GetThenPin());
+		HitPin->MakeLinkTo(CountCaseHit->GetExecPin());
+	}
+}
+
+UK2Node_CallFunction* UK2Node_CasePairedPinsNode::SpawnCaseHitCounter(
+	FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph, uint64 CounterKey, int32 NumCases, int32 CaseIndex)
+{
+	const UEdGraphSchema_K2* Schema = CompilerContext.GetSchema();
+
+	UK2Node_CallFunction* CountCaseHit = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+	CountCaseHit->SetFromFunction(UACFCaseHitCounterLibrary::StaticClass()->FindFunctionByName(
+		GET_FUNCTION_NAME_CHECKED(UACFCaseHitCounterLibrary, CountCaseHit)));
+	CountCaseHit->AllocateDefaultPins();
+	Schema->TrySetDefaultValue(*CountCaseHit->FindPinChecked(TEXT("CounterKey")), LexToString(static_cast<int64>(CounterKey)));
+	Schema->TrySetDefaultValue(*CountCaseHit->FindPinChecked(TEXT("NumCases")), FString::FromInt(NumCases));
+	Schema->TrySetDefaultValue(*CountCaseHit->FindPinChecked(TEXT("CaseIndex")), FString::FromInt(CaseIndex));
+
+	return CountCaseHit;
+}
+
+bool UK2Node_CasePairedPinsNode::IsThreadSafeGraph(const UEdGraph* Graph)
+{
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	return false;
+#else
+	TArray<UK2Node_FunctionEntry*> FunctionEntries;
+	Graph->GetNodesOfClass(FunctionEntries);
+	return (FunctionEntries.Num() > 0) && FunctionEntries[0]->MetaData.bThreadSafe;
+#endif
+}
+
+UEdGraphPin* UK2Node_CasePairedPinsNode::ExpandFindFirstTrueCondition(
+	FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph, const TArray<UEdGraphPin*>& CondPins)
+{
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	UK2Node_MakeArray* MakeArray = CompilerContext.SpawnIntermediateNode<UK2Node_MakeArray>(this, SourceGraph);
+	MakeArray->AllocateDefaultPins();
+	for (int32 Index = 1; Index < CondPins.Num(); ++Index)
+	{
+		MakeArray->AddInputPin();
+	}
+
+	UK2Node_CallFunction* ArrayFind = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+	ArrayFind->SetFromFunction(UKismetArrayLibrary::StaticClass()->FindFunctionByName("Array_Find"));
+	ArrayFind->AllocateDefaultPins();
+
+	TArray<UEdGraphPin*> KeyPins;
+	TArray<UEdGraphPin*> ValuePins;
+	MakeArray->GetKeyAndValuePins(KeyPins, ValuePins);
+	for (int32 Index = 0; Index < CondPins.Num(); ++Index)
+	{
+		KeyPins[Index]->PinType.PinCategory = UEdGraphSchema_K2::PC_Boolean;
+		CompilerContext.MovePinLinksToIntermediate(*CondPins[Index], *KeyPins[Index]);
+	}
+
+	UEdGraphPin* ArrayPin = MakeArray->GetOutputPin();
+	UEdGraphPin* TargetArrayPin = ArrayFind->FindPinChecked(TEXT("TargetArray"));
+	UEdGraphPin* ItemToFindPin = ArrayFind->FindPinChecked(TEXT("ItemToFind"));
+	ArrayPin->PinType.PinCategory = UEdGraphSchema_K2::PC_Boolean;
+	ArrayPin->MakeLinkTo(TargetArrayPin);
+	TargetArrayPin->PinType.PinCategory = UEdGraphSchema_K2::PC_Boolean;
+	ItemToFindPin->PinType.PinCategory = UEdGraphSchema_K2::PC_Boolean;
+	MakeArray->GetSchema()->TrySetDefaultValue(*ItemToFindPin, TEXT("true"));
+
+	return ArrayFind->GetReturnValuePin();
+#else
+	// The conditions are passed as the variadic arguments and packed into the bit masks without building an array.
+	UK2Node_CallFunction* FindFirstTrue = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+	FindFirstTrue->SetFromFunction(UACFConditionLibrary::StaticClass()->FindFunctionByName(
+		GET_FUNCTION_NAME_CHECKED(UACFConditionLibrary, FindFirstTrueCondition)));
+	FindFirstTrue->AllocateDefaultPins();
+	for (int32 Index = 0; Index < CondPins.Num(); ++Index)
+	{
+		UEdGraphPin* ArgPin = FindFirstTrue->CreatePin(
+			EGPD_Input, UEdGraphSchema_K2::PC_Boolean, *FString::Printf(TEXT("Condition_%d"), Index));
+		CompilerContext.MovePinLinksToIntermediate(*CondPins[Index], *ArgPin);
+	}
+
+	return FindFirstTrue->GetReturnValuePin();
+#endif
+}
+
+FEdGraphPinType UK2Node_CasePairedPinsNode::GetWeightPinType() const
+{
+	FEdGraphPinType PinType;
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	PinType.PinCategory = UEdGraphSchema_K2::PC_Float;
+#else
+	PinType.PinCategory = UEdGraphSchema_K2::PC_Real;
+	PinType.PinSubCategory = UEdGraphSchema_K2::PC_Double;
+#endif
+
+	return PinType;
+}
+
+UEdGraphPin* UK2Node_CasePairedPinsNode::ExpandSampleWeightedCase(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph,
+	const TArray<UEdGraphPin*>& WeightPins, UEdGraphPin* StreamPin)
+{
+	const UEdGraphSchema_K2* Schema = CompilerContext.GetSchema();
+
+	// Literal weights are passed as a name, so that the table is looked up without building an array.
+	bool bLiteralWeights = true;
+	TArray<FString> Literals;
+	for (auto& WeightPin : WeightPins)
+	{
+		bLiteralWeights &= (WeightPin->LinkedTo.Num() == 0);
+		Literals.Add(FString::SanitizeFloat(FCString::Atof(*WeightPin->DefaultValue)));
+	}
+	const FString LiteralWeights = FString::Join(Literals, TEXT(","));
+	bLiteralWeights &= (LiteralWeights.Len() < NAME_SIZE);
+
+	UK2Node_CallFunction* Sample = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+	if (bLiteralWeights)
+	{
+		Sample->SetFromFunction(UACFRandomLibrary::StaticClass()->FindFunctionByName(
+			GET_FUNCTION_NAME_CHECKED(UACFRandomLibrary, SampleLiteralWeights)));
+		Sample->AllocateDefaultPins();
+		Schema->TrySetDefaultValue(*Sample->FindPinChecked(TEXT("Weights")), LiteralWeights);
+	}
+	else
+	{
+		Sample->SetFromFunction(
+			UACFRandomLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UACFRandomLibrary, SampleWeights)));
+		Sample->AllocateDefaultPins();
+		const int64 TableKey = ACFRandom::MakeTableKey(FACFCaseProfile::MakeNodeKey(CompilerContext, this));
+		Schema->TrySetDefaultValue(*Sample->FindPinChecked(TEXT("TableKey")), LexToString(TableKey));
+
+		UK2Node_MakeArray* MakeArray = CompilerContext.SpawnIntermediateNode<UK2Node_MakeArray>(this, SourceGraph);
+		MakeArray->AllocateDefaultPins();
+		for (int32 Index = 1; Index < WeightPins.Num(); ++Index)
+		{
+			MakeArray->AddInputPin();
+		}
+
+		// The weights are converted to float by the implicit cast on UE 5.
+		UEdGraphPin* WeightsPin = Sample->FindPinChecked(TEXT("Weights"));
+		FEdGraphPinType ElementPinType = WeightsPin->PinType;
+		ElementPinType.ContainerType = EPinContainerType::None;
+		ElementPinType.bIsReference = false;
+		ElementPinType.bIsConst = false;
+
+		TArray<UEdGraphPin*> KeyPins;
+		TArray<UEdGraphPin*> ValuePins;
+		MakeArray->GetKeyAndValuePins(KeyPins, ValuePins);
+		for (int32 Index = 0; Index < WeightPins.Num(); ++Index)
+		{
+			KeyPins[Index]->PinType = ElementPinType;
+			CompilerContext.MovePinLinksToIntermediate(*WeightPins[Index], *KeyPins[Index]);
+		}
+
+		UEdGraphPin* ArrayPin = MakeArray->GetOutputPin();
+		ArrayPin->PinType = ElementPinType;
+		ArrayPin->PinType.ContainerType = EPinContainerType::Array;
+		ArrayPin->MakeLinkTo(WeightsPin);
+	}
+
+	const bool bUseStream = StreamPin->LinkedTo.Num() > 0;
+	Schema->TrySetDefaultValue(*Sample->FindPinChecked(TEXT("bUseStream")), bUseStream ? TEXT("true") : TEXT("false"));
+	if (bUseStream)
+	{
+		CompilerContext.MovePinLinksToIntermediate(*StreamPin, *Sample->FindPinChecked(TEXT("Stream")));
+	}
+
+	return Sample->GetReturnValuePin();
+}
+
+bool UK2Node_CasePairedPinsNode::ShouldEmitTraceEvents() const
+{
+	return GetDefault<UAdvancedControlFlowSettings>()->bEmitTraceEvents;
+}
+
+UK2Node_CallFunction* UK2Node_CasePairedPinsNode::SpawnTraceCall(
+	FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph, FName FunctionName)
+{
+	const UEdGraphNode* SourceNode = Cast<UEdGraphNode>(CompilerContext.MessageLog.FindSourceObject(this));
+	if (SourceNode == nullptr)
+	{
+		SourceNode = this;
+	}
+
+	UK2Node_CallFunction* TraceCall = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+	TraceCall->SetFromFunction(UACFTraceLibrary::StaticClass()->FindFunctionByName(FunctionName));
+	TraceCall->AllocateDefaultPins();
+
+	const UEdGraphSchema* Schema = TraceCall->GetSchema();
+	Schema->TrySetDefaultValue(*TraceCall->FindPinChecked(TEXT("Blueprint")), CompilerContext.Blueprint->GetPathName());
+	Schema->TrySetDefaultValue(*TraceCall->FindPinChecked(TEXT("Graph")), SourceNode->GetGraph()->GetName());
+	Schema->TrySetDefaultValue(*TraceCall->FindPinChecked(TEXT("NodeGuid")), SourceNode->NodeGuid.ToString());
+
+	return TraceCall;
+}
+
+void UK2Node_CasePairedPinsNode::ExpandTraceEvents(
+	FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph, const TArray<int32>& NumConditions)
+{
+	TArray<UEdGraphPin*> HitPins = GetCaseHitPins();
+	const UEdGraphSchema_K2* Schema = CompilerContext.GetSchema();
+
+	// Begin before the node, so that the conditions are evaluated inside the scope.
+	UK2Node_CallFunction* Begin =
+		SpawnTraceCall(CompilerContext, SourceGraph, GET_FUNCTION_NAME_CHECKED(UACFTraceLibrary, BeginNodeEvaluation));
+	CompilerContext.MovePinLinksToIntermediate(*GetExecPin(), *Begin->GetExecPin());
+	Begin->GetThenPin()->MakeLinkTo(GetExecPin());
+
+	// End between the execution pin and the connected nodes.
+	// The default pin is always ended because it is taken even if nothing is connected.
+	for (int32 Index = 0; Index < HitPins.Num(); ++Index)
+	{
+		UEdGraphPin* HitPin = HitPins[Index];
+		const bool bDefaultPin = Index == HitPins.Num() - 1;
+		if ((HitPin == nullptr) || (!bDefaultPin && HitPin->LinkedTo.Num() == 0))
+		{
+			continue;
+		}
+
+		UK2Node_CallFunction* End =
+			SpawnTraceCall(CompilerContext, SourceGraph, GET_FUNCTION_NAME_CHECKED(UACFTraceLibrary, EndNodeEvaluation));
+		Begin->GetReturnValuePin()->MakeLinkTo(End->FindPinChecked(TEXT("Token")));
+		Schema->TrySetDefaultValue(*End->FindPinChecked(TEXT("NumConditions")), FString::FromInt(NumConditions[Index]));
+		Schema->TrySetDefaultValue(
+			*End->FindPinChecked(TEXT("CaseIndex")), FString::FromInt(bDefaultPin ? INDEX_NONE : Index));
+
+		CompilerContext.MovePinLinksToIntermediate(*HitPin, *End->GetThenPin());
+		HitPin->MakeLinkTo(End->GetExecPin());
+	}
+}
+
+TArray<UEdGraphPin*> UK2Node_CasePairedPinsNode::GetCaseConditionPins() const
+{
+	TArray<UEdGraphPin*> CondPins;
+	for (auto& Pair : GetCasePinPairs())
+	{
+		CondPins.Add(Pair.Key);
+	}
+
+	return CondPins;
+}
+
+TArray<UEdGraphPin*> UK2Node_CasePairedPinsNode::GetCaseHitPins() const
+{
+	TArray<UEdGraphPin*> HitPins;
+	for (auto& Pair : GetCasePinPairs())
+	{
+		HitPins.Add(Pair.Value);
+	}
+	HitPins.Add(FindPin(DefaultExecPinName));
+
+	return HitPins;
 }
 
 #undef LOCTEXT_NAMESPACE
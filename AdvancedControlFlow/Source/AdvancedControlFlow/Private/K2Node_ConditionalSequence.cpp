@@ -11,10 +11,13 @@
 
 #include "K2Node_ConditionalSequence.h"
 
+#include "ACFParallelLibrary.h"
 #include "BlueprintNodeSpawner.h"
 #include "EditorCategoryUtils.h"
+#include "K2Node_CallFunction.h"
 #include "K2Node_ExecutionSequence.h"
 #include "K2Node_IfThenElse.h"
+#include "Kismet2/BlueprintEditorUtils.h"
 #include "KismetCompiler.h"
 
 #define LOCTEXT_NAMESPACE "AdvancedControlFlow"
@@ -27,6 +30,7 @@ UK2Node_ConditionalSequence::UK2Node_ConditionalSequence(const FObjectInitialize
 	CaseValuePinNamePrefix = TEXT("CaseExec");
 	CaseKeyPinFriendlyNamePrefix = TEXT("Condition ");
 	CaseValuePinFriendlyNamePrefix = TEXT(" ");
+	bParallelConditions = false;
 }
 
 void UK2Node_ConditionalSequence::AllocateDefaultPins()
@@ -79,16 +83,58 @@ void UK2Node_ConditionalSequence::ExpandNode(FKismetCompilerContext& CompilerCon
 {
 	Super::ExpandNode(CompilerContext, SourceGraph);
 
+	if (ShouldCountCaseHits(false))
+	{
+		ExpandCaseHitCounters(CompilerContext, SourceGraph);
+	}
+
 	TArray<CasePinPair> CasePairs = GetCasePinPairs();
 
 	UEdGraphPin* ExecTriggeringPin = GetExecPin();
 	UEdGraphPin* DefaultExecPin = FindPin(DefaultExecPinName);
 
+	// The bits of the true conditions, which are evaluated on the worker threads before the sequence.
+	UEdGraphPin* ResultsPin = nullptr;
+	if (bParallelConditions)
+	{
+		TArray<UEdGraphPin*> CondPins;
+		for (auto& Pair : CasePairs)
+		{
+			CondPins.Add(Pair.Key);
+		}
+
+		const FString Conditions = MakeParallelConditions(CondPins, SourceGraph);
+		if (Conditions.IsEmpty())
+		{
+			CompilerContext.MessageLog.Note(
+				*LOCTEXT("ParallelConditionsNotSupported_Note", "Conditions of @@ are evaluated on the game thread").ToString(),
+				this);
+		}
+		else
+		{
+			UK2Node_CallFunction* Evaluate = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+			Evaluate->SetFromFunction(UACFParallelLibrary::StaticClass()->FindFunctionByName(
+				GET_FUNCTION_NAME_CHECKED(UACFParallelLibrary, EvaluateParallelConditions)));
+			Evaluate->AllocateDefaultPins();
+			CompilerContext.GetSchema()->TrySetDefaultValue(*Evaluate->FindPinChecked(TEXT("Conditions")), Conditions);
+			CompilerContext.MovePinLinksToIntermediate(*ExecTriggeringPin, *Evaluate->GetExecPin());
+			ExecTriggeringPin = Evaluate->GetThenPin();
+			ResultsPin = Evaluate->GetReturnValuePin();
+		}
+	}
+
 	{
 		UK2Node_ExecutionSequence* Sequence = CompilerContext.SpawnIntermediateNode<UK2Node_ExecutionSequence>(this, SourceGraph);
 		Sequence->AllocateDefaultPins();
 
-		CompilerContext.MovePinLinksToIntermediate(*ExecTriggeringPin, *Sequence->GetExecPin());
+		if (ResultsPin != nullptr)
+		{
+			ExecTriggeringPin->MakeLinkTo(Sequence->GetExecPin());
+		}
+		else
+		{
+			CompilerContext.MovePinLinksToIntermediate(*ExecTriggeringPin, *Sequence->GetExecPin());
+		}
 
 		for (int32 Index = 0; Index < CasePairs.Num(); ++Index)
 		{
@@ -106,7 +152,20 @@ void UK2Node_ConditionalSequence::ExpandNode(FKismetCompilerContext& CompilerCon
 
 			SequenceExecPin->MakeLinkTo(IfThenElseExecPin);
 			CompilerContext.MovePinLinksToIntermediate(*CaseExecPin, *IfThenElseThenPin);
-			CompilerContext.MovePinLinksToIntermediate(*CaseCondPin, *IfThenElseCondPin);
+			if (ResultsPin != nullptr)
+			{
+				UK2Node_CallFunction* IsTrue = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+				IsTrue->SetFromFunction(UACFParallelLibrary::StaticClass()->FindFunctionByName(
+					GET_FUNCTION_NAME_CHECKED(UACFParallelLibrary, IsParallelConditionTrue)));
+				IsTrue->AllocateDefaultPins();
+				ResultsPin->MakeLinkTo(IsTrue->FindPinChecked(TEXT("Results")));
+				CompilerContext.GetSchema()->TrySetDefaultValue(*IsTrue->FindPinChecked(TEXT("Index")), FString::FromInt(Index));
+				IsTrue->GetReturnValuePin()->MakeLinkTo(IfThenElseCondPin);
+			}
+			else
+			{
+				CompilerContext.MovePinLinksToIntermediate(*CaseCondPin, *IfThenElseCondPin);
+			}
 		}
 
 		CompilerContext.MovePinLinksToIntermediate(*DefaultExecPin, *Sequence->GetThenPinGivenIndex(CasePairs.Num()));
@@ -115,6 +174,16 @@ void UK2Node_ConditionalSequence::ExpandNode(FKismetCompilerContext& CompilerCon
 	BreakAllNodeLinks();
 }
 
+void UK2Node_ConditionalSequence::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UK2Node_ConditionalSequence, bParallelConditions))
+	{
+		FBlueprintEditorUtils::MarkBlueprintAsModified(GetBlueprint());
+	}
+}
+
 void UK2Node_ConditionalSequence::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
 {
 	UClass* ActionKey = GetClass();
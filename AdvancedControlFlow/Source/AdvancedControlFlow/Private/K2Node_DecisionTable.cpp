@@ -0,0 +1,480 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "K2Node_DecisionTable.h"
+
+#include "ACFDecisionRule.h"
+#include "BlueprintNodeSpawner.h"
+#include "EditorCategoryUtils.h"
+#include "Engine/DataTable.h"
+#include "GraphEditorSettings.h"
+#include "K2Node_CasePairedPinsNode.h"
+#include "K2Node_ExecutionSequence.h"
+#include "K2Node_IfThenElse.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "KismetCompiler.h"
+
+#define LOCTEXT_NAMESPACE "AdvancedControlFlow"
+
+namespace ACFDecisionTable
+{
+static const FString ConditionPinNamePrefix(TEXT("Condition_"));
+static const FString OutcomePinNamePrefix(TEXT("Outcome_"));
+
+// The tree is not built if it grows over this limit, which is far more than the rules written by hand.
+static const int32 MaxTreeNodes = 4096;
+static const int32 MaxVisits = 65536;
+
+struct FRule
+{
+	// -1: Not tested, 0: Must be false, 1: Must be true.
+	TArray<int8> Tests;
+	int32 Outcome = INDEX_NONE;
+};
+
+// The child is the index of the node, or -1 - Outcome for the leaf. The outcome equal to the number of the outcomes is Default.
+struct FTreeNode
+{
+	int32 Condition;
+	int32 FalseChild;
+	int32 TrueChild;
+};
+
+static bool LoadRules(const UDataTable* Table, TArray<FName>& OutConditions, TArray<FName>& OutOutcomes,
+	TArray<FRule>& OutRules, FText& OutError)
+{
+	if (Table == nullptr)
+	{
+		OutError = LOCTEXT("DecisionTableNoTable_Error", "No decision table is set");
+		return false;
+	}
+
+	const UScriptStruct* RowStruct = Table->GetRowStruct();
+	if ((RowStruct == nullptr) || !RowStruct->IsChildOf(FACFDecisionRule::StaticStruct()))
+	{
+		OutError = LOCTEXT("DecisionTableRowStruct_Error", "The row structure of the decision table must be ACFDecisionRule");
+		return false;
+	}
+
+	for (const auto& Row : Table->GetRowMap())
+	{
+		const FACFDecisionRule* Rule = reinterpret_cast<const FACFDecisionRule*>(Row.Value);
+		if (Rule->Outcome.IsNone())
+		{
+			OutError = FText::Format(LOCTEXT("DecisionTableNoOutcome_Error", "The row {0} of the decision table has no outcome"),
+				FText::FromName(Row.Key));
+			return false;
+		}
+		for (const auto& Condition : Rule->Conditions)
+		{
+			if (Condition.Key.IsNone())
+			{
+				OutError = FText::Format(
+					LOCTEXT("DecisionTableNoCondition_Error", "The row {0} of the decision table has an unnamed condition"),
+					FText::FromName(Row.Key));
+				return false;
+			}
+			OutConditions.AddUnique(Condition.Key);
+		}
+		OutOutcomes.AddUnique(Rule->Outcome);
+	}
+
+	for (const auto& Row : Table->GetRowMap())
+	{
+		const FACFDecisionRule* Rule = reinterpret_cast<const FACFDecisionRule*>(Row.Value);
+		FRule& NewRule = OutRules.AddDefaulted_GetRef();
+		NewRule.Tests.Init(-1, OutConditions.Num());
+		for (const auto& Condition : Rule->Conditions)
+		{
+			NewRule.Tests[OutConditions.IndexOfByKey(Condition.Key)] = Condition.Value ? 1 : 0;
+		}
+		NewRule.Outcome = OutOutcomes.IndexOfByKey(Rule->Outcome);
+	}
+
+	return true;
+}
+
+// Builds the decision tree which chooses the first rule whose conditions all hold.
+// The condition splitting the remaining rules most evenly is tested first to keep the tree balanced, and the identical
+// subtrees are shared.
+class FTreeBuilder
+{
+	const TArray<FRule>& Rules;
+	int32 NumConditions;
+	int32 NumOutcomes;
+	TMap<FString, int32> AssignmentNodes;
+	TMap<FIntVector, int32> NodeIndices;
+	int32 NumVisits = 0;
+
+	int32 MakeLeaf(int32 Outcome) const
+	{
+		return -1 - Outcome;
+	}
+
+	int32 BuildNode(TArray<int8>& Assignment, const TArray<int32>& RuleIndices);
+
+public:
+	TArray<FTreeNode> Nodes;
+
+	FTreeBuilder(const TArray<FRule>& InRules, int32 InNumConditions, int32 InNumOutcomes)
+		: Rules(InRules), NumConditions(InNumConditions), NumOutcomes(InNumOutcomes)
+	{
+	}
+
+	// Returns false if the tree is too large.
+	bool Build(int32& OutRoot)
+	{
+		TArray<int8> Assignment;
+		Assignment.Init(-1, NumConditions);
+		TArray<int32> RuleIndices;
+		for (int32 Index = 0; Index < Rules.Num(); ++Index)
+		{
+			RuleIndices.Add(Index);
+		}
+
+		OutRoot = BuildNode(Assignment, RuleIndices);
+		return (NumVisits <= MaxVisits) && (Nodes.Num() <= MaxTreeNodes);
+	}
+};
+
+int32 FTreeBuilder::BuildNode(TArray<int8>& Assignment, const TArray<int32>& RuleIndices)
+{
+	if (RuleIndices.Num() == 0)
+	{
+		return MakeLeaf(NumOutcomes);
+	}
+
+	// The first remaining rule is chosen when all its conditions are tested, because the other rules are behind it.
+	const FRule& FirstRule = Rules[RuleIndices[0]];
+	bool bFirstRuleHolds = true;
+	for (int32 Condition = 0; Condition < NumConditions; ++Condition)
+	{
+		if ((FirstRule.Tests[Condition] != -1) && (Assignment[Condition] == -1))
+		{
+			bFirstRuleHolds = false;
+			break;
+		}
+	}
+	if (bFirstRuleHolds)
+	{
+		return MakeLeaf(FirstRule.Outcome);
+	}
+
+	// The remaining rules are decided by the tested conditions.
+	FString AssignmentKey;
+	for (int8 Value : Assignment)
+	{
+		AssignmentKey.AppendChar(Value == -1 ? TEXT('-') : (Value == 1 ? TEXT('1') : TEXT('0')));
+	}
+	if (const int32* Node = AssignmentNodes.Find(AssignmentKey))
+	{
+		return *Node;
+	}
+	if ((++NumVisits > MaxVisits) || (Nodes.Num() > MaxTreeNodes))
+	{
+		return MakeLeaf(NumOutcomes);
+	}
+
+	int32 BestCondition = INDEX_NONE;
+	int32 BestCost = MAX_int32;
+	for (int32 Condition = 0; Condition < NumConditions; ++Condition)
+	{
+		if (Assignment[Condition] != -1)
+		{
+			continue;
+		}
+
+		int32 NumFalse = 0;
+		int32 NumTrue = 0;
+		bool bTested = false;
+		for (int32 RuleIndex : RuleIndices)
+		{
+			const int8 Test = Rules[RuleIndex].Tests[Condition];
+			bTested |= (Test != -1);
+			NumFalse += (Test != 1) ? 1 : 0;
+			NumTrue += (Test != 0) ? 1 : 0;
+		}
+		if (!bTested)
+		{
+			continue;
+		}
+
+		// The condition of the first rule is preferred on a tie, which reaches the leaf earlier.
+		const int32 Cost = FMath::Max(NumFalse, NumTrue) * 2 - (FirstRule.Tests[Condition] != -1 ? 1 : 0);
+		if (Cost < BestCost)
+		{
+			BestCost = Cost;
+			BestCondition = Condition;
+		}
+	}
+	check(BestCondition != INDEX_NONE);
+
+	int32 Children[2];
+	for (int8 Value = 0; Value < 2; ++Value)
+	{
+		TArray<int32> ChildRuleIndices;
+		for (int32 RuleIndex : RuleIndices)
+		{
+			const int8 Test = Rules[RuleIndex].Tests[BestCondition];
+			if ((Test == -1) || (Test == Value))
+			{
+				ChildRuleIndices.Add(RuleIndex);
+			}
+		}
+		Assignment[BestCondition] = Value;
+		Children[Value] = BuildNode(Assignment, ChildRuleIndices);
+		Assignment[BestCondition] = -1;
+	}
+
+	int32 Node = Children[0];
+	if (Children[0] != Children[1])
+	{
+		const FIntVector NodeKey(BestCondition, Children[0], Children[1]);
+		if (const int32* SharedNode = NodeIndices.Find(NodeKey))
+		{
+			Node = *SharedNode;
+		}
+		else
+		{
+			Node = Nodes.Add({BestCondition, Children[0], Children[1]});
+			NodeIndices.Add(NodeKey, Node);
+		}
+	}
+	AssignmentNodes.Add(AssignmentKey, Node);
+
+	return Node;
+}
+}  // namespace ACFDecisionTable
+
+UK2Node_DecisionTable::UK2Node_DecisionTable(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+}
+
+void UK2Node_DecisionTable::AllocateDefaultPins()
+{
+	// Pin structure
+	//   C: Number of conditions, O: Number of outcomes
+	// -----
+	// 0: Execution Triggering (In, Exec)
+	// 1 - C: Condition (In, Boolean)
+	// C+1 - C+O: Outcome Execution (Out, Exec)
+	// C+O+1: Default Execution (Out, Exec)
+
+	CreateExecTriggeringPin();
+
+	TArray<FName> Conditions;
+	TArray<FName> Outcomes;
+	TArray<ACFDecisionTable::FRule> Rules;
+	FText Error;
+	if (ACFDecisionTable::LoadRules(DecisionTable, Conditions, Outcomes, Rules, Error))
+	{
+		for (const FName& Condition : Conditions)
+		{
+			CreateConditionPin(Condition);
+		}
+		for (const FName& Outcome : Outcomes)
+		{
+			CreateOutcomeExecPin(Outcome);
+		}
+	}
+
+	CreateDefaultExecPin();
+
+	Super::AllocateDefaultPins();
+}
+
+FText UK2Node_DecisionTable::GetTooltipText() const
+{
+	return LOCTEXT("DecisionTable_Tooltip",
+		"Decision Table\nExecution goes to the outcome of the first rule of the data table whose conditions all hold.\nThe "
+		"rules are compiled into a tree of branches.");
+}
+
+FLinearColor UK2Node_DecisionTable::GetNodeTitleColor() const
+{
+	return GetDefault<UGraphEditorSettings>()->ExecBranchNodeTitleColor;
+}
+
+FText UK2Node_DecisionTable::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	if ((TitleType == ENodeTitleType::FullTitle) && (DecisionTable != nullptr))
+	{
+		return FText::Format(
+			LOCTEXT("DecisionTableWithTable", "Decision Table\n{0}"), FText::FromString(DecisionTable->GetName()));
+	}
+
+	return LOCTEXT("DecisionTable", "Decision Table");
+}
+
+FSlateIcon UK2Node_DecisionTable::GetIconAndTint(FLinearColor& OutColor) const
+{
+	static FSlateIcon Icon("EditorStyle", "GraphEditor.Branch_16x");
+	return Icon;
+}
+
+void UK2Node_DecisionTable::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
+{
+	UClass* ActionKey = GetClass();
+	if (ActionRegistrar.IsOpenForRegistration(ActionKey))
+	{
+		UBlueprintNodeSpawner* NodeSpawner = UBlueprintNodeSpawner::Create(GetClass());
+		check(NodeSpawner != nullptr);
+
+		ActionRegistrar.AddBlueprintAction(ActionKey, NodeSpawner);
+	}
+}
+
+FText UK2Node_DecisionTable::GetMenuCategory() const
+{
+	return FEditorCategoryUtils::GetCommonCategory(FCommonEditorCategory::FlowControl);
+}
+
+void UK2Node_DecisionTable::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	Super::ExpandNode(CompilerContext, SourceGraph);
+
+	TArray<FName> Conditions;
+	TArray<FName> Outcomes;
+	TArray<ACFDecisionTable::FRule> Rules;
+	FText Error;
+	if (!ACFDecisionTable::LoadRules(DecisionTable, Conditions, Outcomes, Rules, Error))
+	{
+		CompilerContext.MessageLog.Error(*FText::Format(LOCTEXT("DecisionTable_Error", "@@: {0}"), Error).ToString(), this);
+		BreakAllNodeLinks();
+		return;
+	}
+
+	// The pins are made from the rules when the node is reconstructed, so the edited table needs the refresh.
+	TArray<UEdGraphPin*> OutcomeExecPins;
+	bool bOutdated = (Pins.Num() != Conditions.Num() + Outcomes.Num() + 2);
+	for (const FName& Condition : Conditions)
+	{
+		bOutdated |= (GetConditionPin(Condition) == nullptr);
+	}
+	for (const FName& Outcome : Outcomes)
+	{
+		OutcomeExecPins.Add(GetOutcomeExecPin(Outcome));
+		bOutdated |= (OutcomeExecPins.Last() == nullptr);
+	}
+	if (bOutdated)
+	{
+		CompilerContext.MessageLog.Error(
+			*LOCTEXT("DecisionTableOutdated_Error", "@@ is out of date with the decision table. Refresh the node.").ToString(),
+			this);
+		BreakAllNodeLinks();
+		return;
+	}
+	OutcomeExecPins.Add(GetDefaultExecPin());
+
+	ACFDecisionTable::FTreeBuilder Builder(Rules, Conditions.Num(), Outcomes.Num());
+	int32 Root = INDEX_NONE;
+	if (!Builder.Build(Root))
+	{
+		CompilerContext.MessageLog.Error(
+			*LOCTEXT("DecisionTableTooLarge_Error", "The decision tree of @@ is too large. Split the decision table.").ToString(),
+			this);
+		BreakAllNodeLinks();
+		return;
+	}
+
+	// The children are built before the parents, so every node is linked to the branches already spawned.
+	TArray<UK2Node_IfThenElse*> Branches;
+	for (const ACFDecisionTable::FTreeNode& TreeNode : Builder.Nodes)
+	{
+		UK2Node_IfThenElse* Branch = CompilerContext.SpawnIntermediateNode<UK2Node_IfThenElse>(this, SourceGraph);
+		Branch->AllocateDefaultPins();
+		CompilerContext.CopyPinLinksToIntermediate(*GetConditionPin(Conditions[TreeNode.Condition]), *Branch->GetConditionPin());
+
+		const int32 Children[2] = {TreeNode.FalseChild, TreeNode.TrueChild};
+		UEdGraphPin* ChildExecPins[2] = {Branch->GetElsePin(), Branch->GetThenPin()};
+		for (int32 Index = 0; Index < 2; ++Index)
+		{
+			if (Children[Index] >= 0)
+			{
+				ChildExecPins[Index]->MakeLinkTo(Branches[Children[Index]]->GetExecPin());
+			}
+			else
+			{
+				CompilerContext.CopyPinLinksToIntermediate(*OutcomeExecPins[-1 - Children[Index]], *ChildExecPins[Index]);
+			}
+		}
+
+		Branches.Add(Branch);
+	}
+
+	if (Root >= 0)
+	{
+		CompilerContext.MovePinLinksToIntermediate(*GetExecPin(), *Branches[Root]->GetExecPin());
+	}
+	else
+	{
+		// The outcome is decided without any condition.
+		UK2Node_ExecutionSequence* Sequence = CompilerContext.SpawnIntermediateNode<UK2Node_ExecutionSequence>(this, SourceGraph);
+		Sequence->AllocateDefaultPins();
+		CompilerContext.MovePinLinksToIntermediate(*GetExecPin(), *Sequence->GetExecPin());
+		CompilerContext.CopyPinLinksToIntermediate(*OutcomeExecPins[-1 - Root], *Sequence->GetThenPinGivenIndex(0));
+	}
+
+	BreakAllNodeLinks();
+}
+
+void UK2Node_DecisionTable::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UK2Node_DecisionTable, DecisionTable))
+	{
+		ReconstructNode();
+		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(GetBlueprint());
+	}
+}
+
+void UK2Node_DecisionTable::CreateExecTriggeringPin()
+{
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Execute);
+}
+
+void UK2Node_DecisionTable::CreateConditionPin(FName Condition)
+{
+	UEdGraphPin* ConditionPin =
+		CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Boolean, *(ACFDecisionTable::ConditionPinNamePrefix + Condition.ToString()));
+	ConditionPin->PinFriendlyName = FText::FromName(Condition);
+}
+
+void UK2Node_DecisionTable::CreateOutcomeExecPin(FName Outcome)
+{
+	UEdGraphPin* OutcomeExecPin =
+		CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, *(ACFDecisionTable::OutcomePinNamePrefix + Outcome.ToString()));
+	OutcomeExecPin->PinFriendlyName = FText::FromName(Outcome);
+}
+
+void UK2Node_DecisionTable::CreateDefaultExecPin()
+{
+	UEdGraphPin* DefaultExecPin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, DefaultExecPinName);
+	DefaultExecPin->PinFriendlyName = FText::AsCultureInvariant(DefaultExecPinFriendlyName.ToString());
+}
+
+UEdGraphPin* UK2Node_DecisionTable::GetConditionPin(FName Condition) const
+{
+	return FindPin(ACFDecisionTable::ConditionPinNamePrefix + Condition.ToString(), EGPD_Input);
+}
+
+UEdGraphPin* UK2Node_DecisionTable::GetOutcomeExecPin(FName Outcome) const
+{
+	return FindPin(ACFDecisionTable::OutcomePinNamePrefix + Outcome.ToString(), EGPD_Output);
+}
+
+UEdGraphPin* UK2Node_DecisionTable::GetDefaultExecPin() const
+{
+	return FindPin(DefaultExecPinName);
+}
+
+#undef LOCTEXT_NAMESPACE
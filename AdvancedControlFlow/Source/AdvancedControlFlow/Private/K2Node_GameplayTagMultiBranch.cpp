@@ -0,0 +1,308 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "K2Node_GameplayTagMultiBranch.h"
+
+#include "ACFGameplayTagLibrary.h"
+#include "BlueprintNodeSpawner.h"
+#include "EditorCategoryUtils.h"
+#include "GraphEditorSettings.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_MakeArray.h"
+#include "K2Node_SwitchInteger.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "KismetCompiler.h"
+
+#define LOCTEXT_NAMESPACE "AdvancedControlFlow"
+
+static const FName GameplayTagBranchTagsPinName(TEXT("Tags"));
+
+UK2Node_GameplayTagMultiBranch::UK2Node_GameplayTagMultiBranch(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	NodeContextMenuSectionName = "K2NodeGameplayTagMultiBranch";
+	NodeContextMenuSectionLabel = LOCTEXT("GameplayTagMultiBranch", "Gameplay Tag Multi-Branch");
+	CaseKeyPinNamePrefix = TEXT("CaseTags");
+	CaseValuePinNamePrefix = TEXT("CaseExec");
+	CaseKeyPinFriendlyNamePrefix = TEXT("Tags ");
+	CaseValuePinFriendlyNamePrefix = TEXT(" ");
+	bMatchAll = false;
+	bExactMatch = false;
+}
+
+void UK2Node_GameplayTagMultiBranch::AllocateDefaultPins()
+{
+	// Pin structure
+	//   N: Number of case pin pair
+	// -----
+	// 0: Execution Triggering (In, Exec)
+	// 1: Tags (In, Gameplay Tag Container)
+	// 2: Default Execution (Out, Exec)
+	// 3 - 2+N: Case Tags (In, Literal Gameplay Tag Container)
+	// 2+N+1 - 2*(N+1): Case Execution (Out, Exec)
+
+	CreateExecTriggeringPin();
+	CreateTagsPin();
+	CreateDefaultExecPin();
+
+	for (int32 Index = 0; Index < 2; ++Index)
+	{
+		AddCasePinPair(Index);
+	}
+
+	Super::AllocateDefaultPins();
+}
+
+FText UK2Node_GameplayTagMultiBranch::GetTooltipText() const
+{
+	return LOCTEXT("GameplayTagMultiBranch_Tooltip",
+		"Gameplay Tag Multi-Branch\nExecution goes to the first case whose tags match the tags.\nThe tags are read once for all "
+		"cases.");
+}
+
+FLinearColor UK2Node_GameplayTagMultiBranch::GetNodeTitleColor() const
+{
+	return GetDefault<UGraphEditorSettings>()->ExecBranchNodeTitleColor;
+}
+
+FText UK2Node_GameplayTagMultiBranch::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("GameplayTagMultiBranch", "Gameplay Tag Multi-Branch");
+}
+
+FSlateIcon UK2Node_GameplayTagMultiBranch::GetIconAndTint(FLinearColor& OutColor) const
+{
+	static FSlateIcon Icon("EditorStyle", "GraphEditor.Branch_16x");
+	return Icon;
+}
+
+void UK2Node_GameplayTagMultiBranch::ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins)
+{
+	CreateExecTriggeringPin();
+	CreateTagsPin();
+	CreateDefaultExecPin();
+
+	Super::ReallocatePinsDuringReconstruction(OldPins);
+}
+
+void UK2Node_GameplayTagMultiBranch::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
+{
+	UClass* ActionKey = GetClass();
+	if (ActionRegistrar.IsOpenForRegistration(ActionKey))
+	{
+		UBlueprintNodeSpawner* NodeSpawner = UBlueprintNodeSpawner::Create(GetClass());
+		check(NodeSpawner != nullptr);
+
+		ActionRegistrar.AddBlueprintAction(ActionKey, NodeSpawner);
+	}
+}
+
+FText UK2Node_GameplayTagMultiBranch::GetMenuCategory() const
+{
+	return FEditorCategoryUtils::GetCommonCategory(FCommonEditorCategory::FlowControl);
+}
+
+void UK2Node_GameplayTagMultiBranch::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	Super::ExpandNode(CompilerContext, SourceGraph);
+
+	TArray<CasePinPair> CasePinPairs = GetCasePinPairs();
+	TArray<FGameplayTagContainer> Cases;
+	bool bError = false;
+	for (auto& Pair : CasePinPairs)
+	{
+		FGameplayTagContainer& CaseTags = Cases.AddDefaulted_GetRef();
+		if (!GetCaseTags(Pair.Key, CaseTags))
+		{
+			CompilerContext.MessageLog.Error(
+				*LOCTEXT("GameplayTagMultiBranchInvalidTags_Error", "@@ has invalid tags").ToString(), Pair.Key);
+			bError = true;
+		}
+	}
+	if (bError)
+	{
+		BreakAllNodeLinks();
+		return;
+	}
+
+	if (ShouldCountCaseHits(false))
+	{
+		ExpandCaseHitCounters(CompilerContext, SourceGraph);
+	}
+
+	if (ShouldEmitTraceEvents())
+	{
+		// The cases are tested in order after the container is read.
+		TArray<int32> NumConditions;
+		for (int32 Index = 0; Index < CasePinPairs.Num(); ++Index)
+		{
+			NumConditions.Add(Index + 1);
+		}
+		NumConditions.Add(CasePinPairs.Num());
+		ExpandTraceEvents(CompilerContext, SourceGraph, NumConditions);
+	}
+
+	// The index of the matched case switches the execution.
+	const UEdGraphSchema_K2* Schema = CompilerContext.GetSchema();
+	UK2Node_CallFunction* FindCase = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+	const FString EncodedCases = ACFGameplayTags::EncodeCases(bMatchAll, bExactMatch, Cases);
+	if (!EncodedCases.IsEmpty())
+	{
+		FindCase->SetFromFunction(UACFGameplayTagLibrary::StaticClass()->FindFunctionByName(
+			GET_FUNCTION_NAME_CHECKED(UACFGameplayTagLibrary, FindGameplayTagCase)));
+		FindCase->AllocateDefaultPins();
+		Schema->TrySetDefaultValue(*FindCase->FindPinChecked(TEXT("Cases")), EncodedCases);
+	}
+	else
+	{
+		// The cases which do not fit in a name literal are tested one by one.
+		FindCase->SetFromFunction(UACFGameplayTagLibrary::StaticClass()->FindFunctionByName(
+			GET_FUNCTION_NAME_CHECKED(UACFGameplayTagLibrary, FindGameplayTagCaseInArray)));
+		FindCase->AllocateDefaultPins();
+		Schema->TrySetDefaultValue(*FindCase->FindPinChecked(TEXT("bMatchAll")), bMatchAll ? TEXT("true") : TEXT("false"));
+		Schema->TrySetDefaultValue(*FindCase->FindPinChecked(TEXT("bExactMatch")), bExactMatch ? TEXT("true") : TEXT("false"));
+
+		UK2Node_MakeArray* MakeArray = CompilerContext.SpawnIntermediateNode<UK2Node_MakeArray>(this, SourceGraph);
+		MakeArray->AllocateDefaultPins();
+		for (int32 Index = 1; Index < CasePinPairs.Num(); ++Index)
+		{
+			MakeArray->AddInputPin();
+		}
+
+		TArray<UEdGraphPin*> ElementPins;
+		for (auto& Pin : MakeArray->Pins)
+		{
+			if (Pin->Direction == EGPD_Input)
+			{
+				ElementPins.Add(Pin);
+			}
+		}
+		for (int32 Index = 0; Index < CasePinPairs.Num(); ++Index)
+		{
+			ElementPins[Index]->PinType = CasePinPairs[Index].Key->PinType;
+			ElementPins[Index]->DefaultValue = CasePinPairs[Index].Key->DefaultValue;
+		}
+
+		UEdGraphPin* ArrayPin = MakeArray->GetOutputPin();
+		ArrayPin->PinType = CasePinPairs[0].Key->PinType;
+		ArrayPin->PinType.ContainerType = EPinContainerType::Array;
+		ArrayPin->MakeLinkTo(FindCase->FindPinChecked(TEXT("Cases")));
+	}
+	CompilerContext.MovePinLinksToIntermediate(*GetTagsPin(), *FindCase->FindPinChecked(TEXT("Tags")));
+
+	UK2Node_SwitchInteger* Switch = CompilerContext.SpawnIntermediateNode<UK2Node_SwitchInteger>(this, SourceGraph);
+	Switch->AllocateDefaultPins();
+	for (int32 Index = 0; Index < CasePinPairs.Num(); ++Index)
+	{
+		Switch->AddPinToSwitchNode();
+	}
+
+	CompilerContext.MovePinLinksToIntermediate(*GetExecPin(), *Switch->GetExecPin());
+	FindCase->GetReturnValuePin()->MakeLinkTo(Switch->GetSelectionPin());
+	for (int32 Index = 0; Index < CasePinPairs.Num(); ++Index)
+	{
+		CompilerContext.MovePinLinksToIntermediate(*CasePinPairs[Index].Value, *Switch->FindPinChecked(*FString::FromInt(Index)));
+	}
+	CompilerContext.MovePinLinksToIntermediate(*GetDefaultExecPin(), *Switch->GetDefaultPin());
+
+	BreakAllNodeLinks();
+}
+
+void UK2Node_GameplayTagMultiBranch::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	const FName PropertyName = PropertyChangedEvent.GetPropertyName();
+	if ((PropertyName == GET_MEMBER_NAME_CHECKED(UK2Node_GameplayTagMultiBranch, bMatchAll)) ||
+		(PropertyName == GET_MEMBER_NAME_CHECKED(UK2Node_GameplayTagMultiBranch, bExactMatch)))
+	{
+		FBlueprintEditorUtils::MarkBlueprintAsModified(GetBlueprint());
+	}
+}
+
+void UK2Node_GameplayTagMultiBranch::CreateExecTriggeringPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 0;
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Execute, Params);
+}
+
+void UK2Node_GameplayTagMultiBranch::CreateTagsPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 1;
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Struct, FGameplayTagContainer::StaticStruct(), GameplayTagBranchTagsPinName,
+		Params);
+}
+
+void UK2Node_GameplayTagMultiBranch::CreateDefaultExecPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 2;
+	UEdGraphPin* DefaultExecPin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, DefaultExecPinName, Params);
+	DefaultExecPin->PinFriendlyName = FText::AsCultureInvariant(DefaultExecPinFriendlyName.ToString());
+}
+
+UEdGraphPin* UK2Node_GameplayTagMultiBranch::GetTagsPin() const
+{
+	return FindPin(GameplayTagBranchTagsPinName);
+}
+
+UEdGraphPin* UK2Node_GameplayTagMultiBranch::GetDefaultExecPin() const
+{
+	return FindPin(DefaultExecPinName);
+}
+
+CasePinPair UK2Node_GameplayTagMultiBranch::AddCasePinPair(int32 CaseIndex)
+{
+	CasePinPair Pair;
+	int32 N = GetCasePinCount();
+
+	{
+		FCreatePinParams Params;
+		Params.Index = 3 + CaseIndex;
+		Pair.Key = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Struct, FGameplayTagContainer::StaticStruct(),
+			*GetCasePinName(CaseKeyPinNamePrefix.ToString(), CaseIndex), Params);
+		Pair.Key->PinFriendlyName =
+			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseKeyPinFriendlyNamePrefix.ToString(), CaseIndex));
+		Pair.Key->bNotConnectable = true;
+	}
+	{
+		FCreatePinParams Params;
+		Params.Index = 3 + N + 1 + CaseIndex;
+		Pair.Value = CreatePin(
+			EGPD_Output, UEdGraphSchema_K2::PC_Exec, *GetCasePinName(CaseValuePinNamePrefix.ToString(), CaseIndex), Params);
+		Pair.Value->PinFriendlyName =
+			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseValuePinFriendlyNamePrefix.ToString(), CaseIndex));
+	}
+
+	return Pair;
+}
+
+TArray<UEdGraphPin*> UK2Node_GameplayTagMultiBranch::GetCaseConditionPins() const
+{
+	// The cases are chosen by the literal tags, not by the conditions.
+	return TArray<UEdGraphPin*>();
+}
+
+bool UK2Node_GameplayTagMultiBranch::GetCaseTags(const UEdGraphPin* CaseTagsPin, FGameplayTagContainer& OutTags) const
+{
+	OutTags.Reset();
+	if ((CaseTagsPin == nullptr) || CaseTagsPin->DefaultValue.IsEmpty())
+	{
+		return CaseTagsPin != nullptr;
+	}
+
+	UScriptStruct* Struct = FGameplayTagContainer::StaticStruct();
+	return Struct->ImportText(*CaseTagsPin->DefaultValue, &OutTags, nullptr, PPF_None, GLog, Struct->GetName()) != nullptr;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -11,11 +11,21 @@
 
 #include "K2Node_MultiBranch.h"
 
+#include "ACFCaseProfile.h"
+#include "ACFConditionLibrary.h"
+#include "ACFParallelLibrary.h"
+#include "ACFThrottleLibrary.h"
+#include "ACFTrace.h"
 #include "BlueprintNodeSpawner.h"
 #include "EdGraphSchema_K2.h"
 #include "EdGraphUtilities.h"
 #include "EditorCategoryUtils.h"
 #include "GraphEditorSettings.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_IfThenElse.h"
+#include "K2Node_SwitchInteger.h"
+#include "K2Node_TemporaryVariable.h"
+#include "Kismet2/BlueprintEditorUtils.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "KismetCompiledFunctionContext.h"
 #include "KismetCompiler.h"
@@ -23,9 +33,64 @@
 
 #define LOCTEXT_NAMESPACE "AdvancedControlFlow"
 
+// From this number of cases, the case is found by Find First True Condition and the binary search on the case index.
+static const int32 MinCasesForFindFirstTrueCondition = 8;
+
+static const FName ForceRefreshPinName(TEXT("ForceRefresh"));
+static const FName LegacyFunctionPinName(TEXT("Not_PreBool"));
+
 class FKCHandler_MultiBranch : public FNodeHandlingFunctor
 {
 	TMap<UEdGraphNode*, FBPTerminal*> BoolTermMap;
+	TMap<UEdGraphNode*, FBPTerminal*> IndexTermMap;
+
+	// Bool = Index < Value, and goto the returned statement if not.
+	FBlueprintCompiledStatement& CompileGotoIfIndexNotLess(FKismetFunctionContext& Context, UEdGraphNode* Node, int32 Value,
+		FBlueprintCompiledStatement*& OutFirstStatement)
+	{
+		FBPTerminal* LiteralTerm = Context.CreateLocalTerminal(ETerminalSpecification::TS_Literal);
+		LiteralTerm->Type.PinCategory = UEdGraphSchema_K2::PC_Int;
+		LiteralTerm->Source = Node;
+		LiteralTerm->Name = FString::FromInt(Value);
+
+		FBlueprintCompiledStatement& CallFuncStatement = Context.AppendStatementForNode(Node);
+		CallFuncStatement.Type = KCST_CallFunction;
+		CallFuncStatement.FunctionToCall = UKismetMathLibrary::StaticClass()->FindFunctionByName(
+			GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, Less_IntInt));
+		CallFuncStatement.LHS = BoolTermMap.FindRef(Node);
+		CallFuncStatement.RHS.Add(IndexTermMap.FindRef(Node));
+		CallFuncStatement.RHS.Add(LiteralTerm);
+		OutFirstStatement = &CallFuncStatement;
+
+		FBlueprintCompiledStatement& GotoStatement = Context.AppendStatementForNode(Node);
+		GotoStatement.Type = KCST_GotoIfNot;
+		GotoStatement.LHS = BoolTermMap.FindRef(Node);
+
+		return GotoStatement;
+	}
+
+	// Binary search for the case of Index in [Begin, End). Returns the first statement.
+	FBlueprintCompiledStatement* CompileCaseSearch(
+		FKismetFunctionContext& Context, UEdGraphNode* Node, const TArray<UEdGraphPin*>& ExecPins, int32 Begin, int32 End)
+	{
+		if (End - Begin == 1)
+		{
+			FBlueprintCompiledStatement& GotoStatement = Context.AppendStatementForNode(Node);
+			GotoStatement.Type = KCST_UnconditionalGoto;
+			Context.GotoFixupRequestMap.Add(&GotoStatement, ExecPins[Begin]);
+			return &GotoStatement;
+		}
+
+		const int32 Mid = (Begin + End) / 2;
+		FBlueprintCompiledStatement* FirstStatement = nullptr;
+		FBlueprintCompiledStatement& GotoUpperStatement = CompileGotoIfIndexNotLess(Context, Node, Mid, FirstStatement);
+		CompileCaseSearch(Context, Node, ExecPins, Begin, Mid);
+		FBlueprintCompiledStatement* UpperStatement = CompileCaseSearch(Context, Node, ExecPins, Mid, End);
+		GotoUpperStatement.TargetLabel = UpperStatement;
+		UpperStatement->bIsJumpTarget = true;
+
+		return FirstStatement;
+	}
 
 public:
 	FKCHandler_MultiBranch(FKismetCompilerContext& InCompilerContext) : FNodeHandlingFunctor(InCompilerContext)
@@ -41,8 +106,14 @@ public:
 		FBPTerminal* BoolTerm = Context.CreateLocalTerminal();
 		BoolTerm->Type.PinCategory = UEdGraphSchema_K2::PC_Boolean;
 		BoolTerm->Source = Node;
-		BoolTerm->Name = Context.NetNameMap->MakeValidName(Node, TEXT("Inverted"));
+		BoolTerm->Name = Context.NetNameMap->MakeValidName(Node, TEXT("IsLess"));
 		BoolTermMap.Add(Node, BoolTerm);
+
+		FBPTerminal* IndexTerm = Context.CreateLocalTerminal();
+		IndexTerm->Type.PinCategory = UEdGraphSchema_K2::PC_Int;
+		IndexTerm->Source = Node;
+		IndexTerm->Name = Context.NetNameMap->MakeValidName(Node, TEXT("CaseIndex"));
+		IndexTermMap.Add(Node, IndexTerm);
 	}
 
 	virtual void Compile(FKismetFunctionContext& Context, UEdGraphNode* Node) override
@@ -72,14 +143,8 @@ public:
 
 		UEdGraphPin* DefaultExecPin = MultiBranchNode->GetDefaultExecPin();
 
-		UEdGraphPin* FunctionPin = MultiBranchNode->GetFunctionPin();
-		FBPTerminal* FunctionContext = Context.NetMap.FindRef(FunctionPin);
-		UClass* FunctionClass = Cast<UClass>(FunctionPin->PinType.PinSubCategoryObject.Get());
-		UFunction* FunctionPtr = FindUField<UFunction>(FunctionClass, FunctionPin->PinName);
-		check(FunctionPtr);
-
-		FBPTerminal* BoolTerm = BoolTermMap.FindRef(MultiBranchNode);
-
+		TArray<UEdGraphPin*> ExecPins;
+		TArray<FBPTerminal*> CondTerms;
 		for (auto PinIt = MultiBranchNode->Pins.CreateIterator(); PinIt; ++PinIt)
 		{
 			UEdGraphPin* ExecPin = *PinIt;
@@ -99,41 +164,81 @@ public:
 
 			UEdGraphPin* CondPin = MultiBranchNode->GetCaseKeyPinFromCaseValuePin(ExecPin);
 			UEdGraphPin* CondNet = FEdGraphUtilities::GetNetFromPin(CondPin);
-			FBPTerminal* CondValueTerm = Context.NetMap.FindRef(CondNet);
+			ExecPins.Add(ExecPin);
+			CondTerms.Add(Context.NetMap.FindRef(CondNet));
+		}
 
-			// Goto if Not_PreBool(Cond)
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+		if (ExecPins.Num() >= MinCasesForFindFirstTrueCondition)
+		{
+			// Index = FindFirstTrueCondition(Cond...)
 			{
 				FBlueprintCompiledStatement& CallFuncStatement = Context.AppendStatementForNode(MultiBranchNode);
 				CallFuncStatement.Type = KCST_CallFunction;
-				CallFuncStatement.FunctionToCall = FunctionPtr;
-				CallFuncStatement.FunctionContext = FunctionContext;
-				CallFuncStatement.bIsParentContext = false;
-				CallFuncStatement.LHS = BoolTerm;
-				CallFuncStatement.RHS.Add(CondValueTerm);
+				CallFuncStatement.FunctionToCall = UACFConditionLibrary::StaticClass()->FindFunctionByName(
+					GET_FUNCTION_NAME_CHECKED(UACFConditionLibrary, FindFirstTrueCondition));
+				CallFuncStatement.LHS = IndexTermMap.FindRef(MultiBranchNode);
+				CallFuncStatement.RHS = CondTerms;
+			}
 
-				FBlueprintCompiledStatement& GotoStatement = Context.AppendStatementForNode(MultiBranchNode);
-				GotoStatement.Type = KCST_GotoIfNot;
-				GotoStatement.LHS = BoolTerm;
+			// Goto default if Index < 0, otherwise search the case.
+			FBlueprintCompiledStatement* FirstStatement = nullptr;
+			FBlueprintCompiledStatement& GotoCasesStatement =
+				CompileGotoIfIndexNotLess(Context, MultiBranchNode, 0, FirstStatement);
+			GenerateSimpleThenGoto(Context, *MultiBranchNode, DefaultExecPin);
+			FBlueprintCompiledStatement* CasesStatement =
+				CompileCaseSearch(Context, MultiBranchNode, ExecPins, 0, ExecPins.Num());
+			GotoCasesStatement.TargetLabel = CasesStatement;
+			CasesStatement->bIsJumpTarget = true;
+
+			return;
+		}
+#endif
 
-				Context.GotoFixupRequestMap.Add(&GotoStatement, ExecPin);
+		// Goto the next case if not Cond, otherwise goto the case.
+		// The condition is tested directly without calling a function, so the node can be used in the thread-safe graphs.
+		FBlueprintCompiledStatement* PrevGotoIfNotStatement = nullptr;
+		for (int32 Index = 0; Index <= ExecPins.Num(); ++Index)
+		{
+			FBlueprintCompiledStatement& Statement = Context.AppendStatementForNode(MultiBranchNode);
+			if (PrevGotoIfNotStatement != nullptr)
+			{
+				PrevGotoIfNotStatement->TargetLabel = &Statement;
+				Statement.bIsJumpTarget = true;
 			}
-		}
 
-		// Goto default
-		GenerateSimpleThenGoto(Context, *MultiBranchNode, DefaultExecPin);
+			// Goto default
+			if (Index == ExecPins.Num())
+			{
+				Statement.Type = KCST_UnconditionalGoto;
+				Context.GotoFixupRequestMap.Add(&Statement, DefaultExecPin);
+				break;
+			}
+
+			Statement.Type = KCST_GotoIfNot;
+			Statement.LHS = CondTerms[Index];
+			PrevGotoIfNotStatement = &Statement;
+
+			FBlueprintCompiledStatement& GotoStatement = Context.AppendStatementForNode(MultiBranchNode);
+			GotoStatement.Type = KCST_UnconditionalGoto;
+			Context.GotoFixupRequestMap.Add(&GotoStatement, ExecPins[Index]);
+		}
 	}
 };
 
 UK2Node_MultiBranch::UK2Node_MultiBranch(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
-	ConditionPreProcessFuncClass = UKismetMathLibrary::StaticClass();
-	ConditionPreProcessFuncName = TEXT("Not_PreBool");
 	NodeContextMenuSectionName = "K2NodeMultiBranch";
 	NodeContextMenuSectionLabel = LOCTEXT("MultiBranch", "MultiBranch");
 	CaseKeyPinNamePrefix = TEXT("CaseCond");
 	CaseValuePinNamePrefix = TEXT("CaseExec");
 	CaseKeyPinFriendlyNamePrefix = TEXT("Condition ");
 	CaseValuePinFriendlyNamePrefix = TEXT(" ");
+	bCasesMutuallyExclusive = false;
+	bParallelConditions = false;
+	bUseExpressions = false;
+	ThrottleMode = EACFThrottleMode::Disabled;
+	ThrottleInterval = 0.25f;
 }
 
 void UK2Node_MultiBranch::AllocateDefaultPins()
@@ -141,17 +246,27 @@ void UK2Node_MultiBranch::AllocateDefaultPins()
 	// Pin structure
 	//   N: Number of case pin pair
 	// -----
-	// 0: Internal function (Hidden, Object)
-	// 1: Execution Triggering (In, Exec)
-	// 2: Default Execution (Out, Exec)
-	// 3 - 2+N: Case Conditional (In, Boolean)
-	// 2+N+1 - 2*(N+1): Case Execution (Out, Exec)
+	// 0: Execution Triggering (In, Exec)
+	// 1: Default Execution (Out, Exec)
+	// 2 - 1+N: Case Conditional (In, Boolean)
+	// 1+N+1 - 2*(N+1)-1: Case Execution (Out, Exec)
+	// After them: Force Refresh (In, Boolean) if the throttle is enabled
+	// After them: Expression Input (In, Boolean/Integer/Float) if the expressions are used
+	//   The case conditional is the expression (In, Literal String) instead.
 
-	CreateFunctionPin();
 	CreateExecTriggeringPin();
 	CreateDefaultExecPin();
 
 	Super::AllocateDefaultPins();
+
+	if (ThrottleMode != EACFThrottleMode::Disabled)
+	{
+		CreateForceRefreshPin();
+	}
+	if (bUseExpressions)
+	{
+		FACFExpressionCompiler::CreateInputPins(this, ExpressionInputs);
+	}
 }
 
 FText UK2Node_MultiBranch::GetTooltipText() const
@@ -177,11 +292,28 @@ FSlateIcon UK2Node_MultiBranch::GetIconAndTint(FLinearColor& OutColor) const
 
 void UK2Node_MultiBranch::ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins)
 {
-	CreateFunctionPin();
+	// The hidden function pin of the older version is no longer used.
+	for (UEdGraphPin* OldPin : OldPins)
+	{
+		if (OldPin->PinName == LegacyFunctionPinName)
+		{
+			OldPin->bSavePinIfOrphaned = false;
+		}
+	}
+
 	CreateExecTriggeringPin();
 	CreateDefaultExecPin();
 
 	Super::ReallocatePinsDuringReconstruction(OldPins);
+
+	if (ThrottleMode != EACFThrottleMode::Disabled)
+	{
+		CreateForceRefreshPin();
+	}
+	if (bUseExpressions)
+	{
+		FACFExpressionCompiler::CreateInputPins(this, ExpressionInputs);
+	}
 }
 
 class FNodeHandlingFunctor* UK2Node_MultiBranch::CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const
@@ -206,6 +338,204 @@ FText UK2Node_MultiBranch::GetMenuCategory() const
 	return FEditorCategoryUtils::GetCommonCategory(FCommonEditorCategory::FlowControl);
 }
 
+void UK2Node_MultiBranch::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	Super::ExpandNode(CompilerContext, SourceGraph);
+
+	if ((ThrottleMode != EACFThrottleMode::Disabled) && !ExpandThrottle(CompilerContext, SourceGraph))
+	{
+		BreakAllNodeLinks();
+		return;
+	}
+
+	const bool bCountCaseHits = ShouldCountCaseHits(bCasesMutuallyExclusive);
+	if (bCountCaseHits)
+	{
+		ExpandCaseHitCounters(CompilerContext, SourceGraph);
+	}
+
+	if (bParallelConditions && !bUseExpressions && ExpandParallelConditions(CompilerContext, SourceGraph))
+	{
+		BreakAllNodeLinks();
+		return;
+	}
+
+	if (!bCasesMutuallyExclusive && !bUseExpressions)
+	{
+		if (ShouldEmitTraceEvents())
+		{
+			// FKCHandler_MultiBranch evaluates all conditions before taking a case.
+			TArray<int32> NumConditions;
+			NumConditions.Init(GetCasePinCount(), GetCasePinCount() + 1);
+			ExpandTraceEvents(CompilerContext, SourceGraph, NumConditions);
+		}
+
+		// Compiled by FKCHandler_MultiBranch.
+		return;
+	}
+
+	TArray<CasePinPair> CasePairs;
+	TArray<UEdGraphPin*> CondPins;
+	for (auto& Pair : GetCasePinPairs())
+	{
+		if (Pair.Value->LinkedTo.Num() > 0)
+		{
+			CasePairs.Add(Pair);
+			CondPins.Add(Pair.Key);
+		}
+	}
+	const FString NodeKey = FACFCaseProfile::MakeNodeKey(CompilerContext, this);
+
+	// Hit counts do not depend on the order of the mutually exclusive cases, so keep the order while counting.
+	// The cases which may be true at the same time are tested in the order of the pins.
+	TArray<int32> Order;
+	if (bCountCaseHits || !bCasesMutuallyExclusive)
+	{
+		for (int32 Index = 0; Index < CasePairs.Num(); ++Index)
+		{
+			Order.Add(Index);
+		}
+	}
+	else
+	{
+		// Cases whose execution pin is not connected are skipped, so map the profile to the remaining cases.
+		const TArray<uint64>* ProfiledHits = FACFCaseProfile::Get().FindCaseHits(NodeKey, GetCasePinCount());
+		TArray<uint64> CaseHits;
+		if (ProfiledHits != nullptr)
+		{
+			for (auto& Pair : CasePairs)
+			{
+				int32 CaseIndex = GetCaseIndexFromCaseKeyPin(Pair.Key);
+				CaseHits.Add(ProfiledHits->IsValidIndex(CaseIndex) ? (*ProfiledHits)[CaseIndex] : 0);
+			}
+		}
+		Order = GetCaseEvaluationOrder(CondPins, (ProfiledHits != nullptr) ? &CaseHits : nullptr);
+	}
+
+	if (ShouldEmitTraceEvents())
+	{
+		// Each case is taken after testing the preceding cases in the evaluation order.
+		TArray<int32> NumConditions;
+		NumConditions.Init(0, GetCasePinCount() + 1);
+		for (int32 OrderIndex = 0; OrderIndex < Order.Num(); ++OrderIndex)
+		{
+			NumConditions[GetCaseIndexFromCaseKeyPin(CasePairs[Order[OrderIndex]].Key)] = OrderIndex + 1;
+		}
+		NumConditions.Last() = Order.Num();
+		ExpandTraceEvents(CompilerContext, SourceGraph, NumConditions);
+	}
+
+	if (CasePairs.Num() == 0)
+	{
+		// No case can be taken, so the execution goes to the default directly.
+		// The links are broken as the other expanded paths do, since the handler cannot compile the expression pins.
+		UEdGraphPin* DefaultExecPin = GetDefaultExecPin();
+		if (DefaultExecPin->LinkedTo.Num() > 0)
+		{
+			for (UEdGraphPin* SourcePin : GetExecPin()->LinkedTo)
+			{
+				SourcePin->MakeLinkTo(DefaultExecPin->LinkedTo[0]);
+			}
+		}
+		BreakAllNodeLinks();
+		return;
+	}
+
+	FACFExpressionCompiler ExpressionCompiler(CompilerContext, SourceGraph, this, ExpressionInputs);
+	TArray<TSharedPtr<const FACFExpression>> Expressions;
+	if (bUseExpressions)
+	{
+		bool bValid = true;
+		for (auto& Pair : CasePairs)
+		{
+			Expressions.Add(ExpressionCompiler.ParseCondition(Pair.Key));
+			bValid &= Expressions.Last().IsValid();
+		}
+		if (!bValid)
+		{
+			BreakAllNodeLinks();
+			return;
+		}
+	}
+
+	// Expand to the chain of Branch nodes, so that each condition is evaluated only when the preceding tests fail.
+	// The expression is expanded to the Branch nodes of its own, which skip the rest of && and || like C++.
+	TArray<UEdGraphPin*> ElsePins;
+	for (int32 OrderIndex : Order)
+	{
+		UEdGraphPin* CaseCondPin = CasePairs[OrderIndex].Key;
+		UEdGraphPin* CaseExecPin = CasePairs[OrderIndex].Value;
+
+		UEdGraphPin* EntryPin = nullptr;
+		TArray<UEdGraphPin*> ThenPins;
+		TArray<UEdGraphPin*> NextElsePins;
+		if (bUseExpressions)
+		{
+			EntryPin = ExpressionCompiler.ExpandBranch(*Expressions[OrderIndex], ThenPins, NextElsePins);
+		}
+		else
+		{
+			UK2Node_IfThenElse* IfThenElse = CompilerContext.SpawnIntermediateNode<UK2Node_IfThenElse>(this, SourceGraph);
+			IfThenElse->AllocateDefaultPins();
+			CompilerContext.MovePinLinksToIntermediate(*CaseCondPin, *IfThenElse->GetConditionPin());
+			EntryPin = IfThenElse->GetExecPin();
+			ThenPins.Add(IfThenElse->GetThenPin());
+			NextElsePins.Add(IfThenElse->GetElsePin());
+		}
+
+		if (OrderIndex == Order[0])
+		{
+			CompilerContext.MovePinLinksToIntermediate(*GetExecPin(), *EntryPin);
+		}
+		for (auto& ElsePin : ElsePins)
+		{
+			ElsePin->MakeLinkTo(EntryPin);
+		}
+		for (auto& ThenPin : ThenPins)
+		{
+			CompilerContext.CopyPinLinksToIntermediate(*CaseExecPin, *ThenPin);
+		}
+
+		ElsePins = NextElsePins;
+	}
+
+	for (auto& ElsePin : ElsePins)
+	{
+		CompilerContext.CopyPinLinksToIntermediate(*GetDefaultExecPin(), *ElsePin);
+	}
+
+	BreakAllNodeLinks();
+}
+
+void UK2Node_MultiBranch::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	if ((PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UK2Node_MultiBranch, bCasesMutuallyExclusive)) ||
+		(PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UK2Node_MultiBranch, bParallelConditions)) ||
+		(PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UK2Node_MultiBranch, ThrottleInterval)))
+	{
+		FBlueprintEditorUtils::MarkBlueprintAsModified(GetBlueprint());
+	}
+	else if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UK2Node_MultiBranch, bUseExpressions))
+	{
+		// The condition pins change between the Boolean pins and the expressions, and "false" is valid for both.
+		for (auto& CondPin : GetCaseConditionPins())
+		{
+			CondPin->BreakAllPinLinks();
+			CondPin->DefaultValue = TEXT("false");
+		}
+		ReconstructNode();
+		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(GetBlueprint());
+	}
+	else if ((PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UK2Node_MultiBranch, ThrottleMode)) ||
+			 (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UK2Node_MultiBranch, ExpressionInputs)))
+	{
+		ReconstructNode();
+		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(GetBlueprint());
+	}
+}
+
 CasePinPair UK2Node_MultiBranch::AddCasePinPair(int32 CaseIndex)
 {
 	CasePinPair Pair;
@@ -213,15 +543,20 @@ CasePinPair UK2Node_MultiBranch::AddCasePinPair(int32 CaseIndex)
 
 	{
 		FCreatePinParams Params;
-		Params.Index = 3 + CaseIndex;
-		Pair.Key = CreatePin(
-			EGPD_Input, UEdGraphSchema_K2::PC_Boolean, *GetCasePinName(CaseKeyPinNamePrefix.ToString(), CaseIndex), Params);
+		Params.Index = 2 + CaseIndex;
+		Pair.Key = CreatePin(EGPD_Input, bUseExpressions ? UEdGraphSchema_K2::PC_String : UEdGraphSchema_K2::PC_Boolean,
+			*GetCasePinName(CaseKeyPinNamePrefix.ToString(), CaseIndex), Params);
 		Pair.Key->PinFriendlyName =
 			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseKeyPinFriendlyNamePrefix.ToString(), CaseIndex));
+		if (bUseExpressions)
+		{
+			Pair.Key->bNotConnectable = true;
+			Pair.Key->DefaultValue = TEXT("false");
+		}
 	}
 	{
 		FCreatePinParams Params;
-		Params.Index = 3 + N + 1 + CaseIndex;
+		Params.Index = 2 + N + 1 + CaseIndex;
 		Pair.Value = CreatePin(
 			EGPD_Output, UEdGraphSchema_K2::PC_Exec, *GetCasePinName(CaseValuePinNamePrefix.ToString(), CaseIndex), Params);
 		Pair.Value->PinFriendlyName =
@@ -231,44 +566,193 @@ CasePinPair UK2Node_MultiBranch::AddCasePinPair(int32 CaseIndex)
 	return Pair;
 }
 
-void UK2Node_MultiBranch::CreateFunctionPin()
+void UK2Node_MultiBranch::CreateExecTriggeringPin()
 {
 	FCreatePinParams Params;
 	Params.Index = 0;
-	UEdGraphPin* FunctionPin =
-		CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Object, ConditionPreProcessFuncClass, ConditionPreProcessFuncName, Params);
-	FunctionPin->bDefaultValueIsReadOnly = true;
-	FunctionPin->bNotConnectable = true;
-	FunctionPin->bHidden = true;
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Execute, Params);
+}
+
+void UK2Node_MultiBranch::CreateDefaultExecPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 1;
+	UEdGraphPin* DefaultExecPin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, DefaultExecPinName, Params);
+	DefaultExecPin->PinFriendlyName = FText::AsCultureInvariant(DefaultExecPinFriendlyName.ToString());
+}
+
+void UK2Node_MultiBranch::CreateForceRefreshPin()
+{
+	UEdGraphPin* ForceRefreshPin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Boolean, ForceRefreshPinName);
+	ForceRefreshPin->PinFriendlyName = LOCTEXT("ForceRefresh", "Force Refresh");
+	ForceRefreshPin->DefaultValue = TEXT("false");
+}
+
+bool UK2Node_MultiBranch::ExpandThrottle(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	// The state is held by a member variable of the instance, which only the event graph can add.
+	if (SourceGraph != CompilerContext.ConsolidatedEventGraph)
+	{
+		CompilerContext.MessageLog.Error(
+			*LOCTEXT("ThrottleNotInEventGraph_Error", "The throttle of @@ is available only in the event graph").ToString(),
+			this);
+		return false;
+	}
+
+	const UEdGraphSchema_K2* Schema = CompilerContext.GetSchema();
+
+	UK2Node_TemporaryVariable* State = CompilerContext.SpawnIntermediateNode<UK2Node_TemporaryVariable>(this, SourceGraph);
+	State->VariableType.PinCategory = UEdGraphSchema_K2::PC_Struct;
+	State->VariableType.PinSubCategoryObject = FACFThrottleState::StaticStruct();
+	State->bIsPersistent = true;
+	State->AllocateDefaultPins();
+	UEdGraphPin* StatePin = State->GetVariablePin();
+
+	UK2Node_CallFunction* Refresh = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+	Refresh->SetFromFunction(UACFThrottleLibrary::StaticClass()->FindFunctionByName(
+		GET_FUNCTION_NAME_CHECKED(UACFThrottleLibrary, RefreshThrottledCase)));
+	Refresh->AllocateDefaultPins();
+	StatePin->MakeLinkTo(Refresh->FindPinChecked(TEXT("State")));
+	Schema->TrySetDefaultValue(*Refresh->FindPinChecked(TEXT("Interval")), FString::SanitizeFloat(ThrottleInterval));
+	Schema->TrySetDefaultValue(
+		*Refresh->FindPinChecked(TEXT("bFrames")), (ThrottleMode == EACFThrottleMode::Frames) ? TEXT("true") : TEXT("false"));
+	CompilerContext.MovePinLinksToIntermediate(*GetForceRefreshPin(), *Refresh->FindPinChecked(TEXT("bForceRefresh")));
+	CompilerContext.MovePinLinksToIntermediate(*GetExecPin(), *Refresh->GetExecPin());
+
+	UK2Node_IfThenElse* IfThenElse = CompilerContext.SpawnIntermediateNode<UK2Node_IfThenElse>(this, SourceGraph);
+	IfThenElse->AllocateDefaultPins();
+	Refresh->GetThenPin()->MakeLinkTo(IfThenElse->GetExecPin());
+	Refresh->GetReturnValuePin()->MakeLinkTo(IfThenElse->GetConditionPin());
+	IfThenElse->GetThenPin()->MakeLinkTo(GetExecPin());
+
+	// Between the refreshes, the last case is taken by the switch without evaluating the conditions.
+	UK2Node_CallFunction* GetCase = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+	GetCase->SetFromFunction(UACFThrottleLibrary::StaticClass()->FindFunctionByName(
+		GET_FUNCTION_NAME_CHECKED(UACFThrottleLibrary, GetThrottledCase)));
+	GetCase->AllocateDefaultPins();
+	StatePin->MakeLinkTo(GetCase->FindPinChecked(TEXT("State")));
+
+	TArray<CasePinPair> CasePairs = GetCasePinPairs();
+	UK2Node_SwitchInteger* Switch = CompilerContext.SpawnIntermediateNode<UK2Node_SwitchInteger>(this, SourceGraph);
+	Switch->AllocateDefaultPins();
+	for (int32 Index = 0; Index < CasePairs.Num(); ++Index)
+	{
+		Switch->AddPinToSwitchNode();
+	}
+	IfThenElse->GetElsePin()->MakeLinkTo(Switch->GetExecPin());
+	GetCase->GetReturnValuePin()->MakeLinkTo(Switch->GetSelectionPin());
+
+	// The counters and the trace events of the node are inserted after this expansion and cover only the refreshes.
+	// The last case taken by the switch is counted and traced here as no condition is evaluated.
+	const bool bCountCaseHits = ShouldCountCaseHits(bCasesMutuallyExclusive);
+	uint64 CounterKey = 0;
+	if (bCountCaseHits)
+	{
+		CounterKey = FACFCaseProfile::Get().RegisterCounter(FACFCaseProfile::MakeNodeKey(CompilerContext, this), CasePairs.Num());
+	}
+	UK2Node_CallFunction* BeginTrace = nullptr;
+	if (ShouldEmitTraceEvents())
+	{
+		BeginTrace =
+			SpawnTraceCall(CompilerContext, SourceGraph, GET_FUNCTION_NAME_CHECKED(UACFTraceLibrary, BeginNodeEvaluation));
+		CompilerContext.MovePinLinksToIntermediate(*Switch->GetExecPin(), *BeginTrace->GetExecPin());
+		BeginTrace->GetThenPin()->MakeLinkTo(Switch->GetExecPin());
+	}
 
-	UFunction* Function = FindUField<UFunction>(ConditionPreProcessFuncClass, ConditionPreProcessFuncName);
-	if (Function != nullptr && Function->HasAllFunctionFlags(FUNC_Static))
+	// Each taken case records itself before the execution goes on. The case not connected is never taken.
+	for (int32 Index = 0; Index <= CasePairs.Num(); ++Index)
 	{
-		UBlueprint* Blueprint = GetBlueprint();
-		if (Blueprint != nullptr)
+		const bool bDefault = Index == CasePairs.Num();
+		UEdGraphPin* CaseExecPin = bDefault ? GetDefaultExecPin() : CasePairs[Index].Value;
+		if (!bDefault && (CaseExecPin->LinkedTo.Num() == 0))
 		{
-			UClass* FunctionOwnerClass = Function->GetOuterUClass();
-			if (!Blueprint->SkeletonGeneratedClass->IsChildOf(FunctionOwnerClass))
-			{
-				FunctionPin->DefaultObject = FunctionOwnerClass->GetDefaultObject();
-			}
+			continue;
+		}
+
+		UEdGraphPin* SwitchCasePin = bDefault ? Switch->GetDefaultPin() : Switch->FindPinChecked(*FString::FromInt(Index));
+		CompilerContext.CopyPinLinksToIntermediate(*CaseExecPin, *SwitchCasePin);
+		if (bCountCaseHits && (CaseExecPin->LinkedTo.Num() > 0))
+		{
+			UK2Node_CallFunction* CountCaseHit =
+				SpawnCaseHitCounter(CompilerContext, SourceGraph, CounterKey, CasePairs.Num() + 1, Index);
+			CompilerContext.MovePinLinksToIntermediate(*SwitchCasePin, *CountCaseHit->GetThenPin());
+			SwitchCasePin->MakeLinkTo(CountCaseHit->GetExecPin());
+		}
+		if (BeginTrace != nullptr)
+		{
+			UK2Node_CallFunction* EndTrace =
+				SpawnTraceCall(CompilerContext, SourceGraph, GET_FUNCTION_NAME_CHECKED(UACFTraceLibrary, EndNodeEvaluation));
+			BeginTrace->GetReturnValuePin()->MakeLinkTo(EndTrace->FindPinChecked(TEXT("Token")));
+			Schema->TrySetDefaultValue(*EndTrace->FindPinChecked(TEXT("NumConditions")), TEXT("0"));
+			Schema->TrySetDefaultValue(
+				*EndTrace->FindPinChecked(TEXT("CaseIndex")), FString::FromInt(bDefault ? INDEX_NONE : Index));
+			CompilerContext.MovePinLinksToIntermediate(*SwitchCasePin, *EndTrace->GetThenPin());
+			SwitchCasePin->MakeLinkTo(EndTrace->GetExecPin());
 		}
+
+		UK2Node_CallFunction* SetCase = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+		SetCase->SetFromFunction(UACFThrottleLibrary::StaticClass()->FindFunctionByName(
+			GET_FUNCTION_NAME_CHECKED(UACFThrottleLibrary, SetThrottledCase)));
+		SetCase->AllocateDefaultPins();
+		StatePin->MakeLinkTo(SetCase->FindPinChecked(TEXT("State")));
+		Schema->TrySetDefaultValue(*SetCase->FindPinChecked(TEXT("CaseIndex")), FString::FromInt(bDefault ? INDEX_NONE : Index));
+		CompilerContext.MovePinLinksToIntermediate(*CaseExecPin, *SetCase->GetThenPin());
+		CaseExecPin->MakeLinkTo(SetCase->GetExecPin());
 	}
-}
 
-void UK2Node_MultiBranch::CreateExecTriggeringPin()
-{
-	FCreatePinParams Params;
-	Params.Index = 1;
-	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Execute, Params);
+	return true;
 }
 
-void UK2Node_MultiBranch::CreateDefaultExecPin()
+bool UK2Node_MultiBranch::ExpandParallelConditions(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
 {
-	FCreatePinParams Params;
-	Params.Index = 2;
-	UEdGraphPin* DefaultExecPin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, DefaultExecPinName, Params);
-	DefaultExecPin->PinFriendlyName = FText::AsCultureInvariant(DefaultExecPinFriendlyName.ToString());
+	TArray<CasePinPair> CasePairs;
+	TArray<UEdGraphPin*> CondPins;
+	for (auto& Pair : GetCasePinPairs())
+	{
+		if (Pair.Value->LinkedTo.Num() > 0)
+		{
+			CasePairs.Add(Pair);
+			CondPins.Add(Pair.Key);
+		}
+	}
+
+	const FString Conditions = MakeParallelConditions(CondPins, SourceGraph);
+	if (Conditions.IsEmpty())
+	{
+		CompilerContext.MessageLog.Note(
+			*LOCTEXT("ParallelConditionsNotSupported_Note", "Conditions of @@ are evaluated on the game thread").ToString(), this);
+		return false;
+	}
+
+	if (ShouldEmitTraceEvents())
+	{
+		// All conditions are evaluated before taking a case.
+		TArray<int32> NumConditions;
+		NumConditions.Init(GetCasePinCount(), GetCasePinCount() + 1);
+		ExpandTraceEvents(CompilerContext, SourceGraph, NumConditions);
+	}
+
+	UK2Node_CallFunction* FindFirst = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+	FindFirst->SetFromFunction(UACFParallelLibrary::StaticClass()->FindFunctionByName(
+		GET_FUNCTION_NAME_CHECKED(UACFParallelLibrary, FindFirstTrueParallelCondition)));
+	FindFirst->AllocateDefaultPins();
+	CompilerContext.GetSchema()->TrySetDefaultValue(*FindFirst->FindPinChecked(TEXT("Conditions")), Conditions);
+
+	UK2Node_SwitchInteger* Switch = CompilerContext.SpawnIntermediateNode<UK2Node_SwitchInteger>(this, SourceGraph);
+	Switch->AllocateDefaultPins();
+	for (int32 Index = 0; Index < CasePairs.Num(); ++Index)
+	{
+		Switch->AddPinToSwitchNode();
+	}
+	FindFirst->GetReturnValuePin()->MakeLinkTo(Switch->GetSelectionPin());
+	CompilerContext.MovePinLinksToIntermediate(*GetExecPin(), *Switch->GetExecPin());
+	for (int32 Index = 0; Index < CasePairs.Num(); ++Index)
+	{
+		CompilerContext.MovePinLinksToIntermediate(*CasePairs[Index].Value, *Switch->FindPinChecked(*FString::FromInt(Index)));
+	}
+	CompilerContext.MovePinLinksToIntermediate(*GetDefaultExecPin(), *Switch->GetDefaultPin());
+
+	return true;
 }
 
 UEdGraphPin* UK2Node_MultiBranch::GetDefaultExecPin() const
@@ -276,9 +760,9 @@ UEdGraphPin* UK2Node_MultiBranch::GetDefaultExecPin() const
 	return FindPin(DefaultExecPinName);
 }
 
-UEdGraphPin* UK2Node_MultiBranch::GetFunctionPin() const
+UEdGraphPin* UK2Node_MultiBranch::GetForceRefreshPin() const
 {
-	return FindPin(ConditionPreProcessFuncName);
+	return FindPin(ForceRefreshPinName);
 }
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,334 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "K2Node_MultiBranchPartition.h"
+
+#include "ACFBatchLibrary.h"
+#include "BlueprintNodeSpawner.h"
+#include "EditorCategoryUtils.h"
+#include "GraphEditorSettings.h"
+#include "K2Node_CallFunction.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "KismetCompiler.h"
+
+#define LOCTEXT_NAMESPACE "AdvancedControlFlow"
+
+static const FName PartitionArrayPinName(TEXT("Array"));
+static const FName PartitionDefaultPinName(TEXT("Default"));
+
+UK2Node_MultiBranchPartition::UK2Node_MultiBranchPartition(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	NodeContextMenuSectionName = "K2NodeMultiBranchPartition";
+	NodeContextMenuSectionLabel = LOCTEXT("MultiBranchPartition", "Multi-Branch Partition");
+	CaseKeyPinNamePrefix = TEXT("CaseConditions");
+	CaseValuePinNamePrefix = TEXT("CaseElements");
+	CaseKeyPinFriendlyNamePrefix = TEXT("Conditions ");
+	CaseValuePinFriendlyNamePrefix = TEXT("Case ");
+}
+
+void UK2Node_MultiBranchPartition::AllocateDefaultPins()
+{
+	// Pin structure
+	//   N: Number of conditions/elements pin pair
+	// -----
+	// 0: Array (In, Wildcard Array)
+	// 1: Default (Out, Wildcard Array)
+	// 2-(N+1): Conditions (In, Boolean Array)
+	// (N+2)-(2N+1): Case (Out, Wildcard Array)
+
+	CreateArrayPin();
+	CreateDefaultPin();
+
+	for (int32 Index = 0; Index < 2; ++Index)
+	{
+		AddCasePinPair(Index);
+	}
+
+	Super::AllocateDefaultPins();
+}
+
+FText UK2Node_MultiBranchPartition::GetTooltipText() const
+{
+	return LOCTEXT("MultiBranchPartition_Tooltip",
+		"Multi-Branch Partition\nDistribute the elements to the first case where the condition is true, keeping their order");
+}
+
+FLinearColor UK2Node_MultiBranchPartition::GetNodeTitleColor() const
+{
+	return GetDefault<UGraphEditorSettings>()->PureFunctionCallNodeTitleColor;
+}
+
+FText UK2Node_MultiBranchPartition::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("MultiBranchPartition", "Multi-Branch Partition");
+}
+
+FSlateIcon UK2Node_MultiBranchPartition::GetIconAndTint(FLinearColor& OutColor) const
+{
+	static FSlateIcon Icon("EditorStyle", "GraphEditor.Branch_16x");
+	return Icon;
+}
+
+void UK2Node_MultiBranchPartition::PinConnectionListChanged(UEdGraphPin* Pin)
+{
+	if (Pin == nullptr)
+	{
+		return;
+	}
+
+	if (Pin->LinkedTo.Num() == 0)
+	{
+		// Ignore the disconnection event.
+		return;
+	}
+
+	if (IsCaseKeyPin(Pin))
+	{
+		// Ignore conditions pin connection.
+		return;
+	}
+
+	Super::PinConnectionListChanged(Pin);
+
+	if (GetArrayPin()->PinType.PinCategory != UEdGraphSchema_K2::PC_Wildcard)
+	{
+		return;
+	}
+
+	// The element type is fixed by the first connection.
+	Modify();
+	SetElementPinType(Pin->LinkedTo[0]->PinType);
+
+	UBlueprint* Blueprint = GetBlueprint();
+	FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+	Blueprint->BroadcastChanged();
+}
+
+void UK2Node_MultiBranchPartition::ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins)
+{
+	CreateArrayPin();
+	CreateDefaultPin();
+	Super::ReallocatePinsDuringReconstruction(OldPins);
+
+	for (auto& OldPin : OldPins)
+	{
+		if ((OldPin->PinName == PartitionArrayPinName) && (OldPin->PinType.PinCategory != UEdGraphSchema_K2::PC_Wildcard))
+		{
+			SetElementPinType(OldPin->PinType);
+			break;
+		}
+	}
+}
+
+void UK2Node_MultiBranchPartition::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
+{
+	// Partition relies on the variadic function call, which is supported from UE 5.0.
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+	UClass* ActionKey = GetClass();
+	if (ActionRegistrar.IsOpenForRegistration(ActionKey))
+	{
+		UBlueprintNodeSpawner* NodeSpawner = UBlueprintNodeSpawner::Create(GetClass());
+		check(NodeSpawner != nullptr);
+
+		ActionRegistrar.AddBlueprintAction(ActionKey, NodeSpawner);
+	}
+#endif
+}
+
+FText UK2Node_MultiBranchPartition::GetMenuCategory() const
+{
+	return FEditorCategoryUtils::GetCommonCategory(FCommonEditorCategory::FlowControl);
+}
+
+void UK2Node_MultiBranchPartition::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	Super::ExpandNode(CompilerContext, SourceGraph);
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	CompilerContext.MessageLog.Error(
+		*LOCTEXT("MultiBranchPartitionUnsupported_Error", "@@ requires UE 5.0 or later").ToString(), this);
+#else
+	UEdGraphPin* ArrayPin = GetArrayPin();
+	if (ArrayPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Wildcard)
+	{
+		CompilerContext.MessageLog.Error(
+			*LOCTEXT("MultiBranchPartitionWildcard_Error", "The element type of @@ is not determined").ToString(), this);
+		BreakAllNodeLinks();
+		return;
+	}
+
+	// The arrays are referred in place by the native function, so they must be connected.
+	TArray<CasePinPair> CasePinPairs = GetCasePinPairs();
+	bool bError = false;
+	if (ArrayPin->LinkedTo.Num() == 0)
+	{
+		CompilerContext.MessageLog.Error(*LOCTEXT("PartitionPinNotConnected_Error", "@@ must be connected").ToString(), ArrayPin);
+		bError = true;
+	}
+	for (auto& Pair : CasePinPairs)
+	{
+		if (Pair.Key->LinkedTo.Num() == 0)
+		{
+			CompilerContext.MessageLog.Error(
+				*LOCTEXT("PartitionPinNotConnected_Error", "@@ must be connected").ToString(), Pair.Key);
+			bError = true;
+		}
+	}
+	if (bError)
+	{
+		BreakAllNodeLinks();
+		return;
+	}
+
+	UK2Node_CallFunction* Partition = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+	Partition->SetFromFunction(
+		UACFBatchLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UACFBatchLibrary, MultiBranchPartition)));
+	Partition->AllocateDefaultPins();
+
+	UEdGraphPin* ArgArrayPin = Partition->FindPinChecked(TEXT("Array"));
+	ArgArrayPin->PinType = ArrayPin->PinType;
+	CompilerContext.MovePinLinksToIntermediate(*ArrayPin, *ArgArrayPin);
+	Partition->GetSchema()->TrySetDefaultValue(*Partition->FindPinChecked(TEXT("NumCases")), FString::FromInt(CasePinPairs.Num()));
+
+	// Link between outer and the variadic arguments of Multi-Branch Partition.
+	// The conditions must be followed by the buckets in the case order.
+	for (int32 Index = 0; Index < CasePinPairs.Num(); ++Index)
+	{
+		UEdGraphPin* ArgPin =
+			Partition->CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Boolean, *FString::Printf(TEXT("Conditions_%d"), Index));
+		ArgPin->PinType.ContainerType = EPinContainerType::Array;
+		CompilerContext.MovePinLinksToIntermediate(*CasePinPairs[Index].Key, *ArgPin);
+	}
+	TArray<UEdGraphPin*> BucketPins = GetCaseHitPins();
+	for (int32 Index = 0; Index < BucketPins.Num(); ++Index)
+	{
+		UEdGraphPin* ArgPin =
+			Partition->CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Wildcard, *FString::Printf(TEXT("Bucket_%d"), Index));
+		ArgPin->PinType = BucketPins[Index]->PinType;
+		CompilerContext.MovePinLinksToIntermediate(*BucketPins[Index], *ArgPin);
+	}
+#endif
+
+	BreakAllNodeLinks();
+}
+
+bool UK2Node_MultiBranchPartition::IsConnectionDisallowed(
+	const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const
+{
+	if (OtherPin && (OtherPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec))
+	{
+		OutReason = LOCTEXT("ExecConnectionDisallowd", "Can't connect with Exec pin.").ToString();
+		return true;
+	}
+
+	if (OtherPin && IsElementArrayPin(MyPin) && !OtherPin->PinType.IsArray() &&
+		(OtherPin->PinType.PinCategory != UEdGraphSchema_K2::PC_Wildcard))
+	{
+		OutReason = LOCTEXT("PartitionArrayConnectionDisallowed", "Only arrays can be connected.").ToString();
+		return true;
+	}
+
+	return Super::IsConnectionDisallowed(MyPin, OtherPin, OutReason);
+}
+
+void UK2Node_MultiBranchPartition::CreateArrayPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 0;
+	Params.ContainerType = EPinContainerType::Array;
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Wildcard, PartitionArrayPinName, Params);
+}
+
+void UK2Node_MultiBranchPartition::CreateDefaultPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 1;
+	Params.ContainerType = EPinContainerType::Array;
+	CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Wildcard, PartitionDefaultPinName, Params);
+}
+
+UEdGraphPin* UK2Node_MultiBranchPartition::GetArrayPin() const
+{
+	return FindPin(PartitionArrayPinName);
+}
+
+UEdGraphPin* UK2Node_MultiBranchPartition::GetDefaultPin() const
+{
+	return FindPin(PartitionDefaultPinName);
+}
+
+CasePinPair UK2Node_MultiBranchPartition::AddCasePinPair(int32 CaseIndex)
+{
+	CasePinPair Pair;
+	int32 N = GetCasePinCount();
+	UEdGraphPin* ArrayPin = GetArrayPin();
+
+	{
+		FCreatePinParams Params;
+		Params.Index = 2 + CaseIndex;
+		Params.ContainerType = EPinContainerType::Array;
+		Pair.Key = CreatePin(
+			EGPD_Input, UEdGraphSchema_K2::PC_Boolean, *GetCasePinName(CaseKeyPinNamePrefix.ToString(), CaseIndex), Params);
+		Pair.Key->PinFriendlyName =
+			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseKeyPinFriendlyNamePrefix.ToString(), CaseIndex));
+	}
+	{
+		FCreatePinParams Params;
+		Params.Index = 2 + N + 1 + CaseIndex;
+		Params.ContainerType = EPinContainerType::Array;
+		Pair.Value = CreatePin(
+			EGPD_Output, UEdGraphSchema_K2::PC_Wildcard, *GetCasePinName(CaseValuePinNamePrefix.ToString(), CaseIndex), Params);
+		Pair.Value->PinFriendlyName =
+			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseValuePinFriendlyNamePrefix.ToString(), CaseIndex));
+		if (ArrayPin != nullptr)
+		{
+			Pair.Value->PinType = ArrayPin->PinType;
+		}
+	}
+
+	return Pair;
+}
+
+void UK2Node_MultiBranchPartition::SetElementPinType(const FEdGraphPinType& PinType)
+{
+	FEdGraphPinType ArrayPinType = PinType;
+	ArrayPinType.ContainerType = EPinContainerType::Array;
+	ArrayPinType.bIsReference = false;
+	ArrayPinType.bIsConst = false;
+	ArrayPinType.PinValueType = FEdGraphTerminalType();
+
+	for (auto& Pin : Pins)
+	{
+		if (IsElementArrayPin(Pin))
+		{
+			Pin->PinType = ArrayPinType;
+		}
+	}
+}
+
+bool UK2Node_MultiBranchPartition::IsElementArrayPin(const UEdGraphPin* Pin) const
+{
+	return (Pin == GetArrayPin()) || (Pin == GetDefaultPin()) || IsCaseValuePin(Pin);
+}
+
+TArray<UEdGraphPin*> UK2Node_MultiBranchPartition::GetCaseHitPins() const
+{
+	TArray<UEdGraphPin*> HitPins;
+	for (auto& Pair : GetCasePinPairs())
+	{
+		HitPins.Add(Pair.Value);
+	}
+	HitPins.Add(GetDefaultPin());
+
+	return HitPins;
+}
+
+#undef LOCTEXT_NAMESPACE
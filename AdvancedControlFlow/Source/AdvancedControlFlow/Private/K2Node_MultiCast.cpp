@@ -0,0 +1,424 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "K2Node_MultiCast.h"
+
+#include "ACFCastLibrary.h"
+#include "BlueprintNodeSpawner.h"
+#include "EditorCategoryUtils.h"
+#include "GraphEditorSettings.h"
+#include "Hash/CityHash.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_MakeArray.h"
+#include "K2Node_SwitchInteger.h"
+#include "KismetCompiler.h"
+#include "Misc/EngineVersionComparison.h"
+
+#define LOCTEXT_NAMESPACE "AdvancedControlFlow"
+
+static const FName MultiCastObjectPinName(TEXT("Object"));
+static const FString MultiCastCaseObjectPinNamePrefix(TEXT("CaseObject"));
+
+UK2Node_MultiCast::UK2Node_MultiCast(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	NodeContextMenuSectionName = "K2NodeMultiCast";
+	NodeContextMenuSectionLabel = LOCTEXT("MultiCast", "Multi-Cast");
+	CaseKeyPinNamePrefix = TEXT("CaseClass");
+	CaseValuePinNamePrefix = TEXT("CaseExec");
+	CaseKeyPinFriendlyNamePrefix = TEXT("Class ");
+	CaseValuePinFriendlyNamePrefix = TEXT(" ");
+}
+
+void UK2Node_MultiCast::AllocateDefaultPins()
+{
+	// Pin structure
+	//   N: Number of case pin pair
+	// -----
+	// 0: Execution Triggering (In, Exec)
+	// 1: Object (In, Object)
+	// 2: Default Execution (Out, Exec)
+	// 3 - 2+N: Case Class (In, Literal Class)
+	// 2+N+1 - 2+3*N: Case Execution (Out, Exec) followed by Case Object (Out, Object of Case Class)
+
+	CreateExecTriggeringPin();
+	CreateObjectPin();
+	CreateDefaultExecPin();
+
+	for (int32 Index = 0; Index < 2; ++Index)
+	{
+		AddCasePinPair(Index);
+	}
+
+	Super::AllocateDefaultPins();
+}
+
+FText UK2Node_MultiCast::GetTooltipText() const
+{
+	return LOCTEXT("MultiCast_Tooltip",
+		"Multi-Cast\nExecution goes to the first case whose class the object is, with the object cast to the class.\nThe case of "
+		"each object class is cached on the first execution.");
+}
+
+FLinearColor UK2Node_MultiCast::GetNodeTitleColor() const
+{
+	return GetDefault<UGraphEditorSettings>()->ExecBranchNodeTitleColor;
+}
+
+FText UK2Node_MultiCast::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("MultiCast", "Multi-Cast");
+}
+
+FSlateIcon UK2Node_MultiCast::GetIconAndTint(FLinearColor& OutColor) const
+{
+	static FSlateIcon Icon("EditorStyle", "GraphEditor.Cast_16x");
+	return Icon;
+}
+
+void UK2Node_MultiCast::PinDefaultValueChanged(UEdGraphPin* Pin)
+{
+	Super::PinDefaultValueChanged(Pin);
+
+	if ((Pin != nullptr) && IsCaseKeyPin(Pin))
+	{
+		UpdateCaseObjectPinType(Pin);
+	}
+}
+
+void UK2Node_MultiCast::ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins)
+{
+	CreateExecTriggeringPin();
+	CreateObjectPin();
+	CreateDefaultExecPin();
+
+	Super::ReallocatePinsDuringReconstruction(OldPins);
+}
+
+void UK2Node_MultiCast::PostReconstructNode()
+{
+	Super::PostReconstructNode();
+
+	// The classes are restored from the old pins after the pins are allocated.
+	for (auto& Pin : Pins)
+	{
+		if (IsCaseKeyPin(Pin))
+		{
+			UpdateCaseObjectPinType(Pin);
+		}
+	}
+}
+
+void UK2Node_MultiCast::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
+{
+	UClass* ActionKey = GetClass();
+	if (ActionRegistrar.IsOpenForRegistration(ActionKey))
+	{
+		UBlueprintNodeSpawner* NodeSpawner = UBlueprintNodeSpawner::Create(GetClass());
+		check(NodeSpawner != nullptr);
+
+		ActionRegistrar.AddBlueprintAction(ActionKey, NodeSpawner);
+	}
+}
+
+FText UK2Node_MultiCast::GetMenuCategory() const
+{
+	return FEditorCategoryUtils::GetCommonCategory(FCommonEditorCategory::FlowControl);
+}
+
+void UK2Node_MultiCast::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	Super::ExpandNode(CompilerContext, SourceGraph);
+
+	TArray<CasePinPair> CasePinPairs = GetCasePinPairs();
+	TArray<UClass*> Classes;
+	bool bError = false;
+	for (auto& Pair : CasePinPairs)
+	{
+		UClass* Class = Cast<UClass>(Pair.Key->DefaultObject);
+		if ((Class == nullptr) || Class->HasAnyClassFlags(CLASS_Interface))
+		{
+			CompilerContext.MessageLog.Error(
+				*LOCTEXT("MultiCastInvalidClass_Error", "@@ must have a class which is not an interface").ToString(), Pair.Key);
+			bError = true;
+		}
+		Classes.Add(Class);
+	}
+	if (bError)
+	{
+		BreakAllNodeLinks();
+		return;
+	}
+
+	if (ShouldCountCaseHits(false))
+	{
+		ExpandCaseHitCounters(CompilerContext, SourceGraph);
+	}
+
+	if (ShouldEmitTraceEvents())
+	{
+		// Every case is taken after one lookup of the cache.
+		TArray<int32> NumConditions;
+		NumConditions.Init(1, CasePinPairs.Num() + 1);
+		ExpandTraceEvents(CompilerContext, SourceGraph, NumConditions);
+	}
+
+	// The cache is shared by the nodes of the same classes in the same order.
+	FString ClassPaths;
+	for (UClass* Class : Classes)
+	{
+		ClassPaths += Class->GetPathName() + TEXT(";");
+	}
+	const FString CaseClasses = FString::Printf(TEXT("%016llx"), CityHash64(reinterpret_cast<const char*>(*ClassPaths),
+																	 ClassPaths.Len() * sizeof(TCHAR)));
+	const UEdGraphSchema_K2* Schema = CompilerContext.GetSchema();
+	UEdGraphPin* ObjectPin = GetObjectPin();
+
+	// The cached case switches the execution. The classes are read only when the case is not cached.
+	UK2Node_CallFunction* FindCase = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+	FindCase->SetFromFunction(UACFCastLibrary::StaticClass()->FindFunctionByName(
+		GET_FUNCTION_NAME_CHECKED(UACFCastLibrary, FindCachedClassCase)));
+	FindCase->AllocateDefaultPins();
+	Schema->TrySetDefaultValue(*FindCase->FindPinChecked(TEXT("CaseClasses")), CaseClasses);
+	Schema->TrySetDefaultValue(*FindCase->FindPinChecked(TEXT("NumCases")), FString::FromInt(Classes.Num()));
+	CompilerContext.CopyPinLinksToIntermediate(*ObjectPin, *FindCase->FindPinChecked(TEXT("Object")));
+
+	UK2Node_SwitchInteger* CachedSwitch = CompilerContext.SpawnIntermediateNode<UK2Node_SwitchInteger>(this, SourceGraph);
+	CachedSwitch->AllocateDefaultPins();
+	for (int32 Index = 0; Index <= Classes.Num(); ++Index)
+	{
+		CachedSwitch->AddPinToSwitchNode();
+	}
+	CompilerContext.MovePinLinksToIntermediate(*GetExecPin(), *CachedSwitch->GetExecPin());
+	FindCase->GetReturnValuePin()->MakeLinkTo(CachedSwitch->GetSelectionPin());
+
+	UK2Node_CallFunction* CacheCase = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+	CacheCase->SetFromFunction(
+		UACFCastLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UACFCastLibrary, CacheClassCase)));
+	CacheCase->AllocateDefaultPins();
+	Schema->TrySetDefaultValue(*CacheCase->FindPinChecked(TEXT("CaseClasses")), CaseClasses);
+	CompilerContext.CopyPinLinksToIntermediate(*ObjectPin, *CacheCase->FindPinChecked(TEXT("Object")));
+	CachedSwitch->FindPinChecked(*FString::FromInt(Classes.Num()))->MakeLinkTo(CacheCase->GetExecPin());
+
+	// The classes are left empty when there is no case, and the object always goes to the default.
+	if (Classes.Num() > 0)
+	{
+		UK2Node_MakeArray* MakeArray = CompilerContext.SpawnIntermediateNode<UK2Node_MakeArray>(this, SourceGraph);
+		MakeArray->AllocateDefaultPins();
+		for (int32 Index = 1; Index < Classes.Num(); ++Index)
+		{
+			MakeArray->AddInputPin();
+		}
+		int32 ElementIndex = 0;
+		for (auto& Pin : MakeArray->Pins)
+		{
+			if ((Pin->Direction == EGPD_Input) && (ElementIndex < Classes.Num()))
+			{
+				Pin->PinType = CasePinPairs[ElementIndex].Key->PinType;
+				Pin->DefaultObject = Classes[ElementIndex];
+				++ElementIndex;
+			}
+		}
+		UEdGraphPin* ArrayPin = MakeArray->GetOutputPin();
+		ArrayPin->PinType = CasePinPairs[0].Key->PinType;
+		ArrayPin->PinType.ContainerType = EPinContainerType::Array;
+		ArrayPin->MakeLinkTo(CacheCase->FindPinChecked(TEXT("Classes")));
+	}
+
+	UK2Node_SwitchInteger* CachingSwitch = CompilerContext.SpawnIntermediateNode<UK2Node_SwitchInteger>(this, SourceGraph);
+	CachingSwitch->AllocateDefaultPins();
+	for (int32 Index = 0; Index < Classes.Num(); ++Index)
+	{
+		CachingSwitch->AddPinToSwitchNode();
+	}
+	CacheCase->GetThenPin()->MakeLinkTo(CachingSwitch->GetExecPin());
+	CacheCase->GetReturnValuePin()->MakeLinkTo(CachingSwitch->GetSelectionPin());
+
+	for (int32 Index = 0; Index < Classes.Num(); ++Index)
+	{
+		UEdGraphPin* CaseExecPin = CasePinPairs[Index].Value;
+		CompilerContext.CopyPinLinksToIntermediate(*CaseExecPin, *CachedSwitch->FindPinChecked(*FString::FromInt(Index)));
+		CompilerContext.CopyPinLinksToIntermediate(*CaseExecPin, *CachingSwitch->FindPinChecked(*FString::FromInt(Index)));
+
+		// The object is known to be of the class, so it is passed through without the cast.
+		UEdGraphPin* CaseObjectPin = GetCaseObjectPinFromCaseValuePin(CaseExecPin);
+		if ((CaseObjectPin == nullptr) || (CaseObjectPin->LinkedTo.Num() == 0))
+		{
+			continue;
+		}
+		UK2Node_CallFunction* CastObject = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+		CastObject->SetFromFunction(
+			UACFCastLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UACFCastLibrary, AsCaseClass)));
+		CastObject->AllocateDefaultPins();
+		Schema->TrySetDefaultObject(*CastObject->FindPinChecked(TEXT("Class")), Classes[Index]);
+		CompilerContext.CopyPinLinksToIntermediate(*ObjectPin, *CastObject->FindPinChecked(TEXT("Object")));
+		UEdGraphPin* ReturnPin = CastObject->GetReturnValuePin();
+		ReturnPin->PinType = CaseObjectPin->PinType;
+		CompilerContext.MovePinLinksToIntermediate(*CaseObjectPin, *ReturnPin);
+	}
+	CompilerContext.CopyPinLinksToIntermediate(*GetDefaultExecPin(), *CachedSwitch->GetDefaultPin());
+	CompilerContext.CopyPinLinksToIntermediate(*GetDefaultExecPin(), *CachingSwitch->GetDefaultPin());
+
+	BreakAllNodeLinks();
+}
+
+void UK2Node_MultiCast::RestoreCaseCompanionPins()
+{
+	// The object pin follows the execution pin of its case, and is left alone when the case is removed.
+	TArray<UEdGraphPin*> OrphanPins;
+	for (int32 PinIndex = 0; PinIndex < Pins.Num(); ++PinIndex)
+	{
+		UEdGraphPin* Pin = Pins[PinIndex];
+		if (!IsCaseObjectPin(Pin))
+		{
+			continue;
+		}
+
+		UEdGraphPin* CaseExecPin = (PinIndex > 0) ? Pins[PinIndex - 1] : nullptr;
+		if ((CaseExecPin != nullptr) && IsCaseValuePin(CaseExecPin))
+		{
+			Pin->PinName = *GetCasePinName(MultiCastCaseObjectPinNamePrefix, GetCaseIndexFromCaseValuePin(CaseExecPin));
+		}
+		else
+		{
+			OrphanPins.Add(Pin);
+		}
+	}
+
+	for (auto& Pin : OrphanPins)
+	{
+		Pin->BreakAllPinLinks();
+		Pins.Remove(Pin);
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+		Pin->MarkPendingKill();
+#else
+		Pin->MarkAsGarbage();
+#endif
+	}
+
+	for (auto& Pin : Pins)
+	{
+		if (IsCaseKeyPin(Pin))
+		{
+			UpdateCaseObjectPinType(Pin);
+		}
+	}
+}
+
+void UK2Node_MultiCast::CreateExecTriggeringPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 0;
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Execute, Params);
+}
+
+void UK2Node_MultiCast::CreateObjectPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 1;
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Object, UObject::StaticClass(), MultiCastObjectPinName, Params);
+}
+
+void UK2Node_MultiCast::CreateDefaultExecPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 2;
+	UEdGraphPin* DefaultExecPin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, DefaultExecPinName, Params);
+	DefaultExecPin->PinFriendlyName = FText::AsCultureInvariant(DefaultExecPinFriendlyName.ToString());
+}
+
+UEdGraphPin* UK2Node_MultiCast::GetObjectPin() const
+{
+	return FindPin(MultiCastObjectPinName);
+}
+
+UEdGraphPin* UK2Node_MultiCast::GetDefaultExecPin() const
+{
+	return FindPin(DefaultExecPinName);
+}
+
+UEdGraphPin* UK2Node_MultiCast::GetCaseObjectPinFromCaseValuePin(const UEdGraphPin* CaseExecPin) const
+{
+	const int32 PinIndex = Pins.IndexOfByKey(CaseExecPin);
+	if ((PinIndex == INDEX_NONE) || (PinIndex + 1 >= Pins.Num()) || !IsCaseObjectPin(Pins[PinIndex + 1]))
+	{
+		return nullptr;
+	}
+
+	return Pins[PinIndex + 1];
+}
+
+CasePinPair UK2Node_MultiCast::AddCasePinPair(int32 CaseIndex)
+{
+	CasePinPair Pair;
+	int32 N = GetCasePinCount();
+
+	{
+		FCreatePinParams Params;
+		Params.Index = 3 + CaseIndex;
+		Pair.Key = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Class, UObject::StaticClass(),
+			*GetCasePinName(CaseKeyPinNamePrefix.ToString(), CaseIndex), Params);
+		Pair.Key->PinFriendlyName =
+			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseKeyPinFriendlyNamePrefix.ToString(), CaseIndex));
+		Pair.Key->bNotConnectable = true;
+	}
+	{
+		// Each case has the execution pin and the object pin.
+		FCreatePinParams Params;
+		Params.Index = 3 + N + 1 + CaseIndex * 2;
+		Pair.Value = CreatePin(
+			EGPD_Output, UEdGraphSchema_K2::PC_Exec, *GetCasePinName(CaseValuePinNamePrefix.ToString(), CaseIndex), Params);
+		Pair.Value->PinFriendlyName =
+			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseValuePinFriendlyNamePrefix.ToString(), CaseIndex));
+	}
+	{
+		FCreatePinParams Params;
+		Params.Index = 3 + N + 1 + CaseIndex * 2 + 1;
+		UEdGraphPin* CaseObjectPin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Object, UObject::StaticClass(),
+			*GetCasePinName(MultiCastCaseObjectPinNamePrefix, CaseIndex), Params);
+		CaseObjectPin->PinFriendlyName = FText::AsCultureInvariant(TEXT("As Object"));
+	}
+
+	return Pair;
+}
+
+bool UK2Node_MultiCast::IsCaseObjectPin(const UEdGraphPin* Pin) const
+{
+	return (Pin->Direction == EGPD_Output) && Pin->GetFName().ToString().StartsWith(MultiCastCaseObjectPinNamePrefix + TEXT("_"));
+}
+
+void UK2Node_MultiCast::UpdateCaseObjectPinType(UEdGraphPin* CaseClassPin)
+{
+	UEdGraphPin* CaseObjectPin = GetCaseObjectPinFromCaseValuePin(GetCaseValuePinFromCaseKeyPin(CaseClassPin));
+	if (CaseObjectPin == nullptr)
+	{
+		return;
+	}
+
+	UClass* Class = Cast<UClass>(CaseClassPin->DefaultObject);
+	if (Class == nullptr)
+	{
+		CaseObjectPin->PinType.PinSubCategoryObject = UObject::StaticClass();
+		CaseObjectPin->PinFriendlyName = FText::AsCultureInvariant(TEXT("As Object"));
+		return;
+	}
+
+	CaseObjectPin->PinType.PinSubCategoryObject = Class;
+	CaseObjectPin->PinFriendlyName =
+		FText::Format(LOCTEXT("MultiCastCaseObject", "As {0}"), FText::FromString(Class->GetDisplayNameText().ToString()));
+}
+
+TArray<UEdGraphPin*> UK2Node_MultiCast::GetCaseConditionPins() const
+{
+	// The cases are chosen by the classes, not by the conditions.
+	return TArray<UEdGraphPin*>();
+}
+
+#undef LOCTEXT_NAMESPACE
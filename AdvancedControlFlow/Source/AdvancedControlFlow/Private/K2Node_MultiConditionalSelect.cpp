@@ -11,12 +11,16 @@
 
 #include "K2Node_MultiConditionalSelect.h"
 
+#include "ACFCaseHitCounters.h"
+#include "ACFCaseProfile.h"
+#include "ACFParallelLibrary.h"
+#include "ACFReactiveLibrary.h"
+#include "ACFTrace.h"
 #include "BlueprintNodeSpawner.h"
 #include "EditorCategoryUtils.h"
 #include "K2Node_CallFunction.h"
-#include "K2Node_MakeArray.h"
 #include "K2Node_Select.h"
-#include "Kismet/KismetArrayLibrary.h"
+#include "K2Node_VariableGet.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "KismetCompiler.h"
@@ -37,6 +41,9 @@ UK2Node_MultiConditionalSelect::UK2Node_MultiConditionalSelect(const FObjectInit
 	CaseValuePinNamePrefix = TEXT("CaseCondition");
 	CaseKeyPinFriendlyNamePrefix = TEXT("Option ");
 	CaseValuePinFriendlyNamePrefix = TEXT("Condition ");
+	bUseExpressions = false;
+	bReactive = false;
+	bParallelConditions = false;
 }
 
 void UK2Node_MultiConditionalSelect::AllocateDefaultPins()
@@ -48,6 +55,8 @@ void UK2Node_MultiConditionalSelect::AllocateDefaultPins()
 	// 1-N: Option (In, Wildcard)
 	// (N+1)-2N: Condition (In, Boolean)
 	// 2N+1: Return Value (Out, Boolean)
+	// After them: Expression Input (In, Boolean/Integer/Float) if the expressions are used
+	//   The condition is the expression (In, Literal String) instead.
 
 	CreateDefaultOptionPin();
 	CreateReturnValuePin();
@@ -57,6 +66,11 @@ void UK2Node_MultiConditionalSelect::AllocateDefaultPins()
 		AddCasePinPair(Index);
 	}
 
+	if (bUseExpressions)
+	{
+		FACFExpressionCompiler::CreateInputPins(this, ExpressionInputs);
+	}
+
 	Super::AllocateDefaultPins();
 }
 
@@ -94,7 +108,7 @@ void UK2Node_MultiConditionalSelect::PinConnectionListChanged(UEdGraphPin* Pin)
 		return;
 	}
 
-	if (IsCaseValuePin(Pin))
+	if (IsCaseValuePin(Pin) || FACFExpressionCompiler::IsInputPin(Pin))
 	{
 		// Ignore condition pin connection.
 		return;
@@ -159,6 +173,11 @@ void UK2Node_MultiConditionalSelect::ReallocatePinsDuringReconstruction(TArray<U
 			Pair.Key->PinType = OldDefaultPin->PinType;
 		}
 	}
+
+	if (bUseExpressions)
+	{
+		FACFExpressionCompiler::CreateInputPins(this, ExpressionInputs);
+	}
 }
 
 void UK2Node_MultiConditionalSelect::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
@@ -226,15 +245,67 @@ Condition 1 | +-----+ | [1]            |     | | Item To Find                  |
             |                                                                                                                       |
             |                                                                                                                       |
             +-----------------------------------------------------------------------------------------------------------------------+
+
+On UE 5.0 or later, Make Array and Find (Array) are replaced with Find First True Condition, which takes the conditions directly.
  */
 // clang-format on
 void UK2Node_MultiConditionalSelect::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
 {
 	Super::ExpandNode(CompilerContext, SourceGraph);
 
+	if (bUseExpressions)
+	{
+		// The expressions are expanded to the pure nodes, whose results are taken as the Boolean conditions.
+		// All conditions are evaluated before the selection as the connected conditions are, so && and || do not short-circuit.
+		FACFExpressionCompiler ExpressionCompiler(CompilerContext, SourceGraph, this, ExpressionInputs);
+		bool bValid = true;
+		for (auto& Pair : GetCasePinPairs())
+		{
+			TSharedPtr<const FACFExpression> Expression = ExpressionCompiler.ParseCondition(Pair.Value);
+			if (!Expression.IsValid())
+			{
+				bValid = false;
+				continue;
+			}
+
+			Pair.Value->PinType.PinCategory = UEdGraphSchema_K2::PC_Boolean;
+			Pair.Value->DefaultValue = TEXT("false");
+			ExpressionCompiler.ExpandCondition(*Expression, Pair.Value);
+		}
+		if (!bValid)
+		{
+			BreakAllNodeLinks();
+			return;
+		}
+	}
+
 	UEdGraphPin* ReferenceOptionPin = GetCasePinPairs()[0].Key;
 	TArray<CasePinPair> CasePinPairs = GetCasePinPairs();
 
+	// The Select node reads only the option of the taken case when it is a member variable or a literal. The option computed
+	// by the pure nodes is evaluated on every read, even while the cached case is valid.
+	if (bReactive)
+	{
+		TArray<UEdGraphPin*> OptionPins = {GetDefaultOptionPin()};
+		for (auto& Pair : CasePinPairs)
+		{
+			OptionPins.Add(Pair.Key);
+		}
+		for (UEdGraphPin* OptionPin : OptionPins)
+		{
+			if ((OptionPin->LinkedTo.Num() > 0) && !OptionPin->LinkedTo[0]->GetOwningNode()->IsA<UK2Node_VariableGet>())
+			{
+				CompilerContext.MessageLog.Note(
+					*LOCTEXT("ReactiveOptionComputed_Note", "The option @@ of @@ is evaluated on every read").ToString(), OptionPin,
+					this);
+			}
+		}
+	}
+
+	const FString NodeKey = FACFCaseProfile::MakeNodeKey(CompilerContext, this);
+	// All conditions are evaluated before the selection, so the order of the cases is kept and no profile is recorded.
+	const bool bCountCaseHits = ShouldCountCaseHits(false);
+
 	FEdGraphPinType Select1stPinType;
 	Select1stPinType.PinCategory = UEdGraphSchema_K2::PC_Int;
 	Select1stPinType.PinSubCategory = UEdGraphSchema_K2::PSC_Index;
@@ -261,19 +332,6 @@ void UK2Node_MultiConditionalSelect::ExpandNode(FKismetCompilerContext& Compiler
 		Select2nd->AddInputPin();
 	}
 
-	UK2Node_MakeArray* MakeArray = CompilerContext.SpawnIntermediateNode<UK2Node_MakeArray>(this, SourceGraph);
-	MakeArray->AllocateDefaultPins();
-	for (int32 Index = 1; Index < CasePinPairs.Num(); ++Index)
-	{
-		MakeArray->AddInputPin();
-	}
-
-	UK2Node_CallFunction* ArrayFind = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
-	UClass* KismetArrayLibrary = UKismetArrayLibrary::StaticClass();
-	UFunction* ArrayFindFunction = KismetArrayLibrary->FindFunctionByName("Array_Find");
-	ArrayFind->SetFromFunction(ArrayFindFunction);
-	ArrayFind->AllocateDefaultPins();
-
 	UK2Node_CallFunction* IntEqual = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
 	UClass* KismetMathLibrary = UKismetMathLibrary::StaticClass();
 	UFunction* EqualEqualIntIntFunction = KismetMathLibrary->FindFunctionByName("EqualEqual_IntInt");
@@ -288,37 +346,76 @@ void UK2Node_MultiConditionalSelect::ExpandNode(FKismetCompilerContext& Compiler
 		CompilerContext.MovePinLinksToIntermediate(*CasePinPairs[Index].Key, *Select1stOptionPins[Index]);
 	}
 
-	// Link between outer and Make Array
-	TArray<UEdGraphPin*> KeyPins;
-	TArray<UEdGraphPin*> ValuePins;
-	MakeArray->GetKeyAndValuePins(KeyPins, ValuePins);
-	for (int Index = 0; Index < CasePinPairs.Num(); ++Index)
+	// Link between outer and Find First True Condition
+	TArray<UEdGraphPin*> CondPins;
+	for (auto& Pair : CasePinPairs)
 	{
-		KeyPins[Index]->PinType.PinCategory = UEdGraphSchema_K2::PC_Boolean;
-		CompilerContext.MovePinLinksToIntermediate(*CasePinPairs[Index].Value, *KeyPins[Index]);
+		CondPins.Add(Pair.Value);
+	}
+	UEdGraphPin* CaseIndexPin = nullptr;
+	if (bReactive)
+	{
+		CaseIndexPin = ExpandReactiveCaseIndex(CompilerContext, SourceGraph, CondPins);
+	}
+	else if (bParallelConditions)
+	{
+		CaseIndexPin = ExpandParallelCaseIndex(CompilerContext, SourceGraph, CondPins);
+	}
+	if (CaseIndexPin == nullptr)
+	{
+		CaseIndexPin = ExpandFindFirstTrueCondition(CompilerContext, SourceGraph, CondPins);
 	}
 
-	// Link between Make Array and Array Find
-	UEdGraphPin* ArrayPin = MakeArray->GetOutputPin();
-	UEdGraphPin* TargetArrayPin = ArrayFind->FindPinChecked(TEXT("TargetArray"));
-	UEdGraphPin* ItemToFindPin = ArrayFind->FindPinChecked(TEXT("ItemToFind"));
-	ArrayPin->PinType.PinCategory = UEdGraphSchema_K2::PC_Boolean;
-	ArrayPin->MakeLinkTo(TargetArrayPin);
-	TargetArrayPin->PinType.PinCategory = UEdGraphSchema_K2::PC_Boolean;
-	ItemToFindPin->PinType.PinCategory = UEdGraphSchema_K2::PC_Boolean;
-	MakeArray->GetSchema()->TrySetDefaultValue(*ItemToFindPin, TEXT("true"));
+	// Link between Find First True Condition and Count Selected Case Hit
+	if (bCountCaseHits)
+	{
+		const int32 NumHitPins = GetCaseHitPins().Num();
+		const uint64 CounterKey = FACFCaseProfile::Get().RegisterCounter(NodeKey, NumHitPins - 1);
+
+		UK2Node_CallFunction* CountCaseHit = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+		CountCaseHit->SetFromFunction(UACFCaseHitCounterLibrary::StaticClass()->FindFunctionByName(
+			GET_FUNCTION_NAME_CHECKED(UACFCaseHitCounterLibrary, CountSelectedCaseHit)));
+		CountCaseHit->AllocateDefaultPins();
+		const UEdGraphSchema* Schema = CountCaseHit->GetSchema();
+		Schema->TrySetDefaultValue(*CountCaseHit->FindPinChecked(TEXT("CounterKey")), LexToString(static_cast<int64>(CounterKey)));
+		Schema->TrySetDefaultValue(*CountCaseHit->FindPinChecked(TEXT("NumCases")), FString::FromInt(NumHitPins));
+		CaseIndexPin->MakeLinkTo(CountCaseHit->FindPinChecked(TEXT("CaseIndex")));
+		CaseIndexPin = CountCaseHit->GetReturnValuePin();
+	}
 
-	// Link between Array Find and 1st Select
-	UEdGraphPin* ArrayFindOutputPin = ArrayFind->GetReturnValuePin();
+	// Link between Find First True Condition and End Select Evaluation
+	if (ShouldEmitTraceEvents())
+	{
+		// Begin is linked to the pin before CaseIndex, so that it is scheduled before the conditions are evaluated.
+		UK2Node_CallFunction* Begin =
+			SpawnTraceCall(CompilerContext, SourceGraph, GET_FUNCTION_NAME_CHECKED(UACFTraceLibrary, BeginSelectEvaluation));
+		UK2Node_CallFunction* End =
+			SpawnTraceCall(CompilerContext, SourceGraph, GET_FUNCTION_NAME_CHECKED(UACFTraceLibrary, EndSelectEvaluation));
+		Begin->GetReturnValuePin()->MakeLinkTo(End->FindPinChecked(TEXT("Token")));
+
+		// The case index is the index in the evaluation order, so pass the original case indices.
+		TArray<FString> CaseOrder;
+		for (auto& Pair : CasePinPairs)
+		{
+			CaseOrder.Add(FString::FromInt(GetCaseIndexFromCasePin(Pair.Key)));
+		}
+		const UEdGraphSchema* Schema = End->GetSchema();
+		Schema->TrySetDefaultValue(*End->FindPinChecked(TEXT("NumConditions")), FString::FromInt(CasePinPairs.Num()));
+		Schema->TrySetDefaultValue(*End->FindPinChecked(TEXT("CaseOrder")), FString::Join(CaseOrder, TEXT(",")));
+		CaseIndexPin->MakeLinkTo(End->FindPinChecked(TEXT("CaseIndex")));
+		CaseIndexPin = End->GetReturnValuePin();
+	}
+
+	// Link between Find First True Condition and 1st Select
 	UEdGraphPin* Select1stIndexPin = Select1st->GetIndexPin();
-	ArrayFindOutputPin->MakeLinkTo(Select1stIndexPin);
+	CaseIndexPin->MakeLinkTo(Select1stIndexPin);
 	Select1st->NotifyPinConnectionListChanged(Select1stIndexPin);
 
-	// Link between Array Find and Int Equal
+	// Link between Find First True Condition and Int Equal
 	UEdGraphPin* IntEqualAPin = IntEqual->FindPinChecked(TEXT("A"));
 	UEdGraphPin* IntEqualBPin = IntEqual->FindPinChecked(TEXT("B"));
-	ArrayFindOutputPin->MakeLinkTo(IntEqualAPin);
-	ArrayFindOutputPin->GetSchema()->TrySetDefaultValue(*IntEqualBPin, TEXT("-1"));
+	CaseIndexPin->MakeLinkTo(IntEqualAPin);
+	CaseIndexPin->GetSchema()->TrySetDefaultValue(*IntEqualBPin, TEXT("-1"));
 
 	// Link among 1st Select, 2nd Select and Int Equal
 	UEdGraphPin* Select1stReturnValuePin = Select1st->GetReturnValuePin();
@@ -338,6 +435,96 @@ void UK2Node_MultiConditionalSelect::ExpandNode(FKismetCompilerContext& Compiler
 	BreakAllNodeLinks();
 }
 
+UEdGraphPin* UK2Node_MultiConditionalSelect::ExpandParallelCaseIndex(
+	FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph, const TArray<UEdGraphPin*>& CondPins)
+{
+	const FString Conditions = MakeParallelConditions(CondPins, SourceGraph);
+	if (Conditions.IsEmpty())
+	{
+		CompilerContext.MessageLog.Note(
+			*LOCTEXT("ParallelConditionsNotSupported_Note", "Conditions of @@ are evaluated on the game thread").ToString(), this);
+		return nullptr;
+	}
+
+	UK2Node_CallFunction* FindFirst = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+	FindFirst->SetFromFunction(UACFParallelLibrary::StaticClass()->FindFunctionByName(
+		GET_FUNCTION_NAME_CHECKED(UACFParallelLibrary, FindFirstTrueParallelCondition)));
+	FindFirst->AllocateDefaultPins();
+	CompilerContext.GetSchema()->TrySetDefaultValue(*FindFirst->FindPinChecked(TEXT("Conditions")), Conditions);
+
+	return FindFirst->GetReturnValuePin();
+}
+
+UEdGraphPin* UK2Node_MultiConditionalSelect::ExpandReactiveCaseIndex(
+	FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph, const TArray<UEdGraphPin*>& CondPins)
+{
+	// The selected cases are cached on the game thread.
+	if (IsThreadSafeGraph(SourceGraph))
+	{
+		CompilerContext.MessageLog.Note(
+			*LOCTEXT("ReactiveInThreadSafeGraph_Note", "@@ does not cache the case in the thread-safe function").ToString(),
+			this);
+		return ExpandFindFirstTrueCondition(CompilerContext, SourceGraph, CondPins);
+	}
+
+	// Each condition is read by the library from a Boolean member variable of self or from the literal, so that the graph
+	// does not evaluate any condition while the cached case is valid.
+	TArray<FString> Sources;
+	for (UEdGraphPin* CondPin : CondPins)
+	{
+		if (CondPin->LinkedTo.Num() == 0)
+		{
+			Sources.Add(CondPin->GetDefaultAsString().ToBool() ? TEXT("=1") : TEXT("=0"));
+			continue;
+		}
+
+		const UK2Node_VariableGet* VariableGet =
+			(CondPin->LinkedTo.Num() == 1) ? Cast<UK2Node_VariableGet>(CondPin->LinkedTo[0]->GetOwningNode()) : nullptr;
+		const UEdGraphPin* SelfPin = (VariableGet != nullptr) ? VariableGet->FindPin(UEdGraphSchema_K2::PN_Self) : nullptr;
+		if ((VariableGet == nullptr) || !VariableGet->VariableReference.IsSelfContext() ||
+			VariableGet->VariableReference.IsLocalScope() || ((SelfPin != nullptr) && (SelfPin->LinkedTo.Num() > 0)))
+		{
+			const FText Message = LOCTEXT("ReactiveConditionNotMember_Note",
+				"@@ does not cache the case since the condition @@ is not connected directly to a member variable of self");
+			CompilerContext.MessageLog.Note(*Message.ToString(), this, CondPin);
+			return ExpandFindFirstTrueCondition(CompilerContext, SourceGraph, CondPins);
+		}
+
+		// The library finds the property by the name on the class of the instance, which derives from the compiled class.
+		const FName VarName = VariableGet->GetVarName();
+		if (FindFProperty<FBoolProperty>(CompilerContext.NewClass, VarName) == nullptr)
+		{
+			const FText Message = FText::Format(
+				LOCTEXT("ReactiveSourceNotFound_Error", "The Boolean property {0} of @@ is not found"), FText::FromName(VarName));
+			CompilerContext.MessageLog.Error(*Message.ToString(), this);
+			return ExpandFindFirstTrueCondition(CompilerContext, SourceGraph, CondPins);
+		}
+		Sources.Add(VarName.ToString());
+	}
+
+	const FString SourcesString = NodeGuid.ToString(EGuidFormats::Digits) + TEXT(";") + FString::Join(Sources, TEXT(","));
+	if (SourcesString.Len() >= NAME_SIZE)
+	{
+		CompilerContext.MessageLog.Note(
+			*LOCTEXT("ReactiveSourcesTooLong_Note", "@@ has too many conditions to cache the selected case").ToString(), this);
+		return ExpandFindFirstTrueCondition(CompilerContext, SourceGraph, CondPins);
+	}
+
+	// The getters are left unlinked, and pruned as they are pure.
+	for (UEdGraphPin* CondPin : CondPins)
+	{
+		CondPin->BreakAllPinLinks();
+	}
+
+	UK2Node_CallFunction* FindCase = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+	FindCase->SetFromFunction(UACFReactiveLibrary::StaticClass()->FindFunctionByName(
+		GET_FUNCTION_NAME_CHECKED(UACFReactiveLibrary, FindFirstTrueReactiveCondition)));
+	FindCase->AllocateDefaultPins();
+	CompilerContext.GetSchema()->TrySetDefaultValue(*FindCase->FindPinChecked(TEXT("Sources")), SourcesString);
+
+	return FindCase->GetReturnValuePin();
+}
+
 bool UK2Node_MultiConditionalSelect::IsConnectionDisallowed(
 	const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const
 {
@@ -350,6 +537,35 @@ bool UK2Node_MultiConditionalSelect::IsConnectionDisallowed(
 	return Super::IsConnectionDisallowed(MyPin, OtherPin, OutReason);
 }
 
+void UK2Node_MultiConditionalSelect::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	const FName PropertyName = PropertyChangedEvent.GetPropertyName();
+	if ((PropertyName == GET_MEMBER_NAME_CHECKED(UK2Node_MultiConditionalSelect, bReactive)) ||
+		(PropertyName == GET_MEMBER_NAME_CHECKED(UK2Node_MultiConditionalSelect, bParallelConditions)))
+	{
+		FBlueprintEditorUtils::MarkBlueprintAsModified(GetBlueprint());
+	}
+	else if (PropertyName == GET_MEMBER_NAME_CHECKED(UK2Node_MultiConditionalSelect, bUseExpressions))
+	{
+		// The condition pins change between the Boolean pins and the expressions, and "false" is valid for both.
+		for (auto& CondPin : GetCaseConditionPins())
+		{
+			CondPin->BreakAllPinLinks();
+			CondPin->DefaultValue = TEXT("false");
+		}
+		ReconstructNode();
+		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(GetBlueprint());
+	}
+	else if (PropertyChangedEvent.GetMemberPropertyName() ==
+			 GET_MEMBER_NAME_CHECKED(UK2Node_MultiConditionalSelect, ExpressionInputs))
+	{
+		ReconstructNode();
+		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(GetBlueprint());
+	}
+}
+
 void UK2Node_MultiConditionalSelect::CreateDefaultOptionPin()
 {
 	FCreatePinParams Params;
@@ -394,13 +610,41 @@ CasePinPair UK2Node_MultiConditionalSelect::AddCasePinPair(int32 CaseIndex)
 	{
 		FCreatePinParams Params;
 		Params.Index = N + 2 + CaseIndex;
-		Pair.Value = CreatePin(
-			EGPD_Input, UEdGraphSchema_K2::PC_Boolean, *GetCasePinName(CaseValuePinNamePrefix.ToString(), CaseIndex), Params);
+		Pair.Value = CreatePin(EGPD_Input, bUseExpressions ? UEdGraphSchema_K2::PC_String : UEdGraphSchema_K2::PC_Boolean,
+			*GetCasePinName(CaseValuePinNamePrefix.ToString(), CaseIndex), Params);
 		Pair.Value->PinFriendlyName =
 			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseValuePinFriendlyNamePrefix.ToString(), CaseIndex));
+		if (bUseExpressions)
+		{
+			Pair.Value->bNotConnectable = true;
+			Pair.Value->DefaultValue = TEXT("false");
+		}
 	}
 
 	return Pair;
 }
 
+TArray<UEdGraphPin*> UK2Node_MultiConditionalSelect::GetCaseHitPins() const
+{
+	TArray<UEdGraphPin*> HitPins;
+	for (auto& Pair : GetCasePinPairs())
+	{
+		HitPins.Add(Pair.Key);
+	}
+	HitPins.Add(GetDefaultOptionPin());
+
+	return HitPins;
+}
+
+TArray<UEdGraphPin*> UK2Node_MultiConditionalSelect::GetCaseConditionPins() const
+{
+	TArray<UEdGraphPin*> CondPins;
+	for (auto& Pair : GetCasePinPairs())
+	{
+		CondPins.Add(Pair.Value);
+	}
+
+	return CondPins;
+}
+
 #undef LOCTEXT_NAMESPACE
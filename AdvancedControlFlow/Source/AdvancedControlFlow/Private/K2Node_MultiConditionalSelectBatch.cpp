@@ -0,0 +1,450 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "K2Node_MultiConditionalSelectBatch.h"
+
+#include "ACFBatchLibrary.h"
+#include "BlueprintNodeSpawner.h"
+#include "EditorCategoryUtils.h"
+#include "GraphEditorSettings.h"
+#include "K2Node_CallFunction.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "KismetCompiler.h"
+#include "ScopedTransaction.h"
+#include "ToolMenu.h"
+
+#define LOCTEXT_NAMESPACE "AdvancedControlFlow"
+
+static const FName BatchDefaultOptionPinName(TEXT("Default"));
+static const FName BatchReturnValuePinName(TEXT("Return Value"));
+
+// The single value options are marked by the bits of the 64-bit mask, including the default option.
+static const int32 MaxBatchCases = 62;
+
+static FEdGraphPinType MakeElementPinType(const FEdGraphPinType& PinType)
+{
+	FEdGraphPinType ElementPinType = PinType;
+	ElementPinType.ContainerType = EPinContainerType::None;
+	ElementPinType.bIsReference = false;
+	ElementPinType.bIsConst = false;
+	ElementPinType.PinValueType = FEdGraphTerminalType();
+
+	return ElementPinType;
+}
+
+UK2Node_MultiConditionalSelectBatch::UK2Node_MultiConditionalSelectBatch(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	NodeContextMenuSectionName = "K2NodeMultiConditionalSelectBatch";
+	NodeContextMenuSectionLabel = LOCTEXT("MultiConditionalSelectBatch", "Multi Conditional Select (Batch)");
+	CaseKeyPinNamePrefix = TEXT("CaseOption");
+	CaseValuePinNamePrefix = TEXT("CaseConditions");
+	CaseKeyPinFriendlyNamePrefix = TEXT("Option ");
+	CaseValuePinFriendlyNamePrefix = TEXT("Conditions ");
+}
+
+void UK2Node_MultiConditionalSelectBatch::AllocateDefaultPins()
+{
+	// Pin structure
+	//   N: Number of option/conditions pin pair
+	// -----
+	// 0: Default (In, Wildcard or Wildcard Array)
+	// 1-N: Option (In, Wildcard or Wildcard Array)
+	// (N+1)-2N: Conditions (In, Boolean Array)
+	// 2N+1: Return Value (Out, Wildcard Array)
+
+	CreateDefaultOptionPin();
+	CreateReturnValuePin();
+
+	for (int Index = 0; Index < 2; ++Index)
+	{
+		AddCasePinPair(Index);
+	}
+
+	Super::AllocateDefaultPins();
+}
+
+FText UK2Node_MultiConditionalSelectBatch::GetTooltipText() const
+{
+	return LOCTEXT("MultiConditionalSelectBatch_Tooltip",
+		"Multi-Conditional Select (Batch)\nReturn the array of the options where the condition is true for each element");
+}
+
+FLinearColor UK2Node_MultiConditionalSelectBatch::GetNodeTitleColor() const
+{
+	return GetDefault<UGraphEditorSettings>()->PureFunctionCallNodeTitleColor;
+}
+
+FText UK2Node_MultiConditionalSelectBatch::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("MultiConditionalSelectBatch", "Multi-Conditional Select (Batch)");
+}
+
+FSlateIcon UK2Node_MultiConditionalSelectBatch::GetIconAndTint(FLinearColor& OutColor) const
+{
+	static FSlateIcon Icon("EditorStyle", "GraphEditor.Select_16x");
+	return Icon;
+}
+
+void UK2Node_MultiConditionalSelectBatch::PinConnectionListChanged(UEdGraphPin* Pin)
+{
+	if (Pin == nullptr)
+	{
+		return;
+	}
+
+	if (Pin->LinkedTo.Num() == 0)
+	{
+		// Ignore the disconnection event.
+		return;
+	}
+
+	if (IsCaseValuePin(Pin))
+	{
+		// Ignore conditions pin connection.
+		return;
+	}
+
+	Super::PinConnectionListChanged(Pin);
+
+	Modify();
+
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+	UEdGraphPin* LinkedPin = Pin->LinkedTo[0];
+	UEdGraphPin* ReturnValuePin = GetReturnValuePin();
+
+	if (ReturnValuePin->PinType.PinCategory == UEdGraphSchema_K2::PC_Wildcard)
+	{
+		// The element type is fixed by the first connection.
+		// Each option takes the container type from its connection, and the unconnected options take a single value.
+		const FEdGraphPinType ElementPinType = MakeElementPinType(LinkedPin->PinType);
+
+		ReturnValuePin->PinType = ElementPinType;
+		ReturnValuePin->PinType.ContainerType = EPinContainerType::Array;
+
+		TArray<UEdGraphPin*> OptionPins = GetCaseHitPins();
+		for (auto& OptionPin : OptionPins)
+		{
+			EPinContainerType ContainerType =
+				(OptionPin->LinkedTo.Num() > 0) ? OptionPin->LinkedTo[0]->PinType.ContainerType : EPinContainerType::None;
+			OptionPin->PinType = ElementPinType;
+			OptionPin->PinType.ContainerType = ContainerType;
+			Schema->ResetPinToAutogeneratedDefaultValue(OptionPin);
+		}
+	}
+	else if (IsOptionPin(Pin))
+	{
+		Pin->PinType.ContainerType = LinkedPin->PinType.ContainerType;
+	}
+
+	UBlueprint* Blueprint = GetBlueprint();
+	FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+	Blueprint->BroadcastChanged();
+}
+
+void UK2Node_MultiConditionalSelectBatch::GetNodeContextMenuActions(
+	class UToolMenu* Menu, class UGraphNodeContextMenuContext* Context) const
+{
+	Super::GetNodeContextMenuActions(Menu, Context);
+
+	if (Context->bIsDebugging || (Context->Pin == nullptr) || !IsOptionPin(Context->Pin))
+	{
+		return;
+	}
+	if (GetReturnValuePin()->PinType.PinCategory == UEdGraphSchema_K2::PC_Wildcard)
+	{
+		return;
+	}
+
+	FToolMenuSection& Section = Menu->FindOrAddSection(NodeContextMenuSectionName);
+	const bool bArray = Context->Pin->PinType.IsArray();
+	Section.AddMenuEntry("ToggleOptionPinContainer",
+		bArray ? LOCTEXT("ChangeOptionPinToSingleValue", "Change to single value")
+			   : LOCTEXT("ChangeOptionPinToArray", "Change to array"),
+		LOCTEXT("ToggleOptionPinContainerTooltip", "Change whether this option takes an array or a single value"),
+		FSlateIcon(),
+		FUIAction(FExecuteAction::CreateUObject(const_cast<UK2Node_MultiConditionalSelectBatch*>(this),
+			&UK2Node_MultiConditionalSelectBatch::ToggleOptionPinContainer, const_cast<UEdGraphPin*>(Context->Pin))));
+}
+
+void UK2Node_MultiConditionalSelectBatch::ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins)
+{
+	CreateDefaultOptionPin();
+	CreateReturnValuePin();
+	Super::ReallocatePinsDuringReconstruction(OldPins);
+
+	// Restore the element type and the container type of each option.
+	for (auto& OldPin : OldPins)
+	{
+		if (OldPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Wildcard)
+		{
+			continue;
+		}
+
+		UEdGraphPin* NewPin = FindPin(OldPin->GetFName());
+		if ((NewPin != nullptr) && (IsOptionPin(NewPin) || (NewPin == GetReturnValuePin())))
+		{
+			NewPin->PinType = OldPin->PinType;
+		}
+	}
+
+	// Options added while reconstructing take a single value.
+	UEdGraphPin* ReturnValuePin = GetReturnValuePin();
+	if (ReturnValuePin->PinType.PinCategory != UEdGraphSchema_K2::PC_Wildcard)
+	{
+		for (auto& OptionPin : GetCaseHitPins())
+		{
+			if (OptionPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Wildcard)
+			{
+				OptionPin->PinType = MakeElementPinType(ReturnValuePin->PinType);
+			}
+		}
+	}
+}
+
+void UK2Node_MultiConditionalSelectBatch::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
+{
+	// Batch evaluation relies on the variadic function call, which is supported from UE 5.0.
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+	UClass* ActionKey = GetClass();
+	if (ActionRegistrar.IsOpenForRegistration(ActionKey))
+	{
+		UBlueprintNodeSpawner* NodeSpawner = UBlueprintNodeSpawner::Create(GetClass());
+		check(NodeSpawner != nullptr);
+
+		ActionRegistrar.AddBlueprintAction(ActionKey, NodeSpawner);
+	}
+#endif
+}
+
+FText UK2Node_MultiConditionalSelectBatch::GetMenuCategory() const
+{
+	return FEditorCategoryUtils::GetCommonCategory(FCommonEditorCategory::Utilities);
+}
+
+void UK2Node_MultiConditionalSelectBatch::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	Super::ExpandNode(CompilerContext, SourceGraph);
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	CompilerContext.MessageLog.Error(
+		*LOCTEXT("MultiConditionalSelectBatchUnsupported_Error", "@@ requires UE 5.0 or later").ToString(), this);
+#else
+	UEdGraphPin* ReturnValuePin = GetReturnValuePin();
+	if (ReturnValuePin->PinType.PinCategory == UEdGraphSchema_K2::PC_Wildcard)
+	{
+		CompilerContext.MessageLog.Error(
+			*LOCTEXT("MultiConditionalSelectBatchWildcard_Error", "The element type of @@ is not determined").ToString(), this);
+		BreakAllNodeLinks();
+		return;
+	}
+
+	TArray<CasePinPair> CasePinPairs = GetCasePinPairs();
+	if (CasePinPairs.Num() > MaxBatchCases)
+	{
+		CompilerContext.MessageLog.Error(
+			*FText::Format(LOCTEXT("MultiConditionalSelectBatchTooManyCases_Error", "@@ can have at most {0} cases"),
+				FText::AsNumber(MaxBatchCases))
+				 .ToString(),
+			this);
+		BreakAllNodeLinks();
+		return;
+	}
+
+	// The arrays are referred in place by the native function, so they must be connected.
+	bool bError = false;
+	for (auto& Pair : CasePinPairs)
+	{
+		if (Pair.Value->LinkedTo.Num() == 0)
+		{
+			CompilerContext.MessageLog.Error(*LOCTEXT("BatchPinNotConnected_Error", "@@ must be connected").ToString(), Pair.Value);
+			bError = true;
+		}
+	}
+	for (auto& OptionPin : GetCaseHitPins())
+	{
+		if (OptionPin->PinType.IsArray() && (OptionPin->LinkedTo.Num() == 0))
+		{
+			CompilerContext.MessageLog.Error(*LOCTEXT("BatchPinNotConnected_Error", "@@ must be connected").ToString(), OptionPin);
+			bError = true;
+		}
+	}
+	if (bError)
+	{
+		BreakAllNodeLinks();
+		return;
+	}
+
+	UK2Node_CallFunction* SelectBatch = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+	SelectBatch->SetFromFunction(UACFBatchLibrary::StaticClass()->FindFunctionByName(
+		GET_FUNCTION_NAME_CHECKED(UACFBatchLibrary, MultiConditionalSelectBatch)));
+	SelectBatch->AllocateDefaultPins();
+
+	UEdGraphPin* ResultPin = SelectBatch->FindPinChecked(TEXT("Result"));
+	ResultPin->PinType = ReturnValuePin->PinType;
+	CompilerContext.MovePinLinksToIntermediate(*ReturnValuePin, *ResultPin);
+
+	// Link between outer and the variadic arguments of Multi-Conditional Select Batch
+	int64 ScalarOptionMask = 0;
+	auto AddOptionArgument = [&](UEdGraphPin* OptionPin, int32 OptionIndex)
+	{
+		UEdGraphPin* ArgPin = SelectBatch->CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Wildcard,
+			*FString::Printf(TEXT("Option_%d"), OptionIndex));
+		ArgPin->PinType = OptionPin->PinType;
+		CompilerContext.MovePinLinksToIntermediate(*OptionPin, *ArgPin);
+		if (!OptionPin->PinType.IsArray())
+		{
+			ScalarOptionMask |= 1LL << OptionIndex;
+		}
+	};
+	for (int32 Index = 0; Index < CasePinPairs.Num(); ++Index)
+	{
+		UEdGraphPin* ArgPin = SelectBatch->CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Boolean,
+			*FString::Printf(TEXT("Conditions_%d"), Index));
+		ArgPin->PinType.ContainerType = EPinContainerType::Array;
+		CompilerContext.MovePinLinksToIntermediate(*CasePinPairs[Index].Value, *ArgPin);
+
+		AddOptionArgument(CasePinPairs[Index].Key, Index);
+	}
+	AddOptionArgument(GetDefaultOptionPin(), CasePinPairs.Num());
+
+	const UEdGraphSchema* Schema = SelectBatch->GetSchema();
+	Schema->TrySetDefaultValue(*SelectBatch->FindPinChecked(TEXT("NumCases")), FString::FromInt(CasePinPairs.Num()));
+	Schema->TrySetDefaultValue(*SelectBatch->FindPinChecked(TEXT("ScalarOptionMask")), LexToString(ScalarOptionMask));
+#endif
+
+	BreakAllNodeLinks();
+}
+
+bool UK2Node_MultiConditionalSelectBatch::IsConnectionDisallowed(
+	const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const
+{
+	if (OtherPin && (OtherPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec))
+	{
+		OutReason = LOCTEXT("ExecConnectionDisallowd", "Can't connect with Exec pin.").ToString();
+		return true;
+	}
+
+	if (OtherPin && (OtherPin->PinType.IsSet() || OtherPin->PinType.IsMap()))
+	{
+		OutReason = LOCTEXT("BatchContainerConnectionDisallowed", "Only arrays and single values can be connected.").ToString();
+		return true;
+	}
+
+	if (OtherPin && (MyPin == GetReturnValuePin()) && !OtherPin->PinType.IsArray() &&
+		(OtherPin->PinType.PinCategory != UEdGraphSchema_K2::PC_Wildcard))
+	{
+		OutReason = LOCTEXT("BatchReturnValueConnectionDisallowed", "Return Value is an array.").ToString();
+		return true;
+	}
+
+	return Super::IsConnectionDisallowed(MyPin, OtherPin, OutReason);
+}
+
+void UK2Node_MultiConditionalSelectBatch::CreateDefaultOptionPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 0;
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Wildcard, BatchDefaultOptionPinName, Params);
+}
+
+void UK2Node_MultiConditionalSelectBatch::CreateReturnValuePin()
+{
+	int N = GetCasePinCount();
+
+	FCreatePinParams Params;
+	Params.Index = 2 * N + 1;
+	Params.ContainerType = EPinContainerType::Array;
+	CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Wildcard, BatchReturnValuePinName, Params);
+}
+
+UEdGraphPin* UK2Node_MultiConditionalSelectBatch::GetDefaultOptionPin() const
+{
+	return FindPin(BatchDefaultOptionPinName);
+}
+
+UEdGraphPin* UK2Node_MultiConditionalSelectBatch::GetReturnValuePin() const
+{
+	return FindPin(BatchReturnValuePinName);
+}
+
+CasePinPair UK2Node_MultiConditionalSelectBatch::AddCasePinPair(int32 CaseIndex)
+{
+	CasePinPair Pair;
+	int N = GetCasePinCount();
+	UEdGraphPin* ReturnValuePin = GetReturnValuePin();
+
+	{
+		FCreatePinParams Params;
+		Params.Index = 1 + CaseIndex;
+		Pair.Key = CreatePin(
+			EGPD_Input, UEdGraphSchema_K2::PC_Wildcard, *GetCasePinName(CaseKeyPinNamePrefix.ToString(), CaseIndex), Params);
+		Pair.Key->PinFriendlyName =
+			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseKeyPinFriendlyNamePrefix.ToString(), CaseIndex));
+		if (ReturnValuePin != nullptr)
+		{
+			Pair.Key->PinType = MakeElementPinType(ReturnValuePin->PinType);
+		}
+	}
+	{
+		FCreatePinParams Params;
+		Params.Index = N + 2 + CaseIndex;
+		Params.ContainerType = EPinContainerType::Array;
+		Pair.Value = CreatePin(
+			EGPD_Input, UEdGraphSchema_K2::PC_Boolean, *GetCasePinName(CaseValuePinNamePrefix.ToString(), CaseIndex), Params);
+		Pair.Value->PinFriendlyName =
+			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseValuePinFriendlyNamePrefix.ToString(), CaseIndex));
+	}
+
+	return Pair;
+}
+
+bool UK2Node_MultiConditionalSelectBatch::IsOptionPin(const UEdGraphPin* Pin) const
+{
+	return (Pin == GetDefaultOptionPin()) || IsCaseKeyPin(Pin);
+}
+
+void UK2Node_MultiConditionalSelectBatch::ToggleOptionPinContainer(UEdGraphPin* Pin)
+{
+	const FScopedTransaction Transaction(LOCTEXT("ChangeOptionPinContainer", "Change Option Pin Container"));
+	Modify();
+
+	Pin->BreakAllPinLinks(true);
+	Pin->PinType.ContainerType = Pin->PinType.IsArray() ? EPinContainerType::None : EPinContainerType::Array;
+	GetDefault<UEdGraphSchema_K2>()->ResetPinToAutogeneratedDefaultValue(Pin);
+
+	FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(GetBlueprint());
+}
+
+TArray<UEdGraphPin*> UK2Node_MultiConditionalSelectBatch::GetCaseHitPins() const
+{
+	TArray<UEdGraphPin*> HitPins;
+	for (auto& Pair : GetCasePinPairs())
+	{
+		HitPins.Add(Pair.Key);
+	}
+	HitPins.Add(GetDefaultOptionPin());
+
+	return HitPins;
+}
+
+TArray<UEdGraphPin*> UK2Node_MultiConditionalSelectBatch::GetCaseConditionPins() const
+{
+	TArray<UEdGraphPin*> CondPins;
+	for (auto& Pair : GetCasePinPairs())
+	{
+		CondPins.Add(Pair.Value);
+	}
+
+	return CondPins;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,820 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "K2Node_MultiSwitch.h"
+
+#include "ACFSwitchLibrary.h"
+#include "BlueprintNodeSpawner.h"
+#include "EdGraphSchema_K2.h"
+#include "EdGraphUtilities.h"
+#include "EditorCategoryUtils.h"
+#include "GraphEditorSettings.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Kismet/KismetStringLibrary.h"
+#include "KismetCompiledFunctionContext.h"
+#include "KismetCompiler.h"
+#include "KismetCompilerMisc.h"
+#include "Misc/DefaultValueHelper.h"
+
+#define LOCTEXT_NAMESPACE "AdvancedControlFlow"
+
+static const FName MultiSwitchSelectionPinName(TEXT("Selection"));
+
+namespace ACFMultiSwitch
+{
+struct FCase
+{
+	int32 Key;
+	UEdGraphPin* ExecPin;
+};
+
+// The range of the values which the selection can take.
+void GetSelectionRange(const FEdGraphPinType& PinType, int64& OutLo, int64& OutHi)
+{
+	if (PinType.PinCategory == UEdGraphSchema_K2::PC_Byte)
+	{
+		OutLo = 0;
+		OutHi = MAX_uint8;
+	}
+	else
+	{
+		OutLo = MIN_int32;
+		OutHi = MAX_int32;
+	}
+}
+
+// The search tree splits the sorted cases in half until one case is left.
+// The leaf is taken without the equality test if the range of the selection narrows down to the key.
+// Returns the number of the comparisons to reach each case.
+void CountComparisons(const TArray<FCase>& Cases, int32 Begin, int32 End, int64 Lo, int64 Hi, int32 Depth, TArray<int32>& OutCounts)
+{
+	if (End - Begin == 1)
+	{
+		OutCounts[Begin] = (Lo == Hi) ? Depth : Depth + 1;
+		return;
+	}
+
+	const int32 Mid = (Begin + End) / 2;
+	CountComparisons(Cases, Begin, Mid, Lo, Cases[Mid].Key - 1, Depth + 1, OutCounts);
+	CountComparisons(Cases, Mid, End, Cases[Mid].Key, Hi, Depth + 1, OutCounts);
+}
+
+ACFSwitch::EKeyType GetKeyType(const UK2Node_MultiSwitch* Node)
+{
+	if (Node->GetSelectionPin()->PinType.PinCategory == UEdGraphSchema_K2::PC_Name)
+	{
+		return ACFSwitch::EKeyType::Name;
+	}
+	return Node->bCaseSensitive ? ACFSwitch::EKeyType::StringCaseSensitive : ACFSwitch::EKeyType::String;
+}
+
+// Keys of the name or string selection in the order of the cases.
+void GetHashedKeys(const UK2Node_MultiSwitch* Node, TArray<FString>& OutKeys, TArray<UEdGraphPin*>& OutExecPins)
+{
+	for (auto& Pin : Node->Pins)
+	{
+		if ((Pin->Direction != EGPD_Output) || (Pin->GetFName() == DefaultExecPinName))
+		{
+			continue;
+		}
+
+		OutKeys.Add(Node->GetCaseKeyPinFromCaseValuePin(Pin)->DefaultValue);
+		OutExecPins.Add(Pin);
+	}
+}
+
+// The hashed lookup returns the index of the case, which is searched in [INDEX_NONE, N - 1].
+void GetIndexCases(const TArray<UEdGraphPin*>& ExecPins, TArray<FCase>& OutCases)
+{
+	for (int32 Index = 0; Index < ExecPins.Num(); ++Index)
+	{
+		OutCases.Add({Index, ExecPins[Index]});
+	}
+}
+}	 // namespace ACFMultiSwitch
+
+class FKCHandler_MultiSwitch : public FNodeHandlingFunctor
+{
+	TMap<UEdGraphNode*, FBPTerminal*> BoolTermMap;
+	TMap<UEdGraphNode*, FBPTerminal*> IndexTermMap;
+
+	FBPTerminal* CreateKeyTerm(FKismetFunctionContext& Context, UEdGraphNode* Node, FName PinCategory, const FString& Key)
+	{
+		FBPTerminal* LiteralTerm = Context.CreateLocalTerminal(ETerminalSpecification::TS_Literal);
+		LiteralTerm->Type.PinCategory = PinCategory;
+		LiteralTerm->Source = Node;
+		LiteralTerm->Name = Key;
+
+		return LiteralTerm;
+	}
+
+	// Bool = Func(Selection, Key), and goto the returned statement if not.
+	FBlueprintCompiledStatement& CompileGotoIfNot(FKismetFunctionContext& Context, UEdGraphNode* Node, FBPTerminal* SelectionTerm,
+		UFunction* Function, FName PinCategory, const FString& Key, FBlueprintCompiledStatement*& OutFirstStatement)
+	{
+		FBlueprintCompiledStatement& CallFuncStatement = Context.AppendStatementForNode(Node);
+		CallFuncStatement.Type = KCST_CallFunction;
+		CallFuncStatement.FunctionToCall = Function;
+		CallFuncStatement.LHS = BoolTermMap.FindRef(Node);
+		CallFuncStatement.RHS.Add(SelectionTerm);
+		CallFuncStatement.RHS.Add(CreateKeyTerm(Context, Node, PinCategory, Key));
+		OutFirstStatement = &CallFuncStatement;
+
+		FBlueprintCompiledStatement& GotoStatement = Context.AppendStatementForNode(Node);
+		GotoStatement.Type = KCST_GotoIfNot;
+		GotoStatement.LHS = BoolTermMap.FindRef(Node);
+
+		return GotoStatement;
+	}
+
+	// Search for the case of Selection in [Begin, End), knowing that Selection is in [Lo, Hi]. Returns the first statement.
+	// PinCategory is the integer or byte type of Selection.
+	FBlueprintCompiledStatement* CompileCaseSearch(FKismetFunctionContext& Context, UK2Node_MultiSwitch* Node,
+		FBPTerminal* SelectionTerm, FName PinCategory, const TArray<ACFMultiSwitch::FCase>& Cases, int32 Begin, int32 End, int64 Lo,
+		int64 Hi)
+	{
+		const bool bByte = PinCategory == UEdGraphSchema_K2::PC_Byte;
+
+		if (End - Begin == 1)
+		{
+			FBlueprintCompiledStatement* FirstStatement = nullptr;
+			if (Lo != Hi)
+			{
+				const FName EqualFunctionName = bByte ? GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, EqualEqual_ByteByte)
+													  : GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, EqualEqual_IntInt);
+				UFunction* EqualFunction = UKismetMathLibrary::StaticClass()->FindFunctionByName(EqualFunctionName);
+				FBlueprintCompiledStatement& GotoDefaultStatement = CompileGotoIfNot(
+					Context, Node, SelectionTerm, EqualFunction, PinCategory, FString::FromInt(Cases[Begin].Key), FirstStatement);
+				Context.GotoFixupRequestMap.Add(&GotoDefaultStatement, Node->GetDefaultExecPin());
+			}
+
+			FBlueprintCompiledStatement& GotoStatement = Context.AppendStatementForNode(Node);
+			GotoStatement.Type = KCST_UnconditionalGoto;
+			Context.GotoFixupRequestMap.Add(&GotoStatement, Cases[Begin].ExecPin);
+
+			return (FirstStatement != nullptr) ? FirstStatement : &GotoStatement;
+		}
+
+		const FName LessFunctionName = bByte ? GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, Less_ByteByte)
+											 : GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, Less_IntInt);
+		UFunction* LessFunction = UKismetMathLibrary::StaticClass()->FindFunctionByName(LessFunctionName);
+		const int32 Mid = (Begin + End) / 2;
+		FBlueprintCompiledStatement* FirstStatement = nullptr;
+		FBlueprintCompiledStatement& GotoUpperStatement = CompileGotoIfNot(
+			Context, Node, SelectionTerm, LessFunction, PinCategory, FString::FromInt(Cases[Mid].Key), FirstStatement);
+		CompileCaseSearch(Context, Node, SelectionTerm, PinCategory, Cases, Begin, Mid, Lo, Cases[Mid].Key - 1);
+		FBlueprintCompiledStatement* UpperStatement =
+			CompileCaseSearch(Context, Node, SelectionTerm, PinCategory, Cases, Mid, End, Cases[Mid].Key, Hi);
+		GotoUpperStatement.TargetLabel = UpperStatement;
+		UpperStatement->bIsJumpTarget = true;
+
+		return FirstStatement;
+	}
+
+	// Index = Find(Name|String)Case(Keys, Selection), and search for the case of Index.
+	// If the keys do not fit in a name literal, the keys are compared one by one.
+	void CompileHashedSwitch(FKismetFunctionContext& Context, UK2Node_MultiSwitch* Node, FBPTerminal* SelectionTerm)
+	{
+		TArray<FString> Keys;
+		TArray<UEdGraphPin*> ExecPins;
+		ACFMultiSwitch::GetHashedKeys(Node, Keys, ExecPins);
+		if (Keys.Num() == 0)
+		{
+			GenerateSimpleThenGoto(Context, *Node, Node->GetDefaultExecPin());
+			return;
+		}
+
+		const ACFSwitch::EKeyType KeyType = ACFMultiSwitch::GetKeyType(Node);
+		const FString EncodedKeys = ACFSwitch::EncodeKeys(KeyType, Keys);
+		if (EncodedKeys.IsEmpty())
+		{
+			UFunction* NotEqualFunction = nullptr;
+			if (KeyType == ACFSwitch::EKeyType::Name)
+			{
+				NotEqualFunction = UKismetMathLibrary::StaticClass()->FindFunctionByName(
+					GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, NotEqual_NameName));
+			}
+			else
+			{
+				const FName NotEqualFunctionName = (KeyType == ACFSwitch::EKeyType::StringCaseSensitive)
+													   ? GET_FUNCTION_NAME_CHECKED(UKismetStringLibrary, NotEqual_StrStr)
+													   : GET_FUNCTION_NAME_CHECKED(UKismetStringLibrary, NotEqual_StriStri);
+				NotEqualFunction = UKismetStringLibrary::StaticClass()->FindFunctionByName(NotEqualFunctionName);
+			}
+
+			for (int32 Index = 0; Index < Keys.Num(); ++Index)
+			{
+				FBlueprintCompiledStatement* FirstStatement = nullptr;
+				FBlueprintCompiledStatement& GotoCaseStatement = CompileGotoIfNot(Context, Node, SelectionTerm, NotEqualFunction,
+					Node->GetSelectionPin()->PinType.PinCategory, Keys[Index], FirstStatement);
+				Context.GotoFixupRequestMap.Add(&GotoCaseStatement, ExecPins[Index]);
+			}
+			GenerateSimpleThenGoto(Context, *Node, Node->GetDefaultExecPin());
+			return;
+		}
+
+		const FName FindFunctionName = (KeyType == ACFSwitch::EKeyType::Name)
+										   ? GET_FUNCTION_NAME_CHECKED(UACFSwitchLibrary, FindNameCase)
+										   : GET_FUNCTION_NAME_CHECKED(UACFSwitchLibrary, FindStringCase);
+		FBlueprintCompiledStatement& CallFuncStatement = Context.AppendStatementForNode(Node);
+		CallFuncStatement.Type = KCST_CallFunction;
+		CallFuncStatement.FunctionToCall = UACFSwitchLibrary::StaticClass()->FindFunctionByName(FindFunctionName);
+		CallFuncStatement.LHS = IndexTermMap.FindRef(Node);
+		CallFuncStatement.RHS.Add(CreateKeyTerm(Context, Node, UEdGraphSchema_K2::PC_Name, EncodedKeys));
+		CallFuncStatement.RHS.Add(SelectionTerm);
+
+		TArray<ACFMultiSwitch::FCase> Cases;
+		ACFMultiSwitch::GetIndexCases(ExecPins, Cases);
+		CompileCaseSearch(Context, Node, IndexTermMap.FindRef(Node), UEdGraphSchema_K2::PC_Int, Cases, 0, Cases.Num(), INDEX_NONE,
+			Cases.Num() - 1);
+	}
+
+public:
+	FKCHandler_MultiSwitch(FKismetCompilerContext& InCompilerContext) : FNodeHandlingFunctor(InCompilerContext)
+	{
+	}
+
+	virtual void RegisterNets(FKismetFunctionContext& Context, UEdGraphNode* Node) override
+	{
+		FNodeHandlingFunctor::RegisterNets(Context, Node);
+
+		FBPTerminal* BoolTerm = Context.CreateLocalTerminal();
+		BoolTerm->Type.PinCategory = UEdGraphSchema_K2::PC_Boolean;
+		BoolTerm->Source = Node;
+		BoolTerm->Name = Context.NetNameMap->MakeValidName(Node, TEXT("CompareResult"));
+		BoolTermMap.Add(Node, BoolTerm);
+
+		FBPTerminal* IndexTerm = Context.CreateLocalTerminal();
+		IndexTerm->Type.PinCategory = UEdGraphSchema_K2::PC_Int;
+		IndexTerm->Source = Node;
+		IndexTerm->Name = Context.NetNameMap->MakeValidName(Node, TEXT("CaseIndex"));
+		IndexTermMap.Add(Node, IndexTerm);
+	}
+
+	virtual void Compile(FKismetFunctionContext& Context, UEdGraphNode* Node) override
+	{
+		UK2Node_MultiSwitch* MultiSwitchNode = CastChecked<UK2Node_MultiSwitch>(Node);
+
+		FEdGraphPinType ExpectedExecPinType;
+		ExpectedExecPinType.PinCategory = UEdGraphSchema_K2::PC_Exec;
+
+		{
+			UEdGraphPin* ExecTriggeringPin =
+				Context.FindRequiredPinByName(MultiSwitchNode, UEdGraphSchema_K2::PN_Execute, EGPD_Input);
+			if ((ExecTriggeringPin == nullptr) || !Context.ValidatePinType(ExecTriggeringPin, ExpectedExecPinType))
+			{
+				CompilerContext.MessageLog.Error(
+					*LOCTEXT("NoValidExecutionPinForMultiSwitch_Error", "@@ must have a valid execution pin @@").ToString(),
+					MultiSwitchNode, ExecTriggeringPin);
+				return;
+			}
+			else if (ExecTriggeringPin->LinkedTo.Num() == 0)
+			{
+				CompilerContext.MessageLog.Warning(
+					*LOCTEXT("NodeNeverExecuted_Warning", "@@ will never be executed").ToString(), MultiSwitchNode);
+				return;
+			}
+		}
+
+		UEdGraphPin* SelectionPin = MultiSwitchNode->GetSelectionPin();
+		FBPTerminal* SelectionTerm = Context.NetMap.FindRef(FEdGraphUtilities::GetNetFromPin(SelectionPin));
+		if (SelectionTerm == nullptr)
+		{
+			CompilerContext.MessageLog.Error(
+				*LOCTEXT("NoValidSelectionForMultiSwitch_Error", "@@ must have a valid selection @@").ToString(), MultiSwitchNode,
+				SelectionPin);
+			return;
+		}
+
+		if (MultiSwitchNode->IsHashedSelection())
+		{
+			CompileHashedSwitch(Context, MultiSwitchNode, SelectionTerm);
+			return;
+		}
+
+		// The keys are validated on the expansion.
+		TArray<ACFMultiSwitch::FCase> Cases;
+		for (auto& Pin : MultiSwitchNode->Pins)
+		{
+			if ((Pin->Direction != EGPD_Output) || (Pin->GetFName() == DefaultExecPinName))
+			{
+				continue;
+			}
+
+			ACFMultiSwitch::FCase Case;
+			if (MultiSwitchNode->GetCaseKeyValue(MultiSwitchNode->GetCaseKeyPinFromCaseValuePin(Pin), Case.Key))
+			{
+				Case.ExecPin = Pin;
+				Cases.Add(Case);
+			}
+		}
+		Cases.Sort([](const ACFMultiSwitch::FCase& A, const ACFMultiSwitch::FCase& B) { return A.Key < B.Key; });
+
+		if (Cases.Num() == 0)
+		{
+			GenerateSimpleThenGoto(Context, *MultiSwitchNode, MultiSwitchNode->GetDefaultExecPin());
+			return;
+		}
+
+		int64 Lo = 0;
+		int64 Hi = 0;
+		ACFMultiSwitch::GetSelectionRange(SelectionPin->PinType, Lo, Hi);
+		CompileCaseSearch(
+			Context, MultiSwitchNode, SelectionTerm, SelectionPin->PinType.PinCategory, Cases, 0, Cases.Num(), Lo, Hi);
+	}
+};
+
+UK2Node_MultiSwitch::UK2Node_MultiSwitch(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	NodeContextMenuSectionName = "K2NodeMultiSwitch";
+	NodeContextMenuSectionLabel = LOCTEXT("MultiSwitch", "Multi-Switch");
+	CaseKeyPinNamePrefix = TEXT("CaseKey");
+	CaseValuePinNamePrefix = TEXT("CaseExec");
+	CaseKeyPinFriendlyNamePrefix = TEXT("Key ");
+	CaseValuePinFriendlyNamePrefix = TEXT(" ");
+	bCaseSensitive = false;
+}
+
+void UK2Node_MultiSwitch::AllocateDefaultPins()
+{
+	// Pin structure
+	//   N: Number of case pin pair
+	// -----
+	// 0: Execution Triggering (In, Exec)
+	// 1: Selection (In, Integer/Byte/Enum/Name/String)
+	// 2: Default Execution (Out, Exec)
+	// 3 - 2+N: Case Key (In, Literal Integer/Byte/Enum/Name/String)
+	// 2+N+1 - 2*(N+1): Case Execution (Out, Exec)
+
+	CreateExecTriggeringPin();
+	CreateSelectionPin();
+	CreateDefaultExecPin();
+
+	for (int32 Index = 0; Index < 2; ++Index)
+	{
+		AddCasePinPair(Index);
+	}
+
+	Super::AllocateDefaultPins();
+}
+
+FText UK2Node_MultiSwitch::GetTooltipText() const
+{
+	return LOCTEXT("MultiSwitch_Tooltip",
+		"Multi-Switch\nExecution goes to the case whose key equals the selection.\nThe case is found by the binary search on the "
+		"keys.\nName and string keys are looked up by the hash.");
+}
+
+FLinearColor UK2Node_MultiSwitch::GetNodeTitleColor() const
+{
+	return GetDefault<UGraphEditorSettings>()->ExecBranchNodeTitleColor;
+}
+
+FText UK2Node_MultiSwitch::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("MultiSwitch", "Multi-Switch");
+}
+
+FSlateIcon UK2Node_MultiSwitch::GetIconAndTint(FLinearColor& OutColor) const
+{
+	static FSlateIcon Icon("EditorStyle", "GraphEditor.Switch_16x");
+	return Icon;
+}
+
+void UK2Node_MultiSwitch::PinConnectionListChanged(UEdGraphPin* Pin)
+{
+	if (Pin == nullptr)
+	{
+		return;
+	}
+
+	if (Pin->LinkedTo.Num() == 0)
+	{
+		// Ignore the disconnection event.
+		return;
+	}
+
+	if (Pin != GetSelectionPin())
+	{
+		return;
+	}
+
+	Super::PinConnectionListChanged(Pin);
+
+	const FEdGraphPinType& LinkedPinType = Pin->LinkedTo[0]->PinType;
+	if ((Pin->PinType.PinCategory == LinkedPinType.PinCategory) &&
+		(Pin->PinType.PinSubCategoryObject == LinkedPinType.PinSubCategoryObject))
+	{
+		// Pin type has already fixed.
+		return;
+	}
+
+	// The keys of the previous type have no meaning for the new type.
+	Modify();
+	SetSelectionPinType(LinkedPinType, true);
+
+	UBlueprint* Blueprint = GetBlueprint();
+	FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+	Blueprint->BroadcastChanged();
+}
+
+void UK2Node_MultiSwitch::ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins)
+{
+	CreateExecTriggeringPin();
+	CreateSelectionPin();
+	CreateDefaultExecPin();
+
+	// The key pins are created with the type of the selection.
+	for (auto& OldPin : OldPins)
+	{
+		if ((OldPin->PinName == MultiSwitchSelectionPinName) && (OldPin->PinType.PinCategory != UEdGraphSchema_K2::PC_Wildcard))
+		{
+			SetSelectionPinType(OldPin->PinType, false);
+			break;
+		}
+	}
+
+	Super::ReallocatePinsDuringReconstruction(OldPins);
+}
+
+class FNodeHandlingFunctor* UK2Node_MultiSwitch::CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const
+{
+	return new FKCHandler_MultiSwitch(CompilerContext);
+}
+
+void UK2Node_MultiSwitch::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
+{
+	UClass* ActionKey = GetClass();
+	if (ActionRegistrar.IsOpenForRegistration(ActionKey))
+	{
+		UBlueprintNodeSpawner* NodeSpawner = UBlueprintNodeSpawner::Create(GetClass());
+		check(NodeSpawner != nullptr);
+
+		ActionRegistrar.AddBlueprintAction(ActionKey, NodeSpawner);
+	}
+}
+
+FText UK2Node_MultiSwitch::GetMenuCategory() const
+{
+	return FEditorCategoryUtils::GetCommonCategory(FCommonEditorCategory::FlowControl);
+}
+
+void UK2Node_MultiSwitch::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	Super::ExpandNode(CompilerContext, SourceGraph);
+
+	UEdGraphPin* SelectionPin = GetSelectionPin();
+	if (SelectionPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Wildcard)
+	{
+		CompilerContext.MessageLog.Error(
+			*LOCTEXT("MultiSwitchWildcard_Error", "The selection type of @@ is not determined").ToString(), this);
+		BreakAllNodeLinks();
+		return;
+	}
+
+	// The search tree requires the unique keys.
+	TArray<ACFMultiSwitch::FCase> Cases;
+	TMap<int32, UEdGraphPin*> KeyPins;
+	bool bError = false;
+	int32 NumLookups = 0;
+	if (IsHashedSelection())
+	{
+		// The name keys are always case-insensitive. The string keys follow the case sensitivity option.
+		const bool bName = SelectionPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Name;
+		const ESearchCase::Type SearchCase =
+			(bCaseSensitive && !bName) ? ESearchCase::CaseSensitive : ESearchCase::IgnoreCase;
+		TArray<FString> Keys;
+		TArray<UEdGraphPin*> ExecPins;
+		ACFMultiSwitch::GetHashedKeys(this, Keys, ExecPins);
+		for (int32 Index = 0; Index < Keys.Num(); ++Index)
+		{
+			UEdGraphPin* KeyPin = GetCaseKeyPinFromCaseValuePin(ExecPins[Index]);
+			if (bName && (Keys[Index].Len() >= NAME_SIZE))
+			{
+				CompilerContext.MessageLog.Error(
+					*LOCTEXT("MultiSwitchInvalidKey_Error", "@@ has an invalid key").ToString(), KeyPin);
+				bError = true;
+				continue;
+			}
+			for (int32 OtherIndex = 0; OtherIndex < Index; ++OtherIndex)
+			{
+				if (Keys[Index].Equals(Keys[OtherIndex], SearchCase))
+				{
+					CompilerContext.MessageLog.Error(
+						*LOCTEXT("MultiSwitchDuplicatedKey_Error", "@@ has the same key as @@").ToString(), KeyPin,
+						GetCaseKeyPinFromCaseValuePin(ExecPins[OtherIndex]));
+					bError = true;
+					break;
+				}
+			}
+		}
+		ACFMultiSwitch::GetIndexCases(ExecPins, Cases);
+		NumLookups = ACFSwitch::EncodeKeys(ACFMultiSwitch::GetKeyType(this), Keys).IsEmpty() ? 0 : 1;
+	}
+	else
+	{
+		for (auto& Pair : GetCasePinPairs())
+		{
+			ACFMultiSwitch::FCase Case;
+			if (!GetCaseKeyValue(Pair.Key, Case.Key))
+			{
+				CompilerContext.MessageLog.Error(
+					*LOCTEXT("MultiSwitchInvalidKey_Error", "@@ has an invalid key").ToString(), Pair.Key);
+				bError = true;
+				continue;
+			}
+			if (UEdGraphPin** DuplicatedPin = KeyPins.Find(Case.Key))
+			{
+				CompilerContext.MessageLog.Error(
+					*LOCTEXT("MultiSwitchDuplicatedKey_Error", "@@ has the same key as @@").ToString(), Pair.Key, *DuplicatedPin);
+				bError = true;
+				continue;
+			}
+			KeyPins.Add(Case.Key, Pair.Key);
+			Case.ExecPin = Pair.Value;
+			Cases.Add(Case);
+		}
+	}
+	if (bError)
+	{
+		BreakAllNodeLinks();
+		return;
+	}
+
+	if (ShouldCountCaseHits(false))
+	{
+		ExpandCaseHitCounters(CompilerContext, SourceGraph);
+	}
+
+	if (ShouldEmitTraceEvents())
+	{
+		// Each case is taken after the comparisons on the path of the search tree.
+		// Default is taken after the comparisons of the deepest path at most.
+		TArray<int32> NumConditions;
+		NumConditions.Init(0, GetCasePinCount() + 1);
+		if (IsHashedSelection() && (NumLookups == 0))
+		{
+			// The keys which do not fit in a name literal are compared one by one.
+			for (int32 Index = 0; Index < Cases.Num(); ++Index)
+			{
+				NumConditions[GetCaseIndexFromCaseValuePin(Cases[Index].ExecPin)] = Index + 1;
+			}
+			NumConditions.Last() = Cases.Num();
+		}
+		else if (IsHashedSelection() && (Cases.Num() > 0))
+		{
+			// The lookup is followed by the search tree on the found index.
+			TArray<int32> Counts;
+			Counts.Init(0, Cases.Num());
+			ACFMultiSwitch::CountComparisons(Cases, 0, Cases.Num(), INDEX_NONE, Cases.Num() - 1, NumLookups, Counts);
+			for (int32 Index = 0; Index < Cases.Num(); ++Index)
+			{
+				NumConditions[GetCaseIndexFromCaseValuePin(Cases[Index].ExecPin)] = Counts[Index];
+			}
+			NumConditions.Last() = FMath::Max(Counts);
+		}
+		else if (Cases.Num() > 0)
+		{
+			Cases.Sort([](const ACFMultiSwitch::FCase& A, const ACFMultiSwitch::FCase& B) { return A.Key < B.Key; });
+			int64 Lo = 0;
+			int64 Hi = 0;
+			ACFMultiSwitch::GetSelectionRange(SelectionPin->PinType, Lo, Hi);
+			TArray<int32> Counts;
+			Counts.Init(0, Cases.Num());
+			ACFMultiSwitch::CountComparisons(Cases, 0, Cases.Num(), Lo, Hi, 0, Counts);
+			for (int32 Index = 0; Index < Cases.Num(); ++Index)
+			{
+				NumConditions[GetCaseIndexFromCaseValuePin(Cases[Index].ExecPin)] = Counts[Index];
+			}
+			NumConditions.Last() = FMath::Max(Counts);
+		}
+		ExpandTraceEvents(CompilerContext, SourceGraph, NumConditions);
+	}
+
+	// Compiled by FKCHandler_MultiSwitch.
+}
+
+bool UK2Node_MultiSwitch::IsConnectionDisallowed(const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const
+{
+	if (OtherPin && (MyPin == GetSelectionPin()))
+	{
+		const FName Category = OtherPin->PinType.PinCategory;
+		if (OtherPin->PinType.IsContainer() ||
+			((Category != UEdGraphSchema_K2::PC_Int) && (Category != UEdGraphSchema_K2::PC_Byte) &&
+				(Category != UEdGraphSchema_K2::PC_Name) && (Category != UEdGraphSchema_K2::PC_String)))
+		{
+			OutReason =
+				LOCTEXT("MultiSwitchSelectionConnectionDisallowed", "Only integer, byte, enum, name or string can be connected.")
+					.ToString();
+			return true;
+		}
+	}
+
+	return Super::IsConnectionDisallowed(MyPin, OtherPin, OutReason);
+}
+
+void UK2Node_MultiSwitch::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UK2Node_MultiSwitch, bCaseSensitive))
+	{
+		FBlueprintEditorUtils::MarkBlueprintAsModified(GetBlueprint());
+	}
+}
+
+void UK2Node_MultiSwitch::CreateExecTriggeringPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 0;
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Execute, Params);
+}
+
+void UK2Node_MultiSwitch::CreateSelectionPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 1;
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Wildcard, MultiSwitchSelectionPinName, Params);
+}
+
+void UK2Node_MultiSwitch::CreateDefaultExecPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 2;
+	UEdGraphPin* DefaultExecPin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, DefaultExecPinName, Params);
+	DefaultExecPin->PinFriendlyName = FText::AsCultureInvariant(DefaultExecPinFriendlyName.ToString());
+}
+
+UEdGraphPin* UK2Node_MultiSwitch::GetSelectionPin() const
+{
+	return FindPin(MultiSwitchSelectionPinName);
+}
+
+UEdGraphPin* UK2Node_MultiSwitch::GetDefaultExecPin() const
+{
+	return FindPin(DefaultExecPinName);
+}
+
+CasePinPair UK2Node_MultiSwitch::AddCasePinPair(int32 CaseIndex)
+{
+	CasePinPair Pair;
+	int32 N = GetCasePinCount();
+	UEdGraphPin* SelectionPin = GetSelectionPin();
+
+	{
+		Pair.Key = CreatePin(EGPD_Input, SelectionPin->PinType, *GetCasePinName(CaseKeyPinNamePrefix.ToString(), CaseIndex),
+			3 + CaseIndex);
+		Pair.Key->PinFriendlyName =
+			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseKeyPinFriendlyNamePrefix.ToString(), CaseIndex));
+		Pair.Key->bNotConnectable = true;
+		Pair.Key->DefaultValue = GetUnusedKeyValue();
+	}
+	{
+		FCreatePinParams Params;
+		Params.Index = 3 + N + 1 + CaseIndex;
+		Pair.Value = CreatePin(
+			EGPD_Output, UEdGraphSchema_K2::PC_Exec, *GetCasePinName(CaseValuePinNamePrefix.ToString(), CaseIndex), Params);
+		Pair.Value->PinFriendlyName =
+			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseValuePinFriendlyNamePrefix.ToString(), CaseIndex));
+	}
+
+	return Pair;
+}
+
+void UK2Node_MultiSwitch::SetSelectionPinType(const FEdGraphPinType& PinType, bool bResetKeys)
+{
+	FEdGraphPinType SelectionPinType = PinType;
+	SelectionPinType.ContainerType = EPinContainerType::None;
+	SelectionPinType.bIsReference = false;
+	SelectionPinType.bIsConst = false;
+	SelectionPinType.PinValueType = FEdGraphTerminalType();
+
+	GetSelectionPin()->PinType = SelectionPinType;
+	TArray<UEdGraphPin*> KeyPins;
+	for (auto& Pin : Pins)
+	{
+		if (IsCaseKeyPin(Pin))
+		{
+			Pin->PinType = SelectionPinType;
+			KeyPins.Add(Pin);
+		}
+	}
+
+	if (bResetKeys)
+	{
+		for (auto& Pin : KeyPins)
+		{
+			Pin->DefaultValue.Empty();
+		}
+		for (auto& Pin : KeyPins)
+		{
+			Pin->DefaultValue = GetUnusedKeyValue();
+		}
+	}
+}
+
+FString UK2Node_MultiSwitch::GetUnusedKeyValue() const
+{
+	if (IsHashedSelection())
+	{
+		TSet<FString> UsedNames;
+		for (auto& Pin : Pins)
+		{
+			if (IsCaseKeyPin(Pin))
+			{
+				UsedNames.Add(Pin->DefaultValue);
+			}
+		}
+
+		int32 Index = 0;
+		while (UsedNames.Contains(FString::Printf(TEXT("Case%d"), Index)))
+		{
+			++Index;
+		}
+		return FString::Printf(TEXT("Case%d"), Index);
+	}
+
+	TSet<int32> UsedKeys;
+	for (auto& Pin : Pins)
+	{
+		int32 Key = 0;
+		if (IsCaseKeyPin(Pin) && GetCaseKeyValue(Pin, Key))
+		{
+			UsedKeys.Add(Key);
+		}
+	}
+
+	UEdGraphPin* SelectionPin = GetSelectionPin();
+	if (const UEnum* Enum = Cast<UEnum>(SelectionPin->PinType.PinSubCategoryObject.Get()))
+	{
+		const int32 NumEnums = Enum->ContainsExistingMax() ? Enum->NumEnums() - 1 : Enum->NumEnums();
+		for (int32 Index = 0; Index < NumEnums; ++Index)
+		{
+			if (!UsedKeys.Contains(Enum->GetValueByIndex(Index)))
+			{
+				return Enum->GetNameStringByIndex(Index);
+			}
+		}
+		return (NumEnums > 0) ? Enum->GetNameStringByIndex(0) : FString();
+	}
+
+	int32 Key = 0;
+	while (UsedKeys.Contains(Key))
+	{
+		++Key;
+	}
+	return FString::FromInt(Key);
+}
+
+TArray<UEdGraphPin*> UK2Node_MultiSwitch::GetCaseConditionPins() const
+{
+	// The cases are chosen by the keys, not by the conditions.
+	return TArray<UEdGraphPin*>();
+}
+
+bool UK2Node_MultiSwitch::GetCaseKeyValue(const UEdGraphPin* KeyPin, int32& OutValue) const
+{
+	if ((KeyPin == nullptr) || IsHashedSelection())
+	{
+		return false;
+	}
+
+	if (const UEnum* Enum = Cast<UEnum>(KeyPin->PinType.PinSubCategoryObject.Get()))
+	{
+		const int32 Index = Enum->GetIndexByNameString(KeyPin->DefaultValue);
+		if (Index == INDEX_NONE)
+		{
+			return false;
+		}
+		OutValue = static_cast<int32>(Enum->GetValueByIndex(Index));
+		return true;
+	}
+
+	if (!FDefaultValueHelper::ParseInt(KeyPin->DefaultValue, OutValue))
+	{
+		return false;
+	}
+	if (KeyPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Byte)
+	{
+		return (OutValue >= 0) && (OutValue <= MAX_uint8);
+	}
+
+	return true;
+}
+
+bool UK2Node_MultiSwitch::IsHashedSelection() const
+{
+	const FName Category = GetSelectionPin()->PinType.PinCategory;
+	return (Category == UEdGraphSchema_K2::PC_Name) || (Category == UEdGraphSchema_K2::PC_String);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,510 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "K2Node_RangeSelect.h"
+
+#include "ACFRangeLibrary.h"
+#include "BlueprintNodeSpawner.h"
+#include "EditorCategoryUtils.h"
+#include "GraphEditorSettings.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_Select.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "KismetCompiler.h"
+#include "Misc/DefaultValueHelper.h"
+
+#define LOCTEXT_NAMESPACE "AdvancedControlFlow"
+
+static const FName RangeSelectValuePinName(TEXT("Value"));
+static const FName RangeSelectDefaultOptionPinName(TEXT("Default"));
+static const FName RangeSelectReturnValuePinName(TEXT("Return Value"));
+
+// Type of the value passed to UACFRangeLibrary::FindLiteralRange, or 0 if the type is not supported.
+static TCHAR GetRangeValueType(const FEdGraphPinType& PinType)
+{
+	if (PinType.IsContainer())
+	{
+		return 0;
+	}
+	if (PinType.PinCategory == UEdGraphSchema_K2::PC_Int)
+	{
+		return TEXT('i');
+	}
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	if (PinType.PinCategory == UEdGraphSchema_K2::PC_Float)
+	{
+		return TEXT('f');
+	}
+#else
+	if (PinType.PinCategory == UEdGraphSchema_K2::PC_Real)
+	{
+		return (PinType.PinSubCategory == UEdGraphSchema_K2::PC_Double) ? TEXT('d') : TEXT('f');
+	}
+#endif
+
+	return 0;
+}
+
+UK2Node_RangeSelect::UK2Node_RangeSelect(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	NodeContextMenuSectionName = "K2NodeRangeSelect";
+	NodeContextMenuSectionLabel = LOCTEXT("RangeSelect", "Range Select");
+	CaseKeyPinNamePrefix = TEXT("CaseOption");
+	CaseValuePinNamePrefix = TEXT("CaseBound");
+	CaseKeyPinFriendlyNamePrefix = TEXT("Option ");
+	CaseValuePinFriendlyNamePrefix = TEXT("Less Than ");
+}
+
+void UK2Node_RangeSelect::AllocateDefaultPins()
+{
+	// Pin structure
+	//   N: Number of option/bound pin pair
+	// -----
+	// 0: Value (In, Integer/Float/Double)
+	// 1: Default (In, Wildcard)
+	// 2-(N+1): Option (In, Wildcard)
+	// (N+2)-(2N+1): Upper Bound (In, Literal Integer/Float/Double)
+	// 2N+2: Return Value (Out, Wildcard)
+
+	CreateValuePin();
+	CreateDefaultOptionPin();
+	CreateReturnValuePin();
+
+	for (int32 Index = 0; Index < 2; ++Index)
+	{
+		AddCasePinPair(Index);
+	}
+
+	Super::AllocateDefaultPins();
+}
+
+FText UK2Node_RangeSelect::GetTooltipText() const
+{
+	return LOCTEXT("RangeSelect_Tooltip",
+		"Range Select\nReturn the option of the smallest upper bound which is greater than the value.\nDefault is returned if no "
+		"bound is greater than the value.");
+}
+
+FLinearColor UK2Node_RangeSelect::GetNodeTitleColor() const
+{
+	return GetDefault<UGraphEditorSettings>()->PureFunctionCallNodeTitleColor;
+}
+
+FText UK2Node_RangeSelect::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("RangeSelect", "Range Select");
+}
+
+FSlateIcon UK2Node_RangeSelect::GetIconAndTint(FLinearColor& OutColor) const
+{
+	static FSlateIcon Icon("EditorStyle", "GraphEditor.Select_16x");
+	return Icon;
+}
+
+void UK2Node_RangeSelect::PinConnectionListChanged(UEdGraphPin* Pin)
+{
+	if (Pin == nullptr)
+	{
+		return;
+	}
+
+	if (Pin->LinkedTo.Num() == 0)
+	{
+		// Ignore the disconnection event.
+		return;
+	}
+
+	if (IsCaseValuePin(Pin))
+	{
+		// Bound pins are not connectable.
+		return;
+	}
+
+	Super::PinConnectionListChanged(Pin);
+
+	const FEdGraphPinType& LinkedPinType = Pin->LinkedTo[0]->PinType;
+	if (Pin == GetValuePin())
+	{
+		if ((Pin->PinType.PinCategory == LinkedPinType.PinCategory) &&
+			(Pin->PinType.PinSubCategory == LinkedPinType.PinSubCategory))
+		{
+			// Pin type has already fixed.
+			return;
+		}
+
+		// The bounds of the previous type may not be valid for the new type.
+		Modify();
+		SetValuePinType(LinkedPinType, true);
+	}
+	else
+	{
+		if (GetDefaultOptionPin()->PinType.PinCategory != UEdGraphSchema_K2::PC_Wildcard)
+		{
+			// Pin type has already fixed.
+			return;
+		}
+
+		Modify();
+
+		const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+		TArray<UEdGraphPin*> OptionPins = GetCaseHitPins();
+		OptionPins.Add(GetReturnValuePin());
+		for (auto& OptionPin : OptionPins)
+		{
+			OptionPin->PinType = LinkedPinType;
+			Schema->ResetPinToAutogeneratedDefaultValue(OptionPin);
+		}
+	}
+
+	UBlueprint* Blueprint = GetBlueprint();
+	FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+	Blueprint->BroadcastChanged();
+}
+
+void UK2Node_RangeSelect::ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins)
+{
+	UEdGraphPin* OldValuePin = nullptr;
+	UEdGraphPin* OldDefaultPin = nullptr;
+	for (auto& Pin : OldPins)
+	{
+		if (Pin->GetFName() == RangeSelectValuePinName)
+		{
+			OldValuePin = Pin;
+		}
+		else if (Pin->GetFName() == RangeSelectDefaultOptionPinName)
+		{
+			OldDefaultPin = Pin;
+		}
+	}
+
+	CreateValuePin();
+	CreateDefaultOptionPin();
+	CreateReturnValuePin();
+
+	// The bound pins are created with the type of the value.
+	if ((OldValuePin != nullptr) && (OldValuePin->PinType.PinCategory != UEdGraphSchema_K2::PC_Wildcard))
+	{
+		SetValuePinType(OldValuePin->PinType, false);
+	}
+
+	Super::ReallocatePinsDuringReconstruction(OldPins);
+
+	if (OldDefaultPin != nullptr)
+	{
+		GetDefaultOptionPin()->PinType = OldDefaultPin->PinType;
+		GetReturnValuePin()->PinType = OldDefaultPin->PinType;
+		for (auto& Pair : GetCasePinPairs())
+		{
+			Pair.Key->PinType = OldDefaultPin->PinType;
+		}
+	}
+}
+
+void UK2Node_RangeSelect::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
+{
+	UClass* ActionKey = GetClass();
+	if (ActionRegistrar.IsOpenForRegistration(ActionKey))
+	{
+		UBlueprintNodeSpawner* NodeSpawner = UBlueprintNodeSpawner::Create(GetClass());
+		check(NodeSpawner != nullptr);
+
+		ActionRegistrar.AddBlueprintAction(ActionKey, NodeSpawner);
+	}
+}
+
+FText UK2Node_RangeSelect::GetMenuCategory() const
+{
+	return FEditorCategoryUtils::GetCommonCategory(FCommonEditorCategory::Utilities);
+}
+
+void UK2Node_RangeSelect::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	Super::ExpandNode(CompilerContext, SourceGraph);
+
+	UEdGraphPin* ValuePin = GetValuePin();
+	const TCHAR ValueType = GetRangeValueType(ValuePin->PinType);
+	if (ValueType == 0)
+	{
+		CompilerContext.MessageLog.Error(
+			*LOCTEXT("RangeSelectWildcard_Error", "The value type of @@ is not determined").ToString(), this);
+		BreakAllNodeLinks();
+		return;
+	}
+
+	TArray<CasePinPair> CasePinPairs = GetCasePinPairs();
+	if (CasePinPairs.Num() == 0)
+	{
+		CompilerContext.MovePinLinksToIntermediate(*GetDefaultOptionPin(), *GetReturnValuePin());
+		BreakAllNodeLinks();
+		return;
+	}
+
+	// The bounds are sorted, so that the range is found by the binary search.
+	// The option of the smallest bound greater than the value is selected, so the order of the pins does not matter.
+	TArray<TPair<double, int32>> Bounds;
+	bool bError = false;
+	for (int32 Index = 0; Index < CasePinPairs.Num(); ++Index)
+	{
+		double Bound = 0.0;
+		if (!GetCaseBoundValue(CasePinPairs[Index].Value, Bound))
+		{
+			CompilerContext.MessageLog.Error(
+				*LOCTEXT("RangeSelectInvalidBound_Error", "@@ has an invalid bound").ToString(), CasePinPairs[Index].Value);
+			bError = true;
+			continue;
+		}
+		Bounds.Add(TPair<double, int32>(Bound, Index));
+	}
+	if (bError)
+	{
+		BreakAllNodeLinks();
+		return;
+	}
+	Bounds.StableSort([](const TPair<double, int32>& A, const TPair<double, int32>& B) { return A.Key < B.Key; });
+
+	TArray<FString> Literals;
+	for (int32 Order = 0; Order < Bounds.Num(); ++Order)
+	{
+		UEdGraphPin* BoundPin = CasePinPairs[Bounds[Order].Value].Value;
+		if ((Order > 0) && (Bounds[Order - 1].Key == Bounds[Order].Key))
+		{
+			CompilerContext.MessageLog.Error(*LOCTEXT("RangeSelectDuplicatedBound_Error", "@@ has the same bound as @@").ToString(),
+				BoundPin, CasePinPairs[Bounds[Order - 1].Value].Value);
+			bError = true;
+		}
+		Literals.Add((ValueType == TEXT('i')) ? FString::FromInt(static_cast<int32>(Bounds[Order].Key))
+											  : BoundPin->DefaultValue.TrimStartAndEnd());
+	}
+	const FString LiteralBounds = FString::Printf(TEXT("%c:%s"), ValueType, *FString::Join(Literals, TEXT(",")));
+	if (LiteralBounds.Len() >= NAME_SIZE)
+	{
+		CompilerContext.MessageLog.Error(*LOCTEXT("RangeSelectTooManyBounds_Error", "@@ has too many bounds").ToString(), this);
+		bError = true;
+	}
+	if (bError)
+	{
+		BreakAllNodeLinks();
+		return;
+	}
+
+	// The index of the range selects the option of the sorted case, and the number of the cases selects Default.
+	UK2Node_CallFunction* FindRange = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+	FindRange->SetFromFunction(
+		UACFRangeLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UACFRangeLibrary, FindLiteralRange)));
+	FindRange->AllocateDefaultPins();
+	CompilerContext.GetSchema()->TrySetDefaultValue(*FindRange->FindPinChecked(TEXT("Bounds")), LiteralBounds);
+	UEdGraphPin* ArgValuePin = FindRange->FindPinChecked(TEXT("Value"));
+	ArgValuePin->PinType = ValuePin->PinType;
+	CompilerContext.MovePinLinksToIntermediate(*ValuePin, *ArgValuePin);
+
+	UK2Node_Select* Select = CompilerContext.SpawnIntermediateNode<UK2Node_Select>(this, SourceGraph);
+	Select->AllocateDefaultPins();
+	Select->ChangePinType(CasePinPairs[0].Key);
+	for (int32 Index = 1; Index < CasePinPairs.Num(); ++Index)
+	{
+		Select->AddInputPin();
+	}
+
+	TArray<UEdGraphPin*> SelectOptionPins;
+	Select->GetOptionPins(SelectOptionPins);
+	for (int32 Order = 0; Order < Bounds.Num(); ++Order)
+	{
+		CompilerContext.MovePinLinksToIntermediate(*CasePinPairs[Bounds[Order].Value].Key, *SelectOptionPins[Order]);
+	}
+	CompilerContext.MovePinLinksToIntermediate(*GetDefaultOptionPin(), *SelectOptionPins[CasePinPairs.Num()]);
+
+	UEdGraphPin* SelectIndexPin = Select->GetIndexPin();
+	FindRange->GetReturnValuePin()->MakeLinkTo(SelectIndexPin);
+	Select->NotifyPinConnectionListChanged(SelectIndexPin);
+
+	CompilerContext.MovePinLinksToIntermediate(*GetReturnValuePin(), *Select->GetReturnValuePin());
+
+	BreakAllNodeLinks();
+}
+
+bool UK2Node_RangeSelect::IsConnectionDisallowed(const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const
+{
+	if (OtherPin && (OtherPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec))
+	{
+		OutReason = LOCTEXT("ExecConnectionDisallowd", "Can't connect with Exec pin.").ToString();
+		return true;
+	}
+
+	if (OtherPin && (MyPin == GetValuePin()) && (GetRangeValueType(OtherPin->PinType) == 0))
+	{
+		OutReason = LOCTEXT("RangeSelectValueConnectionDisallowed", "Only integer, float or double can be connected.").ToString();
+		return true;
+	}
+
+	return Super::IsConnectionDisallowed(MyPin, OtherPin, OutReason);
+}
+
+void UK2Node_RangeSelect::CreateValuePin()
+{
+	FCreatePinParams Params;
+	Params.Index = 0;
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Wildcard, RangeSelectValuePinName, Params);
+}
+
+void UK2Node_RangeSelect::CreateDefaultOptionPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 1;
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Wildcard, RangeSelectDefaultOptionPinName, Params);
+}
+
+void UK2Node_RangeSelect::CreateReturnValuePin()
+{
+	int32 N = GetCasePinCount();
+
+	FCreatePinParams Params;
+	Params.Index = 2 * N + 2;
+	CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Wildcard, RangeSelectReturnValuePinName, Params);
+}
+
+UEdGraphPin* UK2Node_RangeSelect::GetValuePin() const
+{
+	return FindPin(RangeSelectValuePinName);
+}
+
+UEdGraphPin* UK2Node_RangeSelect::GetDefaultOptionPin() const
+{
+	return FindPin(RangeSelectDefaultOptionPinName);
+}
+
+UEdGraphPin* UK2Node_RangeSelect::GetReturnValuePin() const
+{
+	return FindPin(RangeSelectReturnValuePinName);
+}
+
+CasePinPair UK2Node_RangeSelect::AddCasePinPair(int32 CaseIndex)
+{
+	CasePinPair Pair;
+	int32 N = GetCasePinCount();
+	UEdGraphPin* DefaultOptionPin = GetDefaultOptionPin();
+
+	{
+		FCreatePinParams Params;
+		Params.Index = 2 + CaseIndex;
+		Pair.Key = CreatePin(
+			EGPD_Input, UEdGraphSchema_K2::PC_Wildcard, *GetCasePinName(CaseKeyPinNamePrefix.ToString(), CaseIndex), Params);
+		Pair.Key->PinFriendlyName =
+			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseKeyPinFriendlyNamePrefix.ToString(), CaseIndex));
+		Pair.Key->PinType = DefaultOptionPin->PinType;
+	}
+	{
+		Pair.Value = CreatePin(EGPD_Input, GetValuePin()->PinType, *GetCasePinName(CaseValuePinNamePrefix.ToString(), CaseIndex),
+			N + 3 + CaseIndex);
+		Pair.Value->PinFriendlyName =
+			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseValuePinFriendlyNamePrefix.ToString(), CaseIndex));
+		Pair.Value->bNotConnectable = true;
+		Pair.Value->DefaultValue = GetNextBoundValue();
+	}
+
+	return Pair;
+}
+
+void UK2Node_RangeSelect::SetValuePinType(const FEdGraphPinType& PinType, bool bResetBounds)
+{
+	FEdGraphPinType ValuePinType = PinType;
+	ValuePinType.ContainerType = EPinContainerType::None;
+	ValuePinType.bIsReference = false;
+	ValuePinType.bIsConst = false;
+	ValuePinType.PinValueType = FEdGraphTerminalType();
+
+	GetValuePin()->PinType = ValuePinType;
+	TArray<UEdGraphPin*> BoundPins;
+	for (auto& Pin : Pins)
+	{
+		if (IsCaseValuePin(Pin))
+		{
+			Pin->PinType = ValuePinType;
+			BoundPins.Add(Pin);
+		}
+	}
+
+	if (bResetBounds)
+	{
+		for (auto& Pin : BoundPins)
+		{
+			Pin->DefaultValue.Empty();
+		}
+		for (auto& Pin : BoundPins)
+		{
+			Pin->DefaultValue = GetNextBoundValue();
+		}
+	}
+}
+
+FString UK2Node_RangeSelect::GetNextBoundValue() const
+{
+	// Following the largest bound keeps the bounds in ascending order when the case is added last.
+	double MaxBound = -1.0;
+	for (auto& Pin : Pins)
+	{
+		double Bound = 0.0;
+		if (IsCaseValuePin(Pin) && GetCaseBoundValue(Pin, Bound))
+		{
+			MaxBound = FMath::Max(MaxBound, Bound);
+		}
+	}
+
+	const int64 NextBound = static_cast<int64>(FMath::FloorToDouble(MaxBound)) + 1;
+	if (GetRangeValueType(GetValuePin()->PinType) == TEXT('i'))
+	{
+		return LexToString(FMath::Min(NextBound, static_cast<int64>(MAX_int32)));
+	}
+
+	return FString::Printf(TEXT("%lld.0"), NextBound);
+}
+
+TArray<UEdGraphPin*> UK2Node_RangeSelect::GetCaseConditionPins() const
+{
+	// The cases are chosen by the bounds, not by the conditions.
+	return TArray<UEdGraphPin*>();
+}
+
+TArray<UEdGraphPin*> UK2Node_RangeSelect::GetCaseHitPins() const
+{
+	TArray<UEdGraphPin*> HitPins;
+	for (auto& Pair : GetCasePinPairs())
+	{
+		HitPins.Add(Pair.Key);
+	}
+	HitPins.Add(GetDefaultOptionPin());
+
+	return HitPins;
+}
+
+bool UK2Node_RangeSelect::GetCaseBoundValue(const UEdGraphPin* BoundPin, double& OutValue) const
+{
+	if (BoundPin == nullptr)
+	{
+		return false;
+	}
+
+	const FString DefaultValue = BoundPin->DefaultValue.TrimStartAndEnd();
+	if (GetRangeValueType(BoundPin->PinType) == TEXT('i'))
+	{
+		int32 Value = 0;
+		if (!FDefaultValueHelper::ParseInt(DefaultValue, Value))
+		{
+			return false;
+		}
+		OutValue = Value;
+		return true;
+	}
+
+	// NaN never becomes the upper bound of a range.
+	return FDefaultValueHelper::ParseDouble(DefaultValue, OutValue) && !FMath::IsNaN(OutValue);
+}
+
+#undef LOCTEXT_NAMESPACE
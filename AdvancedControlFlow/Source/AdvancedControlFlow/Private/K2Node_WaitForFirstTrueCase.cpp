@@ -0,0 +1,230 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "K2Node_WaitForFirstTrueCase.h"
+
+#include "ACFWaitLibrary.h"
+#include "BlueprintNodeSpawner.h"
+#include "EditorCategoryUtils.h"
+#include "GraphEditorSettings.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_IfThenElse.h"
+#include "K2Node_VariableGet.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "KismetCompiler.h"
+
+#define LOCTEXT_NAMESPACE "AdvancedControlFlow"
+
+UK2Node_WaitForFirstTrueCase::UK2Node_WaitForFirstTrueCase(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	NodeContextMenuSectionName = "K2NodeWaitForFirstTrueCase";
+	NodeContextMenuSectionLabel = LOCTEXT("WaitForFirstTrueCase", "Wait For First True Case");
+	CaseKeyPinNamePrefix = TEXT("CaseCond");
+	CaseValuePinNamePrefix = TEXT("CaseExec");
+	CaseKeyPinFriendlyNamePrefix = TEXT("Condition ");
+	CaseValuePinFriendlyNamePrefix = TEXT(" ");
+	PollingInterval = 0.2f;
+}
+
+void UK2Node_WaitForFirstTrueCase::AllocateDefaultPins()
+{
+	// Pin structure
+	//   N: Number of case pin pair
+	// -----
+	// 0: Execution Triggering (In, Exec)
+	// 1 - N: Case Conditional (In, Boolean)
+	// N+1 - 2*N: Case Execution (Out, Exec)
+
+	CreateExecTriggeringPin();
+
+	for (int32 Index = 0; Index < 2; ++Index)
+	{
+		AddCasePinPair(Index);
+	}
+
+	Super::AllocateDefaultPins();
+}
+
+FText UK2Node_WaitForFirstTrueCase::GetTooltipText() const
+{
+	return LOCTEXT("WaitForFirstTrueCase_Tooltip",
+		"Wait For First True Case\nExecution waits until one of the conditions becomes true, and goes to the first true case.\n"
+		"The conditions are tested again when a Boolean member variable connected directly to a condition notifies its change, "
+		"when Wake Waiting Cases is called, or at the polling interval.");
+}
+
+FLinearColor UK2Node_WaitForFirstTrueCase::GetNodeTitleColor() const
+{
+	return GetDefault<UGraphEditorSettings>()->ExecBranchNodeTitleColor;
+}
+
+FText UK2Node_WaitForFirstTrueCase::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("WaitForFirstTrueCase", "Wait For First True Case");
+}
+
+FSlateIcon UK2Node_WaitForFirstTrueCase::GetIconAndTint(FLinearColor& OutColor) const
+{
+	static FSlateIcon Icon("EditorStyle", "GraphEditor.Timeline_16x");
+	return Icon;
+}
+
+void UK2Node_WaitForFirstTrueCase::ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins)
+{
+	CreateExecTriggeringPin();
+
+	Super::ReallocatePinsDuringReconstruction(OldPins);
+}
+
+FText UK2Node_WaitForFirstTrueCase::GetMenuCategory() const
+{
+	return FEditorCategoryUtils::GetCommonCategory(FCommonEditorCategory::FlowControl);
+}
+
+void UK2Node_WaitForFirstTrueCase::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
+{
+	UClass* ActionKey = GetClass();
+	if (ActionRegistrar.IsOpenForRegistration(ActionKey))
+	{
+		UBlueprintNodeSpawner* NodeSpawner = UBlueprintNodeSpawner::Create(GetClass());
+		check(NodeSpawner != nullptr);
+
+		ActionRegistrar.AddBlueprintAction(ActionKey, NodeSpawner);
+	}
+}
+
+void UK2Node_WaitForFirstTrueCase::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	Super::ExpandNode(CompilerContext, SourceGraph);
+
+	// The latent action resumes the event graph only.
+	if (SourceGraph != CompilerContext.ConsolidatedEventGraph)
+	{
+		CompilerContext.MessageLog.Error(
+			*LOCTEXT("WaitNotInEventGraph_Error", "@@ is available only in the event graph").ToString(), this);
+		BreakAllNodeLinks();
+		return;
+	}
+
+	TArray<CasePinPair> CasePairs = GetCasePinPairs();
+	if (CasePairs.Num() == 0)
+	{
+		BreakAllNodeLinks();
+		return;
+	}
+
+	// Expand to the chain of Branch nodes followed by the wait, which resumes at the head of the chain.
+	// The pure nodes of the conditions are evaluated again each time the chain is entered.
+	UK2Node_CallFunction* Wait = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+	Wait->SetFromFunction(
+		UACFWaitLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UACFWaitLibrary, WaitForCaseChange)));
+	Wait->AllocateDefaultPins();
+	CompilerContext.GetSchema()->TrySetDefaultValue(
+		*Wait->FindPinChecked(TEXT("PollingInterval")), FString::SanitizeFloat(PollingInterval));
+	const FString WakeSources = GetWakeSources(CompilerContext);
+	if (WakeSources.Len() < NAME_SIZE)
+	{
+		CompilerContext.GetSchema()->TrySetDefaultValue(*Wait->FindPinChecked(TEXT("WakeSources")), WakeSources);
+	}
+
+	UEdGraphPin* ElsePin = nullptr;
+	for (auto& Pair : CasePairs)
+	{
+		UK2Node_IfThenElse* IfThenElse = CompilerContext.SpawnIntermediateNode<UK2Node_IfThenElse>(this, SourceGraph);
+		IfThenElse->AllocateDefaultPins();
+		CompilerContext.MovePinLinksToIntermediate(*Pair.Key, *IfThenElse->GetConditionPin());
+		CompilerContext.MovePinLinksToIntermediate(*Pair.Value, *IfThenElse->GetThenPin());
+
+		if (ElsePin == nullptr)
+		{
+			CompilerContext.MovePinLinksToIntermediate(*GetExecPin(), *IfThenElse->GetExecPin());
+			Wait->GetThenPin()->MakeLinkTo(IfThenElse->GetExecPin());
+		}
+		else
+		{
+			ElsePin->MakeLinkTo(IfThenElse->GetExecPin());
+		}
+		ElsePin = IfThenElse->GetElsePin();
+	}
+	ElsePin->MakeLinkTo(Wait->GetExecPin());
+
+	BreakAllNodeLinks();
+}
+
+FString UK2Node_WaitForFirstTrueCase::GetWakeSources(FKismetCompilerContext& CompilerContext) const
+{
+	// The field notification of the Boolean member variable of self wakes the waiter, so the condition connected directly to
+	// it needs neither the polling nor the call of Wake Waiting Cases.
+	TArray<FString> Sources;
+	for (auto& Pair : GetCasePinPairs())
+	{
+		const UEdGraphPin* CondPin = Pair.Key;
+		const UK2Node_VariableGet* VariableGet =
+			(CondPin->LinkedTo.Num() == 1) ? Cast<UK2Node_VariableGet>(CondPin->LinkedTo[0]->GetOwningNode()) : nullptr;
+		const UEdGraphPin* SelfPin = (VariableGet != nullptr) ? VariableGet->FindPin(UEdGraphSchema_K2::PN_Self) : nullptr;
+		if ((VariableGet == nullptr) || !VariableGet->VariableReference.IsSelfContext() ||
+			VariableGet->VariableReference.IsLocalScope() || ((SelfPin != nullptr) && (SelfPin->LinkedTo.Num() > 0)))
+		{
+			continue;
+		}
+
+		const FName VarName = VariableGet->GetVarName();
+		if (FindFProperty<FBoolProperty>(CompilerContext.NewClass, VarName) != nullptr)
+		{
+			Sources.AddUnique(VarName.ToString());
+		}
+	}
+	return FString::Join(Sources, TEXT(","));
+}
+
+void UK2Node_WaitForFirstTrueCase::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UK2Node_WaitForFirstTrueCase, PollingInterval))
+	{
+		FBlueprintEditorUtils::MarkBlueprintAsModified(GetBlueprint());
+	}
+}
+
+void UK2Node_WaitForFirstTrueCase::CreateExecTriggeringPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 0;
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Execute, Params);
+}
+
+CasePinPair UK2Node_WaitForFirstTrueCase::AddCasePinPair(int32 CaseIndex)
+{
+	CasePinPair Pair;
+	int N = GetCasePinCount();
+
+	{
+		FCreatePinParams Params;
+		Params.Index = 1 + CaseIndex;
+		Pair.Key = CreatePin(
+			EGPD_Input, UEdGraphSchema_K2::PC_Boolean, *GetCasePinName(CaseKeyPinNamePrefix.ToString(), CaseIndex), Params);
+		Pair.Key->PinFriendlyName =
+			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseKeyPinFriendlyNamePrefix.ToString(), CaseIndex));
+	}
+	{
+		FCreatePinParams Params;
+		Params.Index = 1 + N + 1 + CaseIndex;
+		Pair.Value = CreatePin(
+			EGPD_Output, UEdGraphSchema_K2::PC_Exec, *GetCasePinName(CaseValuePinNamePrefix.ToString(), CaseIndex), Params);
+		Pair.Value->PinFriendlyName =
+			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseValuePinFriendlyNamePrefix.ToString(), CaseIndex));
+	}
+
+	return Pair;
+}
+
+#undef LOCTEXT_NAMESPACE
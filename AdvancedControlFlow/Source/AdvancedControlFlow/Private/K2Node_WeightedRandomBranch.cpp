@@ -0,0 +1,209 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "K2Node_WeightedRandomBranch.h"
+
+#include "BlueprintNodeSpawner.h"
+#include "EditorCategoryUtils.h"
+#include "GraphEditorSettings.h"
+#include "K2Node_SwitchInteger.h"
+#include "KismetCompiler.h"
+
+#define LOCTEXT_NAMESPACE "AdvancedControlFlow"
+
+static const FName WeightedBranchStreamPinName(TEXT("Stream"));
+
+UK2Node_WeightedRandomBranch::UK2Node_WeightedRandomBranch(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	NodeContextMenuSectionName = "K2NodeWeightedRandomBranch";
+	NodeContextMenuSectionLabel = LOCTEXT("WeightedRandomBranch", "Weighted Random Branch");
+	CaseKeyPinNamePrefix = TEXT("CaseWeight");
+	CaseValuePinNamePrefix = TEXT("CaseExec");
+	CaseKeyPinFriendlyNamePrefix = TEXT("Weight ");
+	CaseValuePinFriendlyNamePrefix = TEXT(" ");
+}
+
+void UK2Node_WeightedRandomBranch::AllocateDefaultPins()
+{
+	// Pin structure
+	//   N: Number of case pin pair
+	// -----
+	// 0: Execution Triggering (In, Exec)
+	// 1: Stream (In, Random Stream)
+	// 2: Default Execution (Out, Exec)
+	// 3 - 2+N: Case Weight (In, Float)
+	// 2+N+1 - 2*(N+1): Case Execution (Out, Exec)
+
+	CreateExecTriggeringPin();
+	CreateStreamPin();
+	CreateDefaultExecPin();
+
+	for (int32 Index = 0; Index < 2; ++Index)
+	{
+		AddCasePinPair(Index);
+	}
+
+	Super::AllocateDefaultPins();
+}
+
+FText UK2Node_WeightedRandomBranch::GetTooltipText() const
+{
+	return LOCTEXT("WeightedRandomBranch_Tooltip",
+		"Weighted Random Branch\nExecution goes to the case chosen at random in proportion to the weight.\nDefault is executed if "
+		"no weight is positive.");
+}
+
+FLinearColor UK2Node_WeightedRandomBranch::GetNodeTitleColor() const
+{
+	return GetDefault<UGraphEditorSettings>()->ExecBranchNodeTitleColor;
+}
+
+FText UK2Node_WeightedRandomBranch::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("WeightedRandomBranch", "Weighted Random Branch");
+}
+
+FSlateIcon UK2Node_WeightedRandomBranch::GetIconAndTint(FLinearColor& OutColor) const
+{
+	static FSlateIcon Icon("EditorStyle", "GraphEditor.Switch_16x");
+	return Icon;
+}
+
+void UK2Node_WeightedRandomBranch::ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins)
+{
+	CreateExecTriggeringPin();
+	CreateStreamPin();
+	CreateDefaultExecPin();
+
+	Super::ReallocatePinsDuringReconstruction(OldPins);
+}
+
+void UK2Node_WeightedRandomBranch::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
+{
+	UClass* ActionKey = GetClass();
+	if (ActionRegistrar.IsOpenForRegistration(ActionKey))
+	{
+		UBlueprintNodeSpawner* NodeSpawner = UBlueprintNodeSpawner::Create(GetClass());
+		check(NodeSpawner != nullptr);
+
+		ActionRegistrar.AddBlueprintAction(ActionKey, NodeSpawner);
+	}
+}
+
+FText UK2Node_WeightedRandomBranch::GetMenuCategory() const
+{
+	return FEditorCategoryUtils::GetCommonCategory(FCommonEditorCategory::FlowControl);
+}
+
+void UK2Node_WeightedRandomBranch::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	Super::ExpandNode(CompilerContext, SourceGraph);
+
+	TArray<CasePinPair> CasePinPairs = GetCasePinPairs();
+	if (CasePinPairs.Num() == 0)
+	{
+		CompilerContext.MovePinLinksToIntermediate(*GetExecPin(), *GetDefaultExecPin());
+		BreakAllNodeLinks();
+		return;
+	}
+
+	// The sampled case index switches the execution, and the number of the cases switches to Default.
+	TArray<UEdGraphPin*> WeightPins;
+	for (auto& Pair : CasePinPairs)
+	{
+		WeightPins.Add(Pair.Key);
+	}
+	UEdGraphPin* CaseIndexPin = ExpandSampleWeightedCase(CompilerContext, SourceGraph, WeightPins, GetStreamPin());
+
+	UK2Node_SwitchInteger* Switch = CompilerContext.SpawnIntermediateNode<UK2Node_SwitchInteger>(this, SourceGraph);
+	Switch->AllocateDefaultPins();
+	for (int32 Index = 0; Index <= CasePinPairs.Num(); ++Index)
+	{
+		Switch->AddPinToSwitchNode();
+	}
+
+	CompilerContext.MovePinLinksToIntermediate(*GetExecPin(), *Switch->GetExecPin());
+	CaseIndexPin->MakeLinkTo(Switch->GetSelectionPin());
+	for (int32 Index = 0; Index < CasePinPairs.Num(); ++Index)
+	{
+		CompilerContext.MovePinLinksToIntermediate(*CasePinPairs[Index].Value, *Switch->FindPinChecked(*FString::FromInt(Index)));
+	}
+	CompilerContext.MovePinLinksToIntermediate(
+		*GetDefaultExecPin(), *Switch->FindPinChecked(*FString::FromInt(CasePinPairs.Num())));
+
+	BreakAllNodeLinks();
+}
+
+void UK2Node_WeightedRandomBranch::CreateExecTriggeringPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 0;
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Execute, Params);
+}
+
+void UK2Node_WeightedRandomBranch::CreateStreamPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 1;
+	CreatePin(
+		EGPD_Input, UEdGraphSchema_K2::PC_Struct, TBaseStructure<FRandomStream>::Get(), WeightedBranchStreamPinName, Params);
+}
+
+void UK2Node_WeightedRandomBranch::CreateDefaultExecPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 2;
+	UEdGraphPin* DefaultExecPin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, DefaultExecPinName, Params);
+	DefaultExecPin->PinFriendlyName = FText::AsCultureInvariant(DefaultExecPinFriendlyName.ToString());
+}
+
+UEdGraphPin* UK2Node_WeightedRandomBranch::GetStreamPin() const
+{
+	return FindPin(WeightedBranchStreamPinName);
+}
+
+UEdGraphPin* UK2Node_WeightedRandomBranch::GetDefaultExecPin() const
+{
+	return FindPin(DefaultExecPinName);
+}
+
+CasePinPair UK2Node_WeightedRandomBranch::AddCasePinPair(int32 CaseIndex)
+{
+	CasePinPair Pair;
+	int32 N = GetCasePinCount();
+
+	{
+		Pair.Key = CreatePin(
+			EGPD_Input, GetWeightPinType(), *GetCasePinName(CaseKeyPinNamePrefix.ToString(), CaseIndex), 3 + CaseIndex);
+		Pair.Key->PinFriendlyName =
+			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseKeyPinFriendlyNamePrefix.ToString(), CaseIndex));
+		Pair.Key->DefaultValue = TEXT("1.0");
+		Pair.Key->AutogeneratedDefaultValue = Pair.Key->DefaultValue;
+	}
+	{
+		FCreatePinParams Params;
+		Params.Index = 3 + N + 1 + CaseIndex;
+		Pair.Value = CreatePin(
+			EGPD_Output, UEdGraphSchema_K2::PC_Exec, *GetCasePinName(CaseValuePinNamePrefix.ToString(), CaseIndex), Params);
+		Pair.Value->PinFriendlyName =
+			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseValuePinFriendlyNamePrefix.ToString(), CaseIndex));
+	}
+
+	return Pair;
+}
+
+TArray<UEdGraphPin*> UK2Node_WeightedRandomBranch::GetCaseConditionPins() const
+{
+	// The cases are chosen by the weights, not by the conditions.
+	return TArray<UEdGraphPin*>();
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,313 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "K2Node_WeightedRandomSelect.h"
+
+#include "BlueprintNodeSpawner.h"
+#include "EditorCategoryUtils.h"
+#include "GraphEditorSettings.h"
+#include "K2Node_Select.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "KismetCompiler.h"
+
+#define LOCTEXT_NAMESPACE "AdvancedControlFlow"
+
+static const FName WeightedSelectStreamPinName(TEXT("Stream"));
+static const FName WeightedSelectDefaultOptionPinName(TEXT("Default"));
+static const FName WeightedSelectReturnValuePinName(TEXT("Return Value"));
+
+UK2Node_WeightedRandomSelect::UK2Node_WeightedRandomSelect(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	NodeContextMenuSectionName = "K2NodeWeightedRandomSelect";
+	NodeContextMenuSectionLabel = LOCTEXT("WeightedRandomSelect", "Weighted Random Select");
+	CaseKeyPinNamePrefix = TEXT("CaseWeight");
+	CaseValuePinNamePrefix = TEXT("CaseOption");
+	CaseKeyPinFriendlyNamePrefix = TEXT("Weight ");
+	CaseValuePinFriendlyNamePrefix = TEXT("Option ");
+}
+
+void UK2Node_WeightedRandomSelect::AllocateDefaultPins()
+{
+	// Pin structure
+	//   N: Number of weight/option pin pair
+	// -----
+	// 0: Stream (In, Random Stream)
+	// 1: Default (In, Wildcard)
+	// 2-(N+1): Weight (In, Float)
+	// (N+2)-(2N+1): Option (In, Wildcard)
+	// 2N+2: Return Value (Out, Wildcard)
+
+	CreateStreamPin();
+	CreateDefaultOptionPin();
+	CreateReturnValuePin();
+
+	for (int32 Index = 0; Index < 2; ++Index)
+	{
+		AddCasePinPair(Index);
+	}
+
+	Super::AllocateDefaultPins();
+}
+
+FText UK2Node_WeightedRandomSelect::GetTooltipText() const
+{
+	return LOCTEXT("WeightedRandomSelect_Tooltip",
+		"Weighted Random Select\nReturn the option chosen at random in proportion to the weight.\nDefault is returned if no weight "
+		"is positive.");
+}
+
+FLinearColor UK2Node_WeightedRandomSelect::GetNodeTitleColor() const
+{
+	return GetDefault<UGraphEditorSettings>()->PureFunctionCallNodeTitleColor;
+}
+
+FText UK2Node_WeightedRandomSelect::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("WeightedRandomSelect", "Weighted Random Select");
+}
+
+FSlateIcon UK2Node_WeightedRandomSelect::GetIconAndTint(FLinearColor& OutColor) const
+{
+	static FSlateIcon Icon("EditorStyle", "GraphEditor.Select_16x");
+	return Icon;
+}
+
+void UK2Node_WeightedRandomSelect::PinConnectionListChanged(UEdGraphPin* Pin)
+{
+	if (Pin == nullptr)
+	{
+		return;
+	}
+
+	if (Pin->LinkedTo.Num() == 0)
+	{
+		// Ignore the disconnection event.
+		return;
+	}
+
+	if (IsCaseKeyPin(Pin) || (Pin == GetStreamPin()))
+	{
+		// Ignore weight and stream pin connection.
+		return;
+	}
+
+	if (GetDefaultOptionPin()->PinType.PinCategory != UEdGraphSchema_K2::PC_Wildcard)
+	{
+		// Pin type has already fixed.
+		return;
+	}
+
+	Super::PinConnectionListChanged(Pin);
+
+	Modify();
+
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+	UEdGraphPin* LinkedPin = Pin->LinkedTo[0];
+
+	TArray<UEdGraphPin*> OptionPins = GetCaseHitPins();
+	OptionPins.Add(GetReturnValuePin());
+	for (auto& OptionPin : OptionPins)
+	{
+		OptionPin->PinType = LinkedPin->PinType;
+		Schema->ResetPinToAutogeneratedDefaultValue(OptionPin);
+	}
+
+	UBlueprint* Blueprint = GetBlueprint();
+	FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+	Blueprint->BroadcastChanged();
+}
+
+void UK2Node_WeightedRandomSelect::ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins)
+{
+	UEdGraphPin* OldDefaultPin = nullptr;
+	for (auto& Pin : OldPins)
+	{
+		if (Pin->GetFName() == WeightedSelectDefaultOptionPinName)
+		{
+			OldDefaultPin = Pin;
+		}
+	}
+
+	CreateStreamPin();
+	CreateDefaultOptionPin();
+	CreateReturnValuePin();
+	Super::ReallocatePinsDuringReconstruction(OldPins);
+
+	if (OldDefaultPin != nullptr)
+	{
+		GetDefaultOptionPin()->PinType = OldDefaultPin->PinType;
+		GetReturnValuePin()->PinType = OldDefaultPin->PinType;
+		for (auto& Pair : GetCasePinPairs())
+		{
+			Pair.Value->PinType = OldDefaultPin->PinType;
+		}
+	}
+}
+
+void UK2Node_WeightedRandomSelect::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
+{
+	UClass* ActionKey = GetClass();
+	if (ActionRegistrar.IsOpenForRegistration(ActionKey))
+	{
+		UBlueprintNodeSpawner* NodeSpawner = UBlueprintNodeSpawner::Create(GetClass());
+		check(NodeSpawner != nullptr);
+
+		ActionRegistrar.AddBlueprintAction(ActionKey, NodeSpawner);
+	}
+}
+
+FText UK2Node_WeightedRandomSelect::GetMenuCategory() const
+{
+	return FEditorCategoryUtils::GetCommonCategory(FCommonEditorCategory::Utilities);
+}
+
+void UK2Node_WeightedRandomSelect::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	Super::ExpandNode(CompilerContext, SourceGraph);
+
+	TArray<CasePinPair> CasePinPairs = GetCasePinPairs();
+	if (CasePinPairs.Num() == 0)
+	{
+		CompilerContext.MovePinLinksToIntermediate(*GetDefaultOptionPin(), *GetReturnValuePin());
+		BreakAllNodeLinks();
+		return;
+	}
+
+	// The sampled case index selects the option, and the number of the cases selects Default.
+	TArray<UEdGraphPin*> WeightPins;
+	for (auto& Pair : CasePinPairs)
+	{
+		WeightPins.Add(Pair.Key);
+	}
+	UEdGraphPin* CaseIndexPin = ExpandSampleWeightedCase(CompilerContext, SourceGraph, WeightPins, GetStreamPin());
+
+	UK2Node_Select* Select = CompilerContext.SpawnIntermediateNode<UK2Node_Select>(this, SourceGraph);
+	Select->AllocateDefaultPins();
+	Select->ChangePinType(CasePinPairs[0].Value);
+	for (int32 Index = 1; Index < CasePinPairs.Num(); ++Index)
+	{
+		Select->AddInputPin();
+	}
+
+	TArray<UEdGraphPin*> SelectOptionPins;
+	Select->GetOptionPins(SelectOptionPins);
+	for (int32 Index = 0; Index < CasePinPairs.Num(); ++Index)
+	{
+		CompilerContext.MovePinLinksToIntermediate(*CasePinPairs[Index].Value, *SelectOptionPins[Index]);
+	}
+	CompilerContext.MovePinLinksToIntermediate(*GetDefaultOptionPin(), *SelectOptionPins[CasePinPairs.Num()]);
+
+	UEdGraphPin* SelectIndexPin = Select->GetIndexPin();
+	CaseIndexPin->MakeLinkTo(SelectIndexPin);
+	Select->NotifyPinConnectionListChanged(SelectIndexPin);
+
+	CompilerContext.MovePinLinksToIntermediate(*GetReturnValuePin(), *Select->GetReturnValuePin());
+
+	BreakAllNodeLinks();
+}
+
+bool UK2Node_WeightedRandomSelect::IsConnectionDisallowed(
+	const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const
+{
+	if (OtherPin && (OtherPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec))
+	{
+		OutReason = LOCTEXT("ExecConnectionDisallowd", "Can't connect with Exec pin.").ToString();
+		return true;
+	}
+
+	return Super::IsConnectionDisallowed(MyPin, OtherPin, OutReason);
+}
+
+void UK2Node_WeightedRandomSelect::CreateStreamPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 0;
+	CreatePin(
+		EGPD_Input, UEdGraphSchema_K2::PC_Struct, TBaseStructure<FRandomStream>::Get(), WeightedSelectStreamPinName, Params);
+}
+
+void UK2Node_WeightedRandomSelect::CreateDefaultOptionPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 1;
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Wildcard, WeightedSelectDefaultOptionPinName, Params);
+}
+
+void UK2Node_WeightedRandomSelect::CreateReturnValuePin()
+{
+	int32 N = GetCasePinCount();
+
+	FCreatePinParams Params;
+	Params.Index = 2 * N + 2;
+	CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Wildcard, WeightedSelectReturnValuePinName, Params);
+}
+
+UEdGraphPin* UK2Node_WeightedRandomSelect::GetStreamPin() const
+{
+	return FindPin(WeightedSelectStreamPinName);
+}
+
+UEdGraphPin* UK2Node_WeightedRandomSelect::GetDefaultOptionPin() const
+{
+	return FindPin(WeightedSelectDefaultOptionPinName);
+}
+
+UEdGraphPin* UK2Node_WeightedRandomSelect::GetReturnValuePin() const
+{
+	return FindPin(WeightedSelectReturnValuePinName);
+}
+
+CasePinPair UK2Node_WeightedRandomSelect::AddCasePinPair(int32 CaseIndex)
+{
+	CasePinPair Pair;
+	int32 N = GetCasePinCount();
+	UEdGraphPin* DefaultOptionPin = GetDefaultOptionPin();
+
+	{
+		Pair.Key = CreatePin(
+			EGPD_Input, GetWeightPinType(), *GetCasePinName(CaseKeyPinNamePrefix.ToString(), CaseIndex), 2 + CaseIndex);
+		Pair.Key->PinFriendlyName =
+			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseKeyPinFriendlyNamePrefix.ToString(), CaseIndex));
+		Pair.Key->DefaultValue = TEXT("1.0");
+		Pair.Key->AutogeneratedDefaultValue = Pair.Key->DefaultValue;
+	}
+	{
+		FCreatePinParams Params;
+		Params.Index = N + 3 + CaseIndex;
+		Pair.Value = CreatePin(
+			EGPD_Input, UEdGraphSchema_K2::PC_Wildcard, *GetCasePinName(CaseValuePinNamePrefix.ToString(), CaseIndex), Params);
+		Pair.Value->PinFriendlyName =
+			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseValuePinFriendlyNamePrefix.ToString(), CaseIndex));
+		Pair.Value->PinType = DefaultOptionPin->PinType;
+	}
+
+	return Pair;
+}
+
+TArray<UEdGraphPin*> UK2Node_WeightedRandomSelect::GetCaseHitPins() const
+{
+	TArray<UEdGraphPin*> HitPins;
+	for (auto& Pair : GetCasePinPairs())
+	{
+		HitPins.Add(Pair.Value);
+	}
+	HitPins.Add(GetDefaultOptionPin());
+
+	return HitPins;
+}
+
+TArray<UEdGraphPin*> UK2Node_WeightedRandomSelect::GetCaseConditionPins() const
+{
+	// The cases are chosen by the weights, not by the conditions.
+	return TArray<UEdGraphPin*>();
+}
+
+#undef LOCTEXT_NAMESPACE
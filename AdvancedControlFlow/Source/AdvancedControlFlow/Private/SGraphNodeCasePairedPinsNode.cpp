@@ -11,11 +11,17 @@
 
 #include "SGraphNodeCasePairedPinsNode.h"
 
+#include "ACFCaseHitCounters.h"
+#include "ACFCaseProfile.h"
+#include "AdvancedControlFlowSettings.h"
 #include "DetailLayoutBuilder.h"
 #include "EditorStyleSet.h"
 #include "GraphEditorSettings.h"
 #include "K2Node_CasePairedPinsNode.h"
 #include "Kismet2/BlueprintEditorUtils.h"
+#include "SGraphPin.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/Text/STextBlock.h"
 
 void SGraphNodeCasePairedPinsNode::Construct(const FArguments& InArgs, UK2Node_CasePairedPinsNode* InNode)
 {
@@ -74,4 +80,78 @@ FReply SGraphNodeCasePairedPinsNode::OnAddPin()
 	GraphNode->GetGraph()->NotifyGraphChanged();
 
 	return FReply::Handled();
-}
\ No newline at end of file
+}
+
+TArray<FOverlayWidgetInfo> SGraphNodeCasePairedPinsNode::GetOverlayWidgets(bool bSelected, const FVector2D& WidgetSize) const
+{
+	TArray<FOverlayWidgetInfo> Widgets = SGraphNodeK2Base::GetOverlayWidgets(bSelected, WidgetSize);
+
+	if (!GetDefault<UAdvancedControlFlowSettings>()->bCountCaseHits)
+	{
+		return Widgets;
+	}
+
+	UK2Node_CasePairedPinsNode* CasePairedPinsNode = CastChecked<UK2Node_CasePairedPinsNode>(GraphNode);
+	TArray<uint64> Hits;
+	const uint64 CounterKey = FACFCaseHitCounters::MakeCounterKey(FACFCaseProfile::MakeNodeKey(CasePairedPinsNode));
+	if (!FACFCaseHitCounters::Get().GetCaseHits(CounterKey, Hits))
+	{
+		return Widgets;
+	}
+
+	uint64 MaxHits = 0;
+	for (uint64 Hit : Hits)
+	{
+		MaxHits = FMath::Max(MaxHits, Hit);
+	}
+	if (MaxHits == 0)
+	{
+		return Widgets;
+	}
+
+	TArray<UEdGraphPin*> HitPins = CasePairedPinsNode->GetCaseHitPins();
+	for (int32 Index = 0; Index < FMath::Min(HitPins.Num(), Hits.Num()); ++Index)
+	{
+		TSharedPtr<SGraphPin> PinWidget = FindWidgetForPin(HitPins[Index]);
+		if (!PinWidget.IsValid())
+		{
+			continue;
+		}
+
+		if (!HeatmapBorders.IsValidIndex(Index))
+		{
+			HeatmapBorders.SetNum(Index + 1);
+			HeatmapTexts.SetNum(Index + 1);
+		}
+		if (!HeatmapBorders[Index].IsValid())
+		{
+			SAssignNew(HeatmapBorders[Index], SBorder)
+				.BorderImage(FEditorStyle::GetBrush("WhiteBrush"))
+				.Padding(FMargin(4.0f, 1.0f))[SAssignNew(HeatmapTexts[Index], STextBlock).ColorAndOpacity(FLinearColor::White)];
+		}
+
+		// Cases never hit are shown in gray to find the dead cases.
+		FLinearColor Color = FLinearColor(0.2f, 0.2f, 0.2f);
+		if (Hits[Index] > 0)
+		{
+			float Heat = static_cast<float>(static_cast<double>(Hits[Index]) / static_cast<double>(MaxHits));
+			Color = FLinearColor::LerpUsingHSV(FLinearColor(0.0f, 0.3f, 1.0f), FLinearColor(1.0f, 0.1f, 0.0f), Heat);
+		}
+		HeatmapBorders[Index]->SetBorderBackgroundColor(Color);
+		HeatmapTexts[Index]->SetText(FText::AsNumber(Hits[Index]));
+
+		FOverlayWidgetInfo Info(HeatmapBorders[Index]);
+		const FVector2D PinOffset = PinWidget->GetNodeOffset();
+		if (HitPins[Index]->Direction == EGPD_Output)
+		{
+			Info.OverlayOffset = FVector2D(WidgetSize.X + 4.0f, PinOffset.Y);
+		}
+		else
+		{
+			Info.OverlayOffset = FVector2D(-HeatmapBorders[Index]->GetDesiredSize().X - 4.0f, PinOffset.Y);
+		}
+		Widgets.Add(Info);
+	}
+
+	return Widgets;
+}
@@ -0,0 +1,41 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "ACFBenchmarkCommandlet.generated.h"
+
+class FJsonObject;
+
+// Microbenchmarks of the runtime kernels against the code which the nodes were expanded to, and of the Blueprints using the
+// nodes against the vanilla Blueprints which they replace.
+// Usage: UnrealEditor-Cmd <Project> -run=ACFBenchmark -nullrhi [-Iterations=<N>]
+// The results are written to Saved/AdvancedControlFlow/Benchmark.json.
+UCLASS()
+class UACFBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+	TSharedRef<FJsonObject> RunFirstTrueBenchmark(int32 NumIterations) const;
+	TSharedRef<FJsonObject> RunBatchSelectBenchmark(int32 NumIterations) const;
+	TSharedRef<FJsonObject> RunPartitionBenchmark(int32 NumIterations) const;
+	TSharedRef<FJsonObject> RunWeightedRandomBenchmark(int32 NumIterations) const;
+	TSharedRef<FJsonObject> RunSwitchBenchmark(int32 NumIterations) const;
+	TSharedRef<FJsonObject> RunRangeSelectBenchmark(int32 NumIterations) const;
+	TSharedRef<FJsonObject> RunHashSwitchBenchmark(int32 NumIterations) const;
+	TSharedRef<FJsonObject> RunBlueprintBenchmark(int32 NumIterations) const;
+
+public:
+	UACFBenchmarkCommandlet(const FObjectInitializer& ObjectInitializer);
+
+	// Override from UCommandlet
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,50 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FKismetCompilerContext;
+class UEdGraphNode;
+
+// Per-case hit counts of the nodes recorded in PIE.
+// The profile is persisted in the Saved directory of the project and used to order the mutually exclusive cases.
+class FACFCaseProfile
+{
+	struct FCounter
+	{
+		FString NodeKey;
+		int32 NumCases;
+	};
+
+	TMap<FString, TArray<uint64>> CaseHits;
+	TMap<uint64, FCounter> Counters;
+	bool bDirty = false;
+
+	FString GetProfileFilePath() const;
+
+public:
+	static FACFCaseProfile& Get();
+
+	static FString MakeNodeKey(FKismetCompilerContext& CompilerContext, const UEdGraphNode* Node);
+	static FString MakeNodeKey(const UEdGraphNode* SourceNode);
+
+	// Register the runtime hit counter of the node to collect the hits of the cases after PIE.
+	// The default case is counted after the cases, but not collected.
+	uint64 RegisterCounter(const FString& NodeKey, int32 NumCases);
+	void CollectCaseHits();
+
+	// Returns nullptr if the hits were recorded when the node had the different number of the cases.
+	const TArray<uint64>* FindCaseHits(const FString& NodeKey, int32 NumCases) const;
+	void Reset();
+
+	void Load();
+	void Save();
+};
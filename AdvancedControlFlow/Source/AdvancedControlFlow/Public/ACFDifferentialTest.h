@@ -0,0 +1,46 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+
+#include "ACFDifferentialTest.generated.h"
+
+class FAutomationTestBase;
+class UK2Node_CasePairedPinsNode;
+
+UCLASS()
+class ADVANCEDCONTROLFLOW_API UACFDifferentialTestLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	// Called by the copy of the node in the oracle Blueprint when the case is executed.
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"))
+	static void RecordCaseHit(int32 CaseIndex);
+};
+
+// Checks the C++ code exported from the node against the node compiled by the Blueprint compiler.
+// The node and the pure nodes which it reads are copied into a function of a transient Blueprint deriving from the Blueprint of
+// the node, and the function is called through ProcessEvent on the Blueprint VM while randomizing the variables read by the node.
+class ADVANCEDCONTROLFLOW_API FACFDifferentialTest
+{
+public:
+	static UK2Node_CasePairedPinsNode* FindNode(const FString& BlueprintPath, const FGuid& NodeGuid);
+
+	// Compare the executed cases of Multi-Branch or Conditional Sequence.
+	static bool RunCaseHitsTest(FAutomationTestBase& Test, const FString& BlueprintPath, const FGuid& NodeGuid,
+		TFunction<TArray<bool>(UObject* Self)> NativeCaseHits, int32 Iterations = 100);
+
+	// Compare the selected option of Multi-Conditional Select. NativeSelect writes the option into the value of the return type.
+	static bool RunSelectTest(FAutomationTestBase& Test, const FString& BlueprintPath, const FGuid& NodeGuid,
+		TFunction<void(UObject* Self, void* OutValue)> NativeSelect, int32 Iterations = 100);
+};
@@ -0,0 +1,127 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EdGraph/EdGraphPin.h"
+
+#include "ACFExpression.generated.h"
+
+class FKismetCompilerContext;
+class UEdGraph;
+class UK2Node;
+
+UENUM()
+enum class EACFExpressionInputType : uint8
+{
+	Boolean,
+	Integer,
+	Float
+};
+
+// Input pin which the case expressions refer to by the name.
+USTRUCT()
+struct FACFExpressionInput
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Expression")
+	FName Name;
+
+	UPROPERTY(EditAnywhere, Category = "Expression")
+	EACFExpressionInputType Type = EACFExpressionInputType::Boolean;
+};
+
+// Parsed case expression such as "Health < 0.25 && !bIsStunned".
+struct FACFExpression
+{
+	enum class EKind : uint8
+	{
+		Literal,
+		Input,
+		Not,
+		Negate,
+		And,
+		Or,
+		Equal,
+		NotEqual,
+		Less,
+		LessEqual,
+		Greater,
+		GreaterEqual,
+		Add,
+		Subtract,
+		Multiply,
+		Divide,
+		Modulo
+	};
+
+	EKind Kind;
+
+	// Name of the input, or the text of the literal ("true", "false" or the number).
+	FString Text;
+
+	TArray<TSharedPtr<const FACFExpression>> Operands;
+
+	// Parses the expression. The same text is parsed only once and shared by all cases and nodes.
+	static TSharedPtr<const FACFExpression> Parse(const FString& Text, FText& OutError);
+};
+
+// Expands the case expressions of a node to the intermediate nodes.
+class FACFExpressionCompiler
+{
+	enum class EType : uint8
+	{
+		Boolean,
+		Integer,
+		Float
+	};
+
+	// Value of the operand, which is one of the output pin of the intermediate node, the input pin of the node or the literal.
+	struct FValue
+	{
+		EType Type = EType::Boolean;
+		UEdGraphPin* OutputPin = nullptr;
+		UEdGraphPin* InputPin = nullptr;
+		FString Literal;
+	};
+
+	FKismetCompilerContext& CompilerContext;
+	UEdGraph* SourceGraph;
+	UK2Node* Node;
+	const TArray<FACFExpressionInput>& Inputs;
+
+	bool CheckType(const FACFExpression& Expression, EType& OutType, FText& OutError) const;
+	FValue ExpandValue(const FACFExpression& Expression);
+	FValue ExpandFunctionCall(const FString& FunctionName, const TArray<FValue>& Arguments, EType ReturnType);
+	FValue ConvertToFloat(const FValue& Value);
+	void LinkValue(const FValue& Value, UEdGraphPin* TargetPin);
+
+public:
+	FACFExpressionCompiler(FKismetCompilerContext& InCompilerContext, UEdGraph* InSourceGraph, UK2Node* InNode,
+		const TArray<FACFExpressionInput>& InInputs);
+
+	// Parses the expression on the pin, and checks that the result is Boolean.
+	TSharedPtr<const FACFExpression> ParseCondition(const UEdGraphPin* ExpressionPin);
+
+	// Expands to the pure nodes whose Boolean result is linked to BoolPin.
+	void ExpandCondition(const FACFExpression& Expression, UEdGraphPin* BoolPin);
+
+	// Expands to the Branch nodes, which skip the rest of && and || once the result is decided.
+	// Returns the execution pin to enter, and the execution pins taken when the result is true or false.
+	UEdGraphPin* ExpandBranch(const FACFExpression& Expression, TArray<UEdGraphPin*>& OutTrueExecPins,
+		TArray<UEdGraphPin*>& OutFalseExecPins);
+
+	// Pins of the inputs, which are appended after the other pins of the node.
+	static void CreateInputPins(UK2Node* Node, const TArray<FACFExpressionInput>& Inputs);
+	static UEdGraphPin* FindInputPin(const UK2Node* Node, FName Name);
+	static bool IsInputPin(const UEdGraphPin* Pin);
+	static FEdGraphPinType GetInputPinType(EACFExpressionInputType Type);
+};
@@ -0,0 +1,69 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EdGraph/EdGraphPin.h"
+
+class UK2Node_CasePairedPinsNode;
+
+// Translates the node and the pure condition subgraphs connected to the node into a Blueprint function library in C++.
+// Calls to the static native functions are emitted as direct calls, others fall back to ProcessEvent.
+class FACFNativeCodeGenerator
+{
+	struct FExpression
+	{
+		FString Code;
+		FString Type;
+	};
+
+	const UK2Node_CasePairedPinsNode* Node;
+	FString BaseName;
+	FString ApiMacro;
+	TSet<FString> Includes;
+	FString ErrorMessage;
+
+	bool GetCppType(const FEdGraphPinType& PinType, FString& OutType);
+	bool GetCppType(const FProperty* Property, FString& OutType);
+	bool GetProcessEventParamType(const FProperty* Property, FString& OutType);
+	FString GetObjectType(const UClass* Class);
+	FString ConvertExpression(const FExpression& Expression, const FString& Type) const;
+
+	bool TranslateLiteral(const UEdGraphPin* Pin, const FString& Type, FExpression& OutExpression);
+	bool TranslateInputPin(const UEdGraphPin* InputPin, const FString& Type, FExpression& OutExpression);
+	bool TranslateOutputPin(const UEdGraphPin* OutputPin, FExpression& OutExpression);
+	bool TranslateFunctionCall(const class UK2Node_CallFunction* CallFunction, const UEdGraphPin* OutputPin, FExpression& OutExpression);
+	bool TranslateTargetPin(const UEdGraphPin* TargetPin, FExpression& OutExpression);
+
+	bool CanCallDirectly(const UFunction* Function);
+
+	bool GenerateMultiBranch(FString& OutTypes, FString& OutDeclarations, FString& OutDefinitions, FString& OutNativeTest);
+	bool GenerateConditionalSequence(FString& OutTypes, FString& OutDeclarations, FString& OutDefinitions, FString& OutNativeTest);
+	bool GenerateMultiConditionalSelect(FString& OutTypes, FString& OutDeclarations, FString& OutDefinitions, FString& OutNativeTest);
+
+public:
+	explicit FACFNativeCodeGenerator(const UK2Node_CasePairedPinsNode* InNode);
+
+	bool Generate(FString& OutHeader, FString& OutSource);
+
+	// Generate the code and write it into the Source directory of the project.
+	bool Export(FString& OutHeaderFilePath);
+
+	const FString& GetBaseName() const
+	{
+		return BaseName;
+	}
+	const FString& GetErrorMessage() const
+	{
+		return ErrorMessage;
+	}
+
+	static bool IsSupportedNode(const UK2Node_CasePairedPinsNode* Node);
+};
@@ -18,6 +18,8 @@ class FGraphPanelNodeFactory_AdvancedControlFlow;
 class FAdvancedControlFlowModule : public IModuleInterface
 {
 	TSharedPtr<FGraphPanelNodeFactory_AdvancedControlFlow> GraphPanelNodeFactory_AdvancedControlFlow;
+	FDelegateHandle BeginPIEHandle;
+	FDelegateHandle EndPIEHandle;
 
 public:
 	virtual void StartupModule() override;
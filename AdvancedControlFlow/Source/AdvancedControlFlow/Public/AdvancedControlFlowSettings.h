@@ -0,0 +1,42 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "Engine/DeveloperSettings.h"
+
+#include "AdvancedControlFlowSettings.generated.h"
+
+UCLASS(config = EditorPerProjectUserSettings, meta = (DisplayName = "Advanced Control Flow"))
+class UAdvancedControlFlowSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UAdvancedControlFlowSettings(const FObjectInitializer& ObjectInitializer);
+
+	// Override from UDeveloperSettings
+	virtual FName GetCategoryName() const override;
+
+	// Instrument the nodes whose cases are mutually exclusive to record the per-case hit count in PIE.
+	// Blueprints must be recompiled after changing this option.
+	UPROPERTY(EditAnywhere, config, Category = "Profiling")
+	bool bRecordCaseProfile;
+
+	// Instrument all nodes to count the per-case hits in PIE and show the counts as a heatmap on the case pins.
+	// Blueprints must be recompiled after changing this option.
+	UPROPERTY(EditAnywhere, config, Category = "Profiling")
+	bool bCountCaseHits;
+
+	// Instrument Multi-Branch and Multi-Conditional Select to emit the timing events to the "ACF" trace channel.
+	// Unlike the other profiling options, cooked Blueprints are also instrumented.
+	// Blueprints must be recompiled after changing this option.
+	UPROPERTY(EditAnywhere, config, Category = "Profiling")
+	bool bEmitTraceEvents;
+};
@@ -0,0 +1,50 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "AnimGraphNode_Base.h"
+#include "AnimNode_BlendListByFirstTrue.h"
+
+#include "AnimGraphNode_BlendListByFirstTrue.generated.h"
+
+// AnimGraph version of Multi-Conditional Select, which blends to the pose of the first true condition.
+UCLASS(MinimalAPI, meta = (Keywords = "Blend Poses First True Condition Select MultiConditionalSelect"))
+class UAnimGraphNode_BlendListByFirstTrue : public UAnimGraphNode_Base
+{
+	GENERATED_BODY()
+
+	// Override from UEdGraphNode
+	virtual FText GetTooltipText() const override;
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+	virtual void GetNodeContextMenuActions(class UToolMenu* Menu, class UGraphNodeContextMenuContext* Context) const override;
+
+	// Override from UK2Node
+	virtual void ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins) override;
+
+	// Override from UAnimGraphNode_Base
+	virtual FString GetNodeCategory() const override;
+	virtual void CustomizePinData(UEdGraphPin* Pin, FName SourcePropertyName, int32 ArrayIndex) const override;
+
+	// Internal functions.
+	void AddCasePin();
+	void RemoveCasePin(UEdGraphPin* Pin);
+
+	// Case removed by RemoveCasePin, whose following pins are renamed to keep their links on the reconstruction.
+	int32 RemovedCaseIndex;
+
+public:
+	UAnimGraphNode_BlendListByFirstTrue(const FObjectInitializer& ObjectInitializer);
+
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	FAnimNode_BlendListByFirstTrue Node;
+
+	// Returns the case of the condition, the pose or the blend time pin, or INDEX_NONE for the default pose.
+	static int32 GetCaseIndexFromPin(const UEdGraphPin* Pin);
+};
@@ -60,6 +60,11 @@ protected:
 	{
 		return CasePinPair();
 	}
+	// Called after the case pins are added, removed or renamed.
+	// The node which has more pins than the key and the value for each case keeps them in sync here.
+	virtual void RestoreCaseCompanionPins()
+	{
+	}
 	void AddCasePinAfter(UEdGraphPin* Pin);
 	void AddCasePinBefore(UEdGraphPin* Pin);
 	void RemoveCasePinAt(UEdGraphPin* Pin);
@@ -71,6 +76,40 @@ protected:
 	bool IsCaseKeyPin(const UEdGraphPin* Pin) const;
 	bool IsCaseValuePin(const UEdGraphPin* Pin) const;
 
+	void ExportAsNativeCode();
+
+	bool ShouldCountCaseHits(bool bRecordCaseProfile) const;
+	void ExpandCaseHitCounters(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph);
+	class UK2Node_CallFunction* SpawnCaseHitCounter(
+		FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph, uint64 CounterKey, int32 NumCases, int32 CaseIndex);
+
+	// Returns the pin of the index of the first true condition, or INDEX_NONE.
+	UEdGraphPin* ExpandFindFirstTrueCondition(
+		FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph, const TArray<UEdGraphPin*>& CondPins);
+
+	// Weights are float on UE 4 and double on UE 5.
+	FEdGraphPinType GetWeightPinType() const;
+
+	// Returns the pin of the index of the case sampled by the weights, or the number of the weights if no weight is positive.
+	// The stream is used only if StreamPin is connected.
+	UEdGraphPin* ExpandSampleWeightedCase(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph,
+		const TArray<UEdGraphPin*>& WeightPins, UEdGraphPin* StreamPin);
+
+	bool ShouldEmitTraceEvents() const;
+	class UK2Node_CallFunction* SpawnTraceCall(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph, FName FunctionName);
+	void ExpandTraceEvents(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph, const TArray<int32>& NumConditions);
+
+	int32 EstimateCaseConditionCost(const UEdGraphPin* CondPin) const;
+	TArray<int32> GetCaseEvaluationOrder(const TArray<UEdGraphPin*>& CondPins, const TArray<uint64>* CaseHits) const;
+
+	// Returns the conditions passed to ACFParallelLibrary, or empty if any condition is not the direct call of a thread-safe
+	// static native function whose arguments are the literals or the member variables.
+	// The conditions in the thread-safe graph are not passed, since ACFParallelLibrary runs on the game thread.
+	FString MakeParallelConditions(const TArray<UEdGraphPin*>& CondPins, const UEdGraph* SourceGraph) const;
+
+	// Thread-safe graph such as the thread-safe update function of Animation Blueprint, which runs on the worker threads.
+	static bool IsThreadSafeGraph(const UEdGraph* Graph);
+
 	FName NodeContextMenuSectionName;
 	FText NodeContextMenuSectionLabel;
 	FName CaseKeyPinNamePrefix;
@@ -81,9 +120,16 @@ protected:
 public:
 	UK2Node_CasePairedPinsNode(const FObjectInitializer& ObjectInitializer);
 
-	UEdGraphPin* GetCaseValuePinFromCaseKeyPin(const UEdGraphPin* CondPin) const;
-	UEdGraphPin* GetCaseKeyPinFromCaseValuePin(const UEdGraphPin* ExecPin) const;
+	// Exported so that the other modules can build the graph with the nodes.
+	ADVANCEDCONTROLFLOW_API UEdGraphPin* GetCaseValuePinFromCaseKeyPin(const UEdGraphPin* CondPin) const;
+	ADVANCEDCONTROLFLOW_API UEdGraphPin* GetCaseKeyPinFromCaseValuePin(const UEdGraphPin* ExecPin) const;
+
+	ADVANCEDCONTROLFLOW_API int32 GetCasePinCount() const;
+	ADVANCEDCONTROLFLOW_API void AddCasePinLast();
+
+	// Boolean pins of the case conditions in the case order.
+	virtual TArray<UEdGraphPin*> GetCaseConditionPins() const;
 
-	int32 GetCasePinCount() const;
-	void AddCasePinLast();
+	// Pins whose hits are counted in the case order, followed by the default pin.
+	virtual TArray<UEdGraphPin*> GetCaseHitPins() const;
 };
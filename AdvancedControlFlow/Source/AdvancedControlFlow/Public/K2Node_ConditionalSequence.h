@@ -31,6 +31,9 @@ class UK2Node_ConditionalSequence : public UK2Node_CasePairedPinsNode
 	virtual void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
 	virtual void ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph) override;
 
+	// Override from UObject
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+
 	void CreateExecTriggeringPin();
 	void CreateDefaultExecPin();
 	virtual CasePinPair AddCasePinPair(int32 CaseIndex) override;
@@ -38,5 +41,10 @@ class UK2Node_ConditionalSequence : public UK2Node_CasePairedPinsNode
 public:
 	UK2Node_ConditionalSequence(const FObjectInitializer& ObjectInitializer);
 
-	UEdGraphPin* GetDefaultExecPin() const;
+	// Conditions which call the thread-safe native functions are evaluated on the worker threads when they are expensive.
+	// All conditions are evaluated before the first case is executed, so a case cannot change the conditions of the later cases.
+	UPROPERTY(EditAnywhere, Category = "Optimization")
+	bool bParallelConditions;
+
+	ADVANCEDCONTROLFLOW_API UEdGraphPin* GetDefaultExecPin() const;
 };
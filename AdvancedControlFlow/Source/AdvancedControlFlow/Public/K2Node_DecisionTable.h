@@ -0,0 +1,57 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "BlueprintActionDatabaseRegistrar.h"
+#include "K2Node.h"
+
+#include "K2Node_DecisionTable.generated.h"
+
+class UDataTable;
+
+// Execution goes to the outcome of the first rule of the data table whose conditions all hold.
+// The rules are compiled into a tree of branches, so the number of tested conditions is the depth of the tree.
+UCLASS(MinimalAPI, meta = (Keywords = "Decision Table Rule DataTable Branch"))
+class UK2Node_DecisionTable : public UK2Node
+{
+	GENERATED_BODY()
+
+	// Override from UEdGraphNode
+	virtual void AllocateDefaultPins() override;
+	virtual FText GetTooltipText() const override;
+	virtual FLinearColor GetNodeTitleColor() const override;
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+	virtual FSlateIcon GetIconAndTint(FLinearColor& OutColor) const override;
+
+	// Override from UK2Node
+	virtual void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
+	virtual FText GetMenuCategory() const override;
+	virtual void ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph) override;
+
+	// Override from UObject
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+
+	// Internal functions.
+	void CreateExecTriggeringPin();
+	void CreateConditionPin(FName Condition);
+	void CreateOutcomeExecPin(FName Outcome);
+	void CreateDefaultExecPin();
+
+public:
+	UK2Node_DecisionTable(const FObjectInitializer& ObjectInitializer);
+
+	// Data table whose row structure is ACFDecisionRule.
+	UPROPERTY(EditAnywhere, Category = "DecisionTable")
+	UDataTable* DecisionTable;
+
+	UEdGraphPin* GetConditionPin(FName Condition) const;
+	UEdGraphPin* GetOutcomeExecPin(FName Outcome) const;
+	UEdGraphPin* GetDefaultExecPin() const;
+};
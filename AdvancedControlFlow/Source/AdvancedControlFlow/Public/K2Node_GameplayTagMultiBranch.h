@@ -0,0 +1,66 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "BlueprintActionDatabaseRegistrar.h"
+#include "GameplayTagContainer.h"
+#include "K2Node_CasePairedPinsNode.h"
+
+#include "K2Node_GameplayTagMultiBranch.generated.h"
+
+// Execution goes to the first case whose tags match the input tag container.
+// The tags of the cases are compiled into the bitsets, and the container is read once for all cases.
+UCLASS(MinimalAPI, meta = (Keywords = "Branch Gameplay Tag HasTag HasAny HasAll MultiBranch"))
+class UK2Node_GameplayTagMultiBranch : public UK2Node_CasePairedPinsNode
+{
+	GENERATED_BODY()
+
+	// Override from UEdGraphNode
+	virtual void AllocateDefaultPins() override;
+	virtual FText GetTooltipText() const override;
+	virtual FLinearColor GetNodeTitleColor() const override;
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+	virtual FSlateIcon GetIconAndTint(FLinearColor& OutColor) const override;
+
+	// Override from UK2Node
+	virtual void ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins) override;
+	virtual void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
+	virtual FText GetMenuCategory() const override;
+	virtual void ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph) override;
+
+	// Override from UObject
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+
+	// Internal functions.
+	void CreateExecTriggeringPin();
+	void CreateTagsPin();
+	void CreateDefaultExecPin();
+	virtual CasePinPair AddCasePinPair(int32 CaseIndex) override;
+
+public:
+	UK2Node_GameplayTagMultiBranch(const FObjectInitializer& ObjectInitializer);
+
+	// Every tag of the case must be in the container (HasAll). Otherwise any tag of the case is enough (HasAny).
+	UPROPERTY(EditAnywhere, Category = "PinOptions")
+	bool bMatchAll;
+
+	// The parent tags of the container do not match the tags of the cases.
+	UPROPERTY(EditAnywhere, Category = "PinOptions")
+	bool bExactMatch;
+
+	// Override from UK2Node_CasePairedPinsNode
+	virtual TArray<UEdGraphPin*> GetCaseConditionPins() const override;
+
+	UEdGraphPin* GetTagsPin() const;
+	UEdGraphPin* GetDefaultExecPin() const;
+
+	// Literal tags of the case, or false if the tags can not be parsed.
+	bool GetCaseTags(const UEdGraphPin* CaseTagsPin, FGameplayTagContainer& OutTags) const;
+};
@@ -9,11 +9,20 @@
 
 #pragma once
 
+#include "ACFExpression.h"
 #include "BlueprintActionDatabaseRegistrar.h"
 #include "K2Node_CasePairedPinsNode.h"
 
 #include "K2Node_MultiBranch.generated.h"
 
+UENUM()
+enum class EACFThrottleMode : uint8
+{
+	Disabled,
+	Seconds,
+	Frames
+};
+
 UCLASS(MinimalAPI, meta = (Keywords = "If ElseIf Else Branch MultiBranch"))
 class UK2Node_MultiBranch : public UK2Node_CasePairedPinsNode
 {
@@ -31,18 +40,53 @@ class UK2Node_MultiBranch : public UK2Node_CasePairedPinsNode
 	virtual class FNodeHandlingFunctor* CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const override;
 	virtual void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
 	virtual FText GetMenuCategory() const override;
+	virtual void ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph) override;
+
+	// Override from UObject
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
 
-	void CreateFunctionPin();
 	void CreateExecTriggeringPin();
 	void CreateDefaultExecPin();
+	void CreateForceRefreshPin();
 	virtual CasePinPair AddCasePinPair(int32 CaseIndex) override;
 
-	TSubclassOf<class UObject> ConditionPreProcessFuncClass;
-	FName ConditionPreProcessFuncName;
+	// Evaluates the conditions only when the throttle state is refreshed, and takes the last case in between.
+	bool ExpandThrottle(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph);
+
+	// Finds the first true condition on the worker threads. Returns false if the conditions cannot be evaluated in parallel.
+	bool ExpandParallelConditions(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph);
 
 public:
 	UK2Node_MultiBranch(const FObjectInitializer& ObjectInitializer);
 
-	UEdGraphPin* GetDefaultExecPin() const;
-	UEdGraphPin* GetFunctionPin() const;
+	// Conditions never become true at the same time, so the cases can be tested in any order.
+	// The compiler tests the cases in the order of the recorded profile or the estimated condition cost.
+	UPROPERTY(EditAnywhere, Category = "Optimization")
+	bool bCasesMutuallyExclusive;
+
+	// Conditions which call the thread-safe native functions are evaluated on the worker threads when they are expensive.
+	// Each argument must be a literal or a member variable.
+	UPROPERTY(EditAnywhere, Category = "Optimization")
+	bool bParallelConditions;
+
+	// Each condition is written as an expression over the expression inputs, such as "Health < 0.25 && !bIsStunned".
+	UPROPERTY(EditAnywhere, Category = "Expression")
+	bool bUseExpressions;
+
+	// Input pins which the expressions refer to by the name.
+	UPROPERTY(EditAnywhere, Category = "Expression", meta = (EditCondition = "bUseExpressions"))
+	TArray<FACFExpressionInput> ExpressionInputs;
+
+	// The conditions are evaluated at most once per interval, and the last taken case is taken again in between.
+	// Each instance holds the last case, and starts at a random phase of the interval.
+	UPROPERTY(EditAnywhere, Category = "Throttle")
+	EACFThrottleMode ThrottleMode;
+
+	// Interval in seconds or in frames.
+	UPROPERTY(EditAnywhere, Category = "Throttle",
+		meta = (EditCondition = "ThrottleMode != EACFThrottleMode::Disabled", ClampMin = "0.0"))
+	float ThrottleInterval;
+
+	ADVANCEDCONTROLFLOW_API UEdGraphPin* GetDefaultExecPin() const;
+	UEdGraphPin* GetForceRefreshPin() const;
 };
@@ -0,0 +1,57 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "BlueprintActionDatabaseRegistrar.h"
+#include "K2Node_CasePairedPinsNode.h"
+
+#include "K2Node_MultiBranchPartition.generated.h"
+
+// Distributes the elements of an array to the first case whose condition is true, as Multi-Branch does for each element.
+UCLASS(MinimalAPI, meta = (Keywords = "Partition MultiBranch Filter Array"))
+class UK2Node_MultiBranchPartition : public UK2Node_CasePairedPinsNode
+{
+	GENERATED_BODY()
+
+	// Override from UEdGraphNode
+	virtual void AllocateDefaultPins() override;
+	virtual FText GetTooltipText() const override;
+	virtual FLinearColor GetNodeTitleColor() const override;
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+	virtual FSlateIcon GetIconAndTint(FLinearColor& OutColor) const override;
+	virtual void PinConnectionListChanged(UEdGraphPin* Pin) override;
+
+	// Override from UK2Node
+	virtual void ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins) override;
+	virtual void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
+	virtual FText GetMenuCategory() const override;
+	virtual void ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph) override;
+	virtual bool IsNodePure() const override
+	{
+		return true;
+	}
+	virtual bool IsConnectionDisallowed(const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const override;
+
+	// Internal functions.
+	void CreateArrayPin();
+	void CreateDefaultPin();
+	virtual CasePinPair AddCasePinPair(int32 CaseIndex) override;
+	void SetElementPinType(const FEdGraphPinType& PinType);
+	bool IsElementArrayPin(const UEdGraphPin* Pin) const;
+
+public:
+	UK2Node_MultiBranchPartition(const FObjectInitializer& ObjectInitializer);
+
+	// Override from UK2Node_CasePairedPinsNode
+	virtual TArray<UEdGraphPin*> GetCaseHitPins() const override;
+
+	UEdGraphPin* GetArrayPin() const;
+	UEdGraphPin* GetDefaultPin() const;
+};
@@ -0,0 +1,61 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "BlueprintActionDatabaseRegistrar.h"
+#include "K2Node_CasePairedPinsNode.h"
+
+#include "K2Node_MultiCast.generated.h"
+
+// Execution goes to the first case whose class the object is, with the object cast to the class.
+// The case of each object class is resolved once and cached, instead of the chain of the casts.
+UCLASS(MinimalAPI, meta = (Keywords = "Cast Class IsA Type Switch MultiCast"))
+class UK2Node_MultiCast : public UK2Node_CasePairedPinsNode
+{
+	GENERATED_BODY()
+
+	// Override from UEdGraphNode
+	virtual void AllocateDefaultPins() override;
+	virtual FText GetTooltipText() const override;
+	virtual FLinearColor GetNodeTitleColor() const override;
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+	virtual FSlateIcon GetIconAndTint(FLinearColor& OutColor) const override;
+	virtual void PinDefaultValueChanged(UEdGraphPin* Pin) override;
+
+	// Override from UK2Node
+	virtual void ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins) override;
+	virtual void PostReconstructNode() override;
+	virtual void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
+	virtual FText GetMenuCategory() const override;
+	virtual void ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph) override;
+
+	// Override from UK2Node_CasePairedPinsNode
+	virtual void RestoreCaseCompanionPins() override;
+
+	// Internal functions.
+	void CreateExecTriggeringPin();
+	void CreateObjectPin();
+	void CreateDefaultExecPin();
+	virtual CasePinPair AddCasePinPair(int32 CaseIndex) override;
+	bool IsCaseObjectPin(const UEdGraphPin* Pin) const;
+	void UpdateCaseObjectPinType(UEdGraphPin* CaseClassPin);
+
+public:
+	UK2Node_MultiCast(const FObjectInitializer& ObjectInitializer);
+
+	// Override from UK2Node_CasePairedPinsNode
+	virtual TArray<UEdGraphPin*> GetCaseConditionPins() const override;
+
+	UEdGraphPin* GetObjectPin() const;
+	UEdGraphPin* GetDefaultExecPin() const;
+
+	// Output pin of the object cast to the class of the case.
+	UEdGraphPin* GetCaseObjectPinFromCaseValuePin(const UEdGraphPin* CaseExecPin) const;
+};
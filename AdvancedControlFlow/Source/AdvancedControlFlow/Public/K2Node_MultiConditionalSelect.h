@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include "ACFExpression.h"
 #include "BlueprintActionDatabaseRegistrar.h"
 #include "K2Node_CasePairedPinsNode.h"
 
@@ -38,13 +39,49 @@ class UK2Node_MultiConditionalSelect : public UK2Node_CasePairedPinsNode
 	}
 	virtual bool IsConnectionDisallowed(const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const;
 
+	// Override from UObject
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+
 	// Internal functions.
 	void CreateDefaultOptionPin();
 	void CreateReturnValuePin();
-	UEdGraphPin* GetDefaultOptionPin() const;
-	UEdGraphPin* GetReturnValuePin() const;
 	virtual CasePinPair AddCasePinPair(int32 CaseIndex) override;
 
+	// Returns the pin of the index of the first true condition, which is cached for each instance.
+	UEdGraphPin* ExpandReactiveCaseIndex(
+		FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph, const TArray<UEdGraphPin*>& CondPins);
+
+	// Returns the pin of the index of the first true condition found on the worker threads, or nullptr if the conditions
+	// cannot be evaluated in parallel.
+	UEdGraphPin* ExpandParallelCaseIndex(
+		FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph, const TArray<UEdGraphPin*>& CondPins);
+
 public:
 	UK2Node_MultiConditionalSelect(const FObjectInitializer& ObjectInitializer);
+
+	// Override from UK2Node_CasePairedPinsNode
+	virtual TArray<UEdGraphPin*> GetCaseConditionPins() const override;
+	virtual TArray<UEdGraphPin*> GetCaseHitPins() const override;
+
+	ADVANCEDCONTROLFLOW_API UEdGraphPin* GetDefaultOptionPin() const;
+	ADVANCEDCONTROLFLOW_API UEdGraphPin* GetReturnValuePin() const;
+
+	// The selected case of each instance is cached, and found again only when one of the conditions changes.
+	// Each condition must be a Boolean member variable of self or a literal. The variable is observed by the field notification,
+	// or compared with its last value if it does not notify its change.
+	UPROPERTY(EditAnywhere, Category = "Optimization")
+	bool bReactive;
+
+	// Conditions which call the thread-safe native functions are evaluated on the worker threads when they are expensive.
+	// Each argument must be a literal or a member variable. The reactive mode takes precedence.
+	UPROPERTY(EditAnywhere, Category = "Optimization")
+	bool bParallelConditions;
+
+	// Each condition is written as an expression over the expression inputs, such as "Health < 0.25 && !bIsStunned".
+	UPROPERTY(EditAnywhere, Category = "Expression")
+	bool bUseExpressions;
+
+	// Input pins which the expressions refer to by the name.
+	UPROPERTY(EditAnywhere, Category = "Expression", meta = (EditCondition = "bUseExpressions"))
+	TArray<FACFExpressionInput> ExpressionInputs;
 };
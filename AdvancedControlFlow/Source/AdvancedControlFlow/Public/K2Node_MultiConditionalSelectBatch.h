@@ -0,0 +1,60 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "BlueprintActionDatabaseRegistrar.h"
+#include "K2Node_CasePairedPinsNode.h"
+
+#include "K2Node_MultiConditionalSelectBatch.generated.h"
+
+// Multi-Conditional Select over the arrays of elements.
+// Each case takes a Boolean array of the conditions, and an array or a single value of the options.
+UCLASS(MinimalAPI, meta = (Keywords = "Select MultiConditionalSelect Batch Array"))
+class UK2Node_MultiConditionalSelectBatch : public UK2Node_CasePairedPinsNode
+{
+	GENERATED_BODY()
+
+	// Override from UEdGraphNode
+	virtual void AllocateDefaultPins() override;
+	virtual FText GetTooltipText() const override;
+	virtual FLinearColor GetNodeTitleColor() const override;
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+	virtual FSlateIcon GetIconAndTint(FLinearColor& OutColor) const override;
+	virtual void PinConnectionListChanged(UEdGraphPin* Pin) override;
+
+	// Override from UK2Node
+	virtual void GetNodeContextMenuActions(class UToolMenu* Menu, class UGraphNodeContextMenuContext* Context) const override;
+	virtual void ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins) override;
+	virtual void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
+	virtual FText GetMenuCategory() const override;
+	virtual void ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph) override;
+	virtual bool IsNodePure() const override
+	{
+		return true;
+	}
+	virtual bool IsConnectionDisallowed(const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const override;
+
+	// Internal functions.
+	void CreateDefaultOptionPin();
+	void CreateReturnValuePin();
+	virtual CasePinPair AddCasePinPair(int32 CaseIndex) override;
+	bool IsOptionPin(const UEdGraphPin* Pin) const;
+	void ToggleOptionPinContainer(UEdGraphPin* Pin);
+
+public:
+	UK2Node_MultiConditionalSelectBatch(const FObjectInitializer& ObjectInitializer);
+
+	// Override from UK2Node_CasePairedPinsNode
+	virtual TArray<UEdGraphPin*> GetCaseConditionPins() const override;
+	virtual TArray<UEdGraphPin*> GetCaseHitPins() const override;
+
+	UEdGraphPin* GetDefaultOptionPin() const;
+	UEdGraphPin* GetReturnValuePin() const;
+};
@@ -0,0 +1,70 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "BlueprintActionDatabaseRegistrar.h"
+#include "K2Node_CasePairedPinsNode.h"
+
+#include "K2Node_MultiSwitch.generated.h"
+
+// Execution goes to the case whose literal key equals the selection.
+// The integer keys are sorted at compile time and searched by a balanced tree of comparisons.
+// The name and string keys are looked up by the perfect hash, and the found index is searched by the tree.
+UCLASS(MinimalAPI, meta = (Keywords = "Switch Case Integer Enum Name String MultiSwitch"))
+class UK2Node_MultiSwitch : public UK2Node_CasePairedPinsNode
+{
+	GENERATED_BODY()
+
+	// Override from UEdGraphNode
+	virtual void AllocateDefaultPins() override;
+	virtual FText GetTooltipText() const override;
+	virtual FLinearColor GetNodeTitleColor() const override;
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+	virtual FSlateIcon GetIconAndTint(FLinearColor& OutColor) const override;
+	virtual void PinConnectionListChanged(UEdGraphPin* Pin) override;
+
+	// Override from UK2Node
+	virtual void ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins) override;
+	virtual class FNodeHandlingFunctor* CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const override;
+	virtual void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
+	virtual FText GetMenuCategory() const override;
+	virtual void ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph) override;
+	virtual bool IsConnectionDisallowed(const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const override;
+
+	// Override from UObject
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+
+	// Internal functions.
+	void CreateExecTriggeringPin();
+	void CreateSelectionPin();
+	void CreateDefaultExecPin();
+	virtual CasePinPair AddCasePinPair(int32 CaseIndex) override;
+	void SetSelectionPinType(const FEdGraphPinType& PinType, bool bResetKeys);
+	FString GetUnusedKeyValue() const;
+
+public:
+	UK2Node_MultiSwitch(const FObjectInitializer& ObjectInitializer);
+
+	// String keys are compared case-sensitively. Name keys are always case-insensitive.
+	UPROPERTY(EditAnywhere, Category = "PinOptions")
+	bool bCaseSensitive;
+
+	// Override from UK2Node_CasePairedPinsNode
+	virtual TArray<UEdGraphPin*> GetCaseConditionPins() const override;
+
+	UEdGraphPin* GetSelectionPin() const;
+	UEdGraphPin* GetDefaultExecPin() const;
+
+	// Integer value of the literal key, or false if the key is not valid.
+	bool GetCaseKeyValue(const UEdGraphPin* KeyPin, int32& OutValue) const;
+
+	// True if the selection is a name or a string, whose keys are looked up by the hash.
+	bool IsHashedSelection() const;
+};
@@ -0,0 +1,64 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "BlueprintActionDatabaseRegistrar.h"
+#include "K2Node_CasePairedPinsNode.h"
+
+#include "K2Node_RangeSelect.generated.h"
+
+// Returns the option of the smallest literal upper bound which is greater than the value.
+// The bounds are sorted at compile time and searched by the binary search.
+UCLASS(MinimalAPI, meta = (Keywords = "Select Range Threshold Tier Band"))
+class UK2Node_RangeSelect : public UK2Node_CasePairedPinsNode
+{
+	GENERATED_BODY()
+
+	// Override from UEdGraphNode
+	virtual void AllocateDefaultPins() override;
+	virtual FText GetTooltipText() const override;
+	virtual FLinearColor GetNodeTitleColor() const override;
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+	virtual FSlateIcon GetIconAndTint(FLinearColor& OutColor) const override;
+	virtual void PinConnectionListChanged(UEdGraphPin* Pin) override;
+
+	// Override from UK2Node
+	virtual void ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins) override;
+	virtual void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
+	virtual FText GetMenuCategory() const override;
+	virtual void ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph) override;
+	virtual bool IsNodePure() const override
+	{
+		return true;
+	}
+	virtual bool IsConnectionDisallowed(const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const override;
+
+	// Internal functions.
+	void CreateValuePin();
+	void CreateDefaultOptionPin();
+	void CreateReturnValuePin();
+	virtual CasePinPair AddCasePinPair(int32 CaseIndex) override;
+	void SetValuePinType(const FEdGraphPinType& PinType, bool bResetBounds);
+	FString GetNextBoundValue() const;
+
+public:
+	UK2Node_RangeSelect(const FObjectInitializer& ObjectInitializer);
+
+	// Override from UK2Node_CasePairedPinsNode
+	virtual TArray<UEdGraphPin*> GetCaseConditionPins() const override;
+	virtual TArray<UEdGraphPin*> GetCaseHitPins() const override;
+
+	UEdGraphPin* GetValuePin() const;
+	UEdGraphPin* GetDefaultOptionPin() const;
+	UEdGraphPin* GetReturnValuePin() const;
+
+	// Value of the literal upper bound, or false if the bound is not valid.
+	bool GetCaseBoundValue(const UEdGraphPin* BoundPin, double& OutValue) const;
+};
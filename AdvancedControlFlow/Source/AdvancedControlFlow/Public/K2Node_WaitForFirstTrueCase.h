@@ -0,0 +1,56 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "BlueprintActionDatabaseRegistrar.h"
+#include "K2Node_CasePairedPinsNode.h"
+
+#include "K2Node_WaitForFirstTrueCase.generated.h"
+
+// Latent node which executes the first case whose condition becomes true.
+// The conditions are tested again when the node is woken by the field notification of the Boolean member variable connected
+// directly to a condition or by Wake Waiting Cases, or polled by the shared scheduler.
+UCLASS(MinimalAPI, meta = (Keywords = "Wait Until Latent Condition Branch MultiBranch"))
+class UK2Node_WaitForFirstTrueCase : public UK2Node_CasePairedPinsNode
+{
+	GENERATED_BODY()
+
+	// Override from UEdGraphNode
+	virtual void AllocateDefaultPins() override;
+	virtual FText GetTooltipText() const override;
+	virtual FLinearColor GetNodeTitleColor() const override;
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+	virtual FSlateIcon GetIconAndTint(FLinearColor& OutColor) const override;
+
+	// Override from UK2Node
+	virtual void ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins) override;
+	virtual bool IsLatentForMacros() const override
+	{
+		return true;
+	}
+	virtual FText GetMenuCategory() const override;
+	virtual void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
+	virtual void ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph) override;
+
+	// Override from UObject
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+
+	// Internal functions.
+	void CreateExecTriggeringPin();
+	FString GetWakeSources(FKismetCompilerContext& CompilerContext) const;
+	virtual CasePinPair AddCasePinPair(int32 CaseIndex) override;
+
+public:
+	UK2Node_WaitForFirstTrueCase(const FObjectInitializer& ObjectInitializer);
+
+	// Interval in seconds to test the conditions while no wake comes. 0 tests them only when the node is woken.
+	UPROPERTY(EditAnywhere, Category = "Wait", meta = (ClampMin = "0.0"))
+	float PollingInterval;
+};
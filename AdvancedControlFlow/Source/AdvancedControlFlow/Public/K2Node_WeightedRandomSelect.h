@@ -0,0 +1,58 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "BlueprintActionDatabaseRegistrar.h"
+#include "K2Node_CasePairedPinsNode.h"
+
+#include "K2Node_WeightedRandomSelect.generated.h"
+
+// Returns the option chosen at random in proportion to its weight.
+UCLASS(MinimalAPI, meta = (Keywords = "Select Random Weighted Loot"))
+class UK2Node_WeightedRandomSelect : public UK2Node_CasePairedPinsNode
+{
+	GENERATED_BODY()
+
+	// Override from UEdGraphNode
+	virtual void AllocateDefaultPins() override;
+	virtual FText GetTooltipText() const override;
+	virtual FLinearColor GetNodeTitleColor() const override;
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+	virtual FSlateIcon GetIconAndTint(FLinearColor& OutColor) const override;
+	virtual void PinConnectionListChanged(UEdGraphPin* Pin) override;
+
+	// Override from UK2Node
+	virtual void ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins) override;
+	virtual void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
+	virtual FText GetMenuCategory() const override;
+	virtual void ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph) override;
+	virtual bool IsNodePure() const override
+	{
+		return true;
+	}
+	virtual bool IsConnectionDisallowed(const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const override;
+
+	// Internal functions.
+	void CreateStreamPin();
+	void CreateDefaultOptionPin();
+	void CreateReturnValuePin();
+	virtual CasePinPair AddCasePinPair(int32 CaseIndex) override;
+
+public:
+	UK2Node_WeightedRandomSelect(const FObjectInitializer& ObjectInitializer);
+
+	// Override from UK2Node_CasePairedPinsNode
+	virtual TArray<UEdGraphPin*> GetCaseConditionPins() const override;
+	virtual TArray<UEdGraphPin*> GetCaseHitPins() const override;
+
+	UEdGraphPin* GetStreamPin() const;
+	UEdGraphPin* GetDefaultOptionPin() const;
+	UEdGraphPin* GetReturnValuePin() const;
+};
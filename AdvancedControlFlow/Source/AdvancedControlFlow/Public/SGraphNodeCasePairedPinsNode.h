@@ -11,6 +11,8 @@
 
 #include "KismetNodes/SGraphNodeK2Base.h"
 
+class SBorder;
+class STextBlock;
 class UK2Node_CasePairedPinsNode;
 
 class SGraphNodeCasePairedPinsNode : public SGraphNodeK2Base
@@ -22,8 +24,16 @@ class SGraphNodeCasePairedPinsNode : public SGraphNodeK2Base
 
 	void Construct(const FArguments& InArgs, UK2Node_CasePairedPinsNode* InNode);
 
+	// Override from SNodePanel::SNode
+	virtual TArray<FOverlayWidgetInfo> GetOverlayWidgets(bool bSelected, const FVector2D& WidgetSize) const override;
+
 protected:
 	virtual void CreateOutputSideAddButton(TSharedPtr<SVerticalBox> OutputBox) override;
 	virtual EVisibility IsAddPinButtonVisible() const override;
 	virtual FReply OnAddPin() override;
+
+private:
+	// Heatmap of the per-case hit counts shown beside the case pins.
+	mutable TArray<TSharedPtr<SBorder>> HeatmapBorders;
+	mutable TArray<TSharedPtr<STextBlock>> HeatmapTexts;
 };
\ No newline at end of file
@@ -0,0 +1,30 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+using UnrealBuildTool;
+
+public class AdvancedControlFlowAI : ModuleRules
+{
+	public AdvancedControlFlowAI(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[]{
+			"AIModule",
+			"Core",
+			"CoreUObject",
+			"Engine",
+			"GameplayTasks",
+		});
+
+		PrivateDependencyModuleNames.AddRange(new string[]{
+			"AdvancedControlFlowRuntime",
+		});
+	}
+}
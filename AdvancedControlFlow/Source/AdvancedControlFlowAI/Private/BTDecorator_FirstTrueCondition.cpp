@@ -0,0 +1,205 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "BTDecorator_FirstTrueCondition.h"
+
+#include "Algo/Compare.h"
+#include "BehaviorTree/BTCompositeNode.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/BlackboardData.h"
+
+bool FACFBlackboardCondition::Evaluate(const UBlackboardComponent& BlackboardComp) const
+{
+	if (BlackboardKey.SelectedKeyType == nullptr)
+	{
+		return false;
+	}
+
+	const UBlackboardKeyType* KeyCDO = BlackboardKey.SelectedKeyType->GetDefaultObject<UBlackboardKeyType>();
+	const uint8* KeyMemory = BlackboardComp.GetKeyRawData(BlackboardKey.GetSelectedKeyID());
+	if (KeyMemory == nullptr)
+	{
+		return false;
+	}
+
+	switch (KeyCDO->GetTestOperation())
+	{
+		case EBlackboardKeyOperation::Basic:
+			return KeyCDO->WrappedTestBasicOperation(BlackboardComp, KeyMemory, BasicOperation);
+		case EBlackboardKeyOperation::Arithmetic:
+			return KeyCDO->WrappedTestArithmeticOperation(BlackboardComp, KeyMemory, ArithmeticOperation, IntValue, FloatValue);
+		case EBlackboardKeyOperation::Text:
+			return KeyCDO->WrappedTestTextOperation(BlackboardComp, KeyMemory, TextOperation, StringValue);
+		default:
+			return false;
+	}
+}
+
+bool FACFBlackboardCondition::IsSameCondition(const FACFBlackboardCondition& Other) const
+{
+	return (BlackboardKey.SelectedKeyName == Other.BlackboardKey.SelectedKeyName) && (BasicOperation == Other.BasicOperation) &&
+		   (ArithmeticOperation == Other.ArithmeticOperation) && (TextOperation == Other.TextOperation) &&
+		   (IntValue == Other.IntValue) && (FloatValue == Other.FloatValue) && (StringValue == Other.StringValue);
+}
+
+UBTDecorator_FirstTrueCondition::UBTDecorator_FirstTrueCondition(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	NodeName = TEXT("First True Condition");
+	CaseIndex = 0;
+
+	bNotifyBecomeRelevant = true;
+	bNotifyCeaseRelevant = true;
+}
+
+void UBTDecorator_FirstTrueCondition::InitializeFromAsset(UBehaviorTree& Asset)
+{
+	Super::InitializeFromAsset(Asset);
+
+	// The decorators under the same composite route its children together, so they must share the conditions and have their
+	// own cases. The first sibling with the conditions is the source of the siblings whose conditions are empty.
+	TArray<const UBTDecorator_FirstTrueCondition*, TInlineAllocator<8>> Siblings;
+	if (const UBTCompositeNode* Parent = GetParentNode())
+	{
+		for (const FBTCompositeChild& Child : Parent->Children)
+		{
+			for (const UBTDecorator* Decorator : Child.Decorators)
+			{
+				const UBTDecorator_FirstTrueCondition* Sibling = Cast<UBTDecorator_FirstTrueCondition>(Decorator);
+				if ((Sibling != nullptr) && (Sibling != this))
+				{
+					Siblings.Add(Sibling);
+				}
+			}
+		}
+	}
+
+	const UBTDecorator_FirstTrueCondition* const* Source =
+		Siblings.FindByPredicate([](const UBTDecorator_FirstTrueCondition* Sibling) { return Sibling->Conditions.Num() > 0; });
+	if (Source != nullptr)
+	{
+		const TArray<FACFBlackboardCondition>& SourceConditions = (*Source)->Conditions;
+		if (Conditions.Num() == 0)
+		{
+			Conditions = SourceConditions;
+		}
+		else if (!Algo::CompareByPredicate(Conditions, SourceConditions,
+					 [](const FACFBlackboardCondition& A, const FACFBlackboardCondition& B) { return A.IsSameCondition(B); }))
+		{
+			UE_LOG(LogBehaviorTree, Error, TEXT("%s in %s has the conditions different from its sibling %s."), *GetName(),
+				*Asset.GetName(), *(*Source)->GetName());
+		}
+	}
+
+	for (const UBTDecorator_FirstTrueCondition* Sibling : Siblings)
+	{
+		if (Sibling->CaseIndex == CaseIndex)
+		{
+			UE_LOG(LogBehaviorTree, Error, TEXT("%s in %s has the same case index %d as its sibling %s."), *GetName(),
+				*Asset.GetName(), CaseIndex, *Sibling->GetName());
+			break;
+		}
+	}
+
+	UBlackboardData* BlackboardAsset = GetBlackboardAsset();
+	if (BlackboardAsset == nullptr)
+	{
+		UE_LOG(LogBehaviorTree, Warning, TEXT("Can't initialize %s due to missing blackboard data."), *GetName());
+		return;
+	}
+
+	for (FACFBlackboardCondition& Condition : Conditions)
+	{
+		Condition.BlackboardKey.ResolveSelectedKey(*BlackboardAsset);
+	}
+}
+
+FString UBTDecorator_FirstTrueCondition::GetStaticDescription() const
+{
+	TArray<FString> KeyNames;
+	for (int32 Index = 0; Index < GetNumTestedConditions(); ++Index)
+	{
+		KeyNames.Add(Conditions[Index].BlackboardKey.SelectedKeyName.ToString());
+	}
+
+	const FString Case = (CaseIndex == INDEX_NONE) ? TEXT("Default") : FString::Printf(TEXT("Case %d"), CaseIndex);
+	return FString::Printf(TEXT("%s: %s of %s"), *Super::GetStaticDescription(), *Case, *FString::Join(KeyNames, TEXT(", ")));
+}
+
+bool UBTDecorator_FirstTrueCondition::CalculateRawConditionValue(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const
+{
+	const UBlackboardComponent* BlackboardComp = OwnerComp.GetBlackboardComponent();
+	if (BlackboardComp == nullptr)
+	{
+		return false;
+	}
+
+	// The conditions after this case cannot change the result.
+	const int32 NumTestedConditions = GetNumTestedConditions();
+	for (int32 Index = 0; Index < NumTestedConditions; ++Index)
+	{
+		if (Conditions[Index].Evaluate(*BlackboardComp))
+		{
+			return Index == CaseIndex;
+		}
+	}
+
+	return CaseIndex == INDEX_NONE;
+}
+
+void UBTDecorator_FirstTrueCondition::OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	UBlackboardComponent* BlackboardComp = OwnerComp.GetBlackboardComponent();
+	if (BlackboardComp == nullptr)
+	{
+		return;
+	}
+
+	TArray<FBlackboard::FKey, TInlineAllocator<8>> KeyIDs;
+	for (int32 Index = 0; Index < GetNumTestedConditions(); ++Index)
+	{
+		const FBlackboard::FKey KeyID = Conditions[Index].BlackboardKey.GetSelectedKeyID();
+		if ((KeyID != FBlackboard::InvalidKey) && !KeyIDs.Contains(KeyID))
+		{
+			KeyIDs.Add(KeyID);
+			BlackboardComp->RegisterObserver(KeyID, this,
+				FOnBlackboardChangeNotification::CreateUObject(this, &UBTDecorator_FirstTrueCondition::OnBlackboardKeyValueChange));
+		}
+	}
+}
+
+void UBTDecorator_FirstTrueCondition::OnCeaseRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	UBlackboardComponent* BlackboardComp = OwnerComp.GetBlackboardComponent();
+	if (BlackboardComp != nullptr)
+	{
+		BlackboardComp->UnregisterObserversFrom(this);
+	}
+}
+
+EBlackboardNotificationResult UBTDecorator_FirstTrueCondition::OnBlackboardKeyValueChange(
+	const UBlackboardComponent& Blackboard, FBlackboard::FKey ChangedKeyID)
+{
+	UBehaviorTreeComponent* BehaviorComp = Cast<UBehaviorTreeComponent>(Blackboard.GetBrainComponent());
+	if (BehaviorComp == nullptr)
+	{
+		return EBlackboardNotificationResult::RemoveObserver;
+	}
+
+	// Only the observed keys come here. The execution is requested only when the result of the decorator changes, so that
+	// the key updated every tick does not abort the branch every tick.
+	ConditionalFlowAbort(*BehaviorComp, EBTDecoratorAbortRequest::ConditionResultChanged);
+	return EBlackboardNotificationResult::ContinueObserving;
+}
+
+int32 UBTDecorator_FirstTrueCondition::GetNumTestedConditions() const
+{
+	return (CaseIndex == INDEX_NONE) ? Conditions.Num() : FMath::Min(CaseIndex + 1, Conditions.Num());
+}
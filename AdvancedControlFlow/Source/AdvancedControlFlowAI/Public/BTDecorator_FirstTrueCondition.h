@@ -0,0 +1,95 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "BehaviorTree/BTDecorator.h"
+#include "BehaviorTree/BehaviorTreeTypes.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType.h"
+
+#include "BTDecorator_FirstTrueCondition.generated.h"
+
+class UBlackboardComponent;
+
+// Test of a blackboard key, same as Blackboard decorator.
+// The operation is chosen by the type of the key.
+USTRUCT()
+struct ADVANCEDCONTROLFLOWAI_API FACFBlackboardCondition
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Condition")
+	FBlackboardKeySelector BlackboardKey;
+
+	// Used for Bool, Object, Class and Vector keys.
+	UPROPERTY(EditAnywhere, Category = "Condition")
+	TEnumAsByte<EBasicKeyOperation::Type> BasicOperation = EBasicKeyOperation::Set;
+
+	// Used for Int, Float and Enum keys.
+	UPROPERTY(EditAnywhere, Category = "Condition")
+	TEnumAsByte<EArithmeticKeyOperation::Type> ArithmeticOperation = EArithmeticKeyOperation::Equal;
+
+	// Used for String and Name keys.
+	UPROPERTY(EditAnywhere, Category = "Condition")
+	TEnumAsByte<ETextKeyOperation::Type> TextOperation = ETextKeyOperation::Equal;
+
+	UPROPERTY(EditAnywhere, Category = "Condition")
+	int32 IntValue = 0;
+
+	UPROPERTY(EditAnywhere, Category = "Condition")
+	float FloatValue = 0.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Condition")
+	FString StringValue;
+
+	bool Evaluate(const UBlackboardComponent& BlackboardComp) const;
+
+	// Compares the settings. The keys are compared by the name, so the unresolved keys can be compared.
+	bool IsSameCondition(const FACFBlackboardCondition& Other) const;
+};
+
+// Behavior Tree version of Multi-Branch. Each branch of a selector has this decorator with the same conditions and its own
+// case, and the branch of the first true condition is executed like if-elseif-else statement.
+// The conditions after the first true one are not tested, and only the keys of the conditions which can change the result of
+// this case are observed.
+UCLASS(meta = (DisplayName = "First True Condition"))
+class ADVANCEDCONTROLFLOWAI_API UBTDecorator_FirstTrueCondition : public UBTDecorator
+{
+	GENERATED_BODY()
+
+public:
+	UBTDecorator_FirstTrueCondition(const FObjectInitializer& ObjectInitializer);
+
+	// Conditions tested in the order. Leave it empty to use the conditions of the first sibling decorator under the same
+	// composite, so that the conditions are written once.
+	UPROPERTY(EditAnywhere, Category = "Condition")
+	TArray<FACFBlackboardCondition> Conditions;
+
+	// Passes when the condition of this index is the first true one. -1 passes when no condition is true.
+	UPROPERTY(EditAnywhere, Category = "Condition", meta = (ClampMin = "-1"))
+	int32 CaseIndex;
+
+	// Override from UBTNode
+	virtual void InitializeFromAsset(UBehaviorTree& Asset) override;
+	virtual FString GetStaticDescription() const override;
+
+protected:
+	// Override from UBTDecorator
+	virtual bool CalculateRawConditionValue(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const override;
+
+	// Override from UBTAuxiliaryNode
+	virtual void OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual void OnCeaseRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+
+	EBlackboardNotificationResult OnBlackboardKeyValueChange(
+		const UBlackboardComponent& Blackboard, FBlackboard::FKey ChangedKeyID);
+
+	// Conditions which decide whether this case passes. The default case depends on all of them.
+	int32 GetNumTestedConditions() const;
+};
@@ -0,0 +1,42 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+using UnrealBuildTool;
+
+public class AdvancedControlFlowRig : ModuleRules
+{
+	public AdvancedControlFlowRig(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[]{
+			"ControlRig",
+			"Core",
+			"CoreUObject",
+			"Engine",
+			"RigVM",
+		});
+
+		PrivateDependencyModuleNames.AddRange(new string[]{
+			"AdvancedControlFlowRuntime",
+			"Json",
+		});
+
+		// The benchmark builds the transient Control Rigs when it runs in the editor.
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.AddRange(new string[]{
+				"ControlRigDeveloper",
+				"ControlRigEditor",
+				"RigVMDeveloper",
+				"UnrealEd",
+			});
+		}
+	}
+}
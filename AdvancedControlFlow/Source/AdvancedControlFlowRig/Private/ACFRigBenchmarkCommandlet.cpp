@@ -0,0 +1,353 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "ACFRigBenchmarkCommandlet.h"
+
+#include "Dom/JsonObject.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "RigUnit_MultiConditionalSelect.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+#if WITH_EDITOR
+#include "ControlRig.h"
+#include "ControlRigBlueprint.h"
+#include "ControlRigBlueprintFactory.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Misc/EngineVersionComparison.h"
+#include "RigVMModel/RigVMController.h"
+#include "RigVMModel/Nodes/RigVMUnitNode.h"
+#include "RigVMModel/Nodes/RigVMVariableNode.h"
+#include "Units/Execution/RigUnit_BeginExecution.h"
+#if !UE_VERSION_OLDER_THAN(5, 2, 0)
+#include "RigVMFunctions/RigVMDispatch_If.h"
+#endif
+#endif
+
+DEFINE_LOG_CATEGORY_STATIC(LogACFBenchmark, Log, All);
+
+// Number of the condition sets evaluated per iteration.
+static const int32 NumConditionSets = 1024;
+
+#if WITH_EDITOR
+
+static FString GetRigPinPath(const URigVMNode* Node, const FString& PinName)
+{
+	return FString::Printf(TEXT("%s.%s"), *Node->GetName(), *PinName);
+}
+
+static URigVMNode* FindOrAddBeginExecution(URigVMController* Controller)
+{
+	// The factory places Forwards Solve on the new rig.
+	for (URigVMNode* Node : Controller->GetGraph()->GetNodes())
+	{
+		const URigVMUnitNode* UnitNode = Cast<URigVMUnitNode>(Node);
+		if ((UnitNode != nullptr) && (UnitNode->GetScriptStruct() == FRigUnit_BeginExecution::StaticStruct()))
+		{
+			return Node;
+		}
+	}
+	return Controller->AddUnitNode(FRigUnit_BeginExecution::StaticStruct(), TEXT("Execute"), FVector2D::ZeroVector);
+}
+
+static URigVMNode* AddRigIfNode(URigVMController* Controller, const FVector2D& Position)
+{
+#if UE_VERSION_OLDER_THAN(5, 2, 0)
+	return Controller->AddIfNode(TEXT("float"), NAME_None, Position);
+#else
+	return Controller->AddTemplateNode(FRigVMDispatch_If().GetTemplateNotation(), Position);
+#endif
+}
+
+// Builds the transient Control Rig whose Forwards Solve sets Result to the option of the first true Condition<N> variable, or
+// -1 if no condition is true. The options are the case indices, and are selected by the nested If nodes or by Multi-Conditional
+// Select (Float) unit. Returns nullptr if the rig is not compiled.
+static UControlRig* CreateBenchmarkRig(
+	const FString& RigName, int32 NumCases, bool bNestedIf, TArray<FBoolProperty*>& OutConditions, FNumericProperty*& OutResult)
+{
+	UControlRigBlueprint* Blueprint = UControlRigBlueprintFactory::CreateNewControlRigAsset(
+		FString::Printf(TEXT("/Temp/AdvancedControlFlow/%s%d"), *RigName, NumCases));
+	if (Blueprint == nullptr)
+	{
+		return nullptr;
+	}
+
+	TArray<FName> ConditionNames;
+	for (int32 Case = 0; Case < NumCases; ++Case)
+	{
+		ConditionNames.Add(Blueprint->AddMemberVariable(*FString::Printf(TEXT("Condition%d"), Case), TEXT("bool")));
+	}
+	const FName ResultName = Blueprint->AddMemberVariable(TEXT("Result"), TEXT("float"));
+
+	URigVMController* Controller = Blueprint->GetController();
+	URigVMNode* BeginExecution = FindOrAddBeginExecution(Controller);
+	URigVMNode* SetResult =
+		Controller->AddVariableNode(ResultName, TEXT("float"), nullptr, false, TEXT(""), FVector2D(800.0f, 0.0f));
+	Controller->AddLink(GetRigPinPath(BeginExecution, TEXT("ExecuteContext")), GetRigPinPath(SetResult, TEXT("ExecuteContext")));
+
+	TArray<URigVMNode*> GetConditions;
+	for (int32 Case = 0; Case < NumCases; ++Case)
+	{
+		GetConditions.Add(Controller->AddVariableNode(
+			ConditionNames[Case], TEXT("bool"), nullptr, true, TEXT(""), FVector2D(0.0f, 100.0f * (Case + 1))));
+	}
+
+	if (bNestedIf)
+	{
+		// The If of the case falls back to the If of the next case, and the innermost If falls back to -1.
+		FString ValuePinPath = GetRigPinPath(SetResult, TEXT("Value"));
+		for (int32 Case = 0; Case < NumCases; ++Case)
+		{
+			URigVMNode* If = AddRigIfNode(Controller, FVector2D(400.0f, 100.0f * (Case + 1)));
+			Controller->AddLink(GetRigPinPath(If, TEXT("Result")), ValuePinPath);
+			Controller->AddLink(GetRigPinPath(GetConditions[Case], TEXT("Value")), GetRigPinPath(If, TEXT("Condition")));
+			Controller->SetPinDefaultValue(GetRigPinPath(If, TEXT("True")), FString::FromInt(Case));
+			ValuePinPath = GetRigPinPath(If, TEXT("False"));
+		}
+		Controller->SetPinDefaultValue(ValuePinPath, TEXT("-1"));
+	}
+	else
+	{
+		URigVMNode* Select = Controller->AddUnitNode(
+			FRigUnit_MultiConditionalSelectFloat::StaticStruct(), TEXT("Execute"), FVector2D(400.0f, 0.0f));
+		Controller->SetArrayPinSize(GetRigPinPath(Select, TEXT("Conditions")), NumCases);
+		Controller->SetArrayPinSize(GetRigPinPath(Select, TEXT("Options")), NumCases);
+		for (int32 Case = 0; Case < NumCases; ++Case)
+		{
+			Controller->AddLink(GetRigPinPath(GetConditions[Case], TEXT("Value")),
+				GetRigPinPath(Select, FString::Printf(TEXT("Conditions.%d"), Case)));
+			Controller->SetPinDefaultValue(
+				GetRigPinPath(Select, FString::Printf(TEXT("Options.%d"), Case)), FString::FromInt(Case));
+		}
+		Controller->SetPinDefaultValue(GetRigPinPath(Select, TEXT("Default")), TEXT("-1"));
+		Controller->AddLink(GetRigPinPath(Select, TEXT("Result")), GetRigPinPath(SetResult, TEXT("Value")));
+	}
+
+	FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::SkipGarbageCollection);
+	if ((Blueprint->Status == BS_Error) || (Blueprint->GeneratedClass == nullptr))
+	{
+		return nullptr;
+	}
+
+	OutConditions.Reset();
+	for (const FName& Name : ConditionNames)
+	{
+		FBoolProperty* Property = FindFProperty<FBoolProperty>(Blueprint->GeneratedClass, Name);
+		if (Property == nullptr)
+		{
+			return nullptr;
+		}
+		OutConditions.Add(Property);
+	}
+	OutResult = FindFProperty<FNumericProperty>(Blueprint->GeneratedClass, ResultName);
+	if (OutResult == nullptr)
+	{
+		return nullptr;
+	}
+
+	UControlRig* Rig = NewObject<UControlRig>(GetTransientPackage(), Blueprint->GeneratedClass);
+	Rig->Initialize(true);
+	return Rig;
+}
+
+// Returns the time per evaluation of the rig in nanoseconds, or -1 if the rig is not built or selects the wrong case.
+static double MeasureBenchmarkRig(
+	const FString& RigName, int32 NumCases, bool bNestedIf, const TArray<bool>& Conditions, int32 NumIterations)
+{
+	TArray<FBoolProperty*> ConditionProperties;
+	FNumericProperty* ResultProperty = nullptr;
+	UControlRig* Rig = CreateBenchmarkRig(RigName, NumCases, bNestedIf, ConditionProperties, ResultProperty);
+	if (Rig == nullptr)
+	{
+		UE_LOG(LogACFBenchmark, Error, TEXT("Failed to build %s rig for %d cases"), *RigName, NumCases);
+		return -1.0;
+	}
+
+	auto SetConditions = [&](int32 Set)
+	{
+		const bool* Values = &Conditions[Set * NumCases];
+		for (int32 Case = 0; Case < NumCases; ++Case)
+		{
+			ConditionProperties[Case]->SetPropertyValue_InContainer(Rig, Values[Case]);
+		}
+	};
+
+	// Check the result of each condition set before the measurement, so that the broken graph is not measured.
+	for (int32 Set = 0; Set < NumConditionSets; ++Set)
+	{
+		SetConditions(Set);
+		Rig->Evaluate_AnyThread();
+
+		const int32 Selected = FMath::RoundToInt(
+			ResultProperty->GetFloatingPointPropertyValue(ResultProperty->ContainerPtrToValuePtr<void>(Rig)));
+		int32 Winner = INDEX_NONE;
+		for (int32 Case = 0; Case < NumCases; ++Case)
+		{
+			if (Conditions[Set * NumCases + Case])
+			{
+				Winner = Case;
+				break;
+			}
+		}
+		if (Selected != Winner)
+		{
+			UE_LOG(LogACFBenchmark, Error, TEXT("%s rig for %d cases selected %d instead of %d"), *RigName, NumCases,
+				Selected, Winner);
+			return -1.0;
+		}
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		for (int32 Set = 0; Set < NumConditionSets; ++Set)
+		{
+			SetConditions(Set);
+			Rig->Evaluate_AnyThread();
+		}
+	}
+	const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+	return Seconds * 1e9 / (static_cast<double>(NumIterations) * NumConditionSets);
+}
+
+#endif
+
+UACFRigBenchmarkCommandlet::UACFRigBenchmarkCommandlet(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UACFRigBenchmarkCommandlet::Main(const FString& Params)
+{
+	int32 NumIterations = 1000;
+	FParse::Value(*Params, TEXT("Iterations="), NumIterations);
+	NumIterations = FMath::Max(NumIterations, 1);
+
+	TSharedRef<FJsonObject> RootObject = MakeShared<FJsonObject>();
+	RootObject->SetNumberField(TEXT("Iterations"), NumIterations);
+	RootObject->SetObjectField(TEXT("RigSelect"), RunRigSelectBenchmark(NumIterations));
+
+	FString JsonString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonString);
+	if (!FJsonSerializer::Serialize(RootObject, Writer))
+	{
+		return 1;
+	}
+
+	const FString FilePath = FPaths::ProjectSavedDir() / TEXT("AdvancedControlFlow") / TEXT("RigBenchmark.json");
+	if (!FFileHelper::SaveStringToFile(JsonString, *FilePath))
+	{
+		UE_LOG(LogACFBenchmark, Error, TEXT("Failed to write %s"), *FilePath);
+		return 1;
+	}
+	UE_LOG(LogACFBenchmark, Display, TEXT("Wrote %s"), *FilePath);
+
+	return 0;
+}
+
+TSharedRef<FJsonObject> UACFRigBenchmarkCommandlet::RunRigSelectBenchmark(int32 NumIterations) const
+{
+	// Compare the chain of the nested If units with Multi-Conditional Select (Float) unit of Control Rig for 2-64 cases.
+	// The rigs built with each of them are evaluated, and so are the native equivalents of the units executed directly, so that
+	// the overhead of the rig evaluation is separated. The winner is uniformly distributed.
+	TSharedRef<FJsonObject> SuiteObject = MakeShared<FJsonObject>();
+	TArray<TSharedPtr<FJsonValue>> Results;
+	FRandomStream Random(0x0acf);
+	volatile float Sink = 0.0f;
+
+	for (int32 NumCases = 2; NumCases <= 64; NumCases *= 2)
+	{
+		TArray<bool> Conditions;
+		Conditions.SetNumZeroed(NumCases * NumConditionSets);
+		for (int32 Set = 0; Set < NumConditionSets; ++Set)
+		{
+			const int32 Winner = Random.RandRange(0, NumCases);
+			for (int32 Case = Winner; Case < NumCases; ++Case)
+			{
+				Conditions[Set * NumCases + Case] = (Case == Winner) || Random.GetFraction() < 0.5f;
+			}
+		}
+
+		FRigUnit_MultiConditionalSelectFloat Unit;
+		Unit.Conditions.SetNumZeroed(NumCases);
+		for (int32 Case = 0; Case < NumCases; ++Case)
+		{
+			Unit.Options.Add(static_cast<float>(Case));
+		}
+		Unit.Default = -1.0f;
+
+		// The nested If units evaluate every condition from the innermost If, which is the last case.
+		const double NestedStartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			for (int32 Set = 0; Set < NumConditionSets; ++Set)
+			{
+				const bool* SetConditions = &Conditions[Set * NumCases];
+				float Value = Unit.Default;
+				for (int32 Case = NumCases - 1; Case >= 0; --Case)
+				{
+					Value = SetConditions[Case] ? Unit.Options[Case] : Value;
+				}
+				Sink = Sink + Value;
+			}
+		}
+		const double NestedSeconds = FPlatformTime::Seconds() - NestedStartTime;
+
+		const FRigUnitContext Context;
+		const double UnitStartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			for (int32 Set = 0; Set < NumConditionSets; ++Set)
+			{
+				FMemory::Memcpy(Unit.Conditions.GetData(), &Conditions[Set * NumCases], NumCases * sizeof(bool));
+				Unit.Execute(Context);
+				Sink = Sink + Unit.Result;
+			}
+		}
+		const double UnitSeconds = FPlatformTime::Seconds() - UnitStartTime;
+
+		const double NumEvaluations = static_cast<double>(NumIterations) * NumConditionSets;
+		TSharedRef<FJsonObject> ResultObject = MakeShared<FJsonObject>();
+		ResultObject->SetNumberField(TEXT("NumCases"), NumCases);
+		ResultObject->SetNumberField(TEXT("NestedIfNs"), NestedSeconds * 1e9 / NumEvaluations);
+		ResultObject->SetNumberField(TEXT("UnitNs"), UnitSeconds * 1e9 / NumEvaluations);
+
+#if WITH_EDITOR
+		const double NestedIfRigNs = MeasureBenchmarkRig(TEXT("NestedIfRig"), NumCases, true, Conditions, NumIterations);
+		const double UnitRigNs = MeasureBenchmarkRig(TEXT("UnitRig"), NumCases, false, Conditions, NumIterations);
+		if (NestedIfRigNs >= 0.0)
+		{
+			ResultObject->SetNumberField(TEXT("NestedIfRigNs"), NestedIfRigNs);
+		}
+		if (UnitRigNs >= 0.0)
+		{
+			ResultObject->SetNumberField(TEXT("UnitRigNs"), UnitRigNs);
+		}
+
+		UE_LOG(LogACFBenchmark, Display,
+			TEXT("RigSelect: %3d cases, Nested If %.2f ns, Unit %.2f ns, Nested If rig %.2f ns, Unit rig %.2f ns"), NumCases,
+			NestedSeconds * 1e9 / NumEvaluations, UnitSeconds * 1e9 / NumEvaluations, NestedIfRigNs, UnitRigNs);
+#else
+		UE_LOG(LogACFBenchmark, Display, TEXT("RigSelect: %3d cases, Nested If %.2f ns, Unit %.2f ns"), NumCases,
+			NestedSeconds * 1e9 / NumEvaluations, UnitSeconds * 1e9 / NumEvaluations);
+#endif
+
+		Results.Add(MakeShared<FJsonValueObject>(ResultObject));
+	}
+
+	SuiteObject->SetArrayField(TEXT("Results"), Results);
+
+	return SuiteObject;
+}
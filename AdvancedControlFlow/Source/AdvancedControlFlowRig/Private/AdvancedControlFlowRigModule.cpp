@@ -0,0 +1,20 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowRigModule.h"
+
+void FAdvancedControlFlowRigModule::StartupModule()
+{
+}
+
+void FAdvancedControlFlowRigModule::ShutdownModule()
+{
+}
+
+IMPLEMENT_MODULE(FAdvancedControlFlowRigModule, AdvancedControlFlowRig);
@@ -0,0 +1,48 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "RigUnit_MultiConditionalSelect.h"
+
+#include "ACFConditionLibrary.h"
+
+// The array pins are passed as the fixed arrays or the arrays depending on the engine version, and both provide the operator[].
+template <typename ConditionArrayType>
+static int32 FindFirstTrueCondition(const ConditionArrayType& Conditions)
+{
+	return (Conditions.Num() > 0) ? ACFConditions::FindFirstTrue(&Conditions[0], Conditions.Num()) : INDEX_NONE;
+}
+
+// Only the selected option is copied, and nothing is allocated.
+template <typename ConditionArrayType, typename OptionArrayType, typename ValueType>
+static void SelectFirstTrueOption(
+	const ConditionArrayType& Conditions, const OptionArrayType& Options, const ValueType& Default, ValueType& Result)
+{
+	const int32 CaseIndex = FindFirstTrueCondition(Conditions);
+	Result = ((CaseIndex != INDEX_NONE) && (CaseIndex < Options.Num())) ? Options[CaseIndex] : Default;
+}
+
+FRigUnit_FindFirstTrueCondition_Execute()
+{
+	CaseIndex = FindFirstTrueCondition(Conditions);
+}
+
+FRigUnit_MultiConditionalSelectFloat_Execute()
+{
+	SelectFirstTrueOption(Conditions, Options, Default, Result);
+}
+
+FRigUnit_MultiConditionalSelectVector_Execute()
+{
+	SelectFirstTrueOption(Conditions, Options, Default, Result);
+}
+
+FRigUnit_MultiConditionalSelectTransform_Execute()
+{
+	SelectFirstTrueOption(Conditions, Options, Default, Result);
+}
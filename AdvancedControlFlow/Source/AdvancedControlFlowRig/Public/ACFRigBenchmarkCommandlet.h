@@ -0,0 +1,35 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "ACFRigBenchmarkCommandlet.generated.h"
+
+class FJsonObject;
+
+// Microbenchmarks of the Control Rig units against the nested If units which they replace.
+// The transient rigs built with each of them are evaluated in addition to the direct execution of the units.
+// It lives in AdvancedControlFlowRig, so that only the projects enabling Control Rig depend on it.
+// Usage: UnrealEditor-Cmd <Project> -run=ACFRigBenchmark -nullrhi [-Iterations=<N>]
+// The results are written to Saved/AdvancedControlFlow/RigBenchmark.json.
+UCLASS()
+class UACFRigBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+	TSharedRef<FJsonObject> RunRigSelectBenchmark(int32 NumIterations) const;
+
+public:
+	UACFRigBenchmarkCommandlet(const FObjectInitializer& ObjectInitializer);
+
+	// Override from UCommandlet
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,96 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "Units/RigUnit.h"
+
+#include "RigUnit_MultiConditionalSelect.generated.h"
+
+// Control Rig version of Multi-Branch. Returns the index of the first true condition, or -1 if no condition is true.
+// Connect Case Index to the Select node or the Branch nodes instead of nesting the Branch nodes on each condition.
+USTRUCT(meta = (DisplayName = "Find First True Condition", Category = "Control Flow", Keywords = "Multi-Branch,If,ElseIf,Switch"))
+struct ADVANCEDCONTROLFLOWRIG_API FRigUnit_FindFirstTrueCondition : public FRigUnit
+{
+	GENERATED_BODY()
+
+	RIGVM_METHOD()
+	virtual void Execute(const FRigUnitContext& Context) override;
+
+	UPROPERTY(meta = (Input))
+	TArray<bool> Conditions;
+
+	UPROPERTY(meta = (Output))
+	int32 CaseIndex = INDEX_NONE;
+};
+
+// Control Rig version of Multi-Conditional Select. Returns the option of the first true condition, or Default.
+// The options are paired with the conditions by the index, and the option whose index is out of range is Default.
+USTRUCT(meta = (DisplayName = "Multi-Conditional Select (Float)", Category = "Control Flow", Keywords = "If,ElseIf,Select"))
+struct ADVANCEDCONTROLFLOWRIG_API FRigUnit_MultiConditionalSelectFloat : public FRigUnit
+{
+	GENERATED_BODY()
+
+	RIGVM_METHOD()
+	virtual void Execute(const FRigUnitContext& Context) override;
+
+	UPROPERTY(meta = (Input))
+	TArray<bool> Conditions;
+
+	UPROPERTY(meta = (Input))
+	TArray<float> Options;
+
+	UPROPERTY(meta = (Input))
+	float Default = 0.0f;
+
+	UPROPERTY(meta = (Output))
+	float Result = 0.0f;
+};
+
+USTRUCT(meta = (DisplayName = "Multi-Conditional Select (Vector)", Category = "Control Flow", Keywords = "If,ElseIf,Select"))
+struct ADVANCEDCONTROLFLOWRIG_API FRigUnit_MultiConditionalSelectVector : public FRigUnit
+{
+	GENERATED_BODY()
+
+	RIGVM_METHOD()
+	virtual void Execute(const FRigUnitContext& Context) override;
+
+	UPROPERTY(meta = (Input))
+	TArray<bool> Conditions;
+
+	UPROPERTY(meta = (Input))
+	TArray<FVector> Options;
+
+	UPROPERTY(meta = (Input))
+	FVector Default = FVector::ZeroVector;
+
+	UPROPERTY(meta = (Output))
+	FVector Result = FVector::ZeroVector;
+};
+
+USTRUCT(meta = (DisplayName = "Multi-Conditional Select (Transform)", Category = "Control Flow", Keywords = "If,ElseIf,Select"))
+struct ADVANCEDCONTROLFLOWRIG_API FRigUnit_MultiConditionalSelectTransform : public FRigUnit
+{
+	GENERATED_BODY()
+
+	RIGVM_METHOD()
+	virtual void Execute(const FRigUnitContext& Context) override;
+
+	UPROPERTY(meta = (Input))
+	TArray<bool> Conditions;
+
+	UPROPERTY(meta = (Input))
+	TArray<FTransform> Options;
+
+	UPROPERTY(meta = (Input))
+	FTransform Default = FTransform::Identity;
+
+	UPROPERTY(meta = (Output))
+	FTransform Result = FTransform::Identity;
+};
@@ -0,0 +1,37 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+using UnrealBuildTool;
+
+public class AdvancedControlFlowRuntime : ModuleRules
+{
+	public AdvancedControlFlowRuntime(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[]{
+			"AnimGraphRuntime",
+			"Core",
+			"CoreUObject",
+			"Engine",
+			"GameplayTags",
+			"TraceLog",
+		});
+
+		PrivateDependencyModuleNames.AddRange(new string[]{
+			"Projects",
+		});
+
+		// The field notifications are available from UE 5.1.
+		if ((Target.Version.MajorVersion > 5) || ((Target.Version.MajorVersion == 5) && (Target.Version.MinorVersion >= 1)))
+		{
+			PrivateDependencyModuleNames.Add("FieldNotification");
+		}
+	}
+}
@@ -0,0 +1,317 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "ACFBatchLibrary.h"
+
+#include "ACFConditionLibrary.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+
+static int32 GACFBatchParallelThreshold = 16384;
+static FAutoConsoleVariableRef CVarACFBatchParallelThreshold(TEXT("ACF.Batch.ParallelThreshold"), GACFBatchParallelThreshold,
+	TEXT("Number of the elements from which the batch nodes of AdvancedControlFlow are processed in parallel."));
+
+namespace ACFBatch
+{
+// Number of the elements processed at once. The case indices of a block are kept on the stack.
+static const int32 BlockSize = 2048;
+
+int32 GetParallelThreshold()
+{
+	return GACFBatchParallelThreshold;
+}
+
+void MultiConditionalSelect(const FProperty* ElementProperty, TArrayView<const bool* const> Conditions,
+	TArrayView<const FOption> Options, const FOption& Default, int32 Num, uint8* OutElements)
+{
+	const int32 ElementSize = ElementProperty->ElementSize;
+	const bool bPlainOldData = ElementProperty->HasAnyPropertyFlags(CPF_IsPlainOldData);
+	const int32 NumBlocks = FMath::DivideAndRoundUp(Num, BlockSize);
+
+	ParallelFor(
+		NumBlocks,
+		[&](int32 Block)
+		{
+			const int32 Begin = Block * BlockSize;
+			const int32 End = FMath::Min(Begin + BlockSize, Num);
+			int32 CaseIndices[BlockSize];
+			ACFConditions::ComputeFirstTrueCaseIndices(Conditions, Begin, End, CaseIndices);
+
+			for (int32 Index = Begin; Index < End; ++Index)
+			{
+				const int32 CaseIndex = CaseIndices[Index - Begin];
+				const FOption& Option = (CaseIndex == INDEX_NONE) ? Default : Options[CaseIndex];
+				const uint8* Src = Option.Data + static_cast<SIZE_T>(Option.Stride) * Index;
+				uint8* Dest = OutElements + static_cast<SIZE_T>(ElementSize) * Index;
+				if (bPlainOldData)
+				{
+					FMemory::Memcpy(Dest, Src, ElementSize);
+				}
+				else
+				{
+					ElementProperty->CopySingleValue(Dest, Src);
+				}
+			}
+		},
+		Num < GetParallelThreshold());
+}
+
+void Partition(const FProperty* ElementProperty, TArrayView<const bool* const> Conditions, const uint8* Elements, int32 Num,
+	TArrayView<FScriptArrayHelper> OutBuckets)
+{
+	const int32 NumBuckets = Conditions.Num() + 1;
+	check(OutBuckets.Num() == NumBuckets);
+
+	const int32 ElementSize = ElementProperty->ElementSize;
+	const bool bPlainOldData = ElementProperty->HasAnyPropertyFlags(CPF_IsPlainOldData);
+	const int32 NumBlocks = FMath::DivideAndRoundUp(Num, BlockSize);
+	const bool bSingleThread = Num < GetParallelThreshold();
+
+	// Count the elements of each bucket per block.
+	TArray<int32> CaseIndices;
+	CaseIndices.SetNumUninitialized(Num);
+	TArray<int32> BlockOffsets;
+	BlockOffsets.SetNumZeroed(NumBlocks * NumBuckets);
+	ParallelFor(
+		NumBlocks,
+		[&](int32 Block)
+		{
+			const int32 Begin = Block * BlockSize;
+			const int32 End = FMath::Min(Begin + BlockSize, Num);
+			int32* BlockCaseIndices = CaseIndices.GetData() + Begin;
+			ACFConditions::ComputeFirstTrueCaseIndices(Conditions, Begin, End, BlockCaseIndices);
+
+			int32* Counts = BlockOffsets.GetData() + Block * NumBuckets;
+			for (int32 Index = 0; Index < End - Begin; ++Index)
+			{
+				const int32 CaseIndex = BlockCaseIndices[Index];
+				++Counts[(CaseIndex == INDEX_NONE) ? NumBuckets - 1 : CaseIndex];
+			}
+		},
+		bSingleThread);
+
+	// Turn the counts into the offsets of each block, so that the earlier block is placed first.
+	// The buckets are allocated to the exact size before the elements are scattered.
+	for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+	{
+		int32 Offset = 0;
+		for (int32 Block = 0; Block < NumBlocks; ++Block)
+		{
+			int32& BlockOffset = BlockOffsets[Block * NumBuckets + Bucket];
+			const int32 Count = BlockOffset;
+			BlockOffset = Offset;
+			Offset += Count;
+		}
+		OutBuckets[Bucket].EmptyAndAddValues(Offset);
+	}
+
+	ParallelFor(
+		NumBlocks,
+		[&](int32 Block)
+		{
+			const int32 Begin = Block * BlockSize;
+			const int32 End = FMath::Min(Begin + BlockSize, Num);
+			int32* Offsets = BlockOffsets.GetData() + Block * NumBuckets;
+			for (int32 Index = Begin; Index < End; ++Index)
+			{
+				const int32 CaseIndex = CaseIndices[Index];
+				const int32 Bucket = (CaseIndex == INDEX_NONE) ? NumBuckets - 1 : CaseIndex;
+				const uint8* Src = Elements + static_cast<SIZE_T>(ElementSize) * Index;
+				uint8* Dest = OutBuckets[Bucket].GetRawPtr(Offsets[Bucket]++);
+				if (bPlainOldData)
+				{
+					FMemory::Memcpy(Dest, Src, ElementSize);
+				}
+				else
+				{
+					ElementProperty->CopySingleValue(Dest, Src);
+				}
+			}
+		},
+		bSingleThread);
+}
+}  // namespace ACFBatch
+
+void UACFBatchLibrary::MultiConditionalSelectBatch(int32 NumCases, int64 ScalarOptionMask, TArray<int32>& Result)
+{
+	// Only called from Blueprint through the custom thunk.
+	check(0);
+}
+
+DEFINE_FUNCTION(UACFBatchLibrary::execMultiConditionalSelectBatch)
+{
+	P_GET_PROPERTY(FIntProperty, NumCases);
+	P_GET_PROPERTY(FInt64Property, ScalarOptionMask);
+
+	Stack.MostRecentProperty = nullptr;
+	Stack.MostRecentPropertyAddress = nullptr;
+	Stack.StepCompiledIn<FArrayProperty>(nullptr);
+	FArrayProperty* ResultProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+	void* ResultAddress = Stack.MostRecentPropertyAddress;
+	const FProperty* ElementProperty = (ResultProperty != nullptr) ? ResultProperty->Inner : nullptr;
+
+	// The arrays are referred in place. Only the single values are copied to the temporary storages.
+	TArray<const bool*, TInlineAllocator<16>> Conditions;
+	TArray<int32, TInlineAllocator<16>> NumConditionElements;
+	TArray<ACFBatch::FOption, TInlineAllocator<17>> Options;
+	TArray<int32, TInlineAllocator<17>> NumOptionElements;
+	TArray<void*, TInlineAllocator<17>> SingleValues;
+	for (int32 ArgIndex = 0; Stack.PeekCode() != EX_EndFunctionParms; ++ArgIndex)
+	{
+		const bool bConditions = (ArgIndex < 2 * NumCases) && (ArgIndex % 2 == 0);
+		const int32 OptionIndex = ArgIndex / 2;
+		Stack.MostRecentProperty = nullptr;
+		Stack.MostRecentPropertyAddress = nullptr;
+
+		if (!bConditions && (ElementProperty != nullptr) && (ScalarOptionMask & (1LL << OptionIndex)))
+		{
+			void* Value = FMemory::Malloc(ElementProperty->GetSize(), ElementProperty->GetMinAlignment());
+			ElementProperty->InitializeValue(Value);
+			Stack.StepCompiledIn<FProperty>(Value);
+			SingleValues.Add(Value);
+			Options.Add({static_cast<const uint8*>(Value), 0});
+			NumOptionElements.Add(INDEX_NONE);
+			continue;
+		}
+
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+		FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+		if ((ArrayProperty == nullptr) || (Stack.MostRecentPropertyAddress == nullptr))
+		{
+			continue;
+		}
+		FScriptArrayHelper Helper(ArrayProperty, Stack.MostRecentPropertyAddress);
+		const uint8* Data = (Helper.Num() > 0) ? Helper.GetRawPtr(0) : nullptr;
+		if (bConditions)
+		{
+			Conditions.Add(reinterpret_cast<const bool*>(Data));
+			NumConditionElements.Add(Helper.Num());
+		}
+		else
+		{
+			Options.Add({Data, ArrayProperty->Inner->ElementSize});
+			NumOptionElements.Add(Helper.Num());
+		}
+	}
+
+	P_FINISH;
+
+	P_NATIVE_BEGIN;
+	if (ResultProperty != nullptr)
+	{
+		FScriptArrayHelper ResultHelper(ResultProperty, ResultAddress);
+		const int32 Num = (NumConditionElements.Num() > 0) ? NumConditionElements[0] : 0;
+
+		bool bValid = (Conditions.Num() == NumCases) && (Options.Num() == NumCases + 1);
+		for (int32 NumElements : NumConditionElements)
+		{
+			bValid &= (NumElements == Num);
+		}
+		for (int32 NumElements : NumOptionElements)
+		{
+			bValid &= (NumElements == INDEX_NONE) || (NumElements == Num);
+		}
+
+		if (bValid)
+		{
+			ResultHelper.EmptyAndAddValues(Num);
+			ACFBatch::MultiConditionalSelect(ElementProperty, Conditions, MakeArrayView(Options.GetData(), NumCases),
+				Options.Last(), Num, (Num > 0) ? ResultHelper.GetRawPtr(0) : nullptr);
+		}
+		else
+		{
+			FFrame::KismetExecutionMessage(TEXT("Multi-Conditional Select (Batch): All condition and option arrays must have "
+												"the same number of elements."),
+				ELogVerbosity::Warning);
+			ResultHelper.EmptyValues();
+		}
+	}
+	P_NATIVE_END;
+
+	for (void* Value : SingleValues)
+	{
+		ElementProperty->DestroyValue(Value);
+		FMemory::Free(Value);
+	}
+}
+
+void UACFBatchLibrary::MultiBranchPartition(const TArray<int32>& Array, int32 NumCases)
+{
+	// Only called from Blueprint through the custom thunk.
+	check(0);
+}
+
+DEFINE_FUNCTION(UACFBatchLibrary::execMultiBranchPartition)
+{
+	Stack.MostRecentProperty = nullptr;
+	Stack.MostRecentPropertyAddress = nullptr;
+	Stack.StepCompiledIn<FArrayProperty>(nullptr);
+	FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+	void* ArrayAddress = Stack.MostRecentPropertyAddress;
+
+	P_GET_PROPERTY(FIntProperty, NumCases);
+
+	TArray<const bool*, TInlineAllocator<16>> Conditions;
+	TArray<int32, TInlineAllocator<16>> NumConditionElements;
+	TArray<FScriptArrayHelper, TInlineAllocator<17>> Buckets;
+	for (int32 ArgIndex = 0; Stack.PeekCode() != EX_EndFunctionParms; ++ArgIndex)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.MostRecentPropertyAddress = nullptr;
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+		FArrayProperty* Property = CastField<FArrayProperty>(Stack.MostRecentProperty);
+		if ((Property == nullptr) || (Stack.MostRecentPropertyAddress == nullptr))
+		{
+			continue;
+		}
+
+		if (ArgIndex < NumCases)
+		{
+			FScriptArrayHelper Helper(Property, Stack.MostRecentPropertyAddress);
+			Conditions.Add((Helper.Num() > 0) ? reinterpret_cast<const bool*>(Helper.GetRawPtr(0)) : nullptr);
+			NumConditionElements.Add(Helper.Num());
+		}
+		else
+		{
+			Buckets.Emplace(Property, Stack.MostRecentPropertyAddress);
+		}
+	}
+
+	P_FINISH;
+
+	P_NATIVE_BEGIN;
+	if ((ArrayProperty != nullptr) && (ArrayAddress != nullptr) && (Buckets.Num() == NumCases + 1))
+	{
+		FScriptArrayHelper ArrayHelper(ArrayProperty, ArrayAddress);
+		const int32 Num = ArrayHelper.Num();
+
+		bool bValid = Conditions.Num() == NumCases;
+		for (int32 NumElements : NumConditionElements)
+		{
+			bValid &= (NumElements == Num);
+		}
+
+		if (bValid)
+		{
+			ACFBatch::Partition(
+				ArrayProperty->Inner, Conditions, (Num > 0) ? ArrayHelper.GetRawPtr(0) : nullptr, Num, Buckets);
+		}
+		else
+		{
+			FFrame::KismetExecutionMessage(
+				TEXT("Multi-Branch Partition: All condition arrays must have the same number of elements as Array."),
+				ELogVerbosity::Warning);
+			for (FScriptArrayHelper& Bucket : Buckets)
+			{
+				Bucket.EmptyValues();
+			}
+		}
+	}
+	P_NATIVE_END;
+}
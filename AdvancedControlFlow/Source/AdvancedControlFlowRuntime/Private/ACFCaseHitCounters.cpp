@@ -0,0 +1,192 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "ACFCaseHitCounters.h"
+
+#include "Hash/CityHash.h"
+#include "Misc/ScopeLock.h"
+
+#if ACF_WITH_CASE_HIT_COUNTERS
+
+FACFCaseHitCounters::FHitArray::FHitArray(int32 InNumHits) : NumHits(InNumHits), Hits(new std::atomic<uint64>[InNumHits])
+{
+	for (int32 Index = 0; Index < NumHits; ++Index)
+	{
+		Hits[Index].store(0, std::memory_order_relaxed);
+	}
+}
+
+FACFCaseHitCounters::FHitArray::~FHitArray()
+{
+	delete[] Hits;
+}
+
+FACFCaseHitCounters::~FACFCaseHitCounters()
+{
+	for (FSlot& Slot : Slots)
+	{
+		delete Slot.HitArray.load(std::memory_order_acquire);
+	}
+	for (FHitArray* HitArray : RetiredHitArrays)
+	{
+		delete HitArray;
+	}
+}
+
+FACFCaseHitCounters& FACFCaseHitCounters::Get()
+{
+	static FACFCaseHitCounters Instance;
+	return Instance;
+}
+
+uint64 FACFCaseHitCounters::MakeCounterKey(const FString& NodeKey)
+{
+	FTCHARToUTF8 Converted(*NodeKey);
+
+	// 0 is reserved for the empty slot.
+	return CityHash64(Converted.Get(), Converted.Length()) | 1;
+}
+
+const FACFCaseHitCounters::FSlot* FACFCaseHitCounters::FindSlot(uint64 CounterKey) const
+{
+	for (int32 Probe = 0; Probe < NumSlots; ++Probe)
+	{
+		const FSlot& Slot = Slots[(CounterKey + Probe) & (NumSlots - 1)];
+		uint64 Key = Slot.CounterKey.load(std::memory_order_acquire);
+		if (Key == CounterKey)
+		{
+			return &Slot;
+		}
+		if (Key == 0)
+		{
+			break;
+		}
+	}
+
+	return nullptr;
+}
+
+FACFCaseHitCounters::FSlot* FACFCaseHitCounters::FindOrClaimSlot(uint64 CounterKey)
+{
+	for (int32 Probe = 0; Probe < NumSlots; ++Probe)
+	{
+		FSlot& Slot = Slots[(CounterKey + Probe) & (NumSlots - 1)];
+		uint64 Key = Slot.CounterKey.load(std::memory_order_acquire);
+		if ((Key == 0) && Slot.CounterKey.compare_exchange_strong(Key, CounterKey, std::memory_order_acq_rel))
+		{
+			// This thread claimed the empty slot.
+			return &Slot;
+		}
+
+		// Key holds the claimer's key when the exchange failed.
+		if (Key == CounterKey)
+		{
+			return &Slot;
+		}
+	}
+
+	return nullptr;
+}
+
+FACFCaseHitCounters::FHitArray* FACFCaseHitCounters::ReplaceHitArray(FSlot& Slot, FHitArray* OldHitArray, int32 NumCases)
+{
+	FHitArray* NewHitArray = new FHitArray(NumCases);
+	if (Slot.HitArray.compare_exchange_strong(OldHitArray, NewHitArray, std::memory_order_acq_rel))
+	{
+		if (OldHitArray != nullptr)
+		{
+			FScopeLock Lock(&RetiredHitArraysLock);
+			RetiredHitArrays.Add(OldHitArray);
+		}
+		return NewHitArray;
+	}
+
+	// Another thread replaced it first. OldHitArray holds the replaced one when the exchange failed.
+	delete NewHitArray;
+	return OldHitArray;
+}
+
+void FACFCaseHitCounters::CountCaseHit(uint64 CounterKey, int32 NumCases, int32 CaseIndex)
+{
+	if ((CaseIndex < 0) || (CaseIndex >= NumCases))
+	{
+		return;
+	}
+
+	FSlot* Slot = FindOrClaimSlot(CounterKey);
+	if (Slot == nullptr)
+	{
+		return;
+	}
+
+	FHitArray* HitArray = Slot->HitArray.load(std::memory_order_acquire);
+	if ((HitArray == nullptr) || (HitArray->NumHits != NumCases))
+	{
+		HitArray = ReplaceHitArray(*Slot, HitArray, NumCases);
+	}
+	if (HitArray->NumHits == NumCases)
+	{
+		HitArray->Hits[CaseIndex].fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+bool FACFCaseHitCounters::GetCaseHits(uint64 CounterKey, TArray<uint64>& OutHits) const
+{
+	const FSlot* Slot = FindSlot(CounterKey);
+	if (Slot == nullptr)
+	{
+		return false;
+	}
+
+	const FHitArray* HitArray = Slot->HitArray.load(std::memory_order_acquire);
+	if (HitArray == nullptr)
+	{
+		return false;
+	}
+
+	OutHits.SetNum(HitArray->NumHits);
+	for (int32 Index = 0; Index < HitArray->NumHits; ++Index)
+	{
+		OutHits[Index] = HitArray->Hits[Index].load(std::memory_order_relaxed);
+	}
+
+	return HitArray->NumHits > 0;
+}
+
+void FACFCaseHitCounters::Reset()
+{
+	// The slots are kept, so that the running Blueprints can continue counting.
+	for (FSlot& Slot : Slots)
+	{
+		FHitArray* HitArray = Slot.HitArray.load(std::memory_order_acquire);
+		for (int32 Index = 0; (HitArray != nullptr) && (Index < HitArray->NumHits); ++Index)
+		{
+			HitArray->Hits[Index].store(0, std::memory_order_relaxed);
+		}
+	}
+}
+
+#endif
+
+void UACFCaseHitCounterLibrary::CountCaseHit(int64 CounterKey, int32 NumCases, int32 CaseIndex)
+{
+#if ACF_WITH_CASE_HIT_COUNTERS
+	FACFCaseHitCounters::Get().CountCaseHit(static_cast<uint64>(CounterKey), NumCases, CaseIndex);
+#endif
+}
+
+int32 UACFCaseHitCounterLibrary::CountSelectedCaseHit(int64 CounterKey, int32 NumCases, int32 CaseIndex)
+{
+#if ACF_WITH_CASE_HIT_COUNTERS
+	FACFCaseHitCounters::Get().CountCaseHit(
+		static_cast<uint64>(CounterKey), NumCases, (CaseIndex == INDEX_NONE) ? NumCases - 1 : CaseIndex);
+#endif
+
+	return CaseIndex;
+}
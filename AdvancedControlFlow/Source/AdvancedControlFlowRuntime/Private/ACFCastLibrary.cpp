@@ -0,0 +1,84 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "ACFCastLibrary.h"
+
+#include "Misc/ScopeRWLock.h"
+#include "UObject/ObjectKey.h"
+
+namespace ACFCast
+{
+// The object class is identified with its serial number, so that the class allocated at the address of a destroyed class
+// never hits the cache.
+static TMap<FName, TMap<TObjectKey<UClass>, int32>> ClassCaseCaches;
+static FRWLock CachesLock;
+
+static void ClearClassCaseCaches()
+{
+	FWriteScopeLock WriteLock(CachesLock);
+	ClassCaseCaches.Reset();
+}
+
+static void BindCacheInvalidation()
+{
+	// The classes are replaced by the hot reload and the Blueprint recompile, which may change the hierarchy.
+	FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([](EReloadCompleteReason) { ClearClassCaseCaches(); });
+#if WITH_EDITOR
+	FCoreUObjectDelegates::OnObjectsReplaced.AddLambda([](const TMap<UObject*, UObject*>&) { ClearClassCaseCaches(); });
+#endif
+}
+}  // namespace ACFCast
+
+int32 UACFCastLibrary::FindCachedClassCase(FName CaseClasses, int32 NumCases, UObject* Object)
+{
+	if (Object == nullptr)
+	{
+		return INDEX_NONE;
+	}
+
+	FReadScopeLock ReadLock(ACFCast::CachesLock);
+	if (const TMap<TObjectKey<UClass>, int32>* Cache = ACFCast::ClassCaseCaches.Find(CaseClasses))
+	{
+		if (const int32* CaseIndex = Cache->Find(Object->GetClass()))
+		{
+			return *CaseIndex;
+		}
+	}
+
+	return NumCases;
+}
+
+int32 UACFCastLibrary::CacheClassCase(FName CaseClasses, const TArray<UClass*>& Classes, UObject* Object)
+{
+	if (Object == nullptr)
+	{
+		return INDEX_NONE;
+	}
+
+	// The first case wins as the chain of the casts does.
+	UClass* ObjectClass = Object->GetClass();
+	const int32 CaseIndex = Classes.IndexOfByPredicate(
+		[ObjectClass](const UClass* Class) { return (Class != nullptr) && ObjectClass->IsChildOf(Class); });
+
+	FWriteScopeLock WriteLock(ACFCast::CachesLock);
+	static bool bCacheInvalidationBound = false;
+	if (!bCacheInvalidationBound)
+	{
+		ACFCast::BindCacheInvalidation();
+		bCacheInvalidationBound = true;
+	}
+	ACFCast::ClassCaseCaches.FindOrAdd(CaseClasses).Add(ObjectClass, CaseIndex);
+
+	return CaseIndex;
+}
+
+UObject* UACFCastLibrary::AsCaseClass(UObject* Object, TSubclassOf<UObject> Class)
+{
+	return Object;
+}
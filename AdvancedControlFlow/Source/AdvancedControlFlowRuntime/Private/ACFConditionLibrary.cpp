@@ -0,0 +1,109 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "ACFConditionLibrary.h"
+
+namespace ACFConditions
+{
+int32 FindFirstTrue(const uint64* Masks, int32 NumConditions)
+{
+	const int32 NumWords = GetNumMaskWords(NumConditions);
+	for (int32 Word = 0; Word < NumWords; ++Word)
+	{
+		if (Masks[Word] != 0)
+		{
+			return Word * 64 + static_cast<int32>(FMath::CountTrailingZeros64(Masks[Word]));
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+int32 FindFirstTrue(const bool* Conditions, int32 NumConditions)
+{
+	for (int32 Base = 0; Base < NumConditions; Base += 64)
+	{
+		// Branch-free packing, so that the compiler can vectorize it.
+		const int32 NumBits = FMath::Min(NumConditions - Base, 64);
+		uint64 Mask = 0;
+		for (int32 Bit = 0; Bit < NumBits; ++Bit)
+		{
+			Mask |= static_cast<uint64>(Conditions[Base + Bit]) << Bit;
+		}
+
+		if (Mask != 0)
+		{
+			return Base + static_cast<int32>(FMath::CountTrailingZeros64(Mask));
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+void ComputeFirstTrueCaseIndices(TArrayView<const bool* const> Conditions, int32 Begin, int32 End, int32* OutCaseIndices)
+{
+	const int32 Num = End - Begin;
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		OutCaseIndices[Index] = INDEX_NONE;
+	}
+
+	// Walk the cases backward so that the earlier true case overwrites the later one.
+	// Each pass is a branch-free select over the contiguous elements, which the compiler can vectorize.
+	for (int32 Case = Conditions.Num() - 1; Case >= 0; --Case)
+	{
+		const bool* CaseConditions = Conditions[Case] + Begin;
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			OutCaseIndices[Index] = CaseConditions[Index] ? Case : OutCaseIndices[Index];
+		}
+	}
+}
+}  // namespace ACFConditions
+
+int32 UACFConditionLibrary::FindFirstTrueCondition()
+{
+	// Only called from Blueprint through the custom thunk.
+	check(0);
+	return INDEX_NONE;
+}
+
+DEFINE_FUNCTION(UACFConditionLibrary::execFindFirstTrueCondition)
+{
+	// All variadic arguments must be stepped even after the true condition is found.
+	int32 Result = INDEX_NONE;
+	int32 Index = 0;
+	uint64 Mask = 0;
+	while (Stack.PeekCode() != EX_EndFunctionParms)
+	{
+		bool bCondition = false;
+		Stack.MostRecentProperty = nullptr;
+		Stack.MostRecentPropertyAddress = nullptr;
+		Stack.Step(Stack.Object, &bCondition);
+
+		Mask |= static_cast<uint64>(bCondition) << (Index & 63);
+		++Index;
+		if ((Index & 63) == 0)
+		{
+			if ((Result == INDEX_NONE) && (Mask != 0))
+			{
+				Result = Index - 64 + static_cast<int32>(FMath::CountTrailingZeros64(Mask));
+			}
+			Mask = 0;
+		}
+	}
+	if ((Result == INDEX_NONE) && (Mask != 0))
+	{
+		Result = (Index & ~63) + static_cast<int32>(FMath::CountTrailingZeros64(Mask));
+	}
+
+	P_FINISH;
+
+	*(int32*) RESULT_PARAM = Result;
+}
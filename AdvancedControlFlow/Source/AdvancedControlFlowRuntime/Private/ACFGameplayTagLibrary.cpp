@@ -0,0 +1,240 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "ACFGameplayTagLibrary.h"
+
+#include "GameplayTagsManager.h"
+#include "Misc/ScopeRWLock.h"
+
+namespace ACFGameplayTags
+{
+static TMap<FName, FCaseTable> LiteralTables;
+static FRWLock TablesLock;
+
+#if WITH_EDITOR
+static void ClearLiteralTables()
+{
+	// The network index changes when the tag tree is refreshed.
+	FWriteScopeLock WriteLock(TablesLock);
+	LiteralTables.Reset();
+}
+#endif
+
+void FCaseTable::Build(bool bInMatchAll, bool bInExactMatch, TArrayView<const FGameplayTagContainer> InCases)
+{
+	bMatchAll = bInMatchAll;
+	bExactMatch = bInExactMatch;
+	Cases.Reset();
+	Words.Reset();
+	NumTagWords = 0;
+
+	UGameplayTagsManager& Manager = UGameplayTagsManager::Get();
+	for (const FGameplayTagContainer& CaseTags : InCases)
+	{
+		FCaseBits Bits = {0, 0, Words.Num(), false};
+		TArray<int32, TInlineAllocator<16>> NetIndices;
+		for (const FGameplayTag& Tag : CaseTags)
+		{
+			const FGameplayTagNetIndex NetIndex = Manager.GetNetIndexFromTag(Tag);
+			if (NetIndex != INVALID_TAGNETINDEX)
+			{
+				NetIndices.Add(NetIndex);
+			}
+			else if (bMatchAll)
+			{
+				// No container has the unknown tag.
+				Bits.bNeverMatches = true;
+			}
+		}
+
+		if (NetIndices.Num() > 0)
+		{
+			Bits.FirstWord = FMath::Min(NetIndices) / 64;
+			Bits.NumWords = FMath::Max(NetIndices) / 64 - Bits.FirstWord + 1;
+			Words.AddZeroed(Bits.NumWords);
+			for (int32 NetIndex : NetIndices)
+			{
+				Words[Bits.Offset + NetIndex / 64 - Bits.FirstWord] |= 1ull << (NetIndex % 64);
+			}
+			NumTagWords = FMath::Max(NumTagWords, Bits.FirstWord + Bits.NumWords);
+		}
+		Cases.Add(Bits);
+	}
+}
+
+int32 FCaseTable::Find(const FGameplayTagContainer& Container) const
+{
+	// Tags of the container, including their parents unless the exact match is required.
+	TArray<uint64, TInlineAllocator<64>> TagWords;
+	TagWords.AddZeroed(NumTagWords);
+	const int32 NumTagBits = NumTagWords * 64;
+	auto SetTagBit = [&TagWords, NumTagBits](int32 NetIndex) {
+		if (NetIndex < NumTagBits)
+		{
+			TagWords[NetIndex / 64] |= 1ull << (NetIndex % 64);
+		}
+	};
+
+	UGameplayTagsManager& Manager = UGameplayTagsManager::Get();
+	for (const FGameplayTag& Tag : Container)
+	{
+		if (bExactMatch)
+		{
+			SetTagBit(Manager.GetNetIndexFromTag(Tag));
+			continue;
+		}
+
+		const TSharedPtr<FGameplayTagNode> TagNode = Manager.FindTagNode(Tag);
+		for (const FGameplayTagNode* Node = TagNode.Get(); (Node != nullptr) && Node->GetCompleteTag().IsValid();
+			 Node = Node->GetParentTagNode())
+		{
+			SetTagBit(Node->GetNetIndex());
+		}
+	}
+
+	for (int32 CaseIndex = 0; CaseIndex < Cases.Num(); ++CaseIndex)
+	{
+		const FCaseBits& Bits = Cases[CaseIndex];
+		if (Bits.bNeverMatches)
+		{
+			continue;
+		}
+
+		// Any: some tag of the case is in the container. All: every tag of the case is in the container.
+		bool bMatched = bMatchAll;
+		for (int32 Word = 0; Word < Bits.NumWords; ++Word)
+		{
+			const uint64 CaseWord = Words[Bits.Offset + Word];
+			const uint64 CommonWord = TagWords[Bits.FirstWord + Word] & CaseWord;
+			if (bMatchAll && (CommonWord != CaseWord))
+			{
+				bMatched = false;
+				break;
+			}
+			if (!bMatchAll && (CommonWord != 0))
+			{
+				bMatched = true;
+				break;
+			}
+		}
+		if (bMatched)
+		{
+			return CaseIndex;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+FString EncodeCases(bool bMatchAll, bool bExactMatch, TArrayView<const FGameplayTagContainer> Cases)
+{
+	// Each case is prefixed by the number of its tags. Each tag is terminated by ',' which is not allowed in the tag.
+	FString Encoded;
+	Encoded.AppendChar(bMatchAll ? TEXT('l') : TEXT('a'));
+	Encoded.AppendChar(bExactMatch ? TEXT('e') : TEXT('p'));
+	for (const FGameplayTagContainer& CaseTags : Cases)
+	{
+		Encoded += FString::Printf(TEXT("%d:"), CaseTags.Num());
+		for (const FGameplayTag& Tag : CaseTags)
+		{
+			Encoded += Tag.ToString();
+			Encoded.AppendChar(TEXT(','));
+		}
+	}
+
+	return (Encoded.Len() < NAME_SIZE) ? Encoded : FString();
+}
+
+bool DecodeCases(const FString& Encoded, bool& bOutMatchAll, bool& bOutExactMatch, TArray<FGameplayTagContainer>& OutCases)
+{
+	if (Encoded.Len() < 2)
+	{
+		return false;
+	}
+	bOutMatchAll = Encoded[0] == TEXT('l');
+	bOutExactMatch = Encoded[1] == TEXT('e');
+
+	OutCases.Reset();
+	int32 Position = 2;
+	while (Position < Encoded.Len())
+	{
+		const int32 Colon = Encoded.Find(TEXT(":"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Position);
+		if (Colon == INDEX_NONE)
+		{
+			return false;
+		}
+		const int32 NumTags = FCString::Atoi(*Encoded.Mid(Position, Colon - Position));
+		Position = Colon + 1;
+
+		FGameplayTagContainer& CaseTags = OutCases.AddDefaulted_GetRef();
+		for (int32 Index = 0; Index < NumTags; ++Index)
+		{
+			const int32 Comma = Encoded.Find(TEXT(","), ESearchCase::CaseSensitive, ESearchDir::FromStart, Position);
+			if (Comma == INDEX_NONE)
+			{
+				return false;
+			}
+			CaseTags.AddTag(FGameplayTag::RequestGameplayTag(FName(*Encoded.Mid(Position, Comma - Position)), false));
+			Position = Comma + 1;
+		}
+	}
+
+	return true;
+}
+}  // namespace ACFGameplayTags
+
+int32 UACFGameplayTagLibrary::FindGameplayTagCase(FName Cases, const FGameplayTagContainer& Tags)
+{
+	{
+		FReadScopeLock ReadLock(ACFGameplayTags::TablesLock);
+		if (const ACFGameplayTags::FCaseTable* Table = ACFGameplayTags::LiteralTables.Find(Cases))
+		{
+			return Table->Find(Tags);
+		}
+	}
+
+	bool bMatchAll = false;
+	bool bExactMatch = false;
+	TArray<FGameplayTagContainer> DecodedCases;
+	ACFGameplayTags::FCaseTable Table;
+	if (ACFGameplayTags::DecodeCases(Cases.ToString(), bMatchAll, bExactMatch, DecodedCases))
+	{
+		Table.Build(bMatchAll, bExactMatch, DecodedCases);
+	}
+	const int32 Index = Table.Find(Tags);
+
+	FWriteScopeLock WriteLock(ACFGameplayTags::TablesLock);
+#if WITH_EDITOR
+	static bool bTagTreeRefreshBound = false;
+	if (!bTagTreeRefreshBound)
+	{
+		UGameplayTagsManager::Get().OnEditorRefreshGameplayTagTree.AddStatic(&ACFGameplayTags::ClearLiteralTables);
+		bTagTreeRefreshBound = true;
+	}
+#endif
+	ACFGameplayTags::LiteralTables.Add(Cases, MoveTemp(Table));
+
+	return Index;
+}
+
+int32 UACFGameplayTagLibrary::FindGameplayTagCaseInArray(
+	const TArray<FGameplayTagContainer>& Cases, bool bMatchAll, bool bExactMatch, const FGameplayTagContainer& Tags)
+{
+	for (int32 Index = 0; Index < Cases.Num(); ++Index)
+	{
+		const bool bMatched = bMatchAll ? (bExactMatch ? Tags.HasAllExact(Cases[Index]) : Tags.HasAll(Cases[Index]))
+										: (bExactMatch ? Tags.HasAnyExact(Cases[Index]) : Tags.HasAny(Cases[Index]));
+		if (bMatched)
+		{
+			return Index;
+		}
+	}
+
+	return INDEX_NONE;
+}
@@ -0,0 +1,352 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "ACFParallelLibrary.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+static float GACFParallelMinCostMicroseconds = 50.0f;
+static FAutoConsoleVariableRef CVarACFParallelMinCostMicroseconds(TEXT("ACF.Parallel.MinCostMicroseconds"),
+	GACFParallelMinCostMicroseconds,
+	TEXT("Measured cost of the conditions from which the parallel nodes of AdvancedControlFlow evaluate them on the worker "
+		 "threads."));
+
+namespace ACFParallel
+{
+// Weight of the last measurement in the moving average of the cost.
+static const double CostSmoothing = 0.1;
+
+struct FArgument
+{
+	const FProperty* Param = nullptr;
+	FName Variable;
+	// Property of the variable in the class of the last object.
+	const FProperty* VariableProperty = nullptr;
+	bool bConvertFloatingPoint = false;
+};
+
+struct FCall
+{
+	UFunction* Function = nullptr;
+	UObject* Context = nullptr;
+	const FBoolProperty* ReturnProperty = nullptr;
+	TArray<FArgument> Arguments;
+	// Parameters with the literal arguments set.
+	uint8* Defaults = nullptr;
+
+	FCall() = default;
+	FCall(const FCall&) = delete;
+	FCall& operator=(const FCall&) = delete;
+	~FCall()
+	{
+		if (Defaults != nullptr)
+		{
+			Function->DestroyStruct(Defaults);
+			FMemory::Free(Defaults);
+		}
+	}
+};
+
+struct FConditions
+{
+	TArray<FCall> Calls;
+	// Weak, so that the class allocated at the address of the collected class is resolved again.
+	TWeakObjectPtr<const UClass> ResolvedClass;
+	// Moving average of the total cost of the calls in seconds.
+	double Cost = 0.0;
+};
+
+static TMap<FName, TSharedPtr<FConditions>> ConditionsCache;
+
+static FString Unescape(const FString& Escaped)
+{
+	FString Literal;
+	for (int32 Index = 0; Index < Escaped.Len(); ++Index)
+	{
+		if ((Escaped[Index] == TEXT('%')) && (Index + 2 < Escaped.Len()))
+		{
+			Literal.AppendChar(static_cast<TCHAR>(FParse::HexNumber(*Escaped.Mid(Index + 1, 2))));
+			Index += 2;
+		}
+		else if ((Escaped[Index] == TEXT('^')) && (Index + 1 < Escaped.Len()))
+		{
+			++Index;
+			Literal.AppendChar((Escaped[Index] == TEXT('^')) ? Escaped[Index] : FChar::ToUpper(Escaped[Index]));
+		}
+		else
+		{
+			Literal.AppendChar(Escaped[Index]);
+		}
+	}
+	return Literal;
+}
+
+static void SetLiteral(const FProperty* Param, void* Data, const FString& Literal)
+{
+	const FByteProperty* ByteProperty = CastField<FByteProperty>(Param);
+	const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Param);
+	if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Param))
+	{
+		BoolProperty->SetPropertyValue(Data, Literal.ToBool());
+	}
+	else if (EnumProperty != nullptr)
+	{
+		EnumProperty->GetUnderlyingProperty()->SetIntPropertyValue(Data, EnumProperty->GetEnum()->GetValueByNameString(Literal));
+	}
+	else if ((ByteProperty != nullptr) && (ByteProperty->Enum != nullptr))
+	{
+		ByteProperty->SetIntPropertyValue(Data, ByteProperty->Enum->GetValueByNameString(Literal));
+	}
+	else if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Param))
+	{
+		NumericProperty->SetNumericPropertyValueFromString(Data, *Literal);
+	}
+	else if (const FNameProperty* NameProperty = CastField<FNameProperty>(Param))
+	{
+		NameProperty->SetPropertyValue(Data, FName(*Literal));
+	}
+	else if (const FStrProperty* StrProperty = CastField<FStrProperty>(Param))
+	{
+		StrProperty->SetPropertyValue(Data, Literal);
+	}
+}
+
+static TSharedPtr<FConditions> ParseConditions(FName ConditionsName)
+{
+	FString Key;
+	FString CallList;
+	ConditionsName.ToString().Split(TEXT(";"), &Key, &CallList);
+	TArray<FString> CallStrings;
+	CallList.ParseIntoArray(CallStrings, TEXT("|"));
+
+	TSharedPtr<FConditions> Conditions = MakeShared<FConditions>();
+	Conditions->Calls.Reserve(CallStrings.Num());
+	for (auto& CallString : CallStrings)
+	{
+		TArray<FString> Tokens;
+		CallString.ParseIntoArray(Tokens, TEXT(","), false);
+
+		FCall& Call = Conditions->Calls.Emplace_GetRef();
+		Call.Function = FindObject<UFunction>(nullptr, *Tokens[0]);
+		Call.ReturnProperty = (Call.Function != nullptr) ? CastField<FBoolProperty>(Call.Function->GetReturnProperty()) : nullptr;
+		if (Call.ReturnProperty == nullptr)
+		{
+			// The call is taken as false.
+			Call.Function = nullptr;
+			continue;
+		}
+		Call.Context = Call.Function->GetOwnerClass()->GetDefaultObject();
+		Call.Defaults = static_cast<uint8*>(FMemory::Malloc(Call.Function->ParmsSize, Call.Function->GetMinAlignment()));
+		FMemory::Memzero(Call.Defaults, Call.Function->ParmsSize);
+		Call.Function->InitializeStruct(Call.Defaults);
+
+		for (int32 Index = 1; Index < Tokens.Num(); ++Index)
+		{
+			FString ParamName;
+			FString Value;
+			Tokens[Index].Split(TEXT("="), &ParamName, &Value);
+			const FProperty* Param = FindFProperty<FProperty>(Call.Function, *ParamName);
+			if (Param == nullptr)
+			{
+				continue;
+			}
+
+			if (Value.StartsWith(TEXT("@")))
+			{
+				FArgument& Argument = Call.Arguments.AddDefaulted_GetRef();
+				Argument.Param = Param;
+				Argument.Variable = FName(*Value.RightChop(1));
+			}
+			else
+			{
+				SetLiteral(Param, Param->ContainerPtrToValuePtr<void>(Call.Defaults), Unescape(Value));
+			}
+		}
+	}
+
+	return Conditions;
+}
+
+// The variables are resolved on the game thread before the calls are dispatched.
+static void ResolveVariables(FConditions& Conditions, const UClass* Class)
+{
+	if (Conditions.ResolvedClass.Get() == Class)
+	{
+		return;
+	}
+
+	for (auto& Call : Conditions.Calls)
+	{
+		for (auto& Argument : Call.Arguments)
+		{
+			const FProperty* Variable = FindFProperty<FProperty>(Class, Argument.Variable);
+			const FNumericProperty* NumericParam = CastField<FNumericProperty>(Argument.Param);
+			const FNumericProperty* NumericVariable = CastField<FNumericProperty>(Variable);
+			Argument.bConvertFloatingPoint = (NumericParam != nullptr) && (NumericVariable != nullptr) &&
+											 NumericParam->IsFloatingPoint() && NumericVariable->IsFloatingPoint() &&
+											 !Argument.Param->SameType(Variable);
+			const bool bValid = (Variable != nullptr) && (Argument.bConvertFloatingPoint || Argument.Param->SameType(Variable));
+			Argument.VariableProperty = bValid ? Variable : nullptr;
+		}
+	}
+	Conditions.ResolvedClass = Class;
+}
+
+static bool InvokeCall(const FCall& Call, const UObject* Object)
+{
+	UFunction* Function = Call.Function;
+	if (Function == nullptr)
+	{
+		return false;
+	}
+
+	uint8* Params = static_cast<uint8*>(FMemory_Alloca_Aligned(Function->ParmsSize, Function->GetMinAlignment()));
+	FMemory::Memzero(Params, Function->ParmsSize);
+	Function->InitializeStruct(Params);
+	for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+	{
+		It->CopyCompleteValue_InContainer(Params, Call.Defaults);
+	}
+	for (auto& Argument : Call.Arguments)
+	{
+		if (Argument.VariableProperty == nullptr)
+		{
+			continue;
+		}
+
+		const void* Source = Argument.VariableProperty->ContainerPtrToValuePtr<void>(Object);
+		void* Dest = Argument.Param->ContainerPtrToValuePtr<void>(Params);
+		if (Argument.bConvertFloatingPoint)
+		{
+			CastField<FNumericProperty>(Argument.Param)
+				->SetFloatingPointPropertyValue(
+					Dest, CastField<FNumericProperty>(Argument.VariableProperty)->GetFloatingPointPropertyValue(Source));
+		}
+		else
+		{
+			Argument.Param->CopySingleValue(Dest, Source);
+		}
+	}
+
+	// Call the native function directly as ProcessEvent does, without the checks which assume the game thread.
+	FFrame Stack(Call.Context, Function, Params, nullptr, Function->ChildProperties);
+	Function->Invoke(Call.Context, Stack, Params + Function->ReturnValueOffset);
+	const bool bResult = Call.ReturnProperty->GetPropertyValue_InContainer(Params);
+	Function->DestroyStruct(Params);
+
+	return bResult;
+}
+
+static FConditions& FindConditions(FName ConditionsName)
+{
+	static bool bCacheInvalidationBound = false;
+	if (!bCacheInvalidationBound)
+	{
+		// The functions are replaced by the hot reload, and the variables are replaced by the Blueprint recompile.
+		FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([](EReloadCompleteReason) { ConditionsCache.Reset(); });
+#if WITH_EDITOR
+		FCoreUObjectDelegates::OnObjectsReplaced.AddLambda([](const TMap<UObject*, UObject*>&) { ConditionsCache.Reset(); });
+#endif
+		bCacheInvalidationBound = true;
+	}
+
+	TSharedPtr<FConditions>& Conditions = ConditionsCache.FindOrAdd(ConditionsName);
+	if (!Conditions.IsValid())
+	{
+		Conditions = ParseConditions(ConditionsName);
+	}
+	return *Conditions;
+}
+
+// Evaluates the calls into OutResults. bFirstTrue stops the serial evaluation at the first true condition.
+static void Evaluate(
+	FConditions& Conditions, const UObject* Object, bool bFirstTrue, TArray<bool, TInlineAllocator<64>>& OutResults)
+{
+	check(IsInGameThread());
+
+	ResolveVariables(Conditions, Object->GetClass());
+
+	const int32 NumCalls = Conditions.Calls.Num();
+	OutResults.Init(false, NumCalls);
+
+	double Cost = 0.0;
+	if ((NumCalls >= 2) && (Conditions.Cost * 1000000.0 >= GACFParallelMinCostMicroseconds))
+	{
+		TArray<uint64, TInlineAllocator<64>> Cycles;
+		Cycles.Init(0, NumCalls);
+		ParallelFor(NumCalls,
+			[&Conditions, Object, &OutResults, &Cycles](int32 Index)
+			{
+				const uint64 StartCycles = FPlatformTime::Cycles64();
+				OutResults[Index] = InvokeCall(Conditions.Calls[Index], Object);
+				Cycles[Index] = FPlatformTime::Cycles64() - StartCycles;
+			});
+
+		// The cost is the sum of the calls, so that the node keeps the parallel evaluation only while the calls are expensive.
+		for (uint64 CallCycles : Cycles)
+		{
+			Cost += FPlatformTime::ToSeconds64(CallCycles);
+		}
+	}
+	else
+	{
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		for (int32 Index = 0; Index < NumCalls; ++Index)
+		{
+			OutResults[Index] = InvokeCall(Conditions.Calls[Index], Object);
+			if (bFirstTrue && OutResults[Index])
+			{
+				break;
+			}
+		}
+		Cost = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+	}
+
+	Conditions.Cost += (Cost - Conditions.Cost) * CostSmoothing;
+}
+}  // namespace ACFParallel
+
+int32 UACFParallelLibrary::FindFirstTrueParallelCondition(UObject* Object, FName Conditions)
+{
+	if (Object == nullptr)
+	{
+		return INDEX_NONE;
+	}
+
+	TArray<bool, TInlineAllocator<64>> Results;
+	ACFParallel::Evaluate(ACFParallel::FindConditions(Conditions), Object, true, Results);
+
+	return Results.IndexOfByKey(true);
+}
+
+int64 UACFParallelLibrary::EvaluateParallelConditions(UObject* Object, FName Conditions)
+{
+	if (Object == nullptr)
+	{
+		return 0;
+	}
+
+	TArray<bool, TInlineAllocator<64>> Results;
+	ACFParallel::Evaluate(ACFParallel::FindConditions(Conditions), Object, false, Results);
+
+	int64 Bits = 0;
+	for (int32 Index = 0; Index < FMath::Min(Results.Num(), 64); ++Index)
+	{
+		Bits |= Results[Index] ? (int64(1) << Index) : 0;
+	}
+	return Bits;
+}
+
+bool UACFParallelLibrary::IsParallelConditionTrue(int64 Results, int32 Index)
+{
+	return (Index >= 0) && (Index < 64) && ((Results >> Index) & 1);
+}
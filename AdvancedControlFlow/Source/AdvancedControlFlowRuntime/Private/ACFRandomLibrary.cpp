@@ -0,0 +1,142 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "ACFRandomLibrary.h"
+
+#include "Hash/CityHash.h"
+#include "Misc/ScopeRWLock.h"
+
+namespace ACFRandom
+{
+// Tables of the literal weights and of the nodes with the dynamic weights.
+static TMap<FName, FAliasTable> LiteralTables;
+static TMap<int64, FAliasTable> NodeTables;
+static FRWLock TablesLock;
+
+void FAliasTable::Build(TArrayView<const float> InWeights)
+{
+	const int32 Num = InWeights.Num();
+	Weights.Reset(Num);
+	Weights.Append(InWeights.GetData(), Num);
+	Probabilities.Reset();
+	Aliases.Reset();
+
+	double Sum = 0.0;
+	int32 MaxIndex = INDEX_NONE;
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		if (InWeights[Index] > 0.0f)
+		{
+			Sum += InWeights[Index];
+			MaxIndex = ((MaxIndex == INDEX_NONE) || (InWeights[Index] > InWeights[MaxIndex])) ? Index : MaxIndex;
+		}
+	}
+	if (MaxIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	// Scale the weights so that the average is 1, and pair each small case with a large case.
+	TArray<double, TInlineAllocator<64>> Scaled;
+	TArray<int32, TInlineAllocator<64>> Small;
+	TArray<int32, TInlineAllocator<64>> Large;
+	Probabilities.SetNumZeroed(Num);
+	Aliases.Init(MaxIndex, Num);
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		Scaled.Add(FMath::Max(InWeights[Index], 0.0f) * Num / Sum);
+		(Scaled[Index] < 1.0 ? Small : Large).Add(Index);
+	}
+	while ((Small.Num() > 0) && (Large.Num() > 0))
+	{
+		const int32 SmallIndex = Small.Pop(false);
+		const int32 LargeIndex = Large.Pop(false);
+		Probabilities[SmallIndex] = static_cast<float>(Scaled[SmallIndex]);
+		Aliases[SmallIndex] = LargeIndex;
+		Scaled[LargeIndex] = (Scaled[LargeIndex] + Scaled[SmallIndex]) - 1.0;
+		(Scaled[LargeIndex] < 1.0 ? Small : Large).Add(LargeIndex);
+	}
+
+	// The rest are 1 except for the rounding errors. The cases without weight keep the alias to the heaviest case.
+	for (int32 Index : Large)
+	{
+		Probabilities[Index] = 1.0f;
+	}
+	for (int32 Index : Small)
+	{
+		Probabilities[Index] = (InWeights[Index] > 0.0f) ? 1.0f : 0.0f;
+	}
+}
+
+int32 FAliasTable::Sample(const FRandomStream* Stream) const
+{
+	const int32 Num = Probabilities.Num();
+	if (Num == 0)
+	{
+		return Weights.Num();
+	}
+
+	const int32 Index = (Stream != nullptr) ? Stream->RandHelper(Num) : FMath::RandHelper(Num);
+	const float Fraction = (Stream != nullptr) ? Stream->GetFraction() : FMath::FRand();
+
+	return (Fraction < Probabilities[Index]) ? Index : Aliases[Index];
+}
+
+int64 MakeTableKey(const FString& NodeKey)
+{
+	FTCHARToUTF8 Converted(*NodeKey);
+
+	return static_cast<int64>(CityHash64(Converted.Get(), Converted.Length()));
+}
+}  // namespace ACFRandom
+
+int32 UACFRandomLibrary::SampleLiteralWeights(FName Weights, const FRandomStream& Stream, bool bUseStream)
+{
+	const FRandomStream* StreamToUse = bUseStream ? &Stream : nullptr;
+	{
+		FReadScopeLock ReadLock(ACFRandom::TablesLock);
+		if (const ACFRandom::FAliasTable* Table = ACFRandom::LiteralTables.Find(Weights))
+		{
+			return Table->Sample(StreamToUse);
+		}
+	}
+
+	TArray<FString> Literals;
+	Weights.ToString().ParseIntoArray(Literals, TEXT(","));
+	TArray<float> Values;
+	for (const FString& Literal : Literals)
+	{
+		Values.Add(FCString::Atof(*Literal));
+	}
+
+	FWriteScopeLock WriteLock(ACFRandom::TablesLock);
+	ACFRandom::FAliasTable& Table = ACFRandom::LiteralTables.FindOrAdd(Weights);
+	Table.Build(Values);
+
+	return Table.Sample(StreamToUse);
+}
+
+int32 UACFRandomLibrary::SampleWeights(int64 TableKey, const TArray<float>& Weights, const FRandomStream& Stream, bool bUseStream)
+{
+	const FRandomStream* StreamToUse = bUseStream ? &Stream : nullptr;
+	{
+		FReadScopeLock ReadLock(ACFRandom::TablesLock);
+		const ACFRandom::FAliasTable* Table = ACFRandom::NodeTables.Find(TableKey);
+		if ((Table != nullptr) && (Table->Weights == Weights))
+		{
+			return Table->Sample(StreamToUse);
+		}
+	}
+
+	FWriteScopeLock WriteLock(ACFRandom::TablesLock);
+	ACFRandom::FAliasTable& Table = ACFRandom::NodeTables.FindOrAdd(TableKey);
+	Table.Build(Weights);
+
+	return Table.Sample(StreamToUse);
+}
@@ -0,0 +1,105 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "ACFRangeLibrary.h"
+
+#include "Algo/BinarySearch.h"
+#include "Misc/ScopeRWLock.h"
+
+namespace ACFRange
+{
+struct FLiteralBounds
+{
+	TCHAR Type = TEXT('i');
+	TArray<double> Bounds;
+};
+
+static TMap<FName, FLiteralBounds> LiteralBounds;
+static FRWLock LiteralBoundsLock;
+
+static void ParseLiteralBounds(FName Literal, FLiteralBounds& OutBounds)
+{
+	FString TypeString;
+	FString BoundsString;
+	if (!Literal.ToString().Split(TEXT(":"), &TypeString, &BoundsString) || (TypeString.Len() != 1))
+	{
+		return;
+	}
+	OutBounds.Type = TypeString[0];
+
+	// Float bounds are rounded to float, so that they are compared as the Blueprint literals of float are.
+	TArray<FString> Literals;
+	BoundsString.ParseIntoArray(Literals, TEXT(","));
+	for (const FString& Bound : Literals)
+	{
+		const double Value = FCString::Atod(*Bound);
+		OutBounds.Bounds.Add((OutBounds.Type == TEXT('f')) ? static_cast<float>(Value) : Value);
+	}
+}
+
+static double ToDouble(TCHAR Type, const void* Value)
+{
+	switch (Type)
+	{
+		case TEXT('f'):
+			return *static_cast<const float*>(Value);
+		case TEXT('d'):
+			return *static_cast<const double*>(Value);
+		default:
+			return *static_cast<const int32*>(Value);
+	}
+}
+
+int32 FindRange(TArrayView<const double> Bounds, double Value)
+{
+	// NaN is never less than the bounds, so it falls into the last range.
+	return Algo::UpperBound(Bounds, Value);
+}
+}  // namespace ACFRange
+
+int32 UACFRangeLibrary::FindLiteralRange(FName Bounds, const int32& Value)
+{
+	// Only called from Blueprint through the custom thunk.
+	check(0);
+	return INDEX_NONE;
+}
+
+DEFINE_FUNCTION(UACFRangeLibrary::execFindLiteralRange)
+{
+	P_GET_PROPERTY(FNameProperty, Bounds);
+
+	// The value is copied to the storage whether it is a literal or a variable.
+	alignas(double) uint8 ValueStorage[sizeof(double)] = {};
+	Stack.MostRecentProperty = nullptr;
+	Stack.MostRecentPropertyAddress = nullptr;
+	Stack.StepCompiledIn<FProperty>(ValueStorage);
+
+	P_FINISH;
+
+	P_NATIVE_BEGIN;
+	int32 Result = INDEX_NONE;
+	{
+		FReadScopeLock ReadLock(ACFRange::LiteralBoundsLock);
+		if (const ACFRange::FLiteralBounds* Literal = ACFRange::LiteralBounds.Find(Bounds))
+		{
+			Result = ACFRange::FindRange(Literal->Bounds, ACFRange::ToDouble(Literal->Type, ValueStorage));
+		}
+	}
+	if (Result == INDEX_NONE)
+	{
+		ACFRange::FLiteralBounds Parsed;
+		ACFRange::ParseLiteralBounds(Bounds, Parsed);
+		Result = ACFRange::FindRange(Parsed.Bounds, ACFRange::ToDouble(Parsed.Type, ValueStorage));
+
+		FWriteScopeLock WriteLock(ACFRange::LiteralBoundsLock);
+		ACFRange::LiteralBounds.Add(Bounds, MoveTemp(Parsed));
+	}
+	*static_cast<int32*>(RESULT_PARAM) = Result;
+	P_NATIVE_END;
+}
@@ -0,0 +1,164 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "ACFReactiveLibrary.h"
+
+#include "Misc/EngineVersionComparison.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UObjectGlobals.h"
+
+#if !UE_VERSION_OLDER_THAN(5, 1, 0)
+#include "INotifyFieldValueChanged.h"
+#endif
+
+namespace ACFReactive
+{
+struct FSource
+{
+	// nullptr for the literal condition.
+	const FBoolProperty* Property = nullptr;
+	// The bound property is read only when its notification comes. The others are compared with the last value.
+	bool bBound = false;
+	bool bLastValue = false;
+};
+
+struct FCase
+{
+	TArray<FSource> Sources;
+	// Indices of the sources which are compared with the last value on every call.
+	TArray<int32> PolledSources;
+	int32 CaseIndex = INDEX_NONE;
+	bool bDirty = true;
+};
+
+// Cases of each object and node, which are accessed on the game thread.
+static TMap<TPair<FObjectKey, FName>, FCase> Cases;
+
+static void PurgeCases()
+{
+	for (auto It = Cases.CreateIterator(); It; ++It)
+	{
+		if (It->Key.Key.ResolveObjectPtr() == nullptr)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+#if !UE_VERSION_OLDER_THAN(5, 1, 0)
+static void OnFieldValueChanged(UObject* Object, UE::FieldNotification::FFieldId FieldId, FName Sources)
+{
+	if (FCase* Case = Cases.Find(TPair<FObjectKey, FName>(FObjectKey(Object), Sources)))
+	{
+		Case->bDirty = true;
+	}
+}
+#endif
+
+static void InitCase(FCase& Case, UObject* Object, FName Sources)
+{
+	FString Key;
+	FString SourceList;
+	Sources.ToString().Split(TEXT(";"), &Key, &SourceList);
+	TArray<FString> Fields;
+	SourceList.ParseIntoArray(Fields, TEXT(","), false);
+
+	for (auto& Field : Fields)
+	{
+		FSource& Source = Case.Sources.AddDefaulted_GetRef();
+		if (Field.StartsWith(TEXT("=")))
+		{
+			Source.bLastValue = Field == TEXT("=1");
+			continue;
+		}
+
+		const FName FieldName(*Field);
+		Source.Property = FindFProperty<FBoolProperty>(Object->GetClass(), FieldName);
+		// The compiler reports the property which is not found, so this is reached only by the stale bytecode.
+		if (!ensureMsgf(Source.Property != nullptr, TEXT("Property %s is not found in %s"), *Field, *Object->GetClass()->GetName()))
+		{
+			continue;
+		}
+
+#if !UE_VERSION_OLDER_THAN(5, 1, 0)
+		if (INotifyFieldValueChanged* Notifier = Cast<INotifyFieldValueChanged>(Object))
+		{
+			const UE::FieldNotification::FFieldId FieldId =
+				Notifier->GetFieldNotificationDescriptor().GetField(Object->GetClass(), FieldName);
+			if (FieldId.IsValid())
+			{
+				Notifier->AddFieldValueChangedDelegate(
+					FieldId, INotifyFieldValueChanged::FFieldValueChangedDelegate::CreateStatic(&OnFieldValueChanged, Sources));
+				Source.bBound = true;
+			}
+		}
+#endif
+		if (!Source.bBound)
+		{
+			Case.PolledSources.Add(Case.Sources.Num() - 1);
+		}
+	}
+}
+}  // namespace ACFReactive
+
+int32 UACFReactiveLibrary::FindFirstTrueReactiveCondition(UObject* Object, FName Sources)
+{
+	check(IsInGameThread());
+
+	if (Object == nullptr)
+	{
+		return INDEX_NONE;
+	}
+
+	static bool bPurgeBound = false;
+	if (!bPurgeBound)
+	{
+		FCoreUObjectDelegates::GetPostGarbageCollect().AddStatic(&ACFReactive::PurgeCases);
+		bPurgeBound = true;
+	}
+
+	const TPair<FObjectKey, FName> Key(FObjectKey(Object), Sources);
+	ACFReactive::FCase* Case = ACFReactive::Cases.Find(Key);
+	if (Case == nullptr)
+	{
+		Case = &ACFReactive::Cases.Add(Key);
+		ACFReactive::InitCase(*Case, Object, Sources);
+	}
+
+	// The properties which cannot be observed are tested for the change on every call. The others are not read at all
+	// until their notification comes.
+	for (int32 SourceIndex : Case->PolledSources)
+	{
+		ACFReactive::FSource& Source = Case->Sources[SourceIndex];
+		const bool bValue = Source.Property->GetPropertyValue_InContainer(Object);
+		Case->bDirty |= (bValue != Source.bLastValue);
+		Source.bLastValue = bValue;
+	}
+
+	if (Case->bDirty)
+	{
+		Case->CaseIndex = INDEX_NONE;
+		for (int32 Index = 0; Index < Case->Sources.Num(); ++Index)
+		{
+			ACFReactive::FSource& Source = Case->Sources[Index];
+			if (Source.bBound)
+			{
+				Source.bLastValue = Source.Property->GetPropertyValue_InContainer(Object);
+			}
+			if (Source.bLastValue)
+			{
+				Case->CaseIndex = Index;
+				break;
+			}
+		}
+		Case->bDirty = false;
+	}
+
+	return Case->CaseIndex;
+}
@@ -0,0 +1,305 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "ACFSwitchLibrary.h"
+
+#include "Misc/ScopeRWLock.h"
+
+namespace ACFSwitch
+{
+static TMap<FName, FKeyTable> LiteralTables;
+static FRWLock TablesLock;
+
+// Tries of the displacement per bucket before falling back to the linear search.
+static const uint32 MaxDisplacementTries = 1 << 16;
+
+static uint64 HashName(FName Name)
+{
+	// The name is identified by the comparison index and the number, so the hash never collides.
+	return (static_cast<uint64>(Name.GetComparisonIndex().ToUnstableInt()) << 32) | static_cast<uint32>(Name.GetNumber());
+}
+
+static uint64 HashString(const FString& String, bool bCaseSensitive)
+{
+	// FNV-1a, lowering the characters on the fly not to allocate the lower case string.
+	uint64 Hash = 0xcbf29ce484222325ull;
+	for (TCHAR Char : String)
+	{
+		Hash = (Hash ^ static_cast<uint64>(bCaseSensitive ? Char : FChar::ToLower(Char))) * 0x100000001b3ull;
+	}
+
+	return Hash;
+}
+
+static uint64 Mix(uint64 Hash, uint32 Displacement)
+{
+	// Finalizer of MurmurHash3.
+	Hash += Displacement * 0x9e3779b97f4a7c15ull;
+	Hash = (Hash ^ (Hash >> 33)) * 0xff51afd7ed558ccdull;
+	Hash = (Hash ^ (Hash >> 33)) * 0xc4ceb9fe1a85ec53ull;
+
+	return Hash ^ (Hash >> 33);
+}
+
+static TCHAR GetTypeChar(EKeyType Type)
+{
+	switch (Type)
+	{
+		case EKeyType::String:
+			return TEXT('s');
+		case EKeyType::StringCaseSensitive:
+			return TEXT('c');
+		default:
+			return TEXT('n');
+	}
+}
+
+void FKeyTable::Build(EKeyType InType, TArrayView<const FString> Keys)
+{
+	Type = InType;
+	Names.Reset();
+	Strings.Reset();
+	Hashes.Reset();
+	Displacements.Reset();
+	Slots.Reset();
+
+	for (const FString& Key : Keys)
+	{
+		if (Type == EKeyType::Name)
+		{
+			Names.Add(FName(*Key));
+			Hashes.Add(HashName(Names.Last()));
+		}
+		else
+		{
+			Strings.Add(Key);
+			Hashes.Add(HashString(Key, Type == EKeyType::StringCaseSensitive));
+		}
+	}
+
+	// Hash and displace: the keys are distributed to the buckets, and the displacement of each bucket is searched
+	// so that the keys of the bucket move to the empty slots. The larger buckets are placed first.
+	const int32 Num = Hashes.Num();
+	const int32 NumBuckets = FMath::Max((Num + 1) / 2, 1);
+	const int32 NumSlots = FMath::Max(Num + Num / 4, 1);
+	TArray<TArray<int32>> Buckets;
+	Buckets.SetNum(NumBuckets);
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		Buckets[Hashes[Index] % NumBuckets].Add(Index);
+	}
+	TArray<int32> BucketOrder;
+	for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+	{
+		BucketOrder.Add(Bucket);
+	}
+	BucketOrder.Sort([&Buckets](int32 A, int32 B) { return Buckets[A].Num() > Buckets[B].Num(); });
+
+	Displacements.Init(0, NumBuckets);
+	Slots.Init(INDEX_NONE, NumSlots);
+	TArray<int32, TInlineAllocator<16>> BucketSlots;
+	for (int32 Bucket : BucketOrder)
+	{
+		bool bPlaced = Buckets[Bucket].Num() == 0;
+		for (uint32 Displacement = 0; !bPlaced && (Displacement < MaxDisplacementTries); ++Displacement)
+		{
+			BucketSlots.Reset();
+			bPlaced = true;
+			for (int32 Index : Buckets[Bucket])
+			{
+				const int32 Slot = static_cast<int32>(Mix(Hashes[Index], Displacement) % NumSlots);
+				if ((Slots[Slot] != INDEX_NONE) || BucketSlots.Contains(Slot))
+				{
+					bPlaced = false;
+					break;
+				}
+				BucketSlots.Add(Slot);
+			}
+			if (bPlaced)
+			{
+				Displacements[Bucket] = Displacement;
+				for (int32 Order = 0; Order < BucketSlots.Num(); ++Order)
+				{
+					Slots[BucketSlots[Order]] = Buckets[Bucket][Order];
+				}
+			}
+		}
+
+		if (!bPlaced)
+		{
+			// The duplicated keys or the hash collision.
+			Displacements.Reset();
+			Slots.Reset();
+			return;
+		}
+	}
+}
+
+int32 FKeyTable::FindIndex(uint64 Hash) const
+{
+	const uint32 Displacement = Displacements[Hash % Displacements.Num()];
+
+	return Slots[Mix(Hash, Displacement) % Slots.Num()];
+}
+
+int32 FKeyTable::FindName(FName Key) const
+{
+	if (Slots.Num() == 0)
+	{
+		return Names.IndexOfByKey(Key);
+	}
+
+	const int32 Index = FindIndex(HashName(Key));
+
+	return ((Index != INDEX_NONE) && (Names[Index] == Key)) ? Index : INDEX_NONE;
+}
+
+int32 FKeyTable::FindString(const FString& Key) const
+{
+	const ESearchCase::Type SearchCase =
+		(Type == EKeyType::StringCaseSensitive) ? ESearchCase::CaseSensitive : ESearchCase::IgnoreCase;
+	if (Slots.Num() == 0)
+	{
+		return Strings.IndexOfByPredicate([&Key, SearchCase](const FString& String) { return String.Equals(Key, SearchCase); });
+	}
+
+	const int32 Index = FindIndex(HashString(Key, Type == EKeyType::StringCaseSensitive));
+
+	return ((Index != INDEX_NONE) && Strings[Index].Equals(Key, SearchCase)) ? Index : INDEX_NONE;
+}
+
+FString EncodeKeys(EKeyType Type, TArrayView<const FString> Keys)
+{
+	// Each key is prefixed by its length, so that the keys can contain any character.
+	FString Encoded;
+	Encoded.AppendChar(GetTypeChar(Type));
+	for (const FString& Key : Keys)
+	{
+		FString Escaped;
+		for (TCHAR Char : Key)
+		{
+			const TCHAR Lower = FChar::ToLower(Char);
+			if ((Char == TEXT('^')) || (Char != Lower))
+			{
+				Escaped.AppendChar(TEXT('^'));
+			}
+			Escaped.AppendChar(Lower);
+		}
+		Encoded += FString::Printf(TEXT("%d:%s"), Escaped.Len(), *Escaped);
+	}
+
+	return (Encoded.Len() < NAME_SIZE) ? Encoded : FString();
+}
+
+bool DecodeKeys(const FString& Encoded, EKeyType& OutType, TArray<FString>& OutKeys)
+{
+	if (Encoded.Len() == 0)
+	{
+		return false;
+	}
+	switch (Encoded[0])
+	{
+		case TEXT('n'):
+			OutType = EKeyType::Name;
+			break;
+		case TEXT('s'):
+			OutType = EKeyType::String;
+			break;
+		case TEXT('c'):
+			OutType = EKeyType::StringCaseSensitive;
+			break;
+		default:
+			return false;
+	}
+
+	OutKeys.Reset();
+	int32 Position = 1;
+	while (Position < Encoded.Len())
+	{
+		const int32 Colon = Encoded.Find(TEXT(":"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Position);
+		if (Colon == INDEX_NONE)
+		{
+			return false;
+		}
+		const int32 Length = FCString::Atoi(*Encoded.Mid(Position, Colon - Position));
+		const FString Escaped = Encoded.Mid(Colon + 1, Length);
+		Position = Colon + 1 + Length;
+
+		FString Key;
+		for (int32 Index = 0; Index < Escaped.Len(); ++Index)
+		{
+			if ((Escaped[Index] == TEXT('^')) && (Index + 1 < Escaped.Len()))
+			{
+				++Index;
+				Key.AppendChar((Escaped[Index] == TEXT('^')) ? Escaped[Index] : FChar::ToUpper(Escaped[Index]));
+			}
+			else
+			{
+				Key.AppendChar(Escaped[Index]);
+			}
+		}
+		OutKeys.Add(Key);
+	}
+
+	return true;
+}
+
+// Finds the key in the table of the literal keys. The table is built on the first call.
+template <typename FindFunc>
+static int32 FindInLiteralTable(FName Keys, FindFunc Find)
+{
+	{
+		FReadScopeLock ReadLock(TablesLock);
+		if (const FKeyTable* Table = LiteralTables.Find(Keys))
+		{
+			return Find(*Table);
+		}
+	}
+
+	EKeyType Type = EKeyType::Name;
+	TArray<FString> DecodedKeys;
+	FKeyTable Table;
+	if (DecodeKeys(Keys.ToString(), Type, DecodedKeys))
+	{
+		Table.Build(Type, DecodedKeys);
+	}
+	const int32 Index = Find(Table);
+
+	FWriteScopeLock WriteLock(TablesLock);
+	LiteralTables.Add(Keys, MoveTemp(Table));
+
+	return Index;
+}
+}  // namespace ACFSwitch
+
+int32 UACFSwitchLibrary::FindNameCase(FName Keys, FName Selection)
+{
+	return ACFSwitch::FindInLiteralTable(
+		Keys, [Selection](const ACFSwitch::FKeyTable& Table) { return Table.FindName(Selection); });
+}
+
+int32 UACFSwitchLibrary::FindStringCase(FName Keys, const FString& Selection)
+{
+	// Only called from Blueprint through the custom thunk.
+	check(0);
+	return INDEX_NONE;
+}
+
+DEFINE_FUNCTION(UACFSwitchLibrary::execFindStringCase)
+{
+	P_GET_PROPERTY(FNameProperty, Keys);
+	P_GET_PROPERTY_REF(FStrProperty, Selection);
+
+	P_FINISH;
+
+	P_NATIVE_BEGIN;
+	*static_cast<int32*>(RESULT_PARAM) = ACFSwitch::FindInLiteralTable(
+		Keys, [&Selection](const ACFSwitch::FKeyTable& Table) { return Table.FindString(Selection); });
+	P_NATIVE_END;
+}
@@ -0,0 +1,44 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "ACFThrottleLibrary.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+bool UACFThrottleLibrary::RefreshThrottledCase(
+	const UObject* WorldContextObject, FACFThrottleState& State, float Interval, bool bFrames, bool bForceRefresh)
+{
+	double Now = static_cast<double>(GFrameCounter);
+	if (!bFrames)
+	{
+		const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+		Now = (World != nullptr) ? World->GetTimeSeconds() : FPlatformTime::Seconds();
+	}
+
+	const bool bFirstRefresh = State.NextRefresh < 0.0;
+	if (!bForceRefresh && !bFirstRefresh && (Now < State.NextRefresh))
+	{
+		return false;
+	}
+
+	State.NextRefresh = Now + (bFirstRefresh ? Interval * FMath::FRand() : Interval);
+
+	return true;
+}
+
+void UACFThrottleLibrary::SetThrottledCase(FACFThrottleState& State, int32 CaseIndex)
+{
+	State.CaseIndex = CaseIndex;
+}
+
+int32 UACFThrottleLibrary::GetThrottledCase(const FACFThrottleState& State)
+{
+	return State.CaseIndex;
+}
@@ -0,0 +1,169 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "ACFTrace.h"
+
+#if ACF_TRACE_ENABLED
+
+#include "Misc/Paths.h"
+#include "Misc/ScopeRWLock.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+UE_TRACE_CHANNEL_DEFINE(ACFChannel)
+
+UE_TRACE_EVENT_BEGIN(ACF, NodeSpec, NoSync | Important)
+	UE_TRACE_EVENT_FIELD(uint64, NodeId)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Blueprint)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Graph)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, NodeGuid)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(ACF, NodeEvaluation)
+	UE_TRACE_EVENT_FIELD(uint64, NodeId)
+	UE_TRACE_EVENT_FIELD(uint64, StartCycle)
+	UE_TRACE_EVENT_FIELD(uint64, EndCycle)
+	UE_TRACE_EVENT_FIELD(int32, CaseIndex)
+	UE_TRACE_EVENT_FIELD(int32, NumConditions)
+UE_TRACE_EVENT_END()
+
+namespace ACFTrace
+{
+static FRWLock NodeSpecsLock;
+// Node ID to the CPU profiler scope ID.
+static TMap<uint64, uint32> NodeSpecs;
+
+static uint64 GetNodeId(FName Blueprint, FName Graph, FName NodeGuid)
+{
+	return (static_cast<uint64>(HashCombine(GetTypeHash(Blueprint), GetTypeHash(Graph))) << 32) | GetTypeHash(NodeGuid);
+}
+
+static uint32 FindOrAddNodeSpec(uint64 NodeId, FName Blueprint, FName Graph, FName NodeGuid)
+{
+	{
+		FReadScopeLock Lock(NodeSpecsLock);
+		if (const uint32* SpecId = NodeSpecs.Find(NodeId))
+		{
+			return *SpecId;
+		}
+	}
+
+	FWriteScopeLock Lock(NodeSpecsLock);
+	if (const uint32* SpecId = NodeSpecs.Find(NodeId))
+	{
+		return *SpecId;
+	}
+
+	const FString BlueprintString = Blueprint.ToString();
+	const FString GraphString = Graph.ToString();
+	const FString NodeGuidString = NodeGuid.ToString();
+	UE_TRACE_LOG(ACF, NodeSpec, ACFChannel)
+		<< NodeSpec.NodeId(NodeId) << NodeSpec.Blueprint(*BlueprintString, BlueprintString.Len())
+		<< NodeSpec.Graph(*GraphString, GraphString.Len()) << NodeSpec.NodeGuid(*NodeGuidString, NodeGuidString.Len());
+
+	const FString ScopeName =
+		FString::Printf(TEXT("ACF %s:%s:%s"), *FPaths::GetBaseFilename(BlueprintString), *GraphString, *NodeGuidString);
+	uint32 SpecId = FCpuProfilerTrace::OutputEventType(*ScopeName);
+	NodeSpecs.Add(NodeId, SpecId);
+
+	return SpecId;
+}
+
+// The lowest bit of the token tells whether the CPU profiler scope is opened.
+static int64 Begin(FName Blueprint, FName Graph, FName NodeGuid)
+{
+	if (!UE_TRACE_CHANNELEXPR_IS_ENABLED(ACFChannel))
+	{
+		return 0;
+	}
+
+	const uint64 NodeId = GetNodeId(Blueprint, Graph, NodeGuid);
+	const uint32 SpecId = FindOrAddNodeSpec(NodeId, Blueprint, Graph, NodeGuid);
+	int64 bCpuScope = 0;
+	if (UE_TRACE_CHANNELEXPR_IS_ENABLED(CpuChannel))
+	{
+		FCpuProfilerTrace::OutputBeginEvent(SpecId);
+		bCpuScope = 1;
+	}
+
+	return (static_cast<int64>(FPlatformTime::Cycles64()) << 1) | bCpuScope;
+}
+
+static void End(FName Blueprint, FName Graph, FName NodeGuid, int64 Token, int32 NumConditions, int32 CaseIndex)
+{
+	if (Token == 0)
+	{
+		return;
+	}
+
+	const uint64 EndCycle = FPlatformTime::Cycles64();
+	if (Token & 1)
+	{
+		FCpuProfilerTrace::OutputEndEvent();
+	}
+
+	UE_TRACE_LOG(ACF, NodeEvaluation, ACFChannel)
+		<< NodeEvaluation.NodeId(GetNodeId(Blueprint, Graph, NodeGuid))
+		<< NodeEvaluation.StartCycle(static_cast<uint64>(Token) >> 1) << NodeEvaluation.EndCycle(EndCycle)
+		<< NodeEvaluation.CaseIndex(CaseIndex) << NodeEvaluation.NumConditions(NumConditions);
+}
+
+static int32 GetOriginalCaseIndex(FName CaseOrder, int32 CaseIndex)
+{
+	if (CaseIndex == INDEX_NONE)
+	{
+		return INDEX_NONE;
+	}
+
+	TArray<FString> Indices;
+	CaseOrder.ToString().ParseIntoArray(Indices, TEXT(","));
+
+	return Indices.IsValidIndex(CaseIndex) ? FCString::Atoi(*Indices[CaseIndex]) : CaseIndex;
+}
+}  // namespace ACFTrace
+
+#endif
+
+int64 UACFTraceLibrary::BeginNodeEvaluation(FName Blueprint, FName Graph, FName NodeGuid)
+{
+#if ACF_TRACE_ENABLED
+	return ACFTrace::Begin(Blueprint, Graph, NodeGuid);
+#else
+	return 0;
+#endif
+}
+
+void UACFTraceLibrary::EndNodeEvaluation(
+	FName Blueprint, FName Graph, FName NodeGuid, int64 Token, int32 NumConditions, int32 CaseIndex)
+{
+#if ACF_TRACE_ENABLED
+	ACFTrace::End(Blueprint, Graph, NodeGuid, Token, NumConditions, CaseIndex);
+#endif
+}
+
+int64 UACFTraceLibrary::BeginSelectEvaluation(FName Blueprint, FName Graph, FName NodeGuid)
+{
+#if ACF_TRACE_ENABLED
+	return ACFTrace::Begin(Blueprint, Graph, NodeGuid);
+#else
+	return 0;
+#endif
+}
+
+int32 UACFTraceLibrary::EndSelectEvaluation(
+	FName Blueprint, FName Graph, FName NodeGuid, int64 Token, int32 NumConditions, FName CaseOrder, int32 CaseIndex)
+{
+#if ACF_TRACE_ENABLED
+	if (Token != 0)
+	{
+		ACFTrace::End(Blueprint, Graph, NodeGuid, Token, NumConditions, ACFTrace::GetOriginalCaseIndex(CaseOrder, CaseIndex));
+	}
+#endif
+
+	return CaseIndex;
+}
@@ -0,0 +1,316 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "ACFWaitLibrary.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "LatentActions.h"
+#include "Misc/EngineVersionComparison.h"
+
+#if !UE_VERSION_OLDER_THAN(5, 1, 0)
+#include "INotifyFieldValueChanged.h"
+#endif
+
+static int32 GACFWaitMaxPollsPerFrame = 256;
+static FAutoConsoleVariableRef CVarACFWaitMaxPollsPerFrame(TEXT("ACF.Wait.MaxPollsPerFrame"), GACFWaitMaxPollsPerFrame,
+	TEXT("Number of the waiting nodes of AdvancedControlFlow which are polled in a frame. The rest is polled on the next frame."));
+
+namespace ACFWait
+{
+// Width of the bucket, which is the shortest polling interval.
+static const double BucketSeconds = 0.05;
+
+// Free blocks of the finished actions. The latent actions are created and deleted on the game thread.
+static TArray<void*> FreeActions;
+static const int32 MaxFreeActions = 4096;
+
+#if !UE_VERSION_OLDER_THAN(5, 1, 0)
+static void OnFieldValueChanged(UObject* Object, UE::FieldNotification::FFieldId FieldId)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(Object, EGetWorldErrorMode::ReturnNull);
+	UACFWaitSubsystem* Subsystem = (World != nullptr) ? World->GetSubsystem<UACFWaitSubsystem>() : nullptr;
+	if (Subsystem != nullptr)
+	{
+		Subsystem->Wake(Object);
+	}
+}
+#endif
+}  // namespace ACFWait
+
+class FACFWaitAction : public FPendingLatentAction
+{
+	FName ExecutionFunction;
+	int32 OutputLink;
+	FWeakObjectPtr CallbackTarget;
+#if !UE_VERSION_OLDER_THAN(5, 1, 0)
+	// Field notifications of the callback target which wake the action.
+	TArray<TPair<UE::FieldNotification::FFieldId, FDelegateHandle>, TInlineAllocator<4>> Bindings;
+#endif
+
+public:
+	TWeakObjectPtr<UACFWaitSubsystem> Subsystem;
+	TObjectKey<UObject> Owner;
+	// Index of the bucket which the action is in, or INDEX_NONE.
+	int64 Bucket = INDEX_NONE;
+	bool bWoken = false;
+
+	FACFWaitAction(UACFWaitSubsystem* InSubsystem, const FLatentActionInfo& LatentInfo)
+		: ExecutionFunction(LatentInfo.ExecutionFunction), OutputLink(LatentInfo.Linkage), Subsystem(InSubsystem)
+	{
+		const UObject* Target = LatentInfo.CallbackTarget;
+		CallbackTarget = Target;
+		Owner = TObjectKey<UObject>(Target);
+	}
+
+	virtual ~FACFWaitAction()
+	{
+#if !UE_VERSION_OLDER_THAN(5, 1, 0)
+		if (INotifyFieldValueChanged* Notifier = Cast<INotifyFieldValueChanged>(CallbackTarget.Get()))
+		{
+			for (auto& Binding : Bindings)
+			{
+				Notifier->RemoveFieldValueChangedDelegate(Binding.Key, Binding.Value);
+			}
+		}
+#endif
+		if (UACFWaitSubsystem* WaitSubsystem = Subsystem.Get())
+		{
+			WaitSubsystem->Unregister(this);
+		}
+	}
+
+	// Binds the field notifications of the Boolean member variables of the callback target, which are separated by ",".
+	// The variables which do not notify the change are left to the wake by the call or the polling.
+	void BindWakeSources(FName WakeSources)
+	{
+#if !UE_VERSION_OLDER_THAN(5, 1, 0)
+		UObject* Target = CallbackTarget.Get();
+		INotifyFieldValueChanged* Notifier = Cast<INotifyFieldValueChanged>(Target);
+		if ((Notifier == nullptr) || WakeSources.IsNone())
+		{
+			return;
+		}
+
+		TArray<FString> Fields;
+		WakeSources.ToString().ParseIntoArray(Fields, TEXT(","));
+		for (auto& Field : Fields)
+		{
+			const FName FieldName(*Field);
+			if (FindFProperty<FBoolProperty>(Target->GetClass(), FieldName) == nullptr)
+			{
+				continue;
+			}
+
+			const UE::FieldNotification::FFieldId FieldId =
+				Notifier->GetFieldNotificationDescriptor().GetField(Target->GetClass(), FieldName);
+			if (FieldId.IsValid())
+			{
+				const FDelegateHandle Handle = Notifier->AddFieldValueChangedDelegate(
+					FieldId, INotifyFieldValueChanged::FFieldValueChangedDelegate::CreateStatic(&ACFWait::OnFieldValueChanged));
+				Bindings.Emplace(FieldId, Handle);
+			}
+		}
+#endif
+	}
+
+	virtual void UpdateOperation(FLatentResponse& Response) override
+	{
+		Response.FinishAndTriggerIf(bWoken, ExecutionFunction, OutputLink, CallbackTarget);
+	}
+
+#if WITH_EDITOR
+	virtual FString GetDescription() const override
+	{
+		return TEXT("Waiting for the first true case");
+	}
+#endif
+
+	// A waiting node creates a new action each time its conditions are all false, so the actions are recycled.
+	static void* operator new(size_t Size)
+	{
+		check(IsInGameThread() && (Size == sizeof(FACFWaitAction)));
+		if (ACFWait::FreeActions.Num() > 0)
+		{
+			return ACFWait::FreeActions.Pop(false);
+		}
+		return FMemory::Malloc(sizeof(FACFWaitAction), alignof(FACFWaitAction));
+	}
+
+	static void operator delete(void* Pointer)
+	{
+		if (ACFWait::FreeActions.Num() < ACFWait::MaxFreeActions)
+		{
+			ACFWait::FreeActions.Add(Pointer);
+		}
+		else
+		{
+			FMemory::Free(Pointer);
+		}
+	}
+};
+
+int64 UACFWaitSubsystem::GetBucket(double Time) const
+{
+	return static_cast<int64>(FMath::FloorToDouble(Time / ACFWait::BucketSeconds));
+}
+
+void UACFWaitSubsystem::WakeAction(FACFWaitAction* Action)
+{
+	if (Action->Bucket != INDEX_NONE)
+	{
+		TArray<FACFWaitAction*>* Bucket = Buckets.Find(Action->Bucket);
+		if (Bucket != nullptr)
+		{
+			Bucket->RemoveSingleSwap(Action, false);
+			if (Bucket->Num() == 0)
+			{
+				Buckets.Remove(Action->Bucket);
+			}
+		}
+		Action->Bucket = INDEX_NONE;
+	}
+	Action->bWoken = true;
+}
+
+void UACFWaitSubsystem::Deinitialize()
+{
+	// The latent actions may outlive the subsystem.
+	for (auto& Pair : Waiters)
+	{
+		Pair.Value->Subsystem = nullptr;
+		Pair.Value->Bucket = INDEX_NONE;
+	}
+	Waiters.Reset();
+	Buckets.Reset();
+
+	Super::Deinitialize();
+}
+
+void UACFWaitSubsystem::Tick(float DeltaTime)
+{
+	const int64 CurrentBucket = GetBucket(GetWorld()->GetTimeSeconds());
+	int32 Budget = FMath::Max(GACFWaitMaxPollsPerFrame, 1);
+	for (; NextBucket <= CurrentBucket; ++NextBucket)
+	{
+		TArray<FACFWaitAction*>* Bucket = Buckets.Find(NextBucket);
+		if (Bucket == nullptr)
+		{
+			continue;
+		}
+
+		while ((Bucket->Num() > 0) && (Budget > 0))
+		{
+			FACFWaitAction* Action = Bucket->Pop(false);
+			Action->Bucket = INDEX_NONE;
+			Action->bWoken = true;
+			--Budget;
+		}
+		if (Bucket->Num() > 0)
+		{
+			return;
+		}
+		Buckets.Remove(NextBucket);
+	}
+}
+
+bool UACFWaitSubsystem::IsTickable() const
+{
+	return (Buckets.Num() > 0) && !HasAnyFlags(RF_ClassDefaultObject);
+}
+
+TStatId UACFWaitSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UACFWaitSubsystem, STATGROUP_Tickables);
+}
+
+UWorld* UACFWaitSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+void UACFWaitSubsystem::Register(FACFWaitAction* Action)
+{
+	Waiters.Add(Action->Owner, Action);
+}
+
+void UACFWaitSubsystem::Unregister(FACFWaitAction* Action)
+{
+	WakeAction(Action);
+	Waiters.RemoveSingle(Action->Owner, Action);
+}
+
+void UACFWaitSubsystem::Schedule(FACFWaitAction* Action, float PollingInterval)
+{
+	const int64 CurrentBucket = GetBucket(GetWorld()->GetTimeSeconds());
+	if (Buckets.Num() == 0)
+	{
+		// The buckets passed while nothing was scheduled are not visited.
+		NextBucket = CurrentBucket + 1;
+	}
+
+	const int64 NumBuckets = FMath::Max(static_cast<int64>(FMath::CeilToDouble(PollingInterval / ACFWait::BucketSeconds)), 1LL);
+	Action->Bucket = FMath::Max(CurrentBucket + NumBuckets, NextBucket);
+	Buckets.FindOrAdd(Action->Bucket).Add(Action);
+}
+
+void UACFWaitSubsystem::Wake(const UObject* Object)
+{
+	TArray<FACFWaitAction*> Actions;
+	Waiters.MultiFind(TObjectKey<UObject>(Object), Actions);
+	for (auto& Action : Actions)
+	{
+		WakeAction(Action);
+	}
+}
+
+void UACFWaitLibrary::WaitForCaseChange(
+	const UObject* WorldContextObject, float PollingInterval, FName WakeSources, FLatentActionInfo LatentInfo)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (World == nullptr)
+	{
+		return;
+	}
+
+	FLatentActionManager& LatentActionManager = World->GetLatentActionManager();
+	if (LatentActionManager.FindExistingAction<FACFWaitAction>(LatentInfo.CallbackTarget, LatentInfo.UUID) != nullptr)
+	{
+		return;
+	}
+
+	UACFWaitSubsystem* Subsystem = World->GetSubsystem<UACFWaitSubsystem>();
+	FACFWaitAction* Action = new FACFWaitAction(Subsystem, LatentInfo);
+	if (Subsystem != nullptr)
+	{
+		Subsystem->Register(Action);
+		Action->BindWakeSources(WakeSources);
+		if (PollingInterval > 0.0f)
+		{
+			Subsystem->Schedule(Action, PollingInterval);
+		}
+	}
+	else
+	{
+		// The world without the subsystem polls on every frame.
+		Action->bWoken = true;
+	}
+	LatentActionManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID, Action);
+}
+
+void UACFWaitLibrary::WakeWaitingCases(UObject* Object)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(Object, EGetWorldErrorMode::ReturnNull);
+	UACFWaitSubsystem* Subsystem = (World != nullptr) ? World->GetSubsystem<UACFWaitSubsystem>() : nullptr;
+	if (Subsystem != nullptr)
+	{
+		Subsystem->Wake(Object);
+	}
+}
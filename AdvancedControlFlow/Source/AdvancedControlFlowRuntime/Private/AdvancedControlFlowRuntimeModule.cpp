@@ -0,0 +1,34 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowRuntimeModule.h"
+
+#include "Interfaces/IPluginManager.h"
+
+// The module which depends on the optional plugin is loaded only when the plugin is enabled.
+static void LoadModuleIfPluginEnabled(const TCHAR* PluginName, const TCHAR* ModuleName)
+{
+	TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(PluginName);
+	if (Plugin.IsValid() && Plugin->IsEnabled())
+	{
+		FModuleManager::Get().LoadModule(ModuleName);
+	}
+}
+
+void FAdvancedControlFlowRuntimeModule::StartupModule()
+{
+	LoadModuleIfPluginEnabled(TEXT("StateTree"), TEXT("AdvancedControlFlowStateTree"));
+	LoadModuleIfPluginEnabled(TEXT("ControlRig"), TEXT("AdvancedControlFlowRig"));
+}
+
+void FAdvancedControlFlowRuntimeModule::ShutdownModule()
+{
+}
+
+IMPLEMENT_MODULE(FAdvancedControlFlowRuntimeModule, AdvancedControlFlowRuntime);
@@ -0,0 +1,52 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AnimNode_BlendListByFirstTrue.h"
+
+#include "ACFConditionLibrary.h"
+
+int32 FAnimNode_BlendListByFirstTrue::GetActiveChildIndex()
+{
+	const int32 NumConditions = FMath::Min(Conditions.Num(), BlendPose.Num() - 1);
+	return ACFConditions::FindFirstTrue(Conditions.GetData(), NumConditions) + 1;
+}
+
+FString FAnimNode_BlendListByFirstTrue::GetNodeName(FNodeDebugData& DebugData)
+{
+	return DebugData.GetNodeName(this);
+}
+
+#if WITH_EDITOR
+void FAnimNode_BlendListByFirstTrue::AddCase(int32 CaseIndex)
+{
+	AddPose();
+
+	// The pose is added at the last, so move it to the case.
+	const int32 LastCaseIndex = BlendPose.Num() - 2;
+	if ((CaseIndex != INDEX_NONE) && (CaseIndex < LastCaseIndex))
+	{
+		BlendPose.Insert(BlendPose.Pop(false), CaseIndex + 1);
+		BlendTime.Insert(BlendTime.Pop(false), CaseIndex + 1);
+		Conditions.Insert(false, CaseIndex);
+	}
+	else
+	{
+		Conditions.Add(false);
+	}
+}
+
+void FAnimNode_BlendListByFirstTrue::RemoveCase(int32 CaseIndex)
+{
+	if (Conditions.IsValidIndex(CaseIndex))
+	{
+		RemovePose(CaseIndex + 1);
+		Conditions.RemoveAt(CaseIndex);
+	}
+}
+#endif
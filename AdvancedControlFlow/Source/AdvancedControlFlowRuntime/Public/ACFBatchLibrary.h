@@ -0,0 +1,60 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "Kismet/BlueprintFunctionLibrary.h"
+
+#include "ACFBatchLibrary.generated.h"
+
+// Kernels to evaluate the nodes over the arrays of elements at once.
+// The inputs are given as the structure of arrays, and large inputs are processed in parallel.
+namespace ACFBatch
+{
+struct FOption
+{
+	// The first element of the array, or the single value which is broadcast to all elements.
+	const uint8* Data = nullptr;
+	// 0 for the single value.
+	int32 Stride = 0;
+};
+
+// Elements above this number are processed by ParallelFor. Configurable by "ACF.Batch.ParallelThreshold".
+ADVANCEDCONTROLFLOWRUNTIME_API int32 GetParallelThreshold();
+
+// OutElements must point to Num constructed elements of ElementProperty.
+ADVANCEDCONTROLFLOWRUNTIME_API void MultiConditionalSelect(const FProperty* ElementProperty,
+	TArrayView<const bool* const> Conditions, TArrayView<const FOption> Options, const FOption& Default, int32 Num,
+	uint8* OutElements);
+
+// Distributes Num elements to the buckets of the first true case, and the last bucket for the elements of no true case.
+// The elements keep their order in each bucket. OutBuckets must have Conditions.Num() + 1 arrays of ElementProperty.
+ADVANCEDCONTROLFLOWRUNTIME_API void Partition(const FProperty* ElementProperty, TArrayView<const bool* const> Conditions,
+	const uint8* Elements, int32 Num, TArrayView<FScriptArrayHelper> OutBuckets);
+}  // namespace ACFBatch
+
+UCLASS()
+class ADVANCEDCONTROLFLOWRUNTIME_API UACFBatchLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	// Variadic arguments are (Conditions, Option) of each case followed by Default.
+	// Conditions are Boolean arrays. Options and Default are arrays, or single values if the bit of ScalarOptionMask is set.
+	UFUNCTION(BlueprintPure, CustomThunk, meta = (BlueprintInternalUseOnly = "true", Variadic, ArrayParm = "Result"))
+	static void MultiConditionalSelectBatch(int32 NumCases, int64 ScalarOptionMask, TArray<int32>& Result);
+
+	DECLARE_FUNCTION(execMultiConditionalSelectBatch);
+
+	// Variadic arguments are the Conditions of each case followed by the output arrays of each case and Default.
+	UFUNCTION(BlueprintPure, CustomThunk, meta = (BlueprintInternalUseOnly = "true", Variadic, ArrayParm = "Array"))
+	static void MultiBranchPartition(const TArray<int32>& Array, int32 NumCases);
+
+	DECLARE_FUNCTION(execMultiBranchPartition);
+};
@@ -0,0 +1,84 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "Kismet/BlueprintFunctionLibrary.h"
+
+#include <atomic>
+
+#include "ACFCaseHitCounters.generated.h"
+
+#define ACF_WITH_CASE_HIT_COUNTERS (!UE_BUILD_SHIPPING)
+
+#if ACF_WITH_CASE_HIT_COUNTERS
+
+// Per-case hit counters of the instrumented nodes.
+// Each node owns a slot of the fixed size open addressing table, and the counters are incremented without locks.
+class ADVANCEDCONTROLFLOWRUNTIME_API FACFCaseHitCounters
+{
+	struct FHitArray
+	{
+		int32 NumHits;
+		std::atomic<uint64>* Hits;
+
+		explicit FHitArray(int32 InNumHits);
+		~FHitArray();
+	};
+
+	struct FSlot
+	{
+		// 0 means that the slot is empty.
+		std::atomic<uint64> CounterKey{0};
+		// Replaced when the node is recompiled with the different number of the cases.
+		std::atomic<FHitArray*> HitArray{nullptr};
+	};
+
+	static constexpr int32 NumSlots = 4096;
+
+	FSlot Slots[NumSlots];
+
+	// Replaced hit arrays, which may still be read by the other threads until the process exits.
+	FCriticalSection RetiredHitArraysLock;
+	TArray<FHitArray*> RetiredHitArrays;
+
+	const FSlot* FindSlot(uint64 CounterKey) const;
+	FSlot* FindOrClaimSlot(uint64 CounterKey);
+	FHitArray* ReplaceHitArray(FSlot& Slot, FHitArray* OldHitArray, int32 NumCases);
+
+	FACFCaseHitCounters() = default;
+	~FACFCaseHitCounters();
+
+public:
+	static FACFCaseHitCounters& Get();
+
+	static uint64 MakeCounterKey(const FString& NodeKey);
+
+	// The hits of the different number of the cases, which were counted before the node is recompiled, are discarded since
+	// their case indices no longer match.
+	void CountCaseHit(uint64 CounterKey, int32 NumCases, int32 CaseIndex);
+	bool GetCaseHits(uint64 CounterKey, TArray<uint64>& OutHits) const;
+	void Reset();
+};
+
+#endif
+
+UCLASS(meta = (BlueprintThreadSafe))
+class ADVANCEDCONTROLFLOWRUNTIME_API UACFCaseHitCounterLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"))
+	static void CountCaseHit(int64 CounterKey, int32 NumCases, int32 CaseIndex);
+
+	// CaseIndex of INDEX_NONE is counted as the default case, which is the last one.
+	UFUNCTION(BlueprintPure, meta = (BlueprintInternalUseOnly = "true"))
+	static int32 CountSelectedCaseHit(int64 CounterKey, int32 NumCases, int32 CaseIndex);
+};
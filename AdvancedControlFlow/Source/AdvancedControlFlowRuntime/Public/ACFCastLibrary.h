@@ -0,0 +1,35 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "Kismet/BlueprintFunctionLibrary.h"
+
+#include "ACFCastLibrary.generated.h"
+
+UCLASS()
+class ADVANCEDCONTROLFLOWRUNTIME_API UACFCastLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	// CaseClasses identifies the classes of the cases. The case of each object class is cached by CacheClassCase.
+	// Returns the index of the first case class which Object is, INDEX_NONE if no case matches or Object is null,
+	// or NumCases if the case of the class of Object is not cached yet.
+	UFUNCTION(BlueprintPure, meta = (BlueprintInternalUseOnly = "true"))
+	static int32 FindCachedClassCase(FName CaseClasses, int32 NumCases, UObject* Object);
+
+	// Resolves and caches the case of the class of Object. Returns the same index as FindCachedClassCase after caching.
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"))
+	static int32 CacheClassCase(FName CaseClasses, const TArray<UClass*>& Classes, UObject* Object);
+
+	// Returns Object as Class without checking, for the object whose case is already resolved.
+	UFUNCTION(BlueprintPure, meta = (BlueprintInternalUseOnly = "true", DeterminesOutputType = "Class"))
+	static UObject* AsCaseClass(UObject* Object, TSubclassOf<UObject> Class);
+};
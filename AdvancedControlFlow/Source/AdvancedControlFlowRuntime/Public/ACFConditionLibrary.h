@@ -0,0 +1,45 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "Kismet/BlueprintFunctionLibrary.h"
+
+#include "ACFConditionLibrary.generated.h"
+
+// Kernels to find the first true condition.
+namespace ACFConditions
+{
+constexpr int32 GetNumMaskWords(int32 NumConditions)
+{
+	return (NumConditions + 63) / 64;
+}
+
+// Bits beyond NumConditions must be cleared. Returns INDEX_NONE if no condition is true.
+ADVANCEDCONTROLFLOWRUNTIME_API int32 FindFirstTrue(const uint64* Masks, int32 NumConditions);
+ADVANCEDCONTROLFLOWRUNTIME_API int32 FindFirstTrue(const bool* Conditions, int32 NumConditions);
+
+// Computes the first true case of the elements in [Begin, End) from the per-case condition arrays.
+// OutCaseIndices receives End - Begin indices, which are INDEX_NONE if no case is true for the element.
+ADVANCEDCONTROLFLOWRUNTIME_API void ComputeFirstTrueCaseIndices(
+	TArrayView<const bool* const> Conditions, int32 Begin, int32 End, int32* OutCaseIndices);
+}  // namespace ACFConditions
+
+UCLASS(meta = (BlueprintThreadSafe))
+class ADVANCEDCONTROLFLOWRUNTIME_API UACFConditionLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	// Takes any number of Boolean conditions, and returns the index of the first true one or INDEX_NONE.
+	UFUNCTION(BlueprintPure, CustomThunk, meta = (BlueprintInternalUseOnly = "true", Variadic))
+	static int32 FindFirstTrueCondition();
+
+	DECLARE_FUNCTION(execFindFirstTrueCondition);
+};
@@ -0,0 +1,30 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "Engine/DataTable.h"
+
+#include "ACFDecisionRule.generated.h"
+
+// Row of the data table which Decision Table node refers to.
+// The rules are tested in the row order, and the outcome of the first rule whose conditions all hold is executed.
+USTRUCT(BlueprintType)
+struct ADVANCEDCONTROLFLOWRUNTIME_API FACFDecisionRule : public FTableRowBase
+{
+	GENERATED_BODY()
+
+	// Required value of each condition. The condition which is not listed is not tested by this rule.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "DecisionRule")
+	TMap<FName, bool> Conditions;
+
+	// Name of the execution pin executed when this rule is chosen.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "DecisionRule")
+	FName Outcome;
+};
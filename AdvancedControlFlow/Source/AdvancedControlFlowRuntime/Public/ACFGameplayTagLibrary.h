@@ -0,0 +1,69 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "GameplayTagContainer.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+
+#include "ACFGameplayTagLibrary.generated.h"
+
+namespace ACFGameplayTags
+{
+// Tags of the cases as the bitsets over the network index of the gameplay tags, which is shared by all tables.
+// The first case matching the container is found by one pass over the container and one bitset test per case.
+struct ADVANCEDCONTROLFLOWRUNTIME_API FCaseTable
+{
+	bool bMatchAll = false;
+	bool bExactMatch = false;
+
+	void Build(bool bInMatchAll, bool bInExactMatch, TArrayView<const FGameplayTagContainer> Cases);
+
+	// Returns the index of the first case matching Container, or INDEX_NONE.
+	int32 Find(const FGameplayTagContainer& Container) const;
+
+private:
+	struct FCaseBits
+	{
+		int32 FirstWord;
+		int32 NumWords;
+		// Offset of the words in Words.
+		int32 Offset;
+		bool bNeverMatches;
+	};
+
+	TArray<FCaseBits> Cases;
+	TArray<uint64> Words;
+	// Number of the words covering the tags of all cases. The tags of the container beyond them never match.
+	int32 NumTagWords = 0;
+};
+
+// Encodes the match options and the tags of the cases into a name.
+// Returns the empty string if the encoded cases do not fit in a name.
+ADVANCEDCONTROLFLOWRUNTIME_API FString EncodeCases(bool bMatchAll, bool bExactMatch, TArrayView<const FGameplayTagContainer> Cases);
+ADVANCEDCONTROLFLOWRUNTIME_API bool DecodeCases(
+	const FString& Encoded, bool& bOutMatchAll, bool& bOutExactMatch, TArray<FGameplayTagContainer>& OutCases);
+}  // namespace ACFGameplayTags
+
+UCLASS()
+class ADVANCEDCONTROLFLOWRUNTIME_API UACFGameplayTagLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	// Cases are encoded by ACFGameplayTags::EncodeCases. The table is built once for each distinct cases.
+	// Returns the index of the first case matching Tags, or INDEX_NONE.
+	UFUNCTION(BlueprintPure, meta = (BlueprintInternalUseOnly = "true"))
+	static int32 FindGameplayTagCase(FName Cases, const FGameplayTagContainer& Tags);
+
+	// Tests the cases one by one, for the cases which do not fit in a name.
+	UFUNCTION(BlueprintPure, meta = (BlueprintInternalUseOnly = "true"))
+	static int32 FindGameplayTagCaseInArray(
+		const TArray<FGameplayTagContainer>& Cases, bool bMatchAll, bool bExactMatch, const FGameplayTagContainer& Tags);
+};
@@ -0,0 +1,38 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "Kismet/BlueprintFunctionLibrary.h"
+
+#include "ACFParallelLibrary.generated.h"
+
+// Conditions are the node key followed by ";" and the calls of the conditions separated by "|".
+// The call is the path of the thread-safe static native function followed by the arguments, which are separated by ",".
+// The argument is "Param=Literal" or "Param=@Variable" of the object. "%", "|", ",", "=" and ";" in the literal are escaped as
+// "%XX", and "^" and the upper case are escaped as "^" followed by the lower case, since the conditions are case-insensitive.
+// The calls are evaluated on the worker threads once their measured cost exceeds ACF.Parallel.MinCostMicroseconds, and on the
+// calling thread otherwise. Call these on the game thread.
+UCLASS()
+class ADVANCEDCONTROLFLOWRUNTIME_API UACFParallelLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	// Returns INDEX_NONE if no condition is true.
+	UFUNCTION(BlueprintPure, meta = (BlueprintInternalUseOnly = "true", DefaultToSelf = "Object"))
+	static int32 FindFirstTrueParallelCondition(UObject* Object, FName Conditions);
+
+	// Returns the bits of the true conditions. At most 64 conditions are evaluated.
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", DefaultToSelf = "Object"))
+	static int64 EvaluateParallelConditions(UObject* Object, FName Conditions);
+
+	UFUNCTION(BlueprintPure, meta = (BlueprintInternalUseOnly = "true"))
+	static bool IsParallelConditionTrue(int64 Results, int32 Index);
+};
@@ -0,0 +1,52 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "Kismet/BlueprintFunctionLibrary.h"
+
+#include "ACFRandomLibrary.generated.h"
+
+namespace ACFRandom
+{
+// Alias table built by Vose's method.
+// A case is sampled in O(1) from one uniform index and one uniform fraction.
+struct ADVANCEDCONTROLFLOWRUNTIME_API FAliasTable
+{
+	// The weights which the table was built from. Weights not greater than 0 are never sampled.
+	TArray<float> Weights;
+	// Empty if no weight is positive.
+	TArray<float> Probabilities;
+	TArray<int32> Aliases;
+
+	void Build(TArrayView<const float> InWeights);
+
+	// Returns Weights.Num() if no weight is positive. FMath::FRand is used if Stream is nullptr.
+	int32 Sample(const FRandomStream* Stream) const;
+};
+
+ADVANCEDCONTROLFLOWRUNTIME_API int64 MakeTableKey(const FString& NodeKey);
+}  // namespace ACFRandom
+
+UCLASS()
+class ADVANCEDCONTROLFLOWRUNTIME_API UACFRandomLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	// Weights are the literal weights joined by commas. The table is built once for each distinct weights.
+	// Returns the number of the weights if no weight is positive.
+	UFUNCTION(BlueprintPure, meta = (BlueprintInternalUseOnly = "true"))
+	static int32 SampleLiteralWeights(FName Weights, const FRandomStream& Stream, bool bUseStream);
+
+	// The table of each node is rebuilt only when the weights are changed.
+	// Returns the number of the weights if no weight is positive.
+	UFUNCTION(BlueprintPure, meta = (BlueprintInternalUseOnly = "true"))
+	static int32 SampleWeights(int64 TableKey, const TArray<float>& Weights, const FRandomStream& Stream, bool bUseStream);
+};
@@ -0,0 +1,36 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "Kismet/BlueprintFunctionLibrary.h"
+
+#include "ACFRangeLibrary.generated.h"
+
+namespace ACFRange
+{
+// Returns the index of the first bound greater than Value, or Bounds.Num() if there is no such bound.
+// Bounds must be sorted in ascending order.
+ADVANCEDCONTROLFLOWRUNTIME_API int32 FindRange(TArrayView<const double> Bounds, double Value);
+}  // namespace ACFRange
+
+UCLASS()
+class ADVANCEDCONTROLFLOWRUNTIME_API UACFRangeLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	// Bounds are the type of Value ("i" for integer, "f" for float and "d" for double) and the sorted literal bounds,
+	// like "f:0.5,1,2.5". The bounds are parsed once for each distinct literal.
+	// Returns the index of the first bound greater than Value, or the number of the bounds if there is no such bound.
+	UFUNCTION(BlueprintPure, CustomThunk, meta = (BlueprintInternalUseOnly = "true", CustomStructureParam = "Value"))
+	static int32 FindLiteralRange(FName Bounds, const int32& Value);
+
+	DECLARE_FUNCTION(execFindLiteralRange);
+};
@@ -0,0 +1,29 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "Kismet/BlueprintFunctionLibrary.h"
+
+#include "ACFReactiveLibrary.generated.h"
+
+UCLASS()
+class ADVANCEDCONTROLFLOWRUNTIME_API UACFReactiveLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	// Sources are the node key followed by ";" and the sources of the conditions joined by commas.
+	// The source is the name of the Boolean property of the object, or "=1" and "=0" for the literal condition.
+	// The case of each object is cached, and found again only when the field notification of a property comes or the property
+	// which does not notify its change differs from the last call. No condition is evaluated by the calling graph.
+	// Returns INDEX_NONE if no condition is true. Call this on the game thread.
+	UFUNCTION(BlueprintPure, meta = (BlueprintInternalUseOnly = "true", DefaultToSelf = "Object"))
+	static int32 FindFirstTrueReactiveCondition(UObject* Object, FName Sources);
+};
@@ -0,0 +1,71 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "Kismet/BlueprintFunctionLibrary.h"
+
+#include "ACFSwitchLibrary.generated.h"
+
+namespace ACFSwitch
+{
+enum class EKeyType : uint8
+{
+	Name,
+	String,
+	StringCaseSensitive,
+};
+
+// Lookup table of the literal keys by the perfect hash.
+// A key is found by one hash and one comparison. The table falls back to the linear search if no perfect hash is found.
+struct ADVANCEDCONTROLFLOWRUNTIME_API FKeyTable
+{
+	EKeyType Type = EKeyType::Name;
+	TArray<FName> Names;
+	TArray<FString> Strings;
+
+	void Build(EKeyType InType, TArrayView<const FString> Keys);
+
+	// Returns the index of the key, or INDEX_NONE.
+	int32 FindName(FName Key) const;
+	int32 FindString(const FString& Key) const;
+
+private:
+	int32 FindIndex(uint64 Hash) const;
+
+	TArray<uint64> Hashes;
+	// Displacement of the slots for each bucket of the keys. Empty if no perfect hash is found.
+	TArray<uint32> Displacements;
+	// Index of the key for each slot, or INDEX_NONE.
+	TArray<int32> Slots;
+};
+
+// Encodes the keys into a name. The name is case-insensitive, so the upper case letters are escaped.
+// Returns the empty string if the encoded keys do not fit in a name.
+ADVANCEDCONTROLFLOWRUNTIME_API FString EncodeKeys(EKeyType Type, TArrayView<const FString> Keys);
+ADVANCEDCONTROLFLOWRUNTIME_API bool DecodeKeys(const FString& Encoded, EKeyType& OutType, TArray<FString>& OutKeys);
+}  // namespace ACFSwitch
+
+UCLASS()
+class ADVANCEDCONTROLFLOWRUNTIME_API UACFSwitchLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	// Keys are encoded by ACFSwitch::EncodeKeys. The table is built once for each distinct keys.
+	// Returns the index of the key equal to Selection, or INDEX_NONE.
+	UFUNCTION(BlueprintPure, meta = (BlueprintInternalUseOnly = "true"))
+	static int32 FindNameCase(FName Keys, FName Selection);
+
+	// Selection is referred in place, so that the string is not copied on every call.
+	UFUNCTION(BlueprintPure, CustomThunk, meta = (BlueprintInternalUseOnly = "true"))
+	static int32 FindStringCase(FName Keys, const FString& Selection);
+
+	DECLARE_FUNCTION(execFindStringCase);
+};
@@ -0,0 +1,48 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "Kismet/BlueprintFunctionLibrary.h"
+
+#include "ACFThrottleLibrary.generated.h"
+
+// State of a throttled node, which each instance holds in a persistent variable.
+USTRUCT(BlueprintType)
+struct ADVANCEDCONTROLFLOWRUNTIME_API FACFThrottleState
+{
+	GENERATED_BODY()
+
+	// Time in seconds or the frame number from which the conditions are evaluated again. Negative before the first evaluation.
+	UPROPERTY()
+	double NextRefresh = -1.0;
+
+	// Case taken by the last evaluation. INDEX_NONE for the default case.
+	UPROPERTY()
+	int32 CaseIndex = INDEX_NONE;
+};
+
+UCLASS()
+class ADVANCEDCONTROLFLOWRUNTIME_API UACFThrottleLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	// Returns true if the conditions need to be evaluated, and schedules the next evaluation.
+	// The first evaluation is followed by a random fraction of the interval, so that the instances spread over the interval.
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject"))
+	static bool RefreshThrottledCase(
+		const UObject* WorldContextObject, UPARAM(ref) FACFThrottleState& State, float Interval, bool bFrames, bool bForceRefresh);
+
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"))
+	static void SetThrottledCase(UPARAM(ref) FACFThrottleState& State, int32 CaseIndex);
+
+	UFUNCTION(BlueprintPure, meta = (BlueprintInternalUseOnly = "true"))
+	static int32 GetThrottledCase(const FACFThrottleState& State);
+};
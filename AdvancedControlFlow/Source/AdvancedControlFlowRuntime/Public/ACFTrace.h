@@ -0,0 +1,51 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "Misc/EngineVersionComparison.h"
+#include "Trace/Trace.h"
+
+#include "ACFTrace.generated.h"
+
+#if UE_TRACE_ENABLED && !UE_BUILD_SHIPPING && !UE_VERSION_OLDER_THAN(5, 0, 0)
+#define ACF_TRACE_ENABLED 1
+#else
+#define ACF_TRACE_ENABLED 0
+#endif
+
+#if ACF_TRACE_ENABLED
+// Off by default. Enable by "-trace=cpu,acf" or "Trace.Enable ACF" console command.
+UE_TRACE_CHANNEL_EXTERN(ACFChannel, ADVANCEDCONTROLFLOWRUNTIME_API)
+#endif
+
+// Entry points called from the instrumented nodes.
+// Begin returns the token which must be passed to End. The token is 0 when the channel is disabled.
+UCLASS(meta = (BlueprintThreadSafe))
+class ADVANCEDCONTROLFLOWRUNTIME_API UACFTraceLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"))
+	static int64 BeginNodeEvaluation(FName Blueprint, FName Graph, FName NodeGuid);
+
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"))
+	static void EndNodeEvaluation(FName Blueprint, FName Graph, FName NodeGuid, int64 Token, int32 NumConditions, int32 CaseIndex);
+
+	UFUNCTION(BlueprintPure, meta = (BlueprintInternalUseOnly = "true"))
+	static int64 BeginSelectEvaluation(FName Blueprint, FName Graph, FName NodeGuid);
+
+	// Returns CaseIndex as is, so that the selection waits for the end of the evaluation.
+	// CaseOrder is the comma separated original case indices in the evaluation order, which CaseIndex refers to.
+	UFUNCTION(BlueprintPure, meta = (BlueprintInternalUseOnly = "true"))
+	static int32 EndSelectEvaluation(
+		FName Blueprint, FName Graph, FName NodeGuid, int64 Token, int32 NumConditions, FName CaseOrder, int32 CaseIndex);
+};
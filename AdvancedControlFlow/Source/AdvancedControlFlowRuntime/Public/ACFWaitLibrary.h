@@ -0,0 +1,76 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "Engine/LatentActionManager.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "UObject/ObjectKey.h"
+
+#include "ACFWaitLibrary.generated.h"
+
+class FACFWaitAction;
+
+// Wakes the waiting nodes of the world.
+// The polled waiters are put in the buckets of their polling time, and each tick wakes only the due buckets up to the budget,
+// so that the waiters need neither their own ticks nor a scan of all waiters.
+UCLASS()
+class ADVANCEDCONTROLFLOWRUNTIME_API UACFWaitSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+	// Waiters in the buckets of BucketSeconds, keyed by the bucket index of the time.
+	TMap<int64, TArray<FACFWaitAction*>> Buckets;
+	TMultiMap<TObjectKey<UObject>, FACFWaitAction*> Waiters;
+	int64 NextBucket = 0;
+
+	int64 GetBucket(double Time) const;
+	void WakeAction(FACFWaitAction* Action);
+
+public:
+	// Override from USubsystem
+	virtual void Deinitialize() override;
+
+	// Override from FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	void Register(FACFWaitAction* Action);
+	void Unregister(FACFWaitAction* Action);
+
+	// Schedules the polling of the waiter after the interval. The interval is rounded up to the bucket.
+	void Schedule(FACFWaitAction* Action, float PollingInterval);
+
+	// Wakes all waiters of the object.
+	void Wake(const UObject* Object);
+};
+
+UCLASS()
+class ADVANCEDCONTROLFLOWRUNTIME_API UACFWaitLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	// Resumes when the waiter is woken or polled. PollingInterval not greater than 0 waits only for the wake.
+	// WakeSources are the Boolean member variables of the callback target separated by ",", whose field notifications wake the
+	// waiter. The node which is already waiting does not start another wait.
+	UFUNCTION(BlueprintCallable,
+		meta = (BlueprintInternalUseOnly = "true", Latent, LatentInfo = "LatentInfo", WorldContext = "WorldContextObject"))
+	static void WaitForCaseChange(
+		const UObject* WorldContextObject, float PollingInterval, FName WakeSources, FLatentActionInfo LatentInfo);
+
+	// Makes the Wait For First True Case nodes of the object test their conditions again on the next frame.
+	// Call this from the handler of the delegate or the change notification which the conditions depend on.
+	UFUNCTION(BlueprintCallable, Category = "Utilities|FlowControl", meta = (DefaultToSelf = "Object"))
+	static void WakeWaitingCases(UObject* Object);
+};
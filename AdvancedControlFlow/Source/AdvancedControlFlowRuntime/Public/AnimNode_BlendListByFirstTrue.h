@@ -0,0 +1,38 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "AnimNodes/AnimNode_BlendListBase.h"
+
+#include "AnimNode_BlendListByFirstTrue.generated.h"
+
+// Blends to the pose of the first true condition, or to the default pose if no condition is true.
+// BlendPose[0] is the default pose, and BlendPose[Index + 1] is the pose of Conditions[Index].
+// Only the active pose and the poses which are blending out are updated and evaluated.
+USTRUCT(BlueprintInternalUseOnly)
+struct ADVANCEDCONTROLFLOWRUNTIME_API FAnimNode_BlendListByFirstTrue : public FAnimNode_BlendListBase
+{
+	GENERATED_BODY()
+
+	// Bound to the member variables, the conditions are copied by the fast path without running the Blueprint VM.
+	UPROPERTY(EditAnywhere, EditFixedSize, BlueprintReadWrite, Category = Runtime, meta = (PinShownByDefault))
+	TArray<bool> Conditions;
+
+#if WITH_EDITOR
+	// Adds the pair of the condition and the pose before the case of CaseIndex, or at the last if INDEX_NONE.
+	void AddCase(int32 CaseIndex = INDEX_NONE);
+	void RemoveCase(int32 CaseIndex);
+#endif
+
+protected:
+	// Override from FAnimNode_BlendListBase
+	virtual int32 GetActiveChildIndex() override;
+	virtual FString GetNodeName(FNodeDebugData& DebugData) override;
+};
@@ -0,0 +1,35 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+using UnrealBuildTool;
+
+public class AdvancedControlFlowStateTree : ModuleRules
+{
+	public AdvancedControlFlowStateTree(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[]{
+			"Core",
+			"CoreUObject",
+			"Engine",
+		});
+
+		PrivateDependencyModuleNames.AddRange(new string[]{
+			"AdvancedControlFlowRuntime",
+		});
+
+		// The StateTree API used by the condition is available from UE 5.1.
+		// This module is loaded by AdvancedControlFlowRuntime only when StateTree plugin is enabled.
+		if ((Target.Version.MajorVersion > 5) || ((Target.Version.MajorVersion == 5) && (Target.Version.MinorVersion >= 1)))
+		{
+			PublicDependencyModuleNames.Add("StateTreeModule");
+		}
+	}
+}
@@ -0,0 +1,20 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowStateTreeModule.h"
+
+void FAdvancedControlFlowStateTreeModule::StartupModule()
+{
+}
+
+void FAdvancedControlFlowStateTreeModule::ShutdownModule()
+{
+}
+
+IMPLEMENT_MODULE(FAdvancedControlFlowStateTreeModule, AdvancedControlFlowStateTree);
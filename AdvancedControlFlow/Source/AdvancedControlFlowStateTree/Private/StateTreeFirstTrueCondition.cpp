@@ -0,0 +1,25 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "StateTreeFirstTrueCondition.h"
+
+// @remove-start UE_VERSION=4.26.0,4.27.0,5.0.0
+#include "ACFConditionLibrary.h"
+#include "StateTreeExecutionContext.h"
+
+bool FStateTreeFirstTrueCondition::TestCondition(FStateTreeExecutionContext& Context) const
+{
+	const FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	// The conditions after this case cannot change the result.
+	const int32 NumConditions = InstanceData.Conditions.Num();
+	const int32 NumTestedConditions = (CaseIndex == INDEX_NONE) ? NumConditions : FMath::Min(CaseIndex + 1, NumConditions);
+	return ACFConditions::FindFirstTrue(InstanceData.Conditions.GetData(), NumTestedConditions) == CaseIndex;
+}
+// @remove-end
@@ -0,0 +1,49 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+// @remove-start UE_VERSION=4.26.0,4.27.0,5.0.0
+#include "StateTreeConditionBase.h"
+
+#include "StateTreeFirstTrueCondition.generated.h"
+
+USTRUCT()
+struct ADVANCEDCONTROLFLOWSTATETREE_API FStateTreeFirstTrueConditionInstanceData
+{
+	GENERATED_BODY()
+
+	// Conditions tested in the order. Bind them to the properties of the context or the evaluators.
+	UPROPERTY(EditAnywhere, Category = "Input")
+	TArray<bool> Conditions;
+};
+
+// StateTree version of Multi-Branch. Each transition or state has this condition with the same conditions and its own case,
+// and the one of the first true condition passes like if-elseif-else statement.
+USTRUCT(DisplayName = "First True Condition")
+struct ADVANCEDCONTROLFLOWSTATETREE_API FStateTreeFirstTrueCondition : public FStateTreeConditionCommonBase
+{
+	GENERATED_BODY()
+
+	using FInstanceDataType = FStateTreeFirstTrueConditionInstanceData;
+
+	// Passes when the condition of this index is the first true one. -1 passes when no condition is true.
+	UPROPERTY(EditAnywhere, Category = "Parameter", meta = (ClampMin = "-1"))
+	int32 CaseIndex = 0;
+
+	// Override from FStateTreeNodeBase
+	virtual const UStruct* GetInstanceDataType() const override
+	{
+		return FInstanceDataType::StaticStruct();
+	}
+
+	// Override from FStateTreeConditionBase
+	virtual bool TestCondition(FStateTreeExecutionContext& Context) const override;
+};
+// @remove-end
@@ -18,5 +18,11 @@ public class SampleProject : ModuleRules
 		PublicDependencyModuleNames.AddRange(new string[]{"Core", "CoreUObject", "Engine", "InputCore"});
 
 		PrivateDependencyModuleNames.AddRange(new string[]{});
+
+		// The stress scenario builds the Blueprint running the nodes when it runs in the editor.
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.AddRange(new string[]{"AdvancedControlFlow", "BlueprintGraph", "UnrealEd"});
+		}
 	}
 }
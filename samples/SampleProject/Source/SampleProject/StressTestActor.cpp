@@ -0,0 +1,66 @@
+/*!
+ * SampleProject
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "StressTestActor.h"
+
+// Radius of the area where the targets are placed around the actor.
+static const float TargetRadius = 2000.0f;
+
+AStressTestActor::AStressTestActor()
+	: Health(100.0f),
+	  Stamina(100.0f),
+	  DistanceToTarget(0.0f),
+	  AttackCooldown(0.0f),
+	  bIsAlerted(false),
+	  bIsStunned(false),
+	  Speed(0.0f),
+	  Action(0),
+	  Reactions(0)
+{
+	PrimaryActorTick.bCanEverTick = true;
+}
+
+void AStressTestActor::BeginPlay()
+{
+	// Each actor has its own stream, so that the actors do not switch their cases at the same frame.
+	Random.Initialize(GetUniqueID());
+	Health = Random.FRandRange(50.0f, 100.0f);
+	Stamina = Random.FRandRange(0.0f, 100.0f);
+	TargetLocation = GetActorLocation() + Random.VRand() * Random.FRandRange(0.0f, TargetRadius);
+
+	Super::BeginPlay();
+}
+
+void AStressTestActor::Tick(float DeltaSeconds)
+{
+	// The target moves rarely, and the actor approaches it at the speed chosen by the Blueprint.
+	if (Random.FRand() < 0.01f)
+	{
+		TargetLocation = GetActorLocation() + Random.VRand() * Random.FRandRange(0.0f, TargetRadius);
+	}
+	DistanceToTarget = FMath::Max(FVector::Dist(GetActorLocation(), TargetLocation) - Speed * DeltaSeconds, 0.0f);
+
+	// The dead actor revives after a while.
+	Health = FMath::Clamp(Health + Random.FRandRange(-2.0f, 1.5f) * DeltaSeconds * 10.0f, 0.0f, 100.0f);
+	if (Health <= 0.0f && Random.FRand() < 0.01f)
+	{
+		Health = 100.0f;
+	}
+	Stamina = FMath::Clamp(Stamina + ((Speed > 0.0f) ? -20.0f : 10.0f) * DeltaSeconds, 0.0f, 100.0f);
+	AttackCooldown = FMath::Max(AttackCooldown - DeltaSeconds, 0.0f);
+	if (AttackCooldown <= 0.0f && DistanceToTarget < 200.0f)
+	{
+		AttackCooldown = Random.FRandRange(0.5f, 2.0f);
+	}
+	bIsAlerted = bIsAlerted ? (Random.FRand() > 0.02f) : (Random.FRand() < 0.005f);
+	bIsStunned = (Random.FRand() < 0.001f);
+
+	// Event Tick of the child Blueprint runs here.
+	Super::Tick(DeltaSeconds);
+}
@@ -0,0 +1,64 @@
+/*!
+ * SampleProject
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+
+#include "StressTestActor.generated.h"
+
+// Base class of the actor spawned by AStressTestGameMode.
+// The state is updated before Event Tick, so that the child Blueprint runs Multi-Branch, Conditional Sequence and
+// Multi-Conditional Select on the conditions mixed as in the game (mostly idle, sometimes chasing or attacking, rarely dying).
+UCLASS()
+class SAMPLEPROJECT_API AStressTestActor : public AActor
+{
+	GENERATED_BODY()
+
+	FRandomStream Random;
+	FVector TargetLocation;
+
+public:
+	AStressTestActor();
+
+	// Override from AActor
+	virtual void BeginPlay() override;
+	virtual void Tick(float DeltaSeconds) override;
+
+	UPROPERTY(BlueprintReadOnly, Category = "StressTest")
+	float Health;
+
+	UPROPERTY(BlueprintReadOnly, Category = "StressTest")
+	float Stamina;
+
+	UPROPERTY(BlueprintReadOnly, Category = "StressTest")
+	float DistanceToTarget;
+
+	UPROPERTY(BlueprintReadOnly, Category = "StressTest")
+	float AttackCooldown;
+
+	UPROPERTY(BlueprintReadOnly, Category = "StressTest")
+	bool bIsAlerted;
+
+	UPROPERTY(BlueprintReadOnly, Category = "StressTest")
+	bool bIsStunned;
+
+	// Written by the child Blueprint, such as the speed chosen by Multi-Conditional Select.
+	UPROPERTY(BlueprintReadWrite, Category = "StressTest")
+	float Speed;
+
+	// Written by the child Blueprint, such as the case taken by Multi-Branch.
+	UPROPERTY(BlueprintReadWrite, Category = "StressTest")
+	int32 Action;
+
+	// Written by the child Blueprint, such as the count of the cases executed by Conditional Sequence.
+	UPROPERTY(BlueprintReadWrite, Category = "StressTest")
+	int32 Reactions;
+};
@@ -0,0 +1,239 @@
+/*!
+ * SampleProject
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "StressTestBlueprintBuilder.h"
+
+#if WITH_EDITOR
+
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_ConditionalSequence.h"
+#include "K2Node_Event.h"
+#include "K2Node_MultiBranch.h"
+#include "K2Node_MultiConditionalSelect.h"
+#include "K2Node_VariableGet.h"
+#include "K2Node_VariableSet.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Misc/EngineVersionComparison.h"
+#include "StressTestActor.h"
+
+// Function of Event Tick in AActor.
+static const FName ReceiveTickName(TEXT("ReceiveTick"));
+
+// Values of AStressTestActor::Action.
+enum class EStressTestAction : int32
+{
+	Dead,
+	Stunned,
+	Attack,
+	Chase,
+	Idle
+};
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+static const FName LessName = GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, Less_FloatFloat);
+static const FName LessEqualName = GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, LessEqual_FloatFloat);
+#else
+static const FName LessName = GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, Less_DoubleDouble);
+static const FName LessEqualName = GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, LessEqual_DoubleDouble);
+#endif
+
+static UEdGraphPin* SpawnGet(UEdGraph* Graph, FName VariableName)
+{
+	FGraphNodeCreator<UK2Node_VariableGet> Creator(*Graph);
+	UK2Node_VariableGet* Get = Creator.CreateNode(false);
+	Get->VariableReference.SetSelfMember(VariableName);
+	Creator.Finalize();
+
+	return Get->FindPinChecked(VariableName);
+}
+
+static UK2Node_VariableSet* SpawnSet(UEdGraph* Graph, FName VariableName)
+{
+	FGraphNodeCreator<UK2Node_VariableSet> Creator(*Graph);
+	UK2Node_VariableSet* Set = Creator.CreateNode(false);
+	Set->VariableReference.SetSelfMember(VariableName);
+	Creator.Finalize();
+
+	return Set;
+}
+
+static UK2Node_CallFunction* SpawnMathCall(UEdGraph* Graph, FName FunctionName)
+{
+	FGraphNodeCreator<UK2Node_CallFunction> Creator(*Graph);
+	UK2Node_CallFunction* Call = Creator.CreateNode(false);
+	Call->SetFromFunction(UKismetMathLibrary::StaticClass()->FindFunctionByName(FunctionName));
+	Creator.Finalize();
+
+	return Call;
+}
+
+// Returns the Boolean pin of the comparison between the variable and the value, such as "Health < 30".
+static UEdGraphPin* SpawnCompare(UEdGraph* Graph, FName FunctionName, FName VariableName, float Value)
+{
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+
+	UK2Node_CallFunction* Compare = SpawnMathCall(Graph, FunctionName);
+	Schema->TryCreateConnection(SpawnGet(Graph, VariableName), Compare->FindPinChecked(TEXT("A")));
+	Schema->TrySetDefaultValue(*Compare->FindPinChecked(TEXT("B")), LexToString(Value));
+
+	return Compare->GetReturnValuePin();
+}
+
+static UEdGraphPin* SpawnAnd(UEdGraph* Graph, UEdGraphPin* A, UEdGraphPin* B)
+{
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+
+	UK2Node_CallFunction* And = SpawnMathCall(Graph, GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, BooleanAND));
+	Schema->TryCreateConnection(A, And->FindPinChecked(TEXT("A")));
+	Schema->TryCreateConnection(B, And->FindPinChecked(TEXT("B")));
+
+	return And->GetReturnValuePin();
+}
+
+// Returns the execution pin of the node which increments Reactions.
+static UEdGraphPin* SpawnIncrementReactions(UEdGraph* Graph)
+{
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+	const FName ReactionsName = GET_MEMBER_NAME_CHECKED(AStressTestActor, Reactions);
+
+	UK2Node_CallFunction* Add = SpawnMathCall(Graph, GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, Add_IntInt));
+	Schema->TryCreateConnection(SpawnGet(Graph, ReactionsName), Add->FindPinChecked(TEXT("A")));
+	Schema->TrySetDefaultValue(*Add->FindPinChecked(TEXT("B")), TEXT("1"));
+
+	UK2Node_VariableSet* Set = SpawnSet(Graph, ReactionsName);
+	Schema->TryCreateConnection(Add->GetReturnValuePin(), Set->FindPinChecked(ReactionsName));
+
+	return Set->GetExecPin();
+}
+
+// Returns the execution pin of the node which sets Action, and connects its Then pin to NextExecPin.
+static UEdGraphPin* SpawnSetAction(UEdGraph* Graph, EStressTestAction Action, UEdGraphPin* NextExecPin)
+{
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+	const FName ActionName = GET_MEMBER_NAME_CHECKED(AStressTestActor, Action);
+
+	UK2Node_VariableSet* Set = SpawnSet(Graph, ActionName);
+	Schema->TrySetDefaultValue(*Set->FindPinChecked(ActionName), LexToString(static_cast<int32>(Action)));
+	Schema->TryCreateConnection(Set->GetThenPin(), NextExecPin);
+
+	return Set->GetExecPin();
+}
+
+template <typename NodeType>
+static NodeType* SpawnCasePairedPinsNode(UEdGraph* Graph, const TArray<UEdGraphPin*>& Conditions)
+{
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+
+	FGraphNodeCreator<NodeType> Creator(*Graph);
+	NodeType* Node = Creator.CreateNode(false);
+	Creator.Finalize();
+	while (Node->GetCasePinCount() < Conditions.Num())
+	{
+		Node->AddCasePinLast();
+	}
+
+	const TArray<UEdGraphPin*> CondPins = Node->GetCaseConditionPins();
+	for (int32 Index = 0; Index < Conditions.Num(); ++Index)
+	{
+		Schema->TryCreateConnection(Conditions[Index], CondPins[Index]);
+	}
+
+	return Node;
+}
+
+// Returns Event Tick. FKismetEditorUtilities::CreateBlueprint places it disabled as a hint, so it is enabled here.
+static UK2Node_Event* FindOrAddTickEvent(UBlueprint* Blueprint, UEdGraph* Graph)
+{
+	UK2Node_Event* Tick = FBlueprintEditorUtils::FindOverrideForFunction(Blueprint, AActor::StaticClass(), ReceiveTickName);
+	if (Tick != nullptr)
+	{
+		Tick->SetEnabledState(ENodeEnabledState::Enabled, false);
+		return Tick;
+	}
+
+	FGraphNodeCreator<UK2Node_Event> Creator(*Graph);
+	Tick = Creator.CreateNode(false);
+	Tick->EventReference.SetExternalMember(ReceiveTickName, AActor::StaticClass());
+	Tick->bOverrideFunction = true;
+	Creator.Finalize();
+
+	return Tick;
+}
+
+UClass* FStressTestBlueprintBuilder::Build()
+{
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+
+	const FName BlueprintName = MakeUniqueObjectName(GetTransientPackage(), UBlueprint::StaticClass(), TEXT("BP_StressTestActor"));
+	UBlueprint* Blueprint = FKismetEditorUtilities::CreateBlueprint(AStressTestActor::StaticClass(), GetTransientPackage(),
+		BlueprintName, BPTYPE_Normal, UBlueprint::StaticClass(), UBlueprintGeneratedClass::StaticClass());
+	UEdGraph* Graph = FBlueprintEditorUtils::FindEventGraph(Blueprint);
+	UEdGraphPin* TickPin = FindOrAddTickEvent(Blueprint, Graph)->FindPinChecked(UEdGraphSchema_K2::PN_Then);
+
+	// Event Tick -> Conditional Sequence -> Multi-Branch (-> Multi-Branch) -> Set Action -> Set Speed (Multi-Conditional Select)
+	UK2Node_ConditionalSequence* Reactions = SpawnCasePairedPinsNode<UK2Node_ConditionalSequence>(Graph,
+		{SpawnCompare(Graph, LessName, GET_MEMBER_NAME_CHECKED(AStressTestActor, Health), 30.0f),
+			SpawnCompare(Graph, LessName, GET_MEMBER_NAME_CHECKED(AStressTestActor, Stamina), 20.0f)});
+	Schema->TryCreateConnection(TickPin, Reactions->GetExecPin());
+	for (UEdGraphPin* CondPin : Reactions->GetCaseConditionPins())
+	{
+		Schema->TryCreateConnection(Reactions->GetCaseValuePinFromCaseKeyPin(CondPin), SpawnIncrementReactions(Graph));
+	}
+
+	UK2Node_VariableSet* SetSpeed = SpawnSet(Graph, GET_MEMBER_NAME_CHECKED(AStressTestActor, Speed));
+	UK2Node_MultiConditionalSelect* SelectSpeed = SpawnCasePairedPinsNode<UK2Node_MultiConditionalSelect>(Graph,
+		{SpawnGet(Graph, GET_MEMBER_NAME_CHECKED(AStressTestActor, bIsAlerted)),
+			SpawnCompare(Graph, LessName, GET_MEMBER_NAME_CHECKED(AStressTestActor, Stamina), 20.0f)});
+	// Connecting the return value fixes the option pins to Float.
+	Schema->TryCreateConnection(
+		SelectSpeed->GetReturnValuePin(), SetSpeed->FindPinChecked(GET_MEMBER_NAME_CHECKED(AStressTestActor, Speed)));
+	const TArray<UEdGraphPin*> SpeedCondPins = SelectSpeed->GetCaseConditionPins();
+	Schema->TrySetDefaultValue(*SelectSpeed->GetCaseKeyPinFromCaseValuePin(SpeedCondPins[0]), TEXT("600.0"));
+	Schema->TrySetDefaultValue(*SelectSpeed->GetCaseKeyPinFromCaseValuePin(SpeedCondPins[1]), TEXT("150.0"));
+	Schema->TrySetDefaultValue(*SelectSpeed->GetDefaultOptionPin(), TEXT("300.0"));
+	UEdGraphPin* SetSpeedPin = SetSpeed->GetExecPin();
+
+	UK2Node_MultiBranch* Disabled = SpawnCasePairedPinsNode<UK2Node_MultiBranch>(Graph,
+		{SpawnCompare(Graph, LessEqualName, GET_MEMBER_NAME_CHECKED(AStressTestActor, Health), 0.0f),
+			SpawnGet(Graph, GET_MEMBER_NAME_CHECKED(AStressTestActor, bIsStunned))});
+	const TArray<UEdGraphPin*> DisabledCondPins = Disabled->GetCaseConditionPins();
+	Schema->TryCreateConnection(Reactions->GetDefaultExecPin(), Disabled->GetExecPin());
+	Schema->TryCreateConnection(Disabled->GetCaseValuePinFromCaseKeyPin(DisabledCondPins[0]),
+		SpawnSetAction(Graph, EStressTestAction::Dead, SetSpeedPin));
+	Schema->TryCreateConnection(Disabled->GetCaseValuePinFromCaseKeyPin(DisabledCondPins[1]),
+		SpawnSetAction(Graph, EStressTestAction::Stunned, SetSpeedPin));
+
+	UEdGraphPin* CanAttack =
+		SpawnAnd(Graph, SpawnCompare(Graph, LessName, GET_MEMBER_NAME_CHECKED(AStressTestActor, DistanceToTarget), 200.0f),
+			SpawnCompare(Graph, LessEqualName, GET_MEMBER_NAME_CHECKED(AStressTestActor, AttackCooldown), 0.0f));
+	UK2Node_MultiBranch* Combat = SpawnCasePairedPinsNode<UK2Node_MultiBranch>(
+		Graph, {CanAttack, SpawnGet(Graph, GET_MEMBER_NAME_CHECKED(AStressTestActor, bIsAlerted))});
+	const TArray<UEdGraphPin*> CombatCondPins = Combat->GetCaseConditionPins();
+	Schema->TryCreateConnection(Disabled->GetDefaultExecPin(), Combat->GetExecPin());
+	Schema->TryCreateConnection(Combat->GetCaseValuePinFromCaseKeyPin(CombatCondPins[0]),
+		SpawnSetAction(Graph, EStressTestAction::Attack, SetSpeedPin));
+	Schema->TryCreateConnection(Combat->GetCaseValuePinFromCaseKeyPin(CombatCondPins[1]),
+		SpawnSetAction(Graph, EStressTestAction::Chase, SetSpeedPin));
+	Schema->TryCreateConnection(Combat->GetDefaultExecPin(), SpawnSetAction(Graph, EStressTestAction::Idle, SetSpeedPin));
+
+	FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::SkipGarbageCollection);
+	if (Blueprint->Status == BS_Error)
+	{
+		return nullptr;
+	}
+
+	return Blueprint->GeneratedClass;
+}
+
+#endif
@@ -0,0 +1,28 @@
+/*!
+ * SampleProject
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_EDITOR
+
+// Builds the child Blueprint of AStressTestActor, whose Event Tick runs Conditional Sequence, Multi-Branch and
+// Multi-Conditional Select on the state of the actor, so that the stress scenario runs without the Blueprint asset.
+//   Conditional Sequence: Increments Reactions for each of Health < 30 and Stamina < 20.
+//   Multi-Branch: Sets Action to Dead, Stunned, Attack, Chase or Idle.
+//   Multi-Conditional Select: Sets Speed to 600 if alerted, 150 if Stamina < 20, or 300 otherwise.
+class FStressTestBlueprintBuilder
+{
+public:
+	// Returns the generated class, or nullptr if the Blueprint is not compiled.
+	static UClass* Build();
+};
+
+#endif
@@ -0,0 +1,157 @@
+/*!
+ * SampleProject
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "StressTestGameMode.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/CommandLine.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "StressTestActor.h"
+#include "StressTestBlueprintBuilder.h"
+#include "UObject/UObjectArray.h"
+
+CSV_DEFINE_CATEGORY(StressTest, true);
+
+DEFINE_LOG_CATEGORY_STATIC(LogStressTest, Log, All);
+
+// Distance between the actors placed on the grid.
+static const float GridSpacing = 200.0f;
+
+AStressTestGameMode::AStressTestGameMode()
+	: NumActors(1000),
+	  NumFrames(1000),
+	  NumWarmupFrames(60),
+	  FrameCount(0),
+	  UsedPhysicalBeforeSpawn(0)
+{
+	PrimaryActorTick.bCanEverTick = true;
+}
+
+void AStressTestGameMode::BeginPlay()
+{
+	Super::BeginPlay();
+
+	FParse::Value(FCommandLine::Get(), TEXT("StressActors="), NumActors);
+	FParse::Value(FCommandLine::Get(), TEXT("StressFrames="), NumFrames);
+	FParse::Value(FCommandLine::Get(), TEXT("StressWarmupFrames="), NumWarmupFrames);
+	NumActors = FMath::Max(NumActors, 1);
+	NumFrames = FMath::Max(NumFrames, 1);
+	NumWarmupFrames = FMath::Max(NumWarmupFrames, 0);
+
+	FString ActorClassPathString;
+	if (FParse::Value(FCommandLine::Get(), TEXT("StressActorClass="), ActorClassPathString))
+	{
+		ActorClassPath.SetPath(ActorClassPathString);
+	}
+
+	if (ActorClassPath.IsNull())
+	{
+#if WITH_EDITOR
+		ActorClass = FStressTestBlueprintBuilder::Build();
+		if (ActorClass == nullptr)
+		{
+			UE_LOG(LogStressTest, Error, TEXT("Failed to build the Blueprint of StressTestActor"));
+		}
+#else
+		UE_LOG(LogStressTest, Error, TEXT("Specify -StressActorClass, since the Blueprint is built only in the editor"));
+#endif
+	}
+	else
+	{
+		ActorClass = ActorClassPath.TryLoadClass<AStressTestActor>();
+		if (ActorClass == nullptr)
+		{
+			UE_LOG(LogStressTest, Error, TEXT("%s is not a child class of StressTestActor"), *ActorClassPath.ToString());
+		}
+	}
+	if (ActorClass == nullptr)
+	{
+		SetActorTickEnabled(false);
+		FPlatformMisc::RequestExitWithStatus(false, 1);
+		return;
+	}
+
+	SpawnActors();
+}
+
+void AStressTestGameMode::SpawnActors()
+{
+	// The garbage is collected before and after spawning, so that the difference of the used memory is the actors.
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	UsedPhysicalBeforeSpawn = FPlatformMemory::GetStats().UsedPhysical;
+
+	const int32 GridSize = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(NumActors)));
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	for (int32 Index = 0; Index < NumActors; ++Index)
+	{
+		const FVector Location((Index % GridSize) * GridSpacing, (Index / GridSize) * GridSpacing, 0.0f);
+		GetWorld()->SpawnActor<AStressTestActor>(ActorClass, Location, FRotator::ZeroRotator, SpawnParams);
+	}
+
+	UE_LOG(LogStressTest, Display, TEXT("Spawned %d actors of %s"), NumActors, *ActorClass->GetName());
+}
+
+void AStressTestGameMode::BeginCapture()
+{
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	const uint64 UsedPhysicalAfterSpawn = FPlatformMemory::GetStats().UsedPhysical;
+	const int64 MemoryPerActor =
+		(static_cast<int64>(UsedPhysicalAfterSpawn) - static_cast<int64>(UsedPhysicalBeforeSpawn)) / NumActors;
+	UE_LOG(LogStressTest, Display, TEXT("Memory per actor: %lld bytes"), MemoryPerActor);
+
+#if CSV_PROFILER
+	FCsvProfiler* CsvProfiler = FCsvProfiler::Get();
+	CsvProfiler->SetMetadata(TEXT("StressActors"), *LexToString(NumActors));
+	CsvProfiler->SetMetadata(TEXT("StressActorClass"), *ActorClass->GetPathName());
+	CsvProfiler->SetMetadata(TEXT("MemoryPerActorBytes"), *LexToString(MemoryPerActor));
+	CsvProfiler->BeginCapture();
+#else
+	UE_LOG(LogStressTest, Warning, TEXT("CSV profiler is not available in this build configuration"));
+#endif
+}
+
+void AStressTestGameMode::EndCapture()
+{
+	UE_LOG(LogStressTest, Display, TEXT("Captured %d frames of %d actors"), NumFrames, NumActors);
+
+#if CSV_PROFILER
+	// The capture ends at the end of the frame, and the file is written after that.
+	FCsvProfiler* CsvProfiler = FCsvProfiler::Get();
+	CsvProfiler->OnCSVProfileFinished().AddLambda([](const FString& Filename) {
+		UE_LOG(LogStressTest, Display, TEXT("Wrote %s"), *Filename);
+		FPlatformMisc::RequestExit(false);
+	});
+	CsvProfiler->EndCapture();
+#else
+	FPlatformMisc::RequestExit(false);
+#endif
+}
+
+void AStressTestGameMode::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	if (FrameCount == NumWarmupFrames)
+	{
+		BeginCapture();
+	}
+	else if (FrameCount == NumWarmupFrames + NumFrames)
+	{
+		EndCapture();
+	}
+	++FrameCount;
+
+	// The frame time, the game thread time and the garbage collection time are recorded by the engine.
+	CSV_CUSTOM_STAT(StressTest, UsedPhysicalMB,
+		static_cast<float>(FPlatformMemory::GetStats().UsedPhysical / (1024.0 * 1024.0)), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(StressTest, NumObjects, GUObjectArray.GetObjectArrayNumMinusAvailable(), ECsvCustomStatOp::Set);
+}
@@ -0,0 +1,54 @@
+/*!
+ * SampleProject
+ *
+ * Copyright (c) 2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/GameModeBase.h"
+
+#include "StressTestGameMode.generated.h"
+
+class AStressTestActor;
+
+// Spawns many actors running the nodes every tick, captures the CSV profile for a fixed number of frames, and exits.
+// Usage: UnrealEditor SampleProject /Engine/Maps/Entry?game=/Script/SampleProject.StressTestGameMode -game -nullrhi
+//        [-StressActors=<N>] [-StressFrames=<N>] [-StressWarmupFrames=<N>] [-StressActorClass=<Class Path>]
+// The profile is written to Saved/Profiling/CSV.
+UCLASS()
+class SAMPLEPROJECT_API AStressTestGameMode : public AGameModeBase
+{
+	GENERATED_BODY()
+
+	int32 NumActors;
+	int32 NumFrames;
+	int32 NumWarmupFrames;
+	int32 FrameCount;
+	uint64 UsedPhysicalBeforeSpawn;
+
+	// Class of the spawned actors, which is held so that the built Blueprint is not collected.
+	UPROPERTY(Transient)
+	TSubclassOf<AStressTestActor> ActorClass;
+
+	void SpawnActors();
+	void BeginCapture();
+	void EndCapture();
+
+public:
+	AStressTestGameMode();
+
+	// Override from AActor
+	virtual void BeginPlay() override;
+	virtual void Tick(float DeltaSeconds) override;
+
+	// Class spawned unless -StressActorClass is specified.
+	// If empty, the Blueprint running the nodes is built by FStressTestBlueprintBuilder, which is available in the editor.
+	// Specify /Script/SampleProject.StressTestActor to measure the baseline without the nodes.
+	UPROPERTY(EditAnywhere, Category = "StressTest")
+	FSoftClassPath ActorClassPath;
+};